@@ -435,7 +435,7 @@ bool NCPackageSelector::diffState()
 
     bool diff = false;
 
-    std::ostream & log = yuiMilestone();
+    std::ostream & log = yuiMilestoneStream();
     log << "diffState" << endl;
     diff = diff || p.diffState<zypp::Package>();
     log << diff << endl;
@@ -27,6 +27,7 @@ textdomain "ncurses"
 
 #define	 YUILogComponent "ncurses"
 #include <yui/YUILog.h>
+#include <yui/YUITrace.h>
 #include "NCDialog.h"
 #include "NCstring.h"
 #include "NCPopupInfo.h"
@@ -247,7 +248,9 @@ void NCDialog::showDialog()
 	getVisible();
 
 	doUpdate();
-	DumpOn( yuiDebug(), " " );
+
+	if ( YUILog::logLevelEnabled( YUI_LOG_DEBUG ) )
+	    DumpOn( yuiDebugStream(), " " );
 
     }
     else if ( !pan )
@@ -434,6 +437,8 @@ void NCDialog::wRedraw()
 {
     if ( pan )
     {
+	YUI_TRACE_SPAN( "dialogRedraw" );
+
 	if ( isBoxed() )
 	{
 	    pan->bkgdset( wStyle().getDlgBorder( active ).text );
@@ -1140,7 +1145,7 @@ void NCDialog::processInput( int timeout_millisec )
 			yuiMilestone() << "CTRL('D')-'D' DUMP+++++++++++++++++++++" << std::endl;
 			NCurses::ScreenShot();
 			yuiMilestone() << this << std::endl;
-			DumpOn( yuiMilestone(), " " );
+			DumpOn( yuiMilestoneStream(), " " );
 			yuiMilestone() << "CTRL('D')-'D' DUMP---------------------" << std::endl;
 			break;
 
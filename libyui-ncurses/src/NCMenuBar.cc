@@ -130,6 +130,7 @@ NCMenuBar::rebuildMenuTree()
     selectNextMenu();
 
     defsze = wsze( 1, width );
+    invalidatePreferredSize();
 }
 
 
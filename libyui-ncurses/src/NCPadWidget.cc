@@ -24,6 +24,7 @@
 
 #define  YUILogComponent "ncurses"
 #include <yui/YUILog.h>
+#include <yui/YUITrace.h>
 #include "NCPadWidget.h"
 
 /**
@@ -547,6 +548,7 @@ void NCPadWidget::DrawPad()
 {
     if ( pad && !inMultidraw() )
     {
+	YUI_TRACE_SPAN( "drawPad" );
 	pad->update();
 	Redraw();
     }
@@ -158,6 +158,65 @@ void NCSelectionBox::addItem( YItem * item )
 }
 
 
+void NCSelectionBox::itemsChanged( const YItemChangeList & changes )
+{
+    bool onlyChanged = true;
+
+    for ( const YItemChange & change : changes )
+    {
+	if ( change.type != YItemChange::Changed )
+	    onlyChanged = false;
+    }
+
+    if ( onlyChanged )
+    {
+	// Just update the labels of those lines
+
+	for ( const YItemChange & change : changes )
+	{
+	    for ( int i = change.first; i < change.first + change.count; i++ )
+	    {
+		NCTableLine * line = myPad()->ModifyLine( i );
+
+		if ( line && line->Cols() > 0 )
+		    line->GetCol( 0 )->SetLabel( itemAt( i )->label() );
+	    }
+	}
+    }
+    else
+    {
+	// Items were inserted or removed: Append new lines if that's all,
+	// otherwise create all lines again (but still draw only once)
+
+	int first = 0;
+
+	if ( changes.size() == 1 &&
+	     changes.front().type == YItemChange::Inserted &&
+	     changes.front().first == (int) myPad()->Lines() )
+	{
+	    first = changes.front().first;
+	}
+	else
+	{
+	    clearTable();
+	}
+
+	for ( int i = first; i < itemsCount(); i++ )
+	{
+	    std::vector<NCTableCol*> cells( 1U, new NCTableCol( itemAt( i )->label() ) );
+	    myPad()->Append( cells, i );
+	}
+    }
+
+    YItem * item = selectedItem();
+
+    if ( item )
+	myPad()->ScrlLine( item->index() );
+
+    DrawPad();
+}
+
+
 void NCSelectionBox::addItem( const std::string & description, bool selected )
 {
     YSelectionWidget::addItem( description, selected );
@@ -57,6 +57,15 @@ protected:
     virtual NCPad * CreatePad();
     virtual void    wRecoded();
 
+    /**
+     * Update only the lines of items that were inserted, removed or changed
+     * by YSelectionWidget::addItems( YItemCollection && ) or replaceItems().
+     *
+     * Reimplemented from YSelectionWidget.
+     **/
+    virtual bool supportsItemChanges() const { return true; }
+    virtual void itemsChanged( const YItemChangeList & changes );
+
 public:
 
     NCSelectionBox( YWidget * parent, const std::string & label );
@@ -26,6 +26,7 @@
 
 #define  YUILogComponent "ncurses"
 #include <yui/YUILog.h>
+#include <yui/YUITrace.h>
 #include "NCTable.h"
 #include "NCPopupMenu.h"
 
@@ -167,6 +168,8 @@ void NCTable::cellChanged( const YTableCell * changedCell )
     if ( tableCol )
     {
         tableCol->SetLabel( changedCell->label() );
+        // The column might be wider now
+        invalidatePreferredSize();
         DrawPad();
     }
     else
@@ -274,25 +277,46 @@ void NCTable::addPadLine( NCTableLine *      parentLine,
     if ( parentLine || item->hasChildren() )
         _nestedItems = true;
 
+    int index = myPad()->Lines();
+    item->setIndex( index );
+
+    // yuiMilestone() << "Adding pad line for " << item << " index: " << item->index() << endl;
+
+    NCTableLine *line = createPadLine( parentLine, item, index, state );
+    myPad()->Append( line );
+
+    if ( item->selected() )
+	setCurrentItem( item->index() ) ;
+
+    // Recurse over children (if there are any)
+
+    for ( YItemIterator it = item->childrenBegin(); it != item->childrenEnd(); ++it )
+    {
+        addPadLine( line, *it, preventRedraw, state );
+    }
+
+    if ( ! preventRedraw )
+	DrawPad();
+}
+
+
+NCTableLine * NCTable::createPadLine( NCTableLine *      parentLine,
+                                      YTableItem *       item,
+                                      int                index,
+                                      NCTableLine::STATE state )
+{
     vector<NCTableCol*> cells;
 
     if ( _multiSelect )
     {
         // Add a table tag to hold the "[ ]" / "[x]" marker.
-        cells.push_back( new NCTableTag( yitem, yitem->selected() ) );
+        cells.push_back( new NCTableTag( item, item->selected() ) );
     }
 
     // Add all the cells
     for ( YTableCellIterator it = item->cellsBegin(); it != item->cellsEnd(); ++it )
         cells.push_back( new NCTableCol( NCstring(( *it )->label() ) ) );
 
-    int index = myPad()->Lines();
-    item->setIndex( index );
-
-    // yuiMilestone() << "Adding pad line for " << item << " index: " << item->index() << endl;
-
-
-    // Create the line itself
     NCTableLine *line = new NCTableLine( parentLine,
                                          item,
                                          cells,
@@ -300,20 +324,104 @@ void NCTable::addPadLine( NCTableLine *      parentLine,
                                          _nestedItems,
                                          state );
     YUI_CHECK_NEW( line );
-    myPad()->Append( line );
 
-    if ( item->selected() )
-	setCurrentItem( item->index() ) ;
+    return line;
+}
 
-    // Recurse over children (if there are any)
 
-    for ( YItemIterator it = item->childrenBegin(); it != item->childrenEnd(); ++it )
+void NCTable::itemsChanged( const YItemChangeList & changes )
+{
+    YUI_TRACE_SPAN_DETAIL( "itemsChanged", std::to_string( changes.size() ) + " changes" );
+
+    if ( _nestedItems || hasNestedItems( itemsBegin(), itemsEnd() ) )
     {
-        addPadLine( line, *it, preventRedraw, state );
+        // The tree structure might have changed anywhere
+
+        if ( keepSorting() )
+            rebuildPadLines();
+        else
+            sortItems( _lastSortCol, _sortReverse );
     }
+    else
+    {
+        // A flat list in the order of the items (which is the sort order
+        // for the old ones): Apply the changes to the lines and keep the
+        // lines of all other items
 
-    if ( ! preventRedraw )
-	DrawPad();
+        vector<NCTableLine*> lines;
+        myPad()->TakeLines( lines );
+
+        for ( const YItemChange & change : changes )
+        {
+            vector<NCTableLine*>::iterator first = lines.begin() + change.first;
+
+            switch ( change.type )
+            {
+                case YItemChange::Removed:
+
+                    for ( int i = 0; i < change.count; i++ )
+                        delete first[i];
+
+                    lines.erase( first, first + change.count );
+                    break;
+
+                case YItemChange::Inserted:
+
+                    lines.insert( first, change.count, (NCTableLine *) 0 );
+                    break;
+
+                case YItemChange::Changed:
+
+                    for ( int i = 0; i < change.count; i++ )
+                    {
+                        delete first[i];
+                        first[i] = 0;
+                    }
+                    break;
+            }
+        }
+
+        bool sorted = true;
+
+        for ( unsigned i = 0; i < lines.size(); i++ )
+        {
+            YTableItem * item = dynamic_cast<YTableItem *>( itemAt( i ) );
+            YUI_CHECK_PTR( item );
+
+            if ( lines[i] )
+            {
+                lines[i]->setIndex( i );
+            }
+            else
+            {
+                lines[i] = createPadLine( 0, item, i, NCTableLine::S_NORMAL );
+
+                // The kept items are still sorted among each other, only
+                // the new ones might be in the wrong place
+
+                if ( ! keepSorting() && sorted )
+                {
+                    sorted = ( i == 0                 || inSortOrder( itemAt( i - 1 ), item ) ) &&
+                             ( i + 1 >= lines.size() || inSortOrder( item, itemAt( i + 1 ) ) );
+                }
+            }
+        }
+
+        myPad()->SetLines( lines );
+
+        if ( ! sorted )
+            sortItems( _lastSortCol, _sortReverse );
+    }
+
+    YItem * item = selectedItem();
+
+    if ( item )
+        setCurrentItem( item->index() );
+
+    if ( !_multiSelect )
+        selectCurrentItem();
+
+    DrawPad();
 }
 
 
@@ -735,6 +843,20 @@ void NCTable::sortItems( int sortCol, bool reverse )
 }
 
 
+bool NCTable::inSortOrder( YItem * item1, YItem * item2 )
+{
+    YItemCollection items;
+    items.push_back( item1 );
+    items.push_back( item2 );
+
+    _sortStrategy->setSortCol( _lastSortCol );
+    _sortStrategy->setReverse( _sortReverse );
+    _sortStrategy->sort( items.begin(), items.end() );
+
+    return items[0] == item1;
+}
+
+
 void NCTable::sortYItems( YItemIterator begin,
                           YItemIterator end )
 {
@@ -69,6 +69,9 @@ public:
      **/
     virtual void addItems( const YItemCollection & itemCollection );
 
+    // Don't hide the overload that takes ownership of the items
+    using YSelectionWidget::addItems;
+
     /**
      * Add one item.
      *
@@ -323,6 +326,28 @@ protected:
                              bool               preventRedraw,
                              NCTableLine::STATE state = NCTableLine::S_NORMAL );
 
+    /**
+     * Create the pad line (an NCTableLine) for 'item' with its cells, but
+     * without its children and without adding it to the pad.
+     **/
+    NCTableLine * createPadLine( NCTableLine *      parentLine,
+                                 YTableItem *       item,
+                                 int                index,
+                                 NCTableLine::STATE state );
+
+    /**
+     * Update only the pad lines of items that were inserted, removed or
+     * changed by YSelectionWidget::addItems( YItemCollection && ) or
+     * replaceItems(). The lines of all other items are kept.
+     *
+     * Nested items and a sorted table need all lines again; they are still
+     * drawn only once.
+     *
+     * Reimplemented from YSelectionWidget.
+     **/
+    virtual bool supportsItemChanges() const { return true; }
+    virtual void itemsChanged( const YItemChangeList & changes );
+
 
     /**
      * Build or rebuild the pad lines: Clear the pad, iterate over all YItems
@@ -431,6 +456,12 @@ protected:
     void sortYItems( YItemIterator begin,
                      YItemIterator end   );
 
+    /**
+     * Return 'true' if 'item1' may be displayed before 'item2' with the
+     * current sort column and direction.
+     **/
+    bool inSortOrder( YItem * item1, YItem * item2 );
+
 private:
 
     // Disable unwanted assignment opearator and copy constructor
@@ -136,6 +136,12 @@ public:
      **/
     int index() const { return _index; }
 
+    /**
+     * Set the index, e.g. after lines were inserted or removed before this
+     * one.
+     **/
+    void setIndex( int index ) { _index = index; }
+
     /**
      * Return the number of columns (cells) in this line.
      **/
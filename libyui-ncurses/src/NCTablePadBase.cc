@@ -151,6 +151,15 @@ void NCTablePadBase::SetLines( std::vector<NCTableLine*> & newItems )
 }
 
 
+void NCTablePadBase::TakeLines( std::vector<NCTableLine*> & lines )
+{
+    lines.clear();
+    lines.swap( _items );
+    _visibleItems.clear();
+    setFormatDirty();
+}
+
+
 void NCTablePadBase::AddLine( unsigned idx, NCTableLine * item )
 {
     assertLine( idx );
@@ -132,6 +132,12 @@ public:
 
     void SetLines( std::vector<NCTableLine*> & newItems );
 
+    /**
+     * Move all lines to *lines* without deleting them and clear the table.
+     * The caller takes ownership; SetLines() can put them back.
+     **/
+    void TakeLines( std::vector<NCTableLine*> & lines );
+
     /**
      * Add *item* at position *idx*, expanding if needed
      * @param item we take ownership
@@ -32,6 +32,7 @@
 
 #define  YUILogComponent "ncurses"
 #include <yui/YUILog.h>
+#include <yui/YUITrace.h>
 #include "NCurses.h"
 #include "NCDialog.h"
 
@@ -426,6 +427,7 @@ void NCurses::Refresh()
 {
     if ( myself && myself->initialized() )
     {
+	YUI_TRACE_SPAN( "refresh" );
 	yuiDebug() << "start refresh ..." << std::endl;
 	SetTitle( myself->title_t );
 	SetStatusLine( myself->status_line );
@@ -440,6 +442,7 @@ void NCurses::Redraw()
 {
     if ( myself && myself->initialized() )
     {
+	YUI_TRACE_SPAN( "redraw" );
 	yuiDebug() << "start redraw ..." << std::endl;
 
 	// initialize all dialogs rewdraw
@@ -647,7 +650,7 @@ void NCurses::ScreenShot( const std::string & name )
 	return;
 
     //ofstream out( name.c_str(), ios::out|ios::app );
-    std::ostream & out( yuiMilestone() );
+    std::ostream & out( yuiMilestoneStream() );
 
     int curscrlines = myself->title_line() ? lines() + 1 : lines();
 
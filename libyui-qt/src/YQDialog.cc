@@ -28,14 +28,17 @@
 
 #define YUILogComponent "qt-ui"
 #include <yui/YUILog.h>
+#include <yui/YUITrace.h>
 
 #include <yui/YApplication.h>
 #include <yui/YDialogSpy.h>
 #include <yui/YEvent.h>
+#include <yui/YUILoader.h>
 
 #include <QPushButton>
 #include <QMessageBox>
 #include <QDesktopWidget>
+#include <QTimer>
 
 #include "QY2StyleEditor.h"
 #include "QY2Styler.h"
@@ -178,6 +181,14 @@ YQDialog::openInternal()
     QWidget::show();
     QWidget::raise(); // FIXME: is this really necessary?
     QWidget::update();
+
+    // Qt plug-ins can't be loaded in a helper thread: Load them here as
+    // soon as all pending events (including painting this dialog) are
+    // processed. This is cancelled if the dialog goes away before that;
+    // the next dialog will try again.
+
+    if ( YUILoader::pluginPreloadEnabled() )
+	QTimer::singleShot( 0, this, SLOT( preloadPlugins() ) );
 }
 
 
@@ -262,6 +273,8 @@ YQDialog::setEnabled( bool enabled )
 void
 YQDialog::setSize( int newWidth, int newHeight )
 {
+    YUI_TRACE_SPAN( "setSize" );
+
     // yuiDebug() << "Resizing dialog to " << newWidth << " x " << newHeight << endl;
 
     if ( newWidth > qApp->desktop()->width() )
@@ -812,7 +825,8 @@ YQDialog::pollEventInternal()
 
     if ( ! YQUI::ui()->pendingEvent() )
     {
-	// Very short (10 millisec) event loop
+	// Very short (10 millisec) event loop; this is where Qt repaints
+	YUI_TRACE_SPAN( "processEvents" );
 	_eventLoop->processEvents( QEventLoop::AllEvents, 10 );
     }
 
@@ -837,6 +851,13 @@ YQDialog::waitForEventTimeout()
 }
 
 
+void
+YQDialog::preloadPlugins()
+{
+    YUILoader::preloadPlugins();
+}
+
+
 void
 YQDialog::center( QWidget * dialog, QWidget * parent )
 {
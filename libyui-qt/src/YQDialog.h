@@ -223,6 +223,13 @@ protected slots:
      **/
     void waitForEventTimeout();
 
+    /**
+     * Load the optional plug-ins (package selector, graph) when the event
+     * loop is idle after the dialog is shown. See
+     * YUILoader::enablePluginPreload().
+     **/
+    void preloadPlugins();
+
 
 protected:
 
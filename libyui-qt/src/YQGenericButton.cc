@@ -121,6 +121,7 @@ void YQGenericButton::setIcon( const string & iconName )
 	return;
     }
 
+    invalidatePreferredSize();
     QString qIconName = fromUTF8( iconName );
 
     if ( qIconName.isEmpty() )
@@ -89,6 +89,8 @@ YQMenuBar::rebuildMenuTree()
 	// Recursively add menu content
 	rebuildMenuTree( menu, item->childrenBegin(), item->childrenEnd() );
     }
+
+    invalidatePreferredSize();
 }
 
 
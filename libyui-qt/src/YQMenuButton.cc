@@ -101,6 +101,7 @@ YQMenuButton::rebuildMenuTree()
     //
 
     rebuildMenuTree( menu, itemsBegin(), itemsEnd() );
+    invalidatePreferredSize();
 }
 
 
@@ -73,6 +73,9 @@ public:
      **/
     virtual void addItems( const YItemCollection & itemCollection );
 
+    // Don't hide the overload that takes ownership of the items
+    using YSelectionWidget::addItems;
+
     /**
      * Select or deselect an item.
      *
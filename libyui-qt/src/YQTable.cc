@@ -25,6 +25,7 @@
 
 #define YUILogComponent "qt-ui"
 #include <yui/YUILog.h>
+#include <yui/YUITrace.h>
 
 #include <QHeaderView>
 #include <QVBoxLayout>
@@ -229,6 +230,68 @@ YQTable::addItems( const YItemCollection & itemCollection )
 }
 
 
+void
+YQTable::itemsChanged( const YItemChangeList & changes )
+{
+    YUI_TRACE_SPAN_DETAIL( "itemsChanged", std::to_string( changes.size() ) + " changes" );
+
+    YQSignalBlocker sigBlocker( _qt_listView );
+
+    // The removed and the replaced items are not owned by this widget
+    // anymore; delete their clones
+
+    for ( int i = _qt_listView->topLevelItemCount() - 1; i >= 0; i-- )
+    {
+	YQTableListViewItem * clone = dynamic_cast<YQTableListViewItem *>( _qt_listView->topLevelItem( i ) );
+
+	if ( clone && clone->origItem()->owner() != this )
+	    delete clone;
+    }
+
+    // The positions of the inserted and changed ranges are already the
+    // final ones since they come in ascending order
+
+    for ( const YItemChange & change : changes )
+    {
+	if ( change.type == YItemChange::Removed )
+	    continue;
+
+	for ( int index = change.first; index < change.first + change.count; index++ )
+	{
+	    YTableItem * item = dynamic_cast<YTableItem *>( itemAt( index ) );
+	    YUI_CHECK_PTR( item );
+
+	    YQTableListViewItem * clone = new YQTableListViewItem( this, _qt_listView, item );
+	    YUI_CHECK_NEW( clone );
+
+	    // The new clone is the last one; move it to its place
+
+	    int last = _qt_listView->topLevelItemCount() - 1;
+
+	    if ( index < last )
+	    {
+		_qt_listView->takeTopLevelItem( last );
+		_qt_listView->insertTopLevelItem( index, clone );
+	    }
+
+	    if ( item->hasChildren() )
+	    {
+		cloneChildItems( item, clone );
+		_qt_listView->setRootIsDecorated( true );
+	    }
+	}
+    }
+
+    YItem * sel = YSelectionWidget::selectedItem();
+
+    if ( sel )
+	YQTable::selectItem( sel, true );
+
+    for ( int i=0; i < columns(); i++ )
+	_qt_listView->resizeColumnToContents( i );
+}
+
+
 void
 YQTable::selectItem( YItem * yitem, bool selected )
 {
@@ -307,6 +370,7 @@ YQTable::cellChanged( const YTableCell * cell )
     YUI_CHECK_PTR( clone );
 
     clone->updateCell( cell );
+    invalidatePreferredSize();
 }
 
 
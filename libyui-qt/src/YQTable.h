@@ -76,6 +76,9 @@ public:
      **/
     virtual void addItems( const YItemCollection & itemCollection );
 
+    // Don't hide the overload that takes ownership of the items
+    using YSelectionWidget::addItems;
+
     /**
      * Select or deselect an item.
      *
@@ -202,6 +205,17 @@ protected:
     void cloneChildItems( YTableItem          * parentItem,
                           YQTableListViewItem * parentItemClone );
 
+    /**
+     * Create Qt items only for the items that were inserted or changed by
+     * YSelectionWidget::addItems( YItemCollection && ) or replaceItems()
+     * and delete the ones of the removed items. The Qt items of all other
+     * items are kept.
+     *
+     * Reimplemented from YSelectionWidget.
+     **/
+    virtual bool supportsItemChanges() const { return true; }
+    virtual void itemsChanged( const YItemChangeList & changes );
+
     //
     // Data members
     //
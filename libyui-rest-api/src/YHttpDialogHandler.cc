@@ -14,26 +14,130 @@
   Floor, Boston, MA 02110-1301 USA
 */
 
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
 #include <yui/YDialog.h>
 #include <microhttpd.h>
 #include "YJsonSerializer.h"
+#include "YJsonStreamWriter.h"
 
 #include "YHttpDialogHandler.h"
 
+namespace
+{
+    // the dialog version as an HTTP entity tag
+    std::string version_etag(unsigned long version)
+    {
+        return "\"" + std::to_string(version) + "\"";
+    }
+
+    // does the If-None-Match header contain the entity tag?
+    bool etag_matches(const char *if_none_match, const std::string &etag)
+    {
+        if (!if_none_match)
+            return false;
+
+        std::vector<std::string> tags;
+        boost::split(tags, if_none_match, boost::is_any_of(","));
+
+        for (std::string &tag: tags)
+        {
+            boost::trim(tag);
+
+            // If-None-Match uses the weak comparison
+            if (boost::starts_with(tag, "W/"))
+                tag.erase(0, 2);
+
+            if (tag == "*" || tag == etag)
+                return true;
+        }
+
+        return false;
+    }
+}
 
 void YHttpDialogHandler::process_request(struct MHD_Connection* connection,
     const char* url, const char* method, const char* upload_data,
     size_t* upload_data_size, std::ostream& body, int& error_code,
     std::string& content_type, bool *redraw)
 {
-    if (auto dialog = YDialog::topmostDialog(false))  {
+    content_type = "application/json";
+
+    auto dialog = YDialog::topmostDialog(false);
+
+    if (!dialog) {
+        body << "{ \"error\" : \"No dialog is open\" }" << std::endl;
+        error_code = MHD_HTTP_NOT_FOUND;
+        return;
+    }
+
+    // the version changes with any change in the dialog, the clients can
+    // poll with If-None-Match or ask only for the changes with "since"
+    unsigned long version = dialog->modificationGeneration();
+    std::string etag = version_etag(version);
+    add_response_header(MHD_HTTP_HEADER_ETAG, etag);
+
+    if (etag_matches(MHD_lookup_connection_value(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_NONE_MATCH), etag)) {
+        error_code = MHD_HTTP_NOT_MODIFIED;
+        return;
+    }
+
+    const char* since = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "since");
+
+    if (!since) {
         YJsonSerializer::serialize(dialog, body);
         error_code = MHD_HTTP_OK;
+        return;
+    }
+
+    char *end;
+    errno = 0;
+    unsigned long since_version = strtoul(since, &end, 10);
+
+    if (*since == '\0' || *end != '\0' || errno) {
+        error_code = handle_error(body, std::string("Invalid 'since' version: ") + since, MHD_HTTP_BAD_REQUEST);
+        return;
+    }
+
+    YJsonStreamWriter writer(body);
+    writer.beginObject();
+
+    // the versions increase across all dialogs, an older version than the
+    // last structure change or a newer one cannot be compared widget by
+    // widget, send the whole dialog then
+    if (since_version < dialog->structureGeneration() || since_version > version) {
+        writer.key("dialog");
+        YJsonSerializer::serialize(dialog, writer);
+        writer.key("version");
+        writer.value(YJsonStreamWriter::number(version));
     }
     else {
-        body << "{ \"error\" : \"No dialog is open\" }" << std::endl;
-        error_code = MHD_HTTP_NOT_FOUND;
+        writer.key("version");
+        writer.value(YJsonStreamWriter::number(version));
+        writer.key("widgets");
+
+        std::vector<YWidget*> changed = dialog->changedWidgets(since_version);
+
+        if (changed.empty())
+            writer.value("[]");
+        else {
+            // non recursive dump
+            writer.beginArray();
+
+            for (YWidget *widget: changed) {
+                writer.element();
+                YJsonSerializer::serialize(widget, writer, false);
+            }
+
+            writer.endArray();
+        }
     }
 
-    content_type = "application/json";
+    writer.endObject();
+    error_code = MHD_HTTP_OK;
 }
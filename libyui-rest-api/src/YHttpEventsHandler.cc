@@ -0,0 +1,424 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <sstream>
+#include <vector>
+
+#include <microhttpd.h>
+
+#define YUILogComponent "rest-api"
+#include <yui/YUILog.h>
+
+#include <yui/YDialog.h>
+#include <yui/YEvent.h>
+#include <yui/YItem.h>
+
+#include "YJsonSerializer.h"
+#include "YJsonStreamWriter.h"
+
+#include "YHttpEventsHandler.h"
+
+// one connected client with its queue of not yet sent events
+struct YHttpEventsHandler::Client
+{
+    Client(YHttpEventsHandler *h, struct MHD_Connection *c)
+        : handler(h), connection(c), queued(0), offset(0), dropped(0),
+          suspended(false), closed(false)
+    {}
+
+    // append an event, drop the oldest ones when the limit is exceeded
+    void push(const std::string &frame)
+    {
+        frames.push_back(frame);
+        queued += frame.size();
+
+        // a partially sent event cannot be dropped, the newest one is kept
+        // even if it alone is bigger than the limit
+        size_t first = offset > 0 ? 1 : 0;
+
+        while (queued > YUI_EVENTS_BUFFER_LIMIT && frames.size() > first + 1)
+        {
+            queued -= frames[first].size();
+            frames.erase(frames.begin() + first);
+            ++dropped;
+        }
+
+        resume();
+    }
+
+    void resume()
+    {
+        if (suspended)
+        {
+            suspended = false;
+            MHD_resume_connection(connection);
+        }
+    }
+
+    YHttpEventsHandler *handler;
+    struct MHD_Connection *connection;
+    std::deque<std::string> frames;
+    // the size of all queued frames
+    size_t queued;
+    // the already sent part of the first frame
+    size_t offset;
+    // the number of dropped events not reported yet
+    unsigned long dropped;
+    bool suspended;
+    bool closed;
+};
+
+namespace
+{
+    // format an event for the text/event-stream, each line of the data
+    // needs the "data:" prefix
+    std::string event_frame(const std::string &event, const std::string &data)
+    {
+        std::string frame = "event: " + event + "\n";
+        size_t start = 0;
+
+        while (true)
+        {
+            size_t end = data.find('\n', start);
+            frame += "data: ";
+            frame.append(data, start, end == std::string::npos ? end : end - start);
+            frame += '\n';
+
+            if (end == std::string::npos)
+                break;
+
+            start = end + 1;
+        }
+
+        frame += '\n';
+        return frame;
+    }
+
+    // the dialog with its version, an empty object if there is no dialog
+    std::string dialog_data(YDialog *dialog)
+    {
+        if (!dialog || !dialog->isOpen())
+            return "{}";
+
+        std::ostringstream output;
+        YJsonStreamWriter writer(output);
+        writer.beginObject();
+        writer.key("dialog");
+        YJsonSerializer::serialize(dialog, writer);
+        writer.key("version");
+        writer.value(YJsonStreamWriter::number(dialog->modificationGeneration()));
+        writer.endObject();
+        return output.str();
+    }
+
+    // the widgets changed after 'since' (without children), the same
+    // structure as the "/dialog?since=" response
+    std::string widgets_data(YDialog *dialog, unsigned long since)
+    {
+        std::ostringstream output;
+        YJsonStreamWriter writer(output);
+        writer.beginObject();
+        writer.key("version");
+        writer.value(YJsonStreamWriter::number(dialog->modificationGeneration()));
+        writer.key("widgets");
+
+        std::vector<YWidget*> changed = dialog->changedWidgets(since);
+
+        if (changed.empty())
+            writer.value("[]");
+        else {
+            writer.beginArray();
+
+            for (YWidget *widget: changed) {
+                writer.element();
+                YJsonSerializer::serialize(widget, writer, false);
+            }
+
+            writer.endArray();
+        }
+
+        writer.endObject();
+        return output.str();
+    }
+
+    std::string event_data(YEvent *event)
+    {
+        std::ostringstream output;
+        YJsonStreamWriter writer(output);
+        writer.beginObject();
+
+        // the keys must be written sorted
+        if (event->eventType() == YEvent::MenuEvent) {
+            YMenuEvent *menu_event = static_cast<YMenuEvent *>(event);
+
+            if (!menu_event->id().empty()) {
+                writer.key("id");
+                writer.value(YJsonStreamWriter::quote(menu_event->id()));
+            }
+
+            if (menu_event->item()) {
+                writer.key("item");
+                writer.value(YJsonStreamWriter::quote(menu_event->item()->label()));
+            }
+        }
+        else if (event->eventType() == YEvent::SpecialKeyEvent) {
+            writer.key("id");
+            writer.value(YJsonStreamWriter::quote(static_cast<YSpecialKeyEvent *>(event)->id()));
+        }
+        else if (event->eventType() == YEvent::KeyEvent) {
+            YKeyEvent *key_event = static_cast<YKeyEvent *>(event);
+            writer.key("key");
+            writer.value(YJsonStreamWriter::quote(key_event->keySymbol()));
+        }
+
+        if (event->eventType() == YEvent::WidgetEvent) {
+            writer.key("reason");
+            writer.value(YJsonStreamWriter::quote(YEvent::toString(static_cast<YWidgetEvent *>(event)->reason())));
+        }
+
+        writer.key("type");
+        writer.value(YJsonStreamWriter::quote(YEvent::toString(event->eventType())));
+
+        YWidget *widget = event->widget();
+
+        if (event->eventType() == YEvent::KeyEvent)
+            widget = static_cast<YKeyEvent *>(event)->focusWidget();
+
+        if (widget) {
+            writer.key("widget");
+            YJsonSerializer::serialize(widget, writer, false);
+        }
+
+        writer.endObject();
+        return output.str();
+    }
+}
+
+YHttpEventsHandler::YHttpEventsHandler() : _version(0)
+{
+    YDialog::addListener(this);
+}
+
+YHttpEventsHandler::~YHttpEventsHandler()
+{
+    close();
+}
+
+MHD_RESULT YHttpEventsHandler::handle(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, bool *redraw)
+{
+    Client *client = new Client(this, connection);
+
+    struct MHD_Response *response = MHD_create_response_from_callback(MHD_SIZE_UNKNOWN,
+        4096, &read_events, client, &free_client);
+
+    if (!response) {
+        delete client;
+        // the default JSON error response
+        return YHttpHandler::handle(connection, url, method, upload_data, upload_data_size, redraw);
+    }
+
+    MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, "text/event-stream");
+    MHD_add_response_header(response, MHD_HTTP_HEADER_CACHE_CONTROL, "no-cache");
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // the other clients get the pending changes, the new one starts with
+        // the current dialog
+        flush_changes();
+
+        YDialog *dialog = YDialog::topmostDialog(false);
+        client->push(event_frame("dialog", dialog_data(dialog)));
+        _clients.push_back(client);
+
+        yuiMilestone() << "Starting an event stream, clients: " << _clients.size() << std::endl;
+    }
+
+    // not locked anymore: free_client() locks _mutex when MHD destroys
+    // the response
+    MHD_RESULT ret = MHD_queue_response(connection, MHD_HTTP_OK, response);
+
+    if (ret != MHD_YES) {
+        // no events for a stream which never starts, free_client() deletes
+        // the client when the response is destroyed below
+        std::lock_guard<std::mutex> lock(_mutex);
+        _clients.remove(client);
+    }
+
+    MHD_destroy_response(response);
+    return ret;
+}
+
+void YHttpEventsHandler::process_request(struct MHD_Connection* connection,
+    const char* url, const char* method, const char* upload_data,
+    size_t* upload_data_size, std::ostream& body, int& error_code,
+    std::string& content_type, bool *redraw)
+{
+    content_type = "application/json";
+    error_code = handle_error(body, "Cannot create the event stream", MHD_HTTP_INTERNAL_SERVER_ERROR);
+}
+
+void YHttpEventsHandler::update()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    flush_changes();
+}
+
+void YHttpEventsHandler::flush_changes()
+{
+    YDialog *dialog = YDialog::topmostDialog(false);
+
+    if (!dialog || !dialog->isOpen())
+        return;
+
+    unsigned long version = dialog->modificationGeneration();
+
+    if (version <= _version)
+        return;
+
+    if (!_clients.empty()) {
+        // the single widget changes are lost after a structure change
+        if (dialog->structureGeneration() > _version)
+            publish("dialog", dialog_data(dialog));
+        else
+            publish("widgets", widgets_data(dialog, _version));
+    }
+
+    _version = version;
+}
+
+void YHttpEventsHandler::close()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    YDialog::removeListener(this);
+
+    // the streams end when MHD reads them next time
+    for (Client *client: _clients) {
+        client->closed = true;
+        client->resume();
+    }
+}
+
+void YHttpEventsHandler::dialogOpened(YDialog *dialog)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_clients.empty())
+        publish("dialog-open", dialog_data(dialog));
+
+    _version = dialog->modificationGeneration();
+}
+
+void YHttpEventsHandler::dialogClosed(YDialog *dialog)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // the dialog is gone, send the one below it
+    YDialog *top = YDialog::topmostDialog(false);
+
+    if (!_clients.empty())
+        publish("dialog-close", dialog_data(top));
+
+    if (top)
+        _version = top->modificationGeneration();
+}
+
+void YHttpEventsHandler::waitingForEvent(YDialog *dialog)
+{
+    update();
+}
+
+void YHttpEventsHandler::eventReturned(YDialog *dialog, YEvent *event)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // keep the order, the changes happened before the event
+    flush_changes();
+
+    if (!_clients.empty())
+        publish("event", event_data(event));
+}
+
+void YHttpEventsHandler::publish(const std::string &event, const std::string &data)
+{
+    std::string frame = event_frame(event, data);
+
+    for (Client *client: _clients)
+        client->push(frame);
+}
+
+ssize_t YHttpEventsHandler::read_events(void *cls, uint64_t pos, char *buf, size_t max)
+{
+    Client *client = static_cast<Client *>(cls);
+    std::lock_guard<std::mutex> lock(client->handler->_mutex);
+
+    if (client->closed)
+        return MHD_CONTENT_READER_END_OF_STREAM;
+
+    // report the dropped events before the next complete event
+    if (client->dropped > 0 && client->offset == 0) {
+        std::string frame = event_frame("dropped",
+            "{\n  \"count\" : " + std::to_string(client->dropped) + "\n}");
+        client->frames.push_front(frame);
+        client->queued += frame.size();
+        client->dropped = 0;
+    }
+
+    if (client->frames.empty()) {
+        // wait until an event is pushed, MHD would call again immediately
+        client->suspended = true;
+        MHD_suspend_connection(client->connection);
+        return 0;
+    }
+
+    size_t written = 0;
+
+    while (written < max && !client->frames.empty()) {
+        const std::string &frame = client->frames.front();
+        size_t size = std::min(frame.size() - client->offset, max - written);
+        memcpy(buf + written, frame.data() + client->offset, size);
+        written += size;
+        client->offset += size;
+
+        if (client->offset == frame.size()) {
+            client->queued -= frame.size();
+            client->frames.pop_front();
+            client->offset = 0;
+        }
+    }
+
+    return written;
+}
+
+void YHttpEventsHandler::free_client(void *cls)
+{
+    Client *client = static_cast<Client *>(cls);
+    YHttpEventsHandler *handler = client->handler;
+
+    {
+        std::lock_guard<std::mutex> lock(handler->_mutex);
+        handler->_clients.remove(client);
+        yuiMilestone() << "Event stream finished, clients: " << handler->_clients.size() << std::endl;
+    }
+
+    delete client;
+}
@@ -0,0 +1,94 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YHttpEventsHandler_h
+#define YHttpEventsHandler_h
+
+#include <list>
+#include <mutex>
+#include <string>
+
+#include <yui/YDialogListener.h>
+
+#include "YHttpHandler.h"
+
+// the maximum size of the not yet sent events of a client in bytes,
+// the oldest events are dropped when a client does not read fast enough
+#define YUI_EVENTS_BUFFER_LIMIT (1024 * 1024)
+
+/**
+ * Server-sent events (text/event-stream) with the changes of the UI.
+ *
+ * Each client gets a long-lived response which is fed from the
+ * YDialogListener notifications. The connection is suspended while there is
+ * nothing to send and resumed when an event is queued, so an idle stream
+ * does not cost anything in the UI main loop.
+ */
+class YHttpEventsHandler : public YHttpHandler, public YDialogListener
+{
+
+public:
+
+    YHttpEventsHandler();
+    virtual ~YHttpEventsHandler();
+
+    virtual MHD_RESULT handle(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, bool *redraw = nullptr);
+
+    // send the changes of the topmost dialog which have not been sent yet
+    void update();
+
+    // finish all streams and stop listening, used when the server is stopped
+    void close();
+
+    // YDialogListener notifications
+    virtual void dialogOpened(YDialog *dialog);
+    virtual void dialogClosed(YDialog *dialog);
+    virtual void waitingForEvent(YDialog *dialog);
+    virtual void eventReturned(YDialog *dialog, YEvent *event);
+
+protected:
+
+    // only used when the stream cannot be created
+    virtual void process_request(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, std::ostream& body, int& error_code,
+        std::string& content_type, bool *redraw);
+
+private:
+
+    struct Client;
+
+    // update() without locking, the caller must hold _mutex
+    void flush_changes();
+
+    // queue an event for all clients, 'data' is a JSON text,
+    // the caller must hold _mutex
+    void publish(const std::string &event, const std::string &data);
+
+    // MHD callbacks of the stream responses
+    static ssize_t read_events(void *cls, uint64_t pos, char *buf, size_t max);
+    static void free_client(void *cls);
+
+    std::list<Client *> _clients;
+    // protects the client queues, the UI might run in another thread
+    std::mutex _mutex;
+    // the last dialog version sent to the clients
+    unsigned long _version;
+};
+
+#endif // YHttpEventsHandler_h
@@ -14,9 +14,13 @@
   Floor, Boston, MA 02110-1301 USA
 */
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <json/json.h>
 #include <microhttpd.h>
-#include <sstream>
+#include <ostream>
+#include <streambuf>
 
 #define YUILogComponent "rest-api"
 #include <yui/YUILog.h>
@@ -25,25 +29,103 @@
 #include "YHttpHandler.h"
 
 
+namespace
+{
+    // a stream buffer in a malloc()ed memory block, MHD takes the block
+    // with MHD_RESPMEM_MUST_FREE so the body does not need to be copied
+    class ResponseBuffer : public std::streambuf
+    {
+
+    public:
+
+        ResponseBuffer() : _data(nullptr), _capacity(0) {}
+        ~ResponseBuffer() { free(_data); }
+
+        size_t size() const { return pptr() - pbase(); }
+
+        // pass the ownership of the data to the caller, it must be free()d
+        char *release()
+        {
+            char *ret = _data;
+            _data = nullptr;
+            _capacity = 0;
+            setp(nullptr, nullptr);
+            return ret;
+        }
+
+    protected:
+
+        virtual int_type overflow(int_type ch)
+        {
+            if (traits_type::eq_int_type(ch, traits_type::eof()))
+                return traits_type::not_eof(ch);
+
+            if (!grow(1))
+                return traits_type::eof();
+
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+            return ch;
+        }
+
+        virtual std::streamsize xsputn(const char *str, std::streamsize count)
+        {
+            if (epptr() - pptr() < count && !grow(count))
+                return 0;
+
+            memcpy(pptr(), str, count);
+            pbump(count);
+            return count;
+        }
+
+    private:
+
+        bool grow(size_t needed)
+        {
+            size_t used = size();
+            size_t capacity = std::max({ _capacity * 2, used + needed, (size_t) 4096 });
+            char *data = static_cast<char *>(realloc(_data, capacity));
+
+            if (!data)
+                return false;
+
+            _data = data;
+            _capacity = capacity;
+            setp(_data, _data + _capacity);
+            pbump(used);
+            return true;
+        }
+
+        char *_data;
+        size_t _capacity;
+    };
+}
+
 MHD_RESULT YHttpHandler::handle(struct MHD_Connection* connection,
         const char* url, const char* method, const char* upload_data,
         size_t* upload_data_size, bool *redraw)
 {
-    std::ostringstream body_s;
+    ResponseBuffer body_buf;
+    std::ostream body_s(&body_buf);
     std::string content_type;
     int error_code;
 
+    _response_headers.clear();
+
     process_request(connection, url, method, upload_data, upload_data_size,
       body_s, error_code, content_type, redraw);
 
-    std::string body_str = body_s.str();
-    struct MHD_Response *response = MHD_create_response_from_buffer (body_str.length(),
-		      (void *) body_str.c_str(), MHD_RESPMEM_MUST_COPY);
+    size_t body_size = body_buf.size();
+    struct MHD_Response *response = MHD_create_response_from_buffer (body_size,
+		      body_buf.release(), MHD_RESPMEM_MUST_FREE);
 
     if (!content_type.empty())
         MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, content_type.c_str());
 
-    yuiMilestone() << "Sending response: code: " << error_code << ", body size: " << body_str.length()
+    for (const auto &header: _response_headers)
+        MHD_add_response_header(response, header.first.c_str(), header.second.c_str());
+
+    yuiMilestone() << "Sending response: code: " << error_code << ", body size: " << body_size
       << ", content type: " << content_type << std::endl;
 
     MHD_RESULT ret = MHD_queue_response(connection, error_code, response);
@@ -58,3 +140,8 @@ int YHttpHandler::handle_error(std::ostream& body, std::string error, int error_
     YJsonSerializer::save(response, body);
     return error_code;
 }
+
+void YHttpHandler::add_response_header(const std::string &name, const std::string &value)
+{
+    _response_headers.emplace_back(name, value);
+}
@@ -33,6 +33,8 @@
 
 #include <string>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 struct MHD_Connection;
 
@@ -57,6 +59,13 @@ protected:
         std::string& content_type, bool *redraw) = 0;
 
     int handle_error(std::ostream& body, std::string error, int error_code);
+
+    // add a header to the response of the current request
+    void add_response_header(const std::string &name, const std::string &value);
+
+private:
+
+    std::vector<std::pair<std::string, std::string>> _response_headers;
 };
 
 #endif // YHttpHandler_h
@@ -33,6 +33,7 @@
 
 #include "YHttpAppHandler.h"
 #include "YHttpDialogHandler.h"
+#include "YHttpEventsHandler.h"
 #include "YHttpRootHandler.h"
 #include "YHttpVersionHandler.h"
 #include "YHttpWidgetsActionHandler.h"
@@ -45,6 +46,13 @@
 YHttpServer * YHttpServer::_yserver = 0;
 YHttpWidgetsActionHandler * YHttpServer::_widget_action_handler = 0;
 
+// the event stream suspends idle connections, the flag was renamed in 0.9.59
+#if MHD_VERSION >= 0x00095900
+#define YUI_MHD_SUSPEND_RESUME MHD_ALLOW_SUSPEND_RESUME
+#else
+#define YUI_MHD_SUSPEND_RESUME MHD_USE_SUSPEND_RESUME
+#endif
+
 const char *auth_error_body = "{ \"error\" : \"Authentication error, wrong user name or password\" }\n";
 
 int YHttpServer::port_num()
@@ -94,7 +102,7 @@ struct in6_addr listen_address_v6(bool remote)
 }
 
 YHttpServer::YHttpServer(YHttpWidgetsActionHandler * widgets_action_handler)
-    : server_v4(nullptr), server_v6(nullptr), redraw(false)
+    : server_v4(nullptr), server_v6(nullptr), redraw(false), events_handler(nullptr)
 {
     _yserver = this;
     _widget_action_handler = widgets_action_handler;
@@ -124,6 +132,9 @@ YHttpServer::~YHttpServer()
 {
     yuiMilestone() << "Finishing the REST API HTTP server..." << std::endl;
 
+    if (events_handler)
+        events_handler->close();
+
     if (server_v4) {
         yuiMilestone() << "Stopping IPv4 HTTP server" << std::endl;
         MHD_stop_daemon(server_v4);
@@ -214,18 +225,31 @@ requestHandler(void *srv,
           const char *version,
           const char *upload_data, size_t *upload_data_size, void **ptr)
 {
-    // remember the callback status
-    static int aptr;
+    // the uploaded request body, collected from all calls
+    std::string *upload = static_cast<std::string *>(*ptr);
 
-    if (&aptr != *ptr)
+    if (!upload)
     {
         // do not respond on first call, it's used for the initial check to close invalid requests early
-        *ptr = &aptr;
+        *ptr = new std::string();
         // continue processing the request
         return MHD_YES;
     }
-    // reset
-    *ptr = NULL;
+
+    if (*upload_data_size != 0)
+    {
+        // a bigger upload is not a valid request, close the connection
+        if (upload->size() + *upload_data_size > YUI_MAX_UPLOAD_SIZE)
+        {
+            yuiError() << "Request body too big, closing the connection" << std::endl;
+            return MHD_NO;
+        }
+
+        upload->append(upload_data, *upload_data_size);
+        *upload_data_size = 0;
+        // wait for the rest of the body
+        return MHD_YES;
+    }
 
     YHttpServer *server = (YHttpServer *)srv;
 
@@ -238,7 +262,16 @@ requestHandler(void *srv,
         return MHD_queue_basic_auth_fail_response(connection, "libyui realm", response);
     }
 
-    return server->handle(connection, url, method, upload_data, upload_data_size);
+    size_t upload_size = upload->size();
+    return server->handle(connection, url, method, upload->data(), &upload_size);
+}
+
+// callback called when a request is finished, release the uploaded body
+static void requestCompleted(void *srv, struct MHD_Connection *connection,
+    void **ptr, enum MHD_RequestTerminationCode toe)
+{
+    delete static_cast<std::string *>(*ptr);
+    *ptr = NULL;
 }
 
 // callback called when a new client connects to the HTTP server,
@@ -270,7 +303,10 @@ void YHttpServer::start()
     mount("/dialog", "GET", new YHttpDialogHandler());
     mount("/widgets", "GET", new YHttpWidgetsHandler());
     mount("/widgets", "POST", get_widget_action_handler());
+    mount("/widgets/batch", "POST", get_widget_action_handler());
     mount("/application", "GET", new YHttpAppHandler());
+    events_handler = new YHttpEventsHandler();
+    mount("/events", "GET", events_handler);
     mount("/version", "GET", new YHttpVersionHandler(), false);
 
     bool remote = remote_access();
@@ -282,7 +318,9 @@ void YHttpServer::start()
     server_socket.sin_addr.s_addr = listen_address_v4(remote);
     server_v4 = MHD_start_daemon (
                         // enable debugging output (on STDERR)
-                        MHD_USE_DEBUG,
+                        MHD_USE_DEBUG |
+                        // allow waiting for events in the event stream
+                        YUI_MHD_SUSPEND_RESUME,
                         // the port number to use
                         port_num(),
                         // handler for new connections
@@ -291,6 +329,8 @@ void YHttpServer::start()
                         &requestHandler, this,
                         // allow or forbid reusing the socket for multiple processes
                         MHD_OPTION_LISTENING_ADDRESS_REUSE, port_reuse(),
+                        // release the uploaded request bodies
+                        MHD_OPTION_NOTIFY_COMPLETED, &requestCompleted, this,
                         // set the port and interface to listen to
                         MHD_OPTION_SOCK_ADDR, &server_socket,
                         // finish the argument list
@@ -305,7 +345,9 @@ void YHttpServer::start()
                         // enable debugging output (on STDERR)
                         MHD_USE_DEBUG |
                         // use IPv6
-                        MHD_USE_IPv6,
+                        MHD_USE_IPv6 |
+                        // allow waiting for events in the event stream
+                        YUI_MHD_SUSPEND_RESUME,
                         // the port number to use
                         port_num(),
                         // handler for new connections
@@ -315,6 +357,8 @@ void YHttpServer::start()
                         // disable reusing the socket for multiple processes,
                         // for security reasons allow only one process to use this port
                         MHD_OPTION_LISTENING_ADDRESS_REUSE, port_reuse(),
+                        // release the uploaded request bodies
+                        MHD_OPTION_NOTIFY_COMPLETED, &requestCompleted, this,
                         // set the port and interface to listen to
                         MHD_OPTION_SOCK_ADDR, &server_socket_v6,
                         // finish the argument list
@@ -344,6 +388,11 @@ bool YHttpServer::process_data()
     yuiMilestone() << "Processing HTTP server data..." << std::endl;
     if (server_v4) MHD_run(server_v4);
     if (server_v6) MHD_run(server_v6);
+
+    // push the changes done by the requests to the event streams,
+    // the resumed connections wake up the main loop again
+    if (events_handler) events_handler->update();
+
     return redraw;
 }
 
@@ -23,6 +23,7 @@
 #include "YHttpMount.h"
 #include "YHttpHandler.h"
 #include "YHttpServerSockets.h"
+#include "YHttpEventsHandler.h"
 #include "YHttpWidgetsActionHandler.h"
 
 // environment variables
@@ -34,6 +35,9 @@
 
 #define YUI_API_VERSION     "v1"
 
+// the maximum size of a request body (e.g. a batch of actions)
+#define YUI_MAX_UPLOAD_SIZE (1024 * 1024)
+
 struct MHD_Daemon;
 
 class YHttpServer
@@ -98,6 +102,7 @@ private:
     struct MHD_Daemon *server_v4, *server_v6;
     std::vector<YHttpMount> _mounts;
     bool redraw;
+    YHttpEventsHandler *events_handler;
     static YHttpServer * _yserver;
     static YHttpWidgetsActionHandler * _widget_action_handler;
     // HTTP Basic Auth credentials
@@ -15,11 +15,14 @@
 */
 
 #include <codecvt>
+#include <memory>
 #include <vector>
 #include <sstream>
 #include <cstdlib>
 #include <string>
 
+#include <json/json.h>
+
 #define YUILogComponent "rest-api"
 #include <yui/YUILog.h>
 
@@ -38,71 +41,203 @@
 #include <yui/YTreeItem.h>
 #include <yui/YWidgetID.h>
 
+#include "YJsonSerializer.h"
 #include "YHttpWidgetsActionHandler.h"
 
 
+namespace
+{
+    // collect the query parameters of the request
+    MHD_RESULT add_param(void *cls, enum MHD_ValueKind kind, const char *key, const char *value)
+    {
+        YHttpWidgetsActionHandler::ActionParams *params = static_cast<YHttpWidgetsActionHandler::ActionParams *>(cls);
+        (*params)[key] = value ? value : "";
+        return MHD_YES;
+    }
+
+    // the text of the "error" in an error response body
+    std::string error_message(const std::string &body)
+    {
+        Json::Value json;
+        std::string errors;
+        Json::CharReaderBuilder builder;
+        std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+
+        if (reader->parse(body.data(), body.data() + body.size(), &json, &errors)
+            && json.isObject() && json["error"].isString())
+            return json["error"].asString();
+
+        return body;
+    }
+}
+
 void YHttpWidgetsActionHandler::process_request(struct MHD_Connection* connection,
     const char* url, const char* method, const char* upload_data,
     size_t* upload_data_size, std::ostream& body, int& error_code,
     std::string& content_type, bool *redraw)
 {
     content_type = "application/json";
-    
-    if ( YDialog::topmostDialog(false) )
+
+    if ( !YDialog::topmostDialog(false) )
     {
-        WidgetArray widgets;
+        body << "{ \"error\" : \"No dialog is open\" }" << std::endl;
+        error_code = MHD_HTTP_NOT_FOUND;
+        return;
+    }
+
+    // at least one action succeeded
+    bool changed;
 
-        const char* label = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "label");
-        const char* id = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "id");
-        const char* type = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "type");
-        const char* debug_label = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "debug_label");
+    if ( boost::ends_with( url, "/batch" ) )
+    {
+        error_code = process_batch( upload_data, *upload_data_size, body, changed );
+    }
+    else
+    {
+        ActionParams params;
+        MHD_get_connection_values( connection, MHD_GET_ARGUMENT_KIND, &add_param, &params );
+        error_code = act( params, body );
+        changed = error_code == MHD_HTTP_OK;
+    }
 
-        if ( label || id || type || debug_label)
+    // one update and redraw for all actions
+    if ( changed )
+    {
+        // the actions might have changed the values of other widgets
+        // as well (e.g. radio buttons), bump the dialog version for them
+        if ( YDialog *dialog = YDialog::topmostDialog(false) )
+            dialog->detectInputChanges();
+
+        // the action possibly changed something in the UI, signalize redraw needed
+        if ( redraw )
+            *redraw = true;
+    }
+}
+
+int YHttpWidgetsActionHandler::act( const ActionParams &params, std::ostream& body )
+{
+    WidgetArray widgets;
+
+    const char* label = param( params, "label" );
+    const char* id = param( params, "id" );
+    const char* type = param( params, "type" );
+    const char* debug_label = param( params, "debug_label" );
+
+    if ( label || id || type || debug_label)
+    {
+        widgets = YWidgetFinder::find(label, id, type, debug_label);
+    }
+    else
+    {
+        body << "{ \"error\" : \"No search criteria provided\" }" << std::endl;
+        return MHD_HTTP_NOT_FOUND;
+    }
+
+    if ( widgets.empty() )
+    {
+        body << "{ \"error\" : \"Widget not found\" }" << std::endl;
+        return MHD_HTTP_NOT_FOUND;
+    }
+
+    const char* action = param( params, "action" );
+
+    if ( !action )
+    {
+        body << "{ \"error\" : \"Missing action parameter\" }" << std::endl;
+        return MHD_HTTP_NOT_FOUND;
+    }
+
+    if( widgets.size() != 1 )
+    {
+        body << "{ \"error\" : \"Multiple widgets found to act on, try using multicriteria search (label+id+type)\" }" << std::endl;
+        return MHD_HTTP_NOT_FOUND;
+    }
+
+    int ret = do_action(widgets[0], action, params, body);
+
+    if ( ret == MHD_HTTP_OK )
+        widgets[0]->markChanged();
+
+    return ret;
+}
+
+int YHttpWidgetsActionHandler::process_batch( const char* upload_data, size_t upload_data_size, std::ostream& body, bool &changed )
+{
+    changed = false;
+
+    Json::Value operations;
+    std::string errors;
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+
+    if ( !upload_data
+         || !reader->parse(upload_data, upload_data + upload_data_size, &operations, &errors)
+         || !operations.isArray() )
+    {
+        std::string error ( "Expected a JSON array of actions" );
+        if ( !errors.empty() )
+            error.append( ": " ).append( errors );
+        return handle_error( body, error, MHD_HTTP_BAD_REQUEST );
+    }
+
+    Json::Value results(Json::arrayValue);
+    int ret = MHD_HTTP_OK;
+
+    for ( const Json::Value &operation: operations )
+    {
+        Json::Value result;
+        std::ostringstream action_body;
+        int code;
+
+        if ( operation.isObject() )
         {
-            widgets = YWidgetFinder::find(label, id, type, debug_label);
+            ActionParams params;
+
+            for ( const std::string &name: operation.getMemberNames() )
+            {
+                const Json::Value &value = operation[name];
+
+                // accept numbers and booleans as well, e.g. "row": 2
+                if ( value.isConvertibleTo( Json::stringValue ) && !value.isNull() )
+                    params[name] = value.asString();
+            }
+
+            code = act( params, action_body );
         }
         else
         {
-            body << "{ \"error\" : \"No search criteria provided\" }" << std::endl;
-            error_code = MHD_HTTP_NOT_FOUND;
-            return;
+            code = handle_error( action_body, "An action must be a JSON object", MHD_HTTP_BAD_REQUEST );
         }
 
-        if ( widgets.empty() )
-        {
-            body << "{ \"error\" : \"Widget not found\" }" << std::endl;
-            error_code = MHD_HTTP_NOT_FOUND;
-            return;
-        }
+        result["status"] = code;
 
-        if ( const char* action = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "action") )
-        {
-            if( widgets.size() != 1 )
-            {
-                body << "{ \"error\" : \"Multiple widgets found to act on, try using multicriteria search (label+id+type)\" }" << std::endl;
-                error_code = MHD_HTTP_NOT_FOUND;
-                return;
-            }
+        if ( code != MHD_HTTP_OK )
+            result["error"] = error_message( action_body.str() );
 
-            error_code = do_action(widgets[0], action, connection, body);
+        results.append( result );
 
-            // the action possibly changed something in the UI, signalize redraw needed
-            if ( redraw && error_code == MHD_HTTP_OK )
-                *redraw = true;
-        }
-        else
+        // the following actions might depend on this one,
+        // the status of the failed action is the status of the batch
+        if ( code != MHD_HTTP_OK )
         {
-            body << "{ \"error\" : \"Missing action parameter\" }" << std::endl;
-            error_code = MHD_HTTP_NOT_FOUND;
+            ret = code;
+            break;
         }
+
+        changed = true;
     }
-    else {
-        body << "{ \"error\" : \"No dialog is open\" }" << std::endl;
-        error_code = MHD_HTTP_NOT_FOUND;
-    }
+
+    YJsonSerializer::save( results, body );
+    return ret;
+}
+
+const char* YHttpWidgetsActionHandler::param( const ActionParams &params, const char* name )
+{
+    auto it = params.find( name );
+    return it == params.end() ? nullptr : it->second.c_str();
 }
 
-int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &action, struct MHD_Connection *connection, std::ostream& body)
+int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &action, const ActionParams &params, std::ostream& body)
 {
 
     // TODO improve this, maybe use better names for the actions...
@@ -150,7 +285,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else
         {
             std::string value;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+            if ( const char* val = param( params, "value" ) )
                 value = val;
 
             if( YItemSelector* selector = dynamic_cast<YItemSelector*>(widget) )
@@ -196,7 +331,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else
         {
             std::string value;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+            if ( const char* val = param( params, "value" ) )
                 value = val;
 
             if( YItemSelector* selector = dynamic_cast<YItemSelector*>(widget) )
@@ -244,7 +379,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else
         {
             std::string value;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+            if ( const char* val = param( params, "value" ) )
                 value = val;
 
             if( YItemSelector* selector = dynamic_cast<YItemSelector*>(widget) )
@@ -270,7 +405,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
     else if ( action == "enter_text" )
     {
         std::string value;
-        if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+        if ( const char* val = param( params, "value" ) )
             value = val;
 
         if ( dynamic_cast<YInputField*>(widget) )
@@ -340,7 +475,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
     else if ( action == "select" )
     {
         std::string value;
-        if (const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value"))
+        if (const char* val = param( params, "value" ))
             value = val;
         if ( dynamic_cast<YComboBox*>(widget) )
         {
@@ -363,11 +498,11 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else if( auto tbl = dynamic_cast<YTable*>(widget) )
         {
             int row_id = -1;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "row") )
+            if ( const char* val = param( params, "row" ) )
                 row_id = atoi(val);
 
             int column_id = 0;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "column") )
+            if ( const char* val = param( params, "column" ) )
                 column_id = atoi(val);
 
             return action_handler<YTable>( widget, body, get_table_handler()->get_handler( tbl, value, column_id, row_id) );
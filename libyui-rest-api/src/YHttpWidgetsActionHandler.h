@@ -19,6 +19,7 @@
 
 #include <iostream>
 #include <functional>
+#include <map>
 #include <microhttpd.h>
 #include <sstream>
 #include <boost/algorithm/string.hpp>
@@ -60,6 +61,9 @@ class YHttpWidgetsActionHandler : public YHttpHandler
 
 public:
 
+    // the parameters of an action: the widget filters, "action", "value"...
+    typedef std::map<std::string, std::string> ActionParams;
+
     YHttpWidgetsActionHandler() {};
     virtual ~YHttpWidgetsActionHandler() {};
 
@@ -70,7 +74,16 @@ protected:
         size_t* upload_data_size, std::ostream& body, int& error_code,
         std::string& content_type, bool *redraw);
 
-    int do_action( YWidget *widget, const std::string &action, struct MHD_Connection *connection, std::ostream& body );
+    // find the widget and do the action, returns the HTTP status code
+    int act( const ActionParams &params, std::ostream& body );
+
+    // do a JSON array of actions in order, stop at the first failure
+    int process_batch( const char* upload_data, size_t upload_data_size, std::ostream& body, bool &changed );
+
+    int do_action( YWidget *widget, const std::string &action, const ActionParams &params, std::ostream& body );
+
+    // the value of the parameter, nullptr if it is missing
+    static const char* param( const ActionParams &params, const char* name );
 
     /**
      * Define widgets handlers to override in case need to implement
@@ -14,6 +14,10 @@
   Floor, Boston, MA 02110-1301 USA
 */
 
+#include <algorithm>
+#include <functional>
+#include <map>
+
 #include <json/json.h>
 
 #include <yui/YBarGraph.h>
@@ -42,34 +46,138 @@
 #include <yui/YWizard.h>
 
 #include "YJsonSerializer.h"
+#include "YJsonStreamWriter.h"
+
+// The widgets are written directly into the output stream, no Json::Value
+// tree is built for them. The output is the same as saving the equivalent
+// Json::Value with save(): the object members are sorted by the key and
+// an empty array is written as "null" (an empty Json::Value).
+
+namespace
+{
+    typedef std::function<void(YJsonStreamWriter &)> ValueWriter;
+
+    std::string json_str(const std::string &str) { return YJsonStreamWriter::quote(str); }
+    std::string json_bool(bool b) { return YJsonStreamWriter::boolean(b); }
+    std::string json_int(long long n) { return YJsonStreamWriter::number(n); }
+
+    const std::string json_null("null");
 
-static void serialize_widget_properties(YWidget *widget, Json::Value &json);
-static void serialize_widget_data(YWidget *widget, Json::Value &json);
-static void serialize_widget_specific_data(YWidget *widget, Json::Value &json);
+    // the members of a JSON object, sorted by the key like in a Json::Value,
+    // setting a key again replaces the previous value
+    class Members
+    {
+
+    public:
 
-Json::Value serialize_rec(YWidget *w, bool recursive = true) {
-    Json::Value ret;
+        // set a scalar value (a JSON text)
+        void set(const std::string &key, const std::string &json)
+        {
+            Member &member = _members[key];
+            member.json = json;
+            member.writer = nullptr;
+        }
+
+        // set a value which is written later by the callback
+        void set(const std::string &key, const ValueWriter &writer)
+        {
+            Member &member = _members[key];
+            member.json.clear();
+            member.writer = writer;
+        }
+
+        void write(YJsonStreamWriter &writer) const
+        {
+            if (_members.empty())
+            {
+                writer.value(json_null);
+                return;
+            }
+
+            writer.beginObject();
+
+            for (const auto &member: _members)
+            {
+                writer.key(member.first);
+
+                if (member.second.writer)
+                    member.second.writer(writer);
+                else
+                    writer.value(member.second.json);
+            }
+
+            writer.endObject();
+        }
+
+    private:
+
+        struct Member
+        {
+            std::string json;
+            ValueWriter writer;
+        };
+
+        std::map<std::string, Member> _members;
+    };
+
+    // write an array of scalar values (JSON texts)
+    void write_array(YJsonStreamWriter &writer, const std::vector<std::string> &values)
+    {
+        if (values.empty())
+        {
+            writer.value(json_null);
+            return;
+        }
+
+        writer.beginArray();
+
+        for (const std::string &value: values)
+        {
+            writer.element();
+            writer.value(value);
+        }
+
+        writer.endArray();
+    }
+}
+
+static void serialize_widget_properties(YWidget *widget, Members &json);
+static void serialize_widget_data(YWidget *widget, Members &json);
+static void serialize_widget_specific_data(YWidget *widget, Members &json);
+
+static void serialize_rec(YWidget *w, YJsonStreamWriter &writer, bool recursive = true) {
+    Members ret;
 
     serialize_widget_properties(w, ret);
     serialize_widget_data(w, ret);
     serialize_widget_specific_data(w, ret);
 
     if (recursive && w->hasChildren()) {
-        Json::Value widgets;
-
-        for ( YWidgetListConstIterator it = w->childrenBegin(); it != w->childrenEnd(); ++it )
+        // the children are written when the "widgets" key is reached
+        ret.set("widgets", [w](YJsonStreamWriter &writer)
         {
-            if (*it)
+            if (std::none_of(w->childrenBegin(), w->childrenEnd(), [](YWidget *child) { return child; }))
             {
-                Json::Value widget = serialize_rec(*it);
-                widgets.append(widget);
+                writer.value(json_null);
+                return;
             }
-        }
 
-        ret["widgets"] = widgets;
+            writer.beginArray();
+
+            for ( YWidgetListConstIterator it = w->childrenBegin(); it != w->childrenEnd(); ++it )
+            {
+                if (*it)
+                {
+                    writer.element();
+                    serialize_rec(*it, writer);
+                }
+            }
+
+            writer.endArray();
+        });
     }
 
-    return ret;
+    ret.write(writer);
 }
 
 void YJsonSerializer::save(const Json::Value &json, std::ostream &output)
@@ -84,110 +192,151 @@ void YJsonSerializer::save(const Json::Value &json, std::ostream &output)
 
 void YJsonSerializer::serialize(YWidget *w, std::ostream &output, bool recursive) {
     if (!w) return;
-    Json::Value json = serialize_rec(w, recursive);
-    save(json, output);
+    YJsonStreamWriter writer(output);
+    serialize_rec(w, writer, recursive);
+}
+
+void YJsonSerializer::serialize(YWidget *w, YJsonStreamWriter &writer, bool recursive) {
+    serialize_rec(w, writer, recursive);
 }
 
 void YJsonSerializer::serialize(const std::vector<YWidget*> &widgets, std::ostream &output, bool recursive) {
-    Json::Value array;
+    YJsonStreamWriter writer(output);
+
+    if (widgets.empty())
+    {
+        writer.value(json_null);
+        return;
+    }
+
+    writer.beginArray();
 
     for(YWidget *widget: widgets)
     {
-        Json::Value json = serialize_rec(widget, recursive);
-        array.append(json);
+        writer.element();
+        serialize_rec(widget, writer, recursive);
     }
 
-    save(array, output);
+    writer.endArray();
 }
 
 namespace {
-    void add_opt_string_property(YWidget *w, const std::string &name, Json::Value &json, const std::string &key)
+    void add_opt_string_property(YWidget *w, const YPropertySet &propSet, YPropertyId id, Members &json, const std::string &key)
     {
+        if (!propSet.contains(id))
+            return;
+
         // only when not empty
-        if (w->propertySet().contains(name) && !w->getProperty(name).stringVal().empty())
-            json[key] = w->getProperty(name).stringVal();
+        std::string value = w->getProperty(id).stringVal();
+        if (!value.empty())
+            json.set(key, json_str(value));
     }
 }
 
-void serialize_widget_properties(YWidget *widget, Json::Value &json) {
-    auto propSet = widget->propertySet();
+void serialize_widget_properties(YWidget *widget, Members &json) {
+    const YPropertySet &propSet = widget->propertySet();
 
-    if (propSet.contains("WidgetClass"))
-        json["class"] = widget->getProperty("WidgetClass").stringVal();
+    if (propSet.contains(YUIPropertyId_WidgetClass))
+        json.set("class", json_str(widget->getProperty(YUIPropertyId_WidgetClass).stringVal()));
 
     if (widget->hasId())
-        json["id"] = widget->id()->toString();
+        json.set("id", json_str(widget->id()->toString()));
 
-    if (propSet.contains("Label"))
-        json["label"] = widget->getProperty("Label").stringVal();
+    if (propSet.contains(YUIPropertyId_Label))
+        json.set("label", json_str(widget->getProperty(YUIPropertyId_Label).stringVal()));
 
     // only when false
-    if (propSet.contains("Enabled") && !widget->getProperty("Enabled").boolVal())
-        json["enabled"] = widget->getProperty("Enabled").boolVal();
+    if (propSet.contains(YUIPropertyId_Enabled) && !widget->getProperty(YUIPropertyId_Enabled).boolVal())
+        json.set("enabled", json_bool(false));
 
     // only when true
-    if (propSet.contains("Notify") && widget->getProperty("Notify").boolVal())
-        json["notify"] = widget->getProperty("Notify").boolVal();
+    if (propSet.contains(YUIPropertyId_Notify) && widget->getProperty(YUIPropertyId_Notify).boolVal())
+        json.set("notify", json_bool(true));
 
-    add_opt_string_property(widget, "DebugLabel", json, "debug_label");
-    add_opt_string_property(widget, "Text", json, "text");
-    add_opt_string_property(widget, "ValidChars", json, "valid_chars");
-    add_opt_string_property(widget, "IconPath", json, "icon_path");
-    add_opt_string_property(widget, "HelpText", json, "help_text");
+    add_opt_string_property(widget, propSet, YUIPropertyId_DebugLabel, json, "debug_label");
+    add_opt_string_property(widget, propSet, YUIPropertyId_Text, json, "text");
+    add_opt_string_property(widget, propSet, YUIPropertyId_ValidChars, json, "valid_chars");
+    add_opt_string_property(widget, propSet, YUIPropertyId_IconPath, json, "icon_path");
+    add_opt_string_property(widget, propSet, YUIPropertyId_HelpText, json, "help_text");
 
     // only when set
-    if (propSet.contains("InputMaxLength") && widget->getProperty("InputMaxLength").integerVal() >= 0)
-        json["input_max_length"] = (Json::Value::Int64)widget->getProperty("InputMaxLength").integerVal();
-
+    if (propSet.contains(YUIPropertyId_InputMaxLength))
+    {
+        YInteger max_length = widget->getProperty(YUIPropertyId_InputMaxLength).integerVal();
+        if (max_length >= 0)
+            json.set("input_max_length", json_int(max_length));
+    }
 }
 
-void serialize_widget_data(YWidget *widget, Json::Value &json) {
+void serialize_widget_data(YWidget *widget, Members &json) {
     // generic data
     if (!widget->isEnabled())
-        json["enabled"] = widget->isEnabled();
+        json.set("enabled", json_bool(false));
 
     if (widget->notify())
-        json["notify"] = widget->notify();
+        json.set("notify", json_bool(true));
 
     if (widget->hasFunctionKey())
-        json["fkey"] = widget->functionKey();
+        json.set("fkey", json_int(widget->functionKey()));
 
     if (widget->stretchable(YD_HORIZ))
-        json["hstretch"] = widget->stretchable(YD_HORIZ);
+        json.set("hstretch", json_bool(true));
 
     if (widget->stretchable(YD_VERT))
-        json["vstretch"] = widget->stretchable(YD_VERT);
+        json.set("vstretch", json_bool(true));
 
     if (widget->hasWeight(YD_HORIZ))
-        json["hweight"] = widget->weight(YD_HORIZ);
+        json.set("hweight", json_int(widget->weight(YD_HORIZ)));
 
     if (widget->hasWeight(YD_VERT))
-        json["vweight"] = widget->weight(YD_VERT);
+        json.set("vweight", json_int(widget->weight(YD_VERT)));
 }
 
 namespace
 {
-    void add_items_rec(Json::Value &jitem, const YItem *yitem)
+    void add_items_rec(YJsonStreamWriter &writer, const YItem *yitem)
     {
-        if (yitem->selected())
-            jitem["selected"] = true;
+        // the keys in sorted order: children, icon_name, icons, label,
+        // labels, selected
+        writer.beginObject();
+
+        // this is mainly for the generic widgets like YSelectionBox, YComboBox,...
+        if (yitem->hasChildren())
+        {
+            writer.key("children");
+            writer.beginArray();
+
+            // recursively add the children
+            std::for_each(yitem->childrenBegin(), yitem->childrenEnd(), [&](const YItem *ychild)
+            {
+                writer.element();
+                add_items_rec(writer, ychild);
+            });
+
+            writer.endArray();
+        }
 
         // handle YTableItem specifically
         if (auto tabitem = dynamic_cast<const YTableItem*>(yitem))
         {
-            Json::Value icons, labels;
+            std::vector<std::string> icons, labels;
             // add icons only if not empty
             bool no_icon = true;
             std::for_each(tabitem->cellsBegin(), tabitem->cellsEnd(), [&](const YTableCell *ycell)
             {
                 no_icon &= ycell->iconName().empty();
-                icons.append(ycell->iconName());
-                labels.append(ycell->label());
+                icons.push_back(json_str(ycell->iconName()));
+                labels.push_back(json_str(ycell->label()));
             });
+
             if (!no_icon)
-                jitem["icons"] = icons;
+            {
+                writer.key("icons");
+                write_array(writer, icons);
+            }
 
-            jitem["labels"] = labels;
+            writer.key("labels");
+            write_array(writer, labels);
         }
         // else if (auto treeitem = dynamic_cast<const YTreeItem*>(yitem))
         // {
@@ -195,31 +344,27 @@ namespace
         // }
         else
         {
-            jitem["label"] = yitem->label();
-
             if (yitem->hasIconName())
-                jitem["icon_name"] = yitem->iconName();
+            {
+                writer.key("icon_name");
+                writer.value(json_str(yitem->iconName()));
+            }
+
+            writer.key("label");
+            writer.value(json_str(yitem->label()));
         }
 
-        // this is mainly for the generic widgets like YSelectionBox, YComboBox,...
-        if (yitem->hasChildren())
+        if (yitem->selected())
         {
-            Json::Value children;
-
-            // recursively add the children
-            std::for_each(yitem->childrenBegin(), yitem->childrenEnd(), [&](const YItem *ychild)
-            {
-                Json::Value child;
-                add_items_rec(child, ychild);
-                children.append(child);
-            });
-
-            jitem["children"] = children;
+            writer.key("selected");
+            writer.value(json_bool(true));
         }
+
+        writer.endObject();
     }
 }
 // widget specific data
-static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
+static void serialize_widget_specific_data(YWidget *widget, Members &json) {
 
     // check all classes, some widgets might be derived from others
     // TODO: group the base classes and the final classes
@@ -233,69 +378,69 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
         case YGnomeButtonOrder  : order = "Gnome"; break;
         }
 
-        json["button_order"] = order;
+        json.set("button_order", json_str(order));
     }
 
     if (auto cb = dynamic_cast<YComboBox*>(widget))
     {
-        json["value"] = cb->value();
+        json.set("value", json_str(cb->value()));
 
         if (cb->editable())
-            json["editable"] = true;
+            json.set("editable", json_bool(true));
     }
 
     if (auto ch = dynamic_cast<YCheckBox*>(widget))
     {
         if (ch->value() != YCheckBoxState::YCheckBox_dont_care)
-            json["value"] = ch->isChecked();
+            json.set("value", json_bool(ch->isChecked()));
     }
 
     if (auto cbframe = dynamic_cast<YCheckBoxFrame*>(widget))
     {
-        json["auto_enable"] = cbframe->autoEnable();
+        json.set("auto_enable", json_bool(cbframe->autoEnable()));
     }
 
     if (auto img = dynamic_cast<YImage*>(widget))
     {
-        json["image_file_name"] = img->imageFileName();
-        json["animated"] = img->animated();
-        json["auto_scale"] = img->autoScale();
+        json.set("image_file_name", json_str(img->imageFileName()));
+        json.set("animated", json_bool(img->animated()));
+        json.set("auto_scale", json_bool(img->autoScale()));
     }
 
     if (auto inp = dynamic_cast<YInputField*>(widget))
     {
-        json["value"] = inp->value();
-        json["password_mode"] = inp->passwordMode();
+        json.set("value", json_str(inp->value()));
+        json.set("password_mode", json_bool(inp->passwordMode()));
     }
 
     if (auto inp = dynamic_cast<YMultiLineEdit*>(widget))
     {
-        json["value"] = inp->value();
+        json.set("value", json_str(inp->value()));
     }
 
     if (auto inp = dynamic_cast<YProgressBar*>(widget))
     {
-        json["value"] = inp->value();
+        json.set("value", json_int(inp->value()));
     }
 
     if (auto intf = dynamic_cast<YIntField*>(widget))
     {
-        json["value"] = intf->value();
-        json["min_value"] = intf->minValue();
-        json["max_value"] = intf->maxValue();
+        json.set("value", json_int(intf->value()));
+        json.set("min_value", json_int(intf->minValue()));
+        json.set("max_value", json_int(intf->maxValue()));
     }
 
     if (auto rb = dynamic_cast<YRadioButton*>(widget))
     {
-        json["value"] = rb->value();
+        json.set("value", json_bool(rb->value()));
     }
 
     if (auto sp = dynamic_cast<YSpacing*>(widget))
     {
         if (sp->dimension() == YD_HORIZ)
-            json["value"] = sp->preferredWidth();
+            json.set("value", json_int(sp->preferredWidth()));
         else
-            json["value"] = sp->preferredHeight();
+            json.set("value", json_int(sp->preferredHeight()));
     }
 
     if (auto dg = dynamic_cast<YDialog*>(widget))
@@ -303,13 +448,13 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
         switch (dg->dialogType())
         {
             case YMainDialog:
-                json["type"] = "main";
+                json.set("type", json_str("main"));
                 break;
             case YPopupDialog:
-                json["type"] = "popup";
+                json.set("type", json_str("popup"));
                 break;
             case YWizardDialog:
-                json["type"] = "wizard";
+                json.set("type", json_str("wizard"));
                 break;
         }
     }
@@ -317,122 +462,147 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
     if (auto label = dynamic_cast<YLabel*>(widget))
     {
         if (label->isHeading())
-            json["is_heading"] = true;
+            json.set("is_heading", json_bool(true));
 
         if (label->isOutputField())
-            json["is_output_field"] = true;
+            json.set("is_output_field", json_bool(true));
 
         if (label->useBoldFont())
-            json["use_bold_font"] = true;
+            json.set("use_bold_font", json_bool(true));
     }
 
     if (auto lv = dynamic_cast<YLogView*>(widget))
     {
-        json["lines"] = lv->lines();
-        json["log_text"] = lv->logText();
-        json["max_lines"] = lv->maxLines();
-        json["visible_lines"] = lv->visibleLines();
+        json.set("lines", json_int(lv->lines()));
+        json.set("log_text", json_str(lv->logText()));
+        json.set("max_lines", json_int(lv->maxLines()));
+        json.set("visible_lines", json_int(lv->visibleLines()));
     }
 
     if (auto mle = dynamic_cast<YMultiLineEdit*>(widget))
     {
-        json["input_max_length"] = mle->inputMaxLength();
-        json["default_visible_lines"] = mle->defaultVisibleLines();
+        json.set("input_max_length", json_int(mle->inputMaxLength()));
+        json.set("default_visible_lines", json_int(mle->defaultVisibleLines()));
     }
 
     if (auto pkg = dynamic_cast<YPackageSelector*>(widget))
     {
-        json["test_mode"] = pkg->testMode();
-        json["online_update_mode"] = pkg->onlineUpdateMode();
-        json["update_mode"] = pkg->updateMode();
-        json["search_mode"] = pkg->searchMode();
-        json["summary_mode"] = pkg->summaryMode();
-        json["repo_mode"] = pkg->repoMode();
-        json["repo_mgr_enabled"] = pkg->repoMgrEnabled();
-        json["confirm_unsupported"] = pkg->confirmUnsupported();
+        json.set("test_mode", json_bool(pkg->testMode()));
+        json.set("online_update_mode", json_bool(pkg->onlineUpdateMode()));
+        json.set("update_mode", json_bool(pkg->updateMode()));
+        json.set("search_mode", json_bool(pkg->searchMode()));
+        json.set("summary_mode", json_bool(pkg->summaryMode()));
+        json.set("repo_mode", json_bool(pkg->repoMode()));
+        json.set("repo_mgr_enabled", json_bool(pkg->repoMgrEnabled()));
+        json.set("confirm_unsupported", json_bool(pkg->confirmUnsupported()));
     }
 
     if (auto selection = dynamic_cast<YSelectionWidget*>(widget))
     {
-        json["items_count"] = selection->itemsCount();
-        json["icon_base_path"] = selection->iconBasePath();
+        json.set("items_count", json_int(selection->itemsCount()));
+        json.set("icon_base_path", json_str(selection->iconBasePath()));
 
-        Json::Value items;
-        std::for_each(selection->itemsBegin(), selection->itemsEnd(), [&](const YItem *yitem)
+        if (selection->hasItems())
         {
-            Json::Value item;
-            add_items_rec(item, yitem);
-            items.append(item);
-        });
+            json.set("items", [selection](YJsonStreamWriter &writer)
+            {
+                writer.beginArray();
 
-        json["items"] = items;
+                std::for_each(selection->itemsBegin(), selection->itemsEnd(), [&](const YItem *yitem)
+                {
+                    writer.element();
+                    add_items_rec(writer, yitem);
+                });
+
+                writer.endArray();
+            });
+        }
+        else
+            json.set("items", json_null);
     }
 
     if (auto progress = dynamic_cast<YProgressBar*>(widget))
     {
-        json["max_value"] = progress->maxValue();
+        json.set("max_value", json_int(progress->maxValue()));
     }
 
     if (auto tb = dynamic_cast<YTable*>(widget))
     {
-        Json::Value header;
-        for ( auto idx = 0; idx < tb->columns(); ++idx )
+        json.set("header", [tb](YJsonStreamWriter &writer)
         {
-            header.append(tb->header(idx));
-        }
-        json["header"] = header;
+            std::vector<std::string> header;
+            for ( auto idx = 0; idx < tb->columns(); ++idx )
+            {
+                header.push_back(json_str(tb->header(idx)));
+            }
+            write_array(writer, header);
+        });
 
-        Json::Value alignment;
-        for ( auto idx = 0; idx < tb->columns(); ++idx )
+        json.set("alignment", [tb](YJsonStreamWriter &writer)
         {
-            std::string alignment_str;
-            switch (tb->alignment(idx))
+            std::vector<std::string> alignment;
+            for ( auto idx = 0; idx < tb->columns(); ++idx )
             {
-                case YAlignUnchanged:
-                    alignment_str = "none";
-                    break;
-                case YAlignBegin:
-                    alignment_str = "left";
-                    break;
-                case YAlignEnd:
-                    alignment_str = "right";
-                    break;
-                case YAlignCenter:
-                    alignment_str = "center";
-                    break;
+                std::string alignment_str;
+                switch (tb->alignment(idx))
+                {
+                    case YAlignUnchanged:
+                        alignment_str = "none";
+                        break;
+                    case YAlignBegin:
+                        alignment_str = "left";
+                        break;
+                    case YAlignEnd:
+                        alignment_str = "right";
+                        break;
+                    case YAlignCenter:
+                        alignment_str = "center";
+                        break;
+                }
+                alignment.push_back(json_str(alignment_str));
             }
-            alignment.append(alignment_str);
-        }
-        json["alignment"] = alignment;
+            write_array(writer, alignment);
+        });
 
-        json["columns"] = tb->columns();
-        json["immediate_mode"] = tb->immediateMode();
-        json["keep_sorting"] = tb->keepSorting();
-        json["hasMultiSelection"] = tb->hasMultiSelection();
+        json.set("columns", json_int(tb->columns()));
+        json.set("immediate_mode", json_bool(tb->immediateMode()));
+        json.set("keep_sorting", json_bool(tb->keepSorting()));
+        json.set("hasMultiSelection", json_bool(tb->hasMultiSelection()));
     }
 
     if ( auto bargraph = dynamic_cast<YBarGraph*>(widget) )
     {
-        Json::Value jsegment, jsegments;
-        for ( auto idx = 0; idx < bargraph->segments(); ++idx )
+        json.set("segments", [bargraph](YJsonStreamWriter &writer)
         {
-            std::string label;
-            YBarGraphSegment segment = bargraph->segment(idx);
-            jsegment["label"] = segment.label();
-            jsegment["value"] = segment.value();
-            jsegments.append(jsegment);
-        }
-        json["segments"] = jsegments;
+            if (bargraph->segments() == 0)
+            {
+                writer.value(json_null);
+                return;
+            }
 
+            writer.beginArray();
+            for ( auto idx = 0; idx < bargraph->segments(); ++idx )
+            {
+                YBarGraphSegment segment = bargraph->segment(idx);
+                writer.element();
+                writer.beginObject();
+                writer.key("label");
+                writer.value(json_str(segment.label()));
+                writer.key("value");
+                writer.value(json_int(segment.value()));
+                writer.endObject();
+            }
+            writer.endArray();
+        });
     }
 
     if (auto df = dynamic_cast<YDateField*>(widget))
     {
-        json["value"] = df->value();
+        json.set("value", json_str(df->value()));
     }
 
     if (auto tf = dynamic_cast<YTimeField*>(widget))
     {
-        json["value"] = tf->value();
+        json.set("value", json_str(tf->value()));
     }
 }
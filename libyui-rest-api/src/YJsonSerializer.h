@@ -21,6 +21,7 @@
 #include <vector>
 
 class YWidget;
+class YJsonStreamWriter;
 
 namespace Json {
     class Value;
@@ -37,6 +38,9 @@ public:
     // serialize widget array (by default recursively with all children)
     static void serialize(const std::vector<YWidget*> &widgets, std::ostream &output, bool recursive = true);
 
+    // serialize one widget as the next value of the writer
+    static void serialize(YWidget *, YJsonStreamWriter &writer, bool recursive = true);
+
     // save the JSON value as a text into the output stream
     static void save(const Json::Value &json, std::ostream &output);
 };
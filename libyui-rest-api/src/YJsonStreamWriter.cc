@@ -0,0 +1,208 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "YJsonStreamWriter.h"
+
+namespace
+{
+    const std::string indentation("  ");
+
+    void append_hex(std::string &result, unsigned int ch)
+    {
+        static const char *digits = "0123456789abcdef";
+
+        result += "\\u";
+        for (int shift = 12; shift >= 0; shift -= 4)
+            result += digits[(ch >> shift) & 0xf];
+    }
+
+    // decode one UTF-8 character and move "s" to its last byte,
+    // invalid sequences are handled the same way as in jsoncpp
+    unsigned int utf8_to_codepoint(const char *&s, const char *end)
+    {
+        const unsigned int replacement = 0xfffd;
+        unsigned int first = static_cast<unsigned char>(*s);
+
+        if (first < 0x80)
+            return first;
+
+        if (first < 0xe0)
+        {
+            if (end - s < 2)
+                return replacement;
+
+            unsigned int ret = ((first & 0x1f) << 6) | (s[1] & 0x3f);
+            s += 1;
+            return ret < 0x80 ? replacement : ret;
+        }
+
+        if (first < 0xf0)
+        {
+            if (end - s < 3)
+                return replacement;
+
+            unsigned int ret = ((first & 0x0f) << 12) | ((s[1] & 0x3f) << 6) | (s[2] & 0x3f);
+            s += 2;
+
+            // surrogates are not valid code points
+            if (ret >= 0xd800 && ret <= 0xdfff)
+                return replacement;
+
+            return ret < 0x800 ? replacement : ret;
+        }
+
+        if (first < 0xf8)
+        {
+            if (end - s < 4)
+                return replacement;
+
+            unsigned int ret = ((first & 0x07) << 18) | ((s[1] & 0x3f) << 12)
+                | ((s[2] & 0x3f) << 6) | (s[3] & 0x3f);
+            s += 3;
+            return ret < 0x10000 ? replacement : ret;
+        }
+
+        return replacement;
+    }
+}
+
+YJsonStreamWriter::YJsonStreamWriter(std::ostream &output)
+    : _output(output), _indented(true), _first(true)
+{
+}
+
+std::string YJsonStreamWriter::quote(const std::string &str)
+{
+    std::string ret;
+    ret.reserve(str.size() + 2);
+    ret += '"';
+
+    const char *end = str.data() + str.size();
+    for (const char *c = str.data(); c != end; ++c)
+    {
+        switch (*c)
+        {
+            case '"': ret += "\\\""; break;
+            case '\\': ret += "\\\\"; break;
+            case '\b': ret += "\\b"; break;
+            case '\f': ret += "\\f"; break;
+            case '\n': ret += "\\n"; break;
+            case '\r': ret += "\\r"; break;
+            case '\t': ret += "\\t"; break;
+            default:
+            {
+                // non-ASCII characters are escaped as UTF-16 like jsoncpp does
+                unsigned int codepoint = utf8_to_codepoint(c, end);
+
+                if (codepoint < 0x20)
+                    append_hex(ret, codepoint);
+                else if (codepoint < 0x80)
+                    ret += static_cast<char>(codepoint);
+                else if (codepoint < 0x10000)
+                    append_hex(ret, codepoint);
+                else
+                {
+                    codepoint -= 0x10000;
+                    append_hex(ret, 0xd800 + ((codepoint >> 10) & 0x3ff));
+                    append_hex(ret, 0xdc00 + (codepoint & 0x3ff));
+                }
+            }
+        }
+    }
+
+    ret += '"';
+    return ret;
+}
+
+void YJsonStreamWriter::value(const std::string &json)
+{
+    write(json);
+    _indented = false;
+}
+
+void YJsonStreamWriter::beginObject()
+{
+    writeWithIndent("{");
+    _indent += indentation;
+    _first = true;
+}
+
+void YJsonStreamWriter::endObject()
+{
+    _indent.resize(_indent.size() - indentation.size());
+    writeWithIndent("}");
+    // back in the parent which has at least this member or element
+    _first = false;
+}
+
+void YJsonStreamWriter::key(const std::string &name)
+{
+    nextMember();
+    writeWithIndent(quote(name));
+    write(" : ");
+}
+
+void YJsonStreamWriter::beginArray()
+{
+    writeWithIndent("[");
+    _indent += indentation;
+    _first = true;
+}
+
+void YJsonStreamWriter::endArray()
+{
+    _indent.resize(_indent.size() - indentation.size());
+    writeWithIndent("]");
+    _first = false;
+}
+
+void YJsonStreamWriter::element()
+{
+    nextMember();
+
+    if (!_indented)
+        writeIndent();
+
+    _indented = true;
+}
+
+void YJsonStreamWriter::write(const std::string &str)
+{
+    _output.write(str.data(), str.size());
+}
+
+void YJsonStreamWriter::writeIndent()
+{
+    write("\n");
+    write(_indent);
+}
+
+void YJsonStreamWriter::writeWithIndent(const std::string &str)
+{
+    if (!_indented)
+        writeIndent();
+
+    write(str);
+    _indented = false;
+}
+
+void YJsonStreamWriter::nextMember()
+{
+    if (!_first)
+        write(",");
+
+    _first = false;
+}
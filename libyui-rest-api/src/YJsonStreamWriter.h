@@ -0,0 +1,89 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YJsonStreamWriter_h
+#define YJsonStreamWriter_h
+
+#include <iostream>
+#include <string>
+
+/**
+ * Writes JSON directly into an output stream, without building
+ * a Json::Value document first. The layout is exactly the one the jsoncpp
+ * StreamWriterBuilder used in YJsonSerializer::save() produces (two spaces
+ * indentation, each array element on a separate line, no final new line).
+ *
+ * Scalars are passed as JSON texts, see quote(), boolean() and number().
+ * The members of an object must be written sorted by the key, jsoncpp
+ * sorts them as well. Empty objects and arrays are written as scalars
+ * ("{}", "[]").
+ *
+ *   YJsonStreamWriter writer(output);
+ *   writer.beginObject();
+ *   writer.key("class");
+ *   writer.value(YJsonStreamWriter::quote("YPushButton"));
+ *   writer.key("widgets");
+ *   writer.beginArray();
+ *   writer.element();
+ *   writer.value(YJsonStreamWriter::number(42));
+ *   writer.endArray();
+ *   writer.endObject();
+ */
+class YJsonStreamWriter
+{
+
+public:
+
+    YJsonStreamWriter(std::ostream &output);
+
+    // JSON texts of scalars, strings are escaped like in jsoncpp
+    static std::string quote(const std::string &str);
+    static std::string boolean(bool b) { return b ? "true" : "false"; }
+    static std::string number(long long n) { return std::to_string(n); }
+
+    // write a scalar value (a JSON text)
+    void value(const std::string &json);
+
+    // start and end a non-empty object
+    void beginObject();
+    void endObject();
+
+    // start the next object member, write the value afterwards
+    void key(const std::string &name);
+
+    // start and end a non-empty array
+    void beginArray();
+    void endArray();
+
+    // start the next array element, write the value afterwards
+    void element();
+
+private:
+
+    void write(const std::string &str);
+    void writeIndent();
+    void writeWithIndent(const std::string &str);
+    void nextMember();
+
+    std::ostream &_output;
+    std::string _indent;
+    // the current line is indented already
+    bool _indented;
+    // no member or element written yet in the current object or array
+    bool _first;
+};
+
+#endif // YJsonStreamWriter_h
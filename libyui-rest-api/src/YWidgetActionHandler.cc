@@ -24,7 +24,8 @@ std::string normalize_label_bidi(const std::string& label)
 {
     static std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
 
-    static wchar_t bidi_controls[] { L'\u202a', L'\u202b', L'\u202c', L'\u202d', L'\u202e', L'\u2066', L'\u2067', L'\u2068', L'\u2069' };
+    // null terminated, is_any_of() takes a wchar_t array as a C string
+    static const wchar_t bidi_controls[] = L"\u202a\u202b\u202c\u202d\u202e\u2066\u2067\u2068\u2069";
 
     std::wstring wlabel(conv.from_bytes(label));
     auto new_end = boost::remove_if(wlabel, boost::is_any_of(bidi_controls));
@@ -16,7 +16,8 @@
 
 // boost::erase_all
 #include <boost/algorithm/string.hpp>
-#include <functional>
+#include <stdexcept>
+#include <unordered_map>
 
 #include <yui/YDialog.h>
 #include <yui/YWidget.h>
@@ -25,124 +26,246 @@
 #include "YWidgetFinder.h"
 #include "YWidgetActionHandler.h"
 
+namespace
+{
+    // the searchable data of a widget, read once when the index is built
+    struct IndexEntry
+    {
+        YWidget *widget;
+        bool has_id;
+        bool has_label;
+        bool has_type;
+        bool has_debug_label;
+        std::string id;
+        std::string label;          // normalized
+        std::string type;
+        std::string debug_label;    // normalized
+    };
+
+    // normalize a widget label, keep labels which are not valid UTF-8
+    // (the normalization fails for them) so they do not break the index
+    std::string normalized_widget_label(const std::string &label)
+    {
+        try
+        {
+            return YWidgetActionHandler::normalize_label(label);
+        }
+        catch (const std::range_error &)
+        {
+            return label;
+        }
+    }
+
+    typedef std::vector<const IndexEntry*> EntryList;
+    typedef std::unordered_map<std::string, EntryList> EntryMap;
+
+    // Lookup index of all widgets in a dialog. It is built on the first
+    // lookup and then reused until widgets are added or removed or an ID or
+    // a label changes, so repeated queries do not walk the widget tree and
+    // read the properties again. Other changes (values, items, ...) do not
+    // matter for the index.
+    class WidgetIndex
+    {
+
+    public:
+
+        WidgetIndex() : _dialog(nullptr), _structure_generation(0), _label_generation(0) {}
+
+        // the index for the topmost dialog, (re)built if needed
+        static const WidgetIndex &topmost();
+
+        // all widgets in the tree order
+        const std::vector<IndexEntry> &entries() const { return _entries; }
+
+        const EntryList *by_id(const std::string &id) const { return lookup(_by_id, id); }
+        const EntryList *by_label(const std::string &label) const { return lookup(_by_label, label); }
+        const EntryList *by_type(const std::string &type) const { return lookup(_by_type, type); }
+        const EntryList *by_debug_label(const std::string &label) const { return lookup(_by_debug_label, label); }
+
+    private:
+
+        void build(YDialog *dialog);
+        void add_rec(YWidget *w);
+
+        static const EntryList *lookup(const EntryMap &map, const std::string &key)
+        {
+            auto it = map.find(key);
+            return it == map.end() ? nullptr : &it->second;
+        }
+
+        YDialog *_dialog;
+        unsigned long _structure_generation;
+        unsigned long _label_generation;
+        std::vector<IndexEntry> _entries;
+        EntryMap _by_id;
+        EntryMap _by_label;
+        EntryMap _by_type;
+        EntryMap _by_debug_label;
+    };
+
+    const WidgetIndex &WidgetIndex::topmost()
+    {
+        static WidgetIndex index;
+
+        // throws if there is no dialog
+        YDialog *dialog = YDialog::topmostDialog();
+
+        // the generations are unique across all dialogs, a dialog created
+        // at the same address as a deleted one is detected as well
+        if (dialog != index._dialog || (dialog &&
+            (dialog->structureGeneration() != index._structure_generation ||
+             dialog->labelGeneration() != index._label_generation)))
+            index.build(dialog);
+
+        return index;
+    }
+
+    void WidgetIndex::build(YDialog *dialog)
+    {
+        _dialog = dialog;
+        _structure_generation = dialog ? dialog->structureGeneration() : 0;
+        _label_generation = dialog ? dialog->labelGeneration() : 0;
+        _entries.clear();
+        _by_id.clear();
+        _by_label.clear();
+        _by_type.clear();
+        _by_debug_label.clear();
+
+        if (!dialog)
+            return;
+
+        add_rec(dialog);
+
+        // the entries do not move anymore, fill the maps
+        for (const IndexEntry &entry: _entries)
+        {
+            if (entry.has_id)
+                _by_id[entry.id].push_back(&entry);
+
+            if (entry.has_label)
+                _by_label[entry.label].push_back(&entry);
+
+            if (entry.has_type)
+                _by_type[entry.type].push_back(&entry);
+
+            if (entry.has_debug_label)
+                _by_debug_label[entry.debug_label].push_back(&entry);
+        }
+    }
+
+    void WidgetIndex::add_rec(YWidget *w)
+    {
+        const YPropertySet &propSet = w->propertySet();
+        IndexEntry entry;
 
-// internal helper methods
-static bool filter_by_label_rec(YWidget *w, const std::string &label);
-static bool filter_by_id_rec(YWidget *w, const std::string &id);
-static bool filter_by_type_rec(YWidget *w, const std::string &type);
-static bool filter_by_debug_label_rec(YWidget *w, const std::string &debug_label);
-static void find_widgets(YWidget *w, WidgetArray &array, std::function<bool (YWidget*)> filter_func);
+        entry.widget = w;
+        entry.has_id = w->hasId();
+        entry.has_label = propSet.contains(YUIPropertyId_Label);
+        entry.has_type = propSet.contains(YUIPropertyId_WidgetClass);
+        entry.has_debug_label = propSet.contains(YUIPropertyId_DebugLabel);
+
+        if (entry.has_id)
+            entry.id = w->id()->toString();
+
+        if (entry.has_label)
+            entry.label = normalized_widget_label(w->getProperty(YUIPropertyId_Label).stringVal());
+
+        if (entry.has_type)
+            entry.type = w->getProperty(YUIPropertyId_WidgetClass).stringVal();
+
+        if (entry.has_debug_label)
+            entry.debug_label = normalized_widget_label(w->getProperty(YUIPropertyId_DebugLabel).stringVal());
+
+        _entries.push_back(entry);
+
+        for(YWidget *child: *w)
+        {
+            add_rec(child);
+        };
+    }
+
+    WidgetArray widgets(const EntryList *list)
+    {
+        WidgetArray ret;
+
+        if (list)
+        {
+            ret.reserve(list->size());
+
+            for (const IndexEntry *entry: *list)
+                ret.push_back(entry->widget);
+        }
+
+        return ret;
+    }
+}
 
 // WidgetArray YWidgetFinder::find(const std::string &label, const std::string &id, const std::string &type, const std::string &debug_label)
 WidgetArray YWidgetFinder::find( const char* label, const char* id, const char* type, const char* debug_label )
 {
+    const WidgetIndex &index = WidgetIndex::topmost();
+
+    std::string norm_label = label ? YWidgetActionHandler::normalize_label(label) : std::string();
+    std::string norm_debug_label = debug_label ? YWidgetActionHandler::normalize_label(debug_label) : std::string();
+
+    // start with the most selective filter and check the others on the
+    // candidates, the result is in the tree order
+    const EntryList *candidates = nullptr;
+
+    if (id)
+        candidates = index.by_id(id);
+    else if (label)
+        candidates = index.by_label(norm_label);
+    else if (debug_label)
+        candidates = index.by_debug_label(norm_debug_label);
+    else if (type)
+        candidates = index.by_type(type);
+    else
+        return all();
+
     WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [& label, & id, & type, & debug_label] (YWidget *w) {
-        return (!label || filter_by_label_rec(w, label)) &&
-               (!id || filter_by_id_rec(w, id)) &&
-               (!type || filter_by_type_rec(w, type))  &&
-               (!debug_label || filter_by_debug_label_rec(w, debug_label));
-    } );
+
+    if (!candidates)
+        return ret;
+
+    for (const IndexEntry *entry: *candidates)
+    {
+        if ((!label || (entry->has_label && entry->label == norm_label)) &&
+            (!id || (entry->has_id && entry->id == id)) &&
+            (!type || (entry->has_type && entry->type == type)) &&
+            (!debug_label || (entry->has_debug_label && entry->debug_label == norm_debug_label)))
+            ret.push_back(entry->widget);
+    }
+
     return ret;
 }
 
 WidgetArray YWidgetFinder::by_label(const std::string &label)
 {
-    WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [& label] (YWidget *w) {
-        return filter_by_label_rec(w, label);
-    } );
-    return ret;
+    return widgets(WidgetIndex::topmost().by_label(YWidgetActionHandler::normalize_label(label)));
 }
 
 WidgetArray YWidgetFinder::by_id(const std::string &id)
 {
-    WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [& id] (YWidget *w) {
-        return filter_by_id_rec(w, id);
-    } );
-    return ret;
+    return widgets(WidgetIndex::topmost().by_id(id));
 }
 
 WidgetArray YWidgetFinder::by_type(const std::string &type)
 {
-    WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [& type] (YWidget *w) {
-        return filter_by_type_rec(w, type);
-    } );
-    return ret;
+    return widgets(WidgetIndex::topmost().by_type(type));
 }
 
 WidgetArray YWidgetFinder::by_debug_label(const std::string &debug_label)
 {
-    WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [& debug_label] (YWidget *w) {
-        return filter_by_debug_label_rec(w, debug_label);
-    } );
-    return ret;
+    return widgets(WidgetIndex::topmost().by_debug_label(YWidgetActionHandler::normalize_label(debug_label)));
 }
 
 WidgetArray YWidgetFinder::all()
 {
     WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [] (YWidget *w) {
-        return true;
-    } );
-    return ret;
-}
 
-void find_widgets(YWidget *w, WidgetArray &array, std::function<bool (YWidget*)> filter_func) {
-    if ( !w )
-        return;
+    for (const IndexEntry &entry: WidgetIndex::topmost().entries())
+        ret.push_back(entry.widget);
 
-    if( filter_func(w) )
-        array.push_back(w);
-
-    for(YWidget *child: *w)
-    {
-        find_widgets(child, array, filter_func);
-    };
-}
-
-static bool filter_by_label_rec(YWidget *w, const std::string &label)
-{
-    // check the widget label if it is defined
-    if ( w->propertySet().contains("Label") )
-    {
-        std::string widget_label = w->getProperty("Label").stringVal();
-
-        return YWidgetActionHandler::normalized_labels_equal( widget_label, label );
-    }
-    return false;
-}
-
-static bool filter_by_id_rec(YWidget *w, const std::string &id)
-{
-    if ( w->hasId() && w->id()->toString() == id )
-        return true;
-
-    return false;
-}
-
-
-static bool filter_by_type_rec(YWidget *w, const std::string &type)
-{
-    auto propSet = w->propertySet();
-
-    if ( propSet.contains("WidgetClass") && w->getProperty("WidgetClass").stringVal() == type )
-        return true;
-
-    return false;
-}
-
-static bool filter_by_debug_label_rec(YWidget *w, const std::string &debug_label)
-{
-    // check the widget DebugLabel if it is defined
-    if ( w->propertySet().contains("DebugLabel") )
-    {
-        std::string widget_debug_label = w->getProperty("DebugLabel").stringVal();
-
-        return YWidgetActionHandler::normalized_labels_equal( widget_debug_label, debug_label );
-    }
-    return false;
+    return ret;
 }
@@ -122,24 +122,28 @@ int YAlignment::bottomMargin() const
 void YAlignment::setLeftMargin( int margin )
 {
     priv->leftMargin = margin;
+    invalidatePreferredSize();
 }
 
 
 void YAlignment::setRightMargin( int margin )
 {
     priv->rightMargin = margin;
+    invalidatePreferredSize();
 }
 
 
 void YAlignment::setTopMargin( int margin )
 {
     priv->topMargin = margin;
+    invalidatePreferredSize();
 }
 
 
 void YAlignment::setBottomMargin( int margin )
 {
     priv->bottomMargin = margin;
+    invalidatePreferredSize();
 }
 
 
@@ -158,12 +162,14 @@ int YAlignment::minHeight() const
 void YAlignment::setMinWidth( int width )
 {
     priv->minWidth = width;
+    invalidatePreferredSize();
 }
 
 
 void YAlignment::setMinHeight( int height )
 {
     priv->minHeight = height;
+    invalidatePreferredSize();
 }
 
 
@@ -196,7 +202,7 @@ int YAlignment::preferredWidth()
     if ( ! hasChildren() )
 	return minWidth();
 
-    int preferredWidth = firstChild()->preferredWidth();
+    int preferredWidth = firstChild()->cachedPreferredSize( YD_HORIZ );
     preferredWidth    += leftMargin() + rightMargin();
 
     return std::max( minWidth(), preferredWidth );
@@ -208,7 +214,7 @@ int YAlignment::preferredHeight()
     if ( ! hasChildren() )
 	return minHeight();
 
-    int preferredHeight = firstChild()->preferredHeight();
+    int preferredHeight = firstChild()->cachedPreferredSize( YD_VERT );
     preferredHeight    += topMargin() + bottomMargin();
 
     return std::max( minHeight(), preferredHeight );
@@ -242,7 +248,7 @@ void YAlignment::setSize( int newWidth, int newHeight )
     YUIDimension dim = YD_HORIZ;
     while ( true ) // only toggle
     {
-	int childPreferredSize = firstChild()->preferredSize( dim );
+	int childPreferredSize = firstChild()->cachedPreferredSize( dim );
 	int preferredSize      = childPreferredSize + totalMargin[ dim ];
 
 	if ( newSize[ dim ] >= preferredSize )
@@ -203,6 +203,9 @@ YApplication::setLanguage( const string & language, const string & encoding )
     setenv( "LANG", lang.c_str(), 1 );  // 1 : replace
     setlocale( LC_NUMERIC, "C" );	// but always format numbers with "."
 
+    // Translated texts (and possibly fonts) change the size of all widgets
+    YWidget::invalidateAllPreferredSizes();
+
     yuiMilestone() <<  "Setting language to " << lang << endl;
 }
 
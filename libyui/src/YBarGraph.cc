@@ -131,6 +131,7 @@ YBarGraph::setValue( int segmentIndex, int newValue )
     CHECK_INDEX( segmentIndex );
 
     priv->segments[ segmentIndex ].setValue( newValue );
+    invalidatePreferredSize();
     updateDisplay();
 }
 
@@ -141,6 +142,7 @@ YBarGraph::setLabel( int segmentIndex, const string & newLabel )
     CHECK_INDEX( segmentIndex );
 
     priv->segments[ segmentIndex ].setLabel( newLabel );
+    labelChanged();
     updateDisplay();
 }
 
@@ -193,15 +195,15 @@ YBarGraph::propertySet()
 
 
 bool
-YBarGraph::setProperty( const string & propertyName, const YPropertyValue & val )
+YBarGraph::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if      ( propertyName == YUIProperty_Values )	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Labels )	return false; // Needs special handling
+    if      ( propertyId == YUIPropertyId_Values )	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Labels )	return false; // Needs special handling
     else
     {
-	YWidget::setProperty( propertyName, val );
+	YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special handling necessary
@@ -209,15 +211,15 @@ YBarGraph::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YBarGraph::getProperty( const string & propertyName )
+YBarGraph::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Values	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Labels	)	return YPropertyValue( YOtherProperty );
+    if	    ( propertyId == YUIPropertyId_Values	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Labels	)	return YPropertyValue( YOtherProperty );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
 
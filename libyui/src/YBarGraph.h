@@ -138,8 +138,8 @@ public:
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setPropertyById( YPropertyId	         propertyId,
+				  const YPropertyValue & val );
 
     /**
      * Get a property.
@@ -147,7 +147,7 @@ public:
      *
      * This method may throw YUIPropertyExceptions.
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getPropertyById( YPropertyId propertyId );
 
     /**
      * Return this class's property set.
@@ -0,0 +1,98 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YBinaryMacroFormat.h
+
+/-*/
+
+#ifndef YBinaryMacroFormat_h
+#define YBinaryMacroFormat_h
+
+
+/**
+ * The binary macro format written by YBinaryMacroRecorder and read by
+ * YBinaryMacroPlayer.
+ *
+ * A macro file starts with the 8 bytes of YBinaryMacro_Magic, followed by
+ * the format version as one byte. Then there is a stream of records until
+ * the end of the file. Each record is
+ *
+ *     type      (byte, YBinaryMacroRecordType)
+ *     time      (varint: microseconds since the previous record)
+ *     payload   (depending on the type, see below)
+ *
+ * Numbers are unsigned LEB128 varints; signed numbers are zigzag encoded
+ * first. Strings that occur often (widget IDs, property names) are
+ * interned: A string reference is a varint that is either 0, followed by
+ * a new string that gets the next index (starting at 1), or the index of a
+ * string that was already written. Plain strings are a varint length and
+ * the UTF-8 bytes.
+ *
+ * Payloads:
+ *
+ *     PropertyRecord:   widget ID (ref), property name (ref),
+ *                       value type (byte, YBinaryMacroValueType), value
+ *
+ *     EventRecord:      event type (byte, YEvent::EventType), then
+ *                       WidgetEvent:     widget ID (ref), reason (byte)
+ *                       MenuEvent:       menu item ID (string)
+ *                       KeyEvent:        key symbol (string),
+ *                                        focus widget ID (ref)
+ *                       SpecialKeyEvent: ID (string)
+ *                       others:          nothing
+ *
+ *     ScreenShotRecord: enabled (byte), file name (string)
+ *
+ * Values:
+ *
+ *     StringValue:      string
+ *     BoolValue:        byte
+ *     IntegerValue:     signed varint
+ *     ItemLabelsValue:  varint count, then that many strings
+ *     CheckBoxValue:    byte (YCheckBoxState)
+ *
+ * Properties that don't have a simple type are written as the value that
+ * the widget class offers for them: The text of a YComboBox, the selected
+ * items of other selection widgets and the state of a YCheckBox.
+ *
+ * Widgets without an ID are written with an empty ID.
+ **/
+
+#define YBinaryMacro_Magic	"YUIMACRO"
+#define YBinaryMacro_Version	1
+
+
+enum YBinaryMacroRecordType
+{
+    YBinaryMacro_PropertyRecord		= 1,
+    YBinaryMacro_EventRecord		= 2,
+    YBinaryMacro_ScreenShotRecord	= 3
+};
+
+
+enum YBinaryMacroValueType
+{
+    YBinaryMacro_StringValue		= 1,
+    YBinaryMacro_BoolValue		= 2,
+    YBinaryMacro_IntegerValue		= 3,
+    YBinaryMacro_ItemLabelsValue	= 4,	// the selected items of a YSelectionWidget
+    YBinaryMacro_CheckBoxValue		= 5	// the tristate value of a YCheckBox
+};
+
+
+#endif // YBinaryMacroFormat_h
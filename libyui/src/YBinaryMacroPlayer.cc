@@ -0,0 +1,510 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YBinaryMacroPlayer.cc
+
+/-*/
+
+
+#include <string.h>	// memcmp()
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#define YUILogComponent "ui"
+#include "YUILog.h"
+
+#include "YBinaryMacroPlayer.h"
+#include "YBinaryMacroFormat.h"
+#include "YApplication.h"
+#include "YDialog.h"
+#include "YCheckBox.h"
+#include "YComboBox.h"
+#include "YSelectionWidget.h"
+#include "YUI.h"
+#include "YUIException.h"
+#include "YUISymbols.h"
+#include "YUITrace.h"
+#include "YWidgetID.h"
+
+// Sanity limit for string lengths in broken files
+#define MAX_STRING_LEN	( 16 * 1024 * 1024 )
+
+using std::string;
+
+
+YBinaryMacroPlayer::YBinaryMacroPlayer()
+    : _speed( 0.0 )
+    , _havePendingEvent( false )
+    , _pendingProperties( 0 )
+    , _pendingApplyTime( 0.0 )
+    , _deliveryTime( 0.0 )
+{
+}
+
+
+YBinaryMacroPlayer::~YBinaryMacroPlayer()
+{
+    stop();
+}
+
+
+void YBinaryMacroPlayer::play( const string & macroFile )
+{
+    stop();
+
+    _file.open( macroFile.c_str(), std::ios::in | std::ios::binary );
+
+    if ( ! _file.is_open() )
+    {
+	yuiError() << "Can't open macro file " << macroFile << endl;
+	return;
+    }
+
+    char magic[ sizeof( YBinaryMacro_Magic ) - 1 ];
+    _file.read( magic, sizeof( magic ) );
+    unsigned char version = readByte();
+
+    if ( ! _file.good() ||
+	 memcmp( magic, YBinaryMacro_Magic, sizeof( magic ) ) != 0 ||
+	 version != YBinaryMacro_Version )
+    {
+	yuiError() << "Not a binary macro file (version " << YBinaryMacro_Version
+		   << "): " << macroFile << endl;
+	_file.close();
+	return;
+    }
+
+    yuiMilestone() << "Playing macro " << macroFile
+		   << ( _speed > 0.0 ? "" : " as fast as possible" ) << endl;
+
+    _strings.clear();
+    _steps.clear();
+    _havePendingEvent = false;
+    _deliveryTime     = 0.0;
+}
+
+
+void YBinaryMacroPlayer::stop()
+{
+    _havePendingEvent = false;
+
+    if ( _file.is_open() )
+	_file.close();
+}
+
+
+bool YBinaryMacroPlayer::playing() const
+{
+    return _file.is_open() || _havePendingEvent;
+}
+
+
+void YBinaryMacroPlayer::playNextBlock()
+{
+    playBlock( YDialog::currentDialog( false ) );
+}
+
+
+YEvent * YBinaryMacroPlayer::nextEvent( YDialog * dialog )
+{
+    if ( _deliveryTime > 0.0 )
+    {
+	_steps.back().latency = ( YUITrace::now() - _deliveryTime ) / 1000.0;
+	_deliveryTime = 0.0;
+    }
+
+    if ( ! _havePendingEvent )
+	playBlock( dialog );
+
+    if ( ! _havePendingEvent )
+    {
+	if ( ! _steps.empty() )
+	{
+	    yuiMilestone() << "Macro finished" << endl;
+	    logReport();
+	}
+
+	return 0;
+    }
+
+    _havePendingEvent = false;
+    YEvent * event = createEvent( dialog, _pendingEvent );
+
+    Step step;
+    step.eventType  = _pendingEvent.eventType;
+    step.widgetId   = _pendingEvent.id;
+    step.properties = _pendingProperties;
+    step.applyTime  = _pendingApplyTime;
+    step.latency    = 0.0;
+    _steps.push_back( step );
+
+    _deliveryTime = YUITrace::now();
+
+    return event;
+}
+
+
+void YBinaryMacroPlayer::playBlock( YDialog * dialog )
+{
+    YUI_TRACE_SPAN( "playMacroBlock" );
+
+    _pendingProperties = 0;
+    _pendingApplyTime  = 0.0;
+
+    while ( ! _havePendingEvent && playRecord( dialog ) )
+	;
+}
+
+
+bool YBinaryMacroPlayer::playRecord( YDialog * dialog )
+{
+    if ( ! _file.is_open() )
+	return false;
+
+    if ( _file.peek() == std::ifstream::traits_type::eof() )
+    {
+	_file.close();
+	return false;
+    }
+
+    unsigned char recordType = readByte();
+    waitRecordedTime( readVarint() );
+
+    switch ( recordType )
+    {
+	case YBinaryMacro_PropertyRecord:
+	{
+	    double startTime = YUITrace::now();
+	    playPropertyRecord( dialog );
+
+	    _pendingApplyTime += ( YUITrace::now() - startTime ) / 1000.0;
+	    _pendingProperties++;
+	    break;
+	}
+
+	case YBinaryMacro_EventRecord:
+	{
+	    EventRecord record;
+	    record.eventType = (YEvent::EventType) readByte();
+
+	    switch ( record.eventType )
+	    {
+		case YEvent::WidgetEvent:
+		    record.id	  = readStringRef();
+		    record.reason = (YEvent::EventReason) readByte();
+		    break;
+
+		case YEvent::KeyEvent:
+		    record.keySymbol = readString();
+		    record.id	     = readStringRef();
+		    break;
+
+		case YEvent::MenuEvent:
+		case YEvent::SpecialKeyEvent:
+		    record.id = readString();
+		    break;
+
+		default:
+		    break;
+	    }
+
+	    _pendingEvent     = record;
+	    _havePendingEvent = true;
+	    break;
+	}
+
+	case YBinaryMacro_ScreenShotRecord:
+	{
+	    bool   enabled  = readByte();
+	    string fileName = readString();
+
+	    if ( enabled && _file.good() )
+		YUI::app()->makeScreenShot( fileName );
+
+	    break;
+	}
+
+	default:
+	    yuiError() << "Unknown macro record type " << (int) recordType << endl;
+	    _file.setstate( std::ios::failbit );
+	    break;
+    }
+
+    if ( ! _file.good() )
+    {
+	readError();
+	return false;
+    }
+
+    return true;
+}
+
+
+void YBinaryMacroPlayer::playPropertyRecord( YDialog * dialog )
+{
+    string widgetId	      = readStringRef();
+    string propertyName	      = readStringRef();
+    unsigned char valueType   = readByte();
+
+    YPropertyValue val;
+    std::vector<string> labels;
+
+    switch ( valueType )
+    {
+	case YBinaryMacro_StringValue:
+	    val = YPropertyValue( readString() );
+	    break;
+
+	case YBinaryMacro_BoolValue:
+	    val = YPropertyValue( readByte() != 0 );
+	    break;
+
+	case YBinaryMacro_IntegerValue:
+	{
+	    uint64_t num = readVarint();
+	    val = YPropertyValue( (YInteger) ( ( num >> 1 ) ^ -( num & 1 ) ) );
+	    break;
+	}
+
+	case YBinaryMacro_CheckBoxValue:
+	    val = YPropertyValue( (int) readByte() );
+	    break;
+
+	case YBinaryMacro_ItemLabelsValue:
+	{
+	    uint64_t count = readVarint();
+
+	    for ( uint64_t i = 0; i < count && _file.good(); ++i )
+		labels.push_back( readString() );
+
+	    break;
+	}
+
+	default:
+	    _file.setstate( std::ios::failbit );
+	    break;
+    }
+
+    if ( ! _file.good() )
+	return;
+
+    YWidget * widget = findWidget( dialog, widgetId );
+
+    if ( ! widget )
+    {
+	yuiWarning() << "No widget with ID \"" << widgetId << "\" for property "
+		     << propertyName << endl;
+	return;
+    }
+
+    try
+    {
+	YCheckBox * checkBox = dynamic_cast<YCheckBox *>( widget );
+	YComboBox * comboBox = dynamic_cast<YComboBox *>( widget );
+
+	if ( valueType == YBinaryMacro_ItemLabelsValue )
+	    selectItems( widget, propertyName, labels );
+	else if ( valueType == YBinaryMacro_CheckBoxValue && checkBox )
+	    checkBox->setValue( (YCheckBoxState) val.integerVal() );
+	else if ( valueType == YBinaryMacro_StringValue && comboBox && propertyName == YUIProperty_Value )
+	    comboBox->setValue( val.stringVal() );
+	else if ( ! widget->setProperty( propertyName, val ) )
+	    yuiWarning() << "Can't set property " << propertyName << " of " << widget << endl;
+    }
+    catch ( YUIException & exception )
+    {
+	YUI_CAUGHT( exception );
+    }
+}
+
+
+void YBinaryMacroPlayer::selectItems( YWidget *			widget,
+				      const string &		propertyName,
+				      const std::vector<string> &	labels )
+{
+    YSelectionWidget * selectionWidget = dynamic_cast<YSelectionWidget *>( widget );
+
+    if ( ! selectionWidget )
+	return;
+
+    // In multi-selection widgets, the current item is only the one with the
+    // keyboard focus; the selection is recorded separately.
+
+    if ( propertyName == YUIProperty_CurrentItem && ! selectionWidget->enforceSingleSelection() )
+	return;
+
+    selectionWidget->deselectAllItems();
+
+    for ( const string & label: labels )
+    {
+	YItem * item = selectionWidget->findItem( label );
+
+	if ( item )
+	    selectionWidget->selectItem( item );
+	else
+	    yuiWarning() << "No item \"" << label << "\" in " << widget << endl;
+    }
+}
+
+
+YEvent * YBinaryMacroPlayer::createEvent( YDialog * dialog, const EventRecord & record )
+{
+    switch ( record.eventType )
+    {
+	case YEvent::WidgetEvent:
+	{
+	    YWidget * widget = findWidget( dialog, record.id );
+
+	    if ( ! widget )
+		yuiWarning() << "No widget with ID \"" << record.id << "\" for event" << endl;
+
+	    return new YWidgetEvent( widget, record.reason );
+	}
+
+	case YEvent::MenuEvent:		return new YMenuEvent( record.id );
+	case YEvent::KeyEvent:		return new YKeyEvent( record.keySymbol, findWidget( dialog, record.id ) );
+	case YEvent::SpecialKeyEvent:	return new YSpecialKeyEvent( record.id );
+	case YEvent::CancelEvent:	return new YCancelEvent();
+	case YEvent::TimeoutEvent:	return new YTimeoutEvent();
+	case YEvent::DebugEvent:	return new YDebugEvent();
+
+	default:
+	    yuiWarning() << "Can't replay event type " << (int) record.eventType << endl;
+	    return new YEvent( YEvent::UnknownEvent );
+    }
+}
+
+
+YWidget * YBinaryMacroPlayer::findWidget( YDialog * dialog, const string & id )
+{
+    if ( ! dialog || id.empty() )
+	return 0;
+
+    YStringWidgetID widgetId( id );
+
+    return dialog->findWidget( &widgetId, false );
+}
+
+
+void YBinaryMacroPlayer::waitRecordedTime( uint64_t microseconds )
+{
+    if ( _speed > 0.0 && microseconds > 0 )
+	std::this_thread::sleep_for( std::chrono::microseconds( (int64_t) ( microseconds / _speed ) ) );
+}
+
+
+void YBinaryMacroPlayer::logReport() const
+{
+    if ( _steps.empty() )
+	return;
+
+    std::vector<double> latencies;
+    double totalLatency	  = 0.0;
+    double totalApplyTime = 0.0;
+
+    for ( const Step & step: _steps )
+    {
+	latencies.push_back( step.latency );
+	totalLatency   += step.latency;
+	totalApplyTime += step.applyTime;
+    }
+
+    std::sort( latencies.begin(), latencies.end() );
+
+    yuiMilestone() << "Macro: " << _steps.size() << " events"
+		   << ", latency avg " << totalLatency / _steps.size() << " ms"
+		   << ", median " << latencies[ latencies.size() / 2 ] << " ms"
+		   << ", 95% " << latencies[ latencies.size() * 95 / 100 ] << " ms"
+		   << ", max " << latencies.back() << " ms"
+		   << "; setting user input " << totalApplyTime << " ms total"
+		   << endl;
+}
+
+
+unsigned char YBinaryMacroPlayer::readByte()
+{
+    int c = _file.get();
+
+    return c == std::ifstream::traits_type::eof() ? 0 : (unsigned char) c;
+}
+
+
+uint64_t YBinaryMacroPlayer::readVarint()
+{
+    uint64_t value = 0;
+
+    for ( int shift = 0; shift < 64 && _file.good(); shift += 7 )
+    {
+	unsigned char byte = readByte();
+	value |= (uint64_t) ( byte & 0x7f ) << shift;
+
+	if ( ! ( byte & 0x80 ) )
+	    return value;
+    }
+
+    _file.setstate( std::ios::failbit );
+
+    return 0;
+}
+
+
+string YBinaryMacroPlayer::readString()
+{
+    uint64_t len = readVarint();
+
+    if ( len > MAX_STRING_LEN )
+	_file.setstate( std::ios::failbit );
+
+    if ( ! _file.good() || len == 0 )
+	return string();
+
+    string str( len, '\0' );
+    _file.read( &str[0], len );
+
+    return str;
+}
+
+
+string YBinaryMacroPlayer::readStringRef()
+{
+    uint64_t index = readVarint();
+
+    if ( index == 0 )
+    {
+	string str = readString();
+	_strings.push_back( str );
+
+	return str;
+    }
+
+    if ( index > _strings.size() )
+    {
+	_file.setstate( std::ios::failbit );
+	return string();
+    }
+
+    return _strings[ index - 1 ];
+}
+
+
+void YBinaryMacroPlayer::readError()
+{
+    yuiError() << "Broken macro file - stopped playing" << endl;
+    stop();
+}
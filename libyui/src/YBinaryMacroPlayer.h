@@ -0,0 +1,219 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YBinaryMacroPlayer.h
+
+/-*/
+
+#ifndef YBinaryMacroPlayer_h
+#define YBinaryMacroPlayer_h
+
+#include <stdint.h>
+#include <fstream>
+#include <vector>
+
+#include "YMacroPlayer.h"
+#include "YEvent.h"
+
+class YWidget;
+
+
+/**
+ * Macro player for the binary format written by YBinaryMacroRecorder (see
+ * YBinaryMacroFormat.h).
+ *
+ * While a macro is playing, each YDialog::waitForEvent() or
+ * YDialog::pollEvent() first sets the recorded user input of the next block
+ * in the current dialog and then returns the recorded event instead of
+ * waiting for the user. When the macro is finished, the dialogs wait for
+ * real user input again.
+ *
+ * Macros are played as fast as possible by default; with setSpeed(), the
+ * recorded timing is reproduced (or scaled). For each event, the player
+ * measures how long it took to set the user input and how long the
+ * application took until it asked for the next event (see steps()), so
+ * a recorded session can be used as a load test or benchmark.
+ *
+ *     YBinaryMacroPlayer * player = new YBinaryMacroPlayer();
+ *     YMacro::setPlayer( player );
+ *     YMacro::play( "/tmp/session.ymacro" );
+ *     ... run the application's event loop ...
+ *     player->logReport();
+ **/
+class YBinaryMacroPlayer: public YMacroPlayer
+{
+public:
+
+    /**
+     * Timing of one played event.
+     **/
+    struct Step
+    {
+	YEvent::EventType	eventType;
+	std::string		widgetId;	// or menu / key ID
+	int			properties;	// properties set before the event
+	double			applyTime;	// milliseconds to set them
+	double			latency;	// milliseconds until the next event was requested
+    };
+
+    /**
+     * Constructor.
+     **/
+    YBinaryMacroPlayer();
+
+    /**
+     * Destructor.
+     **/
+    virtual ~YBinaryMacroPlayer();
+
+    /**
+     * Set the replay speed: 0 (the default) plays the macro as fast as
+     * possible, 1.0 with the recorded timing, 2.0 twice as fast etc.
+     **/
+    void setSpeed( double speed ) { _speed = speed; }
+
+    /**
+     * Return the replay speed.
+     **/
+    double speed() const { return _speed; }
+
+    /**
+     * Play a macro from the specified macro file.
+     * Reimplemented from YMacroPlayer.
+     **/
+    virtual void play( const std::string & macroFile );
+
+    /**
+     * Set the user input of the next block in the current dialog and keep
+     * the event of that block for the next nextEvent() call.
+     * Reimplemented from YMacroPlayer.
+     **/
+    virtual void playNextBlock();
+
+    /**
+     * Return 'true' if a macro is currently being played.
+     * Reimplemented from YMacroPlayer.
+     **/
+    virtual bool playing() const;
+
+    /**
+     * Return the next recorded event for 'dialog' or 0 if the macro is
+     * finished.
+     * Reimplemented from YMacroPlayer.
+     **/
+    virtual YEvent * nextEvent( YDialog * dialog );
+
+    /**
+     * Stop playing the current macro.
+     **/
+    void stop();
+
+    /**
+     * Return the timing of the events played so far.
+     **/
+    const std::vector<Step> & steps() const { return _steps; }
+
+    /**
+     * Write a summary of the step timing to the log.
+     **/
+    void logReport() const;
+
+protected:
+
+    /**
+     * A recorded event.
+     **/
+    struct EventRecord
+    {
+	EventRecord(): eventType( YEvent::NoEvent ), reason( YEvent::Activated ) {}
+
+	YEvent::EventType	eventType;
+	YEvent::EventReason	reason;
+	std::string		id;		// widget / menu / special key ID
+	std::string		keySymbol;
+    };
+
+    /**
+     * Read records and apply them to 'dialog' until the next event.
+     **/
+    void playBlock( YDialog * dialog );
+
+    /**
+     * Read the next record and apply it to 'dialog'. Return 'false' at the
+     * end of the macro.
+     **/
+    bool playRecord( YDialog * dialog );
+
+    /**
+     * Read and apply a property record.
+     **/
+    void playPropertyRecord( YDialog * dialog );
+
+    /**
+     * Set the selected items of 'widget' to the items with 'labels'.
+     **/
+    void selectItems( YWidget *				widget,
+		      const std::string &		propertyName,
+		      const std::vector<std::string> &	labels );
+
+    /**
+     * Create an event from 'record' for 'dialog'.
+     **/
+    YEvent * createEvent( YDialog * dialog, const EventRecord & record );
+
+    /**
+     * Find the widget with ID 'id' in 'dialog'. Return 0 if there is none.
+     **/
+    YWidget * findWidget( YDialog * dialog, const std::string & id );
+
+    /**
+     * Wait for the recorded time of the current record if timing is
+     * reproduced.
+     **/
+    void waitRecordedTime( uint64_t microseconds );
+
+    /**
+     * Low-level reading. Errors set the fail bit of the file stream.
+     **/
+    unsigned char readByte();
+    uint64_t readVarint();
+    std::string readString();
+    std::string readStringRef();
+
+    /**
+     * Give up playing a broken macro file.
+     **/
+    void readError();
+
+private:
+
+    std::ifstream		_file;
+    std::vector<std::string>	_strings;
+    double			_speed;
+
+    bool			_havePendingEvent;
+    EventRecord			_pendingEvent;
+    int				_pendingProperties;
+    double			_pendingApplyTime;
+
+    std::vector<Step>		_steps;
+    double			_deliveryTime;	// of the last event; 0 if none
+};
+
+
+#endif // YBinaryMacroPlayer_h
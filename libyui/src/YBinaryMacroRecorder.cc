@@ -0,0 +1,296 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YBinaryMacroRecorder.cc
+
+/-*/
+
+
+#define YUILogComponent "ui"
+#include "YUILog.h"
+
+#include "YBinaryMacroRecorder.h"
+#include "YBinaryMacroFormat.h"
+#include "YDialog.h"
+#include "YEvent.h"
+#include "YCheckBox.h"
+#include "YComboBox.h"
+#include "YSelectionWidget.h"
+#include "YUIException.h"
+#include "YUITrace.h"
+#include "YWidgetID.h"
+
+using std::string;
+
+
+YBinaryMacroRecorder::YBinaryMacroRecorder()
+    : _lastTime( 0.0 )
+{
+}
+
+
+YBinaryMacroRecorder::~YBinaryMacroRecorder()
+{
+    endRecording();
+}
+
+
+void YBinaryMacroRecorder::record( const string & macroFileName )
+{
+    endRecording();
+
+    _file.open( macroFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+
+    if ( ! _file.is_open() )
+    {
+	yuiError() << "Can't open macro file " << macroFileName << endl;
+	return;
+    }
+
+    yuiMilestone() << "Recording macro to " << macroFileName << endl;
+
+    _strings.clear();
+    _lastTime = YUITrace::now();
+
+    _file.write( YBinaryMacro_Magic, sizeof( YBinaryMacro_Magic ) - 1 );
+    writeByte( YBinaryMacro_Version );
+}
+
+
+void YBinaryMacroRecorder::endRecording()
+{
+    if ( _file.is_open() )
+    {
+	yuiMilestone() << "Macro recording done" << endl;
+	_file.close();
+    }
+}
+
+
+bool YBinaryMacroRecorder::recording() const
+{
+    return _file.is_open();
+}
+
+
+void YBinaryMacroRecorder::recordWidgetProperty( YWidget *	widget,
+						 const char *	propertyName )
+{
+    if ( ! recording() || ! widget || ! propertyName )
+	return;
+
+    YPropertyValue val;
+
+    try
+    {
+	val = widget->getProperty( propertyName );
+    }
+    catch ( YUIException & exception )
+    {
+	YUI_CAUGHT( exception );
+	return;
+    }
+
+    YCheckBox *	       checkBox	       = 0;
+    YSelectionWidget * selectionWidget = 0;
+
+    if ( val.type() == YOtherProperty )
+    {
+	YComboBox * comboBox = dynamic_cast<YComboBox *>( widget );
+
+	if ( comboBox && string( propertyName ) == YUIProperty_Value )
+	    val = YPropertyValue( comboBox->value() );	// might be entered text
+	else if ( ! ( checkBox = dynamic_cast<YCheckBox *>( widget ) ) &&
+		  ! ( selectionWidget = dynamic_cast<YSelectionWidget *>( widget ) ) )
+	{
+	    yuiDebug() << "Can't record property " << propertyName << " of " << widget << endl;
+	    return;
+	}
+    }
+
+    writeRecordStart( YBinaryMacro_PropertyRecord );
+    writeWidgetId( widget );
+    writeStringRef( propertyName );
+
+    if ( checkBox )
+    {
+	writeByte( YBinaryMacro_CheckBoxValue );
+	writeByte( checkBox->value() );
+	return;
+    }
+
+    switch ( val.type() )
+    {
+	case YStringProperty:
+	    writeByte( YBinaryMacro_StringValue );
+	    writeString( val.stringVal() );
+	    break;
+
+	case YBoolProperty:
+	    writeByte( YBinaryMacro_BoolValue );
+	    writeByte( val.boolVal() ? 1 : 0 );
+	    break;
+
+	case YIntegerProperty:
+	{
+	    // zigzag encoding: small negative numbers stay small
+	    YInteger num = val.integerVal();
+	    writeByte( YBinaryMacro_IntegerValue );
+	    writeVarint( ( (uint64_t) num << 1 ) ^ (uint64_t) ( num >> 63 ) );
+	    break;
+	}
+
+	default:
+	{
+	    YItemCollection selectedItems = selectionWidget->selectedItems();
+	    writeByte( YBinaryMacro_ItemLabelsValue );
+	    writeVarint( selectedItems.size() );
+
+	    for ( YItem * item: selectedItems )
+		writeString( item->label() );
+
+	    break;
+	}
+    }
+}
+
+
+void YBinaryMacroRecorder::recordMakeScreenShot( bool enabled, const string & filename )
+{
+    if ( ! recording() )
+	return;
+
+    writeRecordStart( YBinaryMacro_ScreenShotRecord );
+    writeByte( enabled ? 1 : 0 );
+    writeString( filename );
+}
+
+
+void YBinaryMacroRecorder::recordEvent( YDialog * dialog, YEvent * event )
+{
+    if ( ! recording() || ! event )
+	return;
+
+    if ( dialog )
+	dialog->saveUserInput( this );
+
+    writeRecordStart( YBinaryMacro_EventRecord );
+    writeByte( event->eventType() );
+
+    switch ( event->eventType() )
+    {
+	case YEvent::WidgetEvent:
+	    writeWidgetId( event->widget() );
+	    writeByte( event->widgetEvent() ? event->widgetEvent()->reason() : YEvent::Activated );
+	    break;
+
+	case YEvent::MenuEvent:
+	{
+	    YMenuEvent * menuEvent = static_cast<YMenuEvent *>( event );
+
+	    // Events for menu items without an ID are replayed with the label as ID
+	    if ( menuEvent->id().empty() && menuEvent->item() )
+		writeString( menuEvent->item()->label() );
+	    else
+		writeString( menuEvent->id() );
+
+	    break;
+	}
+
+	case YEvent::KeyEvent:
+	{
+	    YKeyEvent * keyEvent = static_cast<YKeyEvent *>( event );
+	    writeString( keyEvent->keySymbol() );
+	    writeWidgetId( keyEvent->focusWidget() );
+	    break;
+	}
+
+	case YEvent::SpecialKeyEvent:
+	    writeString( static_cast<YSpecialKeyEvent *>( event )->id() );
+	    break;
+
+	default:
+	    break;
+    }
+
+    if ( ! _file.good() )
+    {
+	yuiError() << "Error writing macro file - recording stopped" << endl;
+	_file.close();
+    }
+}
+
+
+void YBinaryMacroRecorder::writeRecordStart( unsigned char recordType )
+{
+    double now = YUITrace::now();
+
+    writeByte( recordType );
+    writeVarint( (uint64_t) ( now - _lastTime ) );
+    _lastTime = now;
+}
+
+
+void YBinaryMacroRecorder::writeByte( unsigned char value )
+{
+    _file.put( (char) value );
+}
+
+
+void YBinaryMacroRecorder::writeVarint( uint64_t value )
+{
+    while ( value >= 0x80 )
+    {
+	writeByte( (unsigned char) ( value | 0x80 ) );
+	value >>= 7;
+    }
+
+    writeByte( (unsigned char) value );
+}
+
+
+void YBinaryMacroRecorder::writeString( const string & str )
+{
+    writeVarint( str.size() );
+    _file.write( str.data(), str.size() );
+}
+
+
+void YBinaryMacroRecorder::writeStringRef( const string & str )
+{
+    auto it = _strings.find( str );
+
+    if ( it != _strings.end() )
+    {
+	writeVarint( it->second );
+    }
+    else
+    {
+	uint64_t index = _strings.size() + 1;
+	_strings[ str ] = index;
+
+	writeVarint( 0 );
+	writeString( str );
+    }
+}
+
+
+void YBinaryMacroRecorder::writeWidgetId( YWidget * widget )
+{
+    writeStringRef( widget && widget->hasId() ? widget->id()->toString() : string() );
+}
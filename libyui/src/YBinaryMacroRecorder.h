@@ -0,0 +1,144 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YBinaryMacroRecorder.h
+
+/-*/
+
+#ifndef YBinaryMacroRecorder_h
+#define YBinaryMacroRecorder_h
+
+#include <stdint.h>
+#include <fstream>
+#include <unordered_map>
+
+#include "YMacroRecorder.h"
+
+
+/**
+ * Macro recorder that writes the compact binary format described in
+ * YBinaryMacroFormat.h: For each event that a dialog returns, the user
+ * input of all widgets with an ID in that dialog and then the event itself,
+ * each with a timestamp. Records are streamed to the file as they occur.
+ *
+ * Use it with YMacro:
+ *
+ *     YMacro::setRecorder( new YBinaryMacroRecorder() );
+ *     YMacro::record( "/tmp/session.ymacro" );
+ *     ...
+ *     YMacro::endRecording();
+ *
+ * Play the result with YBinaryMacroPlayer.
+ **/
+class YBinaryMacroRecorder: public YMacroRecorder
+{
+public:
+
+    /**
+     * Constructor.
+     **/
+    YBinaryMacroRecorder();
+
+    /**
+     * Destructor. This ends recording.
+     **/
+    virtual ~YBinaryMacroRecorder();
+
+    /**
+     * Start recording a macro to the specified file.
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual void record( const std::string & macroFileName );
+
+    /**
+     * End recording and close the current macro file (if there is any).
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual void endRecording();
+
+    /**
+     * Return 'true' if a macro is currently being recorded.
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual bool recording() const;
+
+    /**
+     * Record one widget property. Only string, boolean and integer
+     * properties and the values of check boxes and selection widgets can
+     * be recorded.
+     *
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual void recordWidgetProperty( YWidget *	widget,
+				       const char *	propertyName );
+
+    /**
+     * Record a request for a screen shot.
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual void recordMakeScreenShot( bool enabled = false,
+				       const std::string & filename = std::string() );
+
+    /**
+     * Record the user input of 'dialog' and then 'event'.
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual void recordEvent( YDialog * dialog, YEvent * event );
+
+protected:
+
+    /**
+     * Write the type and the timestamp of a new record.
+     **/
+    void writeRecordStart( unsigned char recordType );
+
+    /**
+     * Write a byte.
+     **/
+    void writeByte( unsigned char value );
+
+    /**
+     * Write an unsigned varint.
+     **/
+    void writeVarint( uint64_t value );
+
+    /**
+     * Write a string with its length.
+     **/
+    void writeString( const std::string & str );
+
+    /**
+     * Write a reference to an interned string, and the string itself if
+     * it is new.
+     **/
+    void writeStringRef( const std::string & str );
+
+    /**
+     * Write the ID of 'widget' as a string reference.
+     **/
+    void writeWidgetId( YWidget * widget );
+
+private:
+
+    std::ofstream				_file;
+    std::unordered_map<std::string, uint64_t>	_strings;
+    double					_lastTime;
+};
+
+
+#endif // YBinaryMacroRecorder_h
@@ -80,6 +80,7 @@ string YBusyIndicator::label()
 void YBusyIndicator::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -131,16 +132,16 @@ YBusyIndicator::propertySet()
 
 
 bool
-YBusyIndicator::setProperty( const string & propertyName, const YPropertyValue & val )
+YBusyIndicator::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Timeout	)	setTimeout( val.integerVal() );
-    else if ( propertyName == YUIProperty_Alive		)	setAlive( val.boolVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
+    if	    ( propertyId == YUIPropertyId_Timeout	)	setTimeout( val.integerVal() );
+    else if ( propertyId == YUIPropertyId_Alive		)	setAlive( val.boolVal() );
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -148,15 +149,15 @@ YBusyIndicator::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YBusyIndicator::getProperty( const string & propertyName )
+YBusyIndicator::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Timeout	)	return YPropertyValue( timeout() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_Alive		)	return YPropertyValue( alive() );
+    if	    ( propertyId == YUIPropertyId_Timeout	)	return YPropertyValue( timeout() );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
+    else if ( propertyId == YUIPropertyId_Alive		)	return YPropertyValue( alive() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
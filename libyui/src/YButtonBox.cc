@@ -140,6 +140,7 @@ void
 YButtonBox::setMargins( const YButtonBoxMargins & margins )
 {
     priv->margins = margins;
+    invalidatePreferredSize();
 }
 
 
@@ -384,7 +385,7 @@ YButtonBox::doLayout( int width, int height )
 
 	if ( ! equalSizeButtons )
 	{
-	    buttonWidth  = button->preferredWidth();
+	    buttonWidth  = button->cachedPreferredSize( YD_HORIZ );
 	    buttonWidth -= widthLoss;
 	}
 
@@ -534,7 +535,7 @@ YButtonBox::maxChildSize( YUIDimension dim ) const
 	  it != childrenEnd();
 	  ++it )
     {
-	maxSize = std::max( maxSize, (*it)->preferredSize( dim ) );
+	maxSize = std::max( maxSize, (*it)->cachedPreferredSize( dim ) );
     }
 
     return maxSize;
@@ -550,7 +551,7 @@ YButtonBox::totalChildrenWidth() const
 	  it != childrenEnd();
 	  ++it )
     {
-	totalWidth += (*it)->preferredWidth();
+	totalWidth += (*it)->cachedPreferredSize( YD_HORIZ );
     }
 
     return totalWidth;
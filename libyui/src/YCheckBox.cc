@@ -61,6 +61,7 @@ YCheckBox::~YCheckBox()
 void YCheckBox::setLabel( const string & newLabel )
 {
     priv->label = newLabel;
+    labelChanged();
 }
 
 
@@ -79,6 +80,7 @@ bool YCheckBox::useBoldFont() const
 void YCheckBox::setUseBoldFont( bool bold )
 {
     priv->useBoldFont = bold;
+    invalidatePreferredSize();
 }
 
 
@@ -104,15 +106,15 @@ YCheckBox::propertySet()
 
 
 bool
-YCheckBox::setProperty( const string & propertyName, const YPropertyValue & val )
+YCheckBox::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if      ( propertyName == YUIProperty_Value )	return false; // need special processing
-    else if ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
+    if      ( propertyId == YUIPropertyId_Value )	return false; // need special processing
+    else if ( propertyId == YUIPropertyId_Label )	setLabel( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -120,14 +122,14 @@ YCheckBox::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YCheckBox::getProperty( const string & propertyName )
+YCheckBox::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if      ( propertyName == YUIProperty_Value )	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
+    if      ( propertyId == YUIPropertyId_Value )	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Label )	return YPropertyValue( label() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
@@ -155,8 +155,8 @@ public:
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setPropertyById( YPropertyId	         propertyId,
+				  const YPropertyValue & val );
 
     /**
      * Get a property.
@@ -165,7 +165,7 @@ public:
      * This method may throw exceptions, for example
      *   - if there is no property with that name
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getPropertyById( YPropertyId propertyId );
 
     /**
      * Return this class's property set.
@@ -197,6 +197,16 @@ public:
     const char * userInputProperty() { return YUIProperty_Value; }
 
 
+protected:
+
+    /**
+     * Return value() as an integer property value.
+     *
+     * Reimplemented from YWidget.
+     **/
+    virtual YPropertyValue userInputValue() { return YPropertyValue( (int) value() ); }
+
+
 private:
 
     ImplPtr<YCheckBoxPrivate> priv;
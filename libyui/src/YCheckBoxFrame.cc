@@ -73,6 +73,7 @@ string YCheckBoxFrame::label() const
 void YCheckBoxFrame::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -137,15 +138,15 @@ YCheckBoxFrame::propertySet()
 
 
 bool
-YCheckBoxFrame::setProperty( const string & propertyName, const YPropertyValue & val )
+YCheckBoxFrame::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if      ( propertyName == YUIProperty_Value )	setValue( val.boolVal() );
-    else if ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
+    if      ( propertyId == YUIPropertyId_Value )	setValue( val.boolVal() );
+    else if ( propertyId == YUIPropertyId_Label )	setLabel( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -153,14 +154,14 @@ YCheckBoxFrame::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YCheckBoxFrame::getProperty( const string & propertyName )
+YCheckBoxFrame::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if      ( propertyName == YUIProperty_Value )	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
+    if      ( propertyId == YUIPropertyId_Value )	return YPropertyValue( value() );
+    else if ( propertyId == YUIPropertyId_Label )	return YPropertyValue( label() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
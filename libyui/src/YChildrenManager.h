@@ -27,14 +27,19 @@
 
 #include <list>
 #include <algorithm>
+#include <iterator>
 #include "YUIException.h"
 
 
 /**
  * Abstract base template class for children management, such as child
  * widgets.
+ *
+ * The children are stored in a std::list by default. 'List' can be a
+ * std::vector instead for children that are iterated over much more often
+ * than they are removed (see YWidgetList).
  **/
-template<class T> class YChildrenManager
+template<class T, class List = std::list<T *> > class YChildrenManager
 {
 public:
 
@@ -53,7 +58,7 @@ public:
     virtual ~YChildrenManager() {}
 
 
-    typedef std::list<T *> ChildrenList;
+    typedef List ChildrenList;
 
     /**
      * Check if there are any children.
@@ -131,9 +136,39 @@ public:
     /**
      * Remove a child. This only removes the child from the children manager's
      * list; it does not delete it.
+     *
+     * This has to search the child; use erase() if its position is known.
      **/
     virtual void remove( T * child )
-	{ _children.remove( child ); }
+    {
+	// Search from the end: The child to remove is most often the last one
+	// (e.g. the only child of a replace point).
+
+	typename ChildrenList::reverse_iterator it =
+	    std::find( _children.rbegin(), _children.rend(), child );
+
+	if ( it != _children.rend() )
+	    _children.erase( std::next( it ).base() );
+    }
+
+    /**
+     * Remove the child at 'pos'. This only removes the child from the
+     * children manager's list; it does not delete it.
+     **/
+    void erase( typename ChildrenList::iterator pos )
+	{ _children.erase( pos ); }
+
+    /**
+     * Remove all children and return them. This only removes the children
+     * from the children manager's list; it does not delete them.
+     **/
+    ChildrenList takeAll()
+    {
+	ChildrenList children;
+	children.swap( _children );
+
+	return children;
+    }
 
     /**
      * Remove all children. This only removes the children from the children
@@ -149,7 +184,7 @@ public:
      **/
     bool contains( T * child ) const
     {
-	return ( find( _children.begin(), _children.end(), child )
+	return ( std::find( _children.begin(), _children.end(), child )
 		 != _children.end() );
     }
 
@@ -170,12 +205,13 @@ protected:
  * Children manager that can handle one single child (rejecting any more).
  * Useful for YAlignment, YFrame etc.
  **/
-template<class T> class YSingleChildManager: public YChildrenManager<T>
+template<class T, class List = std::list<T *> >
+class YSingleChildManager: public YChildrenManager<T, List>
 {
 public:
 
     YSingleChildManager( T * containerParent )
-	: YChildrenManager<T>( containerParent )
+	: YChildrenManager<T, List>( containerParent )
 	{}
 
     /**
@@ -211,14 +247,15 @@ public:
  * Useful for widget classes that can't handle children such as YPushButton,
  * YSelectionBox etc.
  **/
-template<class T> class YChildrenRejector: public YChildrenManager<T>
+template<class T, class List = std::list<T *> >
+class YChildrenRejector: public YChildrenManager<T, List>
 {
 public:
     /**
      * Constructor.
      **/
     YChildrenRejector( T * containerParent )
-	: YChildrenManager<T>( containerParent )
+	: YChildrenManager<T, List>( containerParent )
 	{}
 
     /**
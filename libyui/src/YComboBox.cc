@@ -90,6 +90,7 @@ int YComboBox::inputMaxLength() const
 void YComboBox::setInputMaxLength( int len )
 {
     priv->inputMaxLength = len;
+    invalidatePreferredSize();
 }
 
 
@@ -199,19 +200,19 @@ YComboBox::propertySet()
 
 
 bool
-YComboBox::setProperty( const string & propertyName, const YPropertyValue & val )
+YComboBox::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Need special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_ValidChars	)	setValidChars( val.stringVal() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	setInputMaxLength( val.integerVal() );
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return false; // Need special handling
+    else if ( propertyId == YUIPropertyId_Items 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_ValidChars	)	setValidChars( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_InputMaxLength )	setInputMaxLength( val.integerVal() );
+    else if ( propertyId == YUIPropertyId_IconPath 	)	setIconBasePath( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -219,18 +220,18 @@ YComboBox::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YComboBox::getProperty( const string & propertyName )
+YComboBox::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_ValidChars	)	return YPropertyValue( validChars() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	return YPropertyValue( inputMaxLength() );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Items 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
+    else if ( propertyId == YUIPropertyId_ValidChars	)	return YPropertyValue( validChars() );
+    else if ( propertyId == YUIPropertyId_InputMaxLength )	return YPropertyValue( inputMaxLength() );
+    else if ( propertyId == YUIPropertyId_IconPath	)	return YPropertyValue( iconBasePath() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
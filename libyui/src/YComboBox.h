@@ -185,8 +185,8 @@ public:
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setPropertyById( YPropertyId	         propertyId,
+				  const YPropertyValue & val );
 
     /**
      * Get a property.
@@ -194,7 +194,7 @@ public:
      *
      * This method may throw YUIPropertyExceptions.
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getPropertyById( YPropertyId propertyId );
 
     /**
      * Return this class's property set.
@@ -233,6 +233,13 @@ protected:
      **/
     virtual void setText( const std::string & newText ) = 0;
 
+    /**
+     * Return value() as a string property value.
+     *
+     * Reimplemented from YWidget.
+     **/
+    virtual YPropertyValue userInputValue() { return YPropertyValue( value() ); }
+
 
 private:
 
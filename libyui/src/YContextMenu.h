@@ -93,6 +93,9 @@ public:
      **/
     virtual void addItems( const YItemCollection & itemCollection );
 
+    // Don't hide the overload that takes ownership of the items
+    using YSelectionWidget::addItems;
+
     /**
      * Add one item. This widget assumes ownership of the item object and will
      * delete it in its destructor.
@@ -131,8 +134,8 @@ public:
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setPropertyById( YPropertyId	         propertyId,
+				  const YPropertyValue & val );
 
     /**
      * Get a property.
@@ -140,7 +143,7 @@ public:
      *
      * This method may throw YUIPropertyExceptions.
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getPropertyById( YPropertyId propertyId );
 
     /**
      * Return this class's property set.
@@ -32,16 +32,44 @@
 #include "YPushButton.h"
 #include "YUI.h"
 #include "YEventFilter.h"
+#include "YDialogListener.h"
+#include "YWidgetID.h"
+#include "YUITrace.h"
+#include "YUILoader.h"
+#include "YMacro.h"
+#include "YMacroPlayer.h"
+#include "YMacroRecorder.h"
+
+#include <map>
+#include <unordered_map>
+#include <algorithm>
 
 #define VERBOSE_DIALOGS			0
 #define VERBOSE_DISCARDED_EVENTS	0
 #define VERBOSE_EVENTS			0
 
 typedef std::list<YEventFilter *> YEventFilterList;
+typedef std::unordered_multimap<std::string, YWidget *> YWidgetIdIndex;
 
 using std::string;
 
 
+// Nesting depth of YDialog::ChangeBatch instances
+static int changeBatchDepth = 0;
+
+// Dialogs that need a layout pass at the end of the outermost ChangeBatch
+static std::vector<YDialog *> pendingLayoutDialogs;
+
+// All existing ChangeBatch instances
+static std::vector<YDialog::ChangeBatch *> changeBatches;
+
+// The last modification generation of any dialog
+static unsigned long lastModificationGeneration = 0;
+
+// Listeners notified about all dialogs
+static std::vector<YDialogListener *> dialogListeners;
+
+
 struct YDialogPrivate
 {
     YDialogPrivate( YDialogType dialogType, YDialogColorMode colorMode )
@@ -53,6 +81,10 @@ struct YDialogPrivate
         , multiPassLayout( false )
         , layoutPass( 0 )
 	, lastEvent( 0 )
+	, shortcutManager( 0 )
+	, modificationGeneration( ++lastModificationGeneration )
+	, structureGeneration( modificationGeneration )
+	, labelGeneration( modificationGeneration )
 	{}
 
     YDialogType		dialogType;
@@ -64,6 +96,15 @@ struct YDialogPrivate
     int                 layoutPass;
     YEvent *		lastEvent;
     YEventFilterList	eventFilterList;
+    YWidgetIdIndex	widgetIdIndex;
+    YShortcutManager *	shortcutManager;
+    unsigned long	modificationGeneration;
+    unsigned long	structureGeneration;
+    unsigned long	labelGeneration;
+
+    // The widgets changed since the last structure change by their change
+    // generation (each widget only with its last change)
+    std::map<unsigned long, YWidget *> changedWidgets;
 };
 
 
@@ -168,17 +209,42 @@ YDialog::~YDialog()
     // the event filters are deleted to prevent duplicate event filter deletion
     // from (a) child widget destructors and (b) here.
     deleteChildren();
+    delete priv->shortcutManager;
 
     // Delete the remaining event filters: Those installed by this dialog and
     // those installed by some child widget that are not deleted yet.
     deleteEventFilters();
 
+    if ( changeBatchDepth > 0 )
+    {
+	pendingLayoutDialogs.erase( std::remove( pendingLayoutDialogs.begin(),
+						 pendingLayoutDialogs.end(),
+						 this ),
+				    pendingLayoutDialogs.end() );
+
+	for ( ChangeBatch * batch: changeBatches )
+	{
+	    if ( batch->_dialog == this )
+		batch->_dialog = 0;
+	}
+    }
+
     if ( ! _dialogStack.empty() && _dialogStack.top() == this )
     {
 	_dialogStack.pop();
 
 	if ( ! _dialogStack.empty() )
+	{
+	    // Clients of the dialog below see a different dialog now
+	    _dialogStack.top()->markModified( true );
 	    _dialogStack.top()->activate();
+	}
+
+	if ( priv->isOpen )
+	{
+	    for ( YDialogListener * listener: dialogListeners )
+		listener->dialogClosed( this );
+	}
     }
     else
 	yuiError() << "Not top of dialog stack: " << this << endl;
@@ -196,6 +262,16 @@ YDialog::open()
     openInternal();	// Make sure this is only called once!
 
     priv->isOpen = true;
+
+    // Take the initial snapshot of the input values; the structure change
+    // below covers them
+    detectInputChanges();
+    markModified( true );
+
+    for ( YDialogListener * listener: dialogListeners )
+	listener->dialogOpened( this );
+
+    YUILoader::startPluginPreload();
 }
 
 
@@ -310,15 +386,39 @@ YDialog::checkShortcuts( bool force )
     }
     else
     {
+	// Keep the shortcut manager: After the first complete check, it only
+	// needs to check the widgets that changed since the last check.
+
+	if ( ! priv->shortcutManager )
+	{
+	    priv->shortcutManager = new YShortcutManager( this );
+	    YUI_CHECK_NEW( priv->shortcutManager );
+	}
 
-	YShortcutManager shortcutManager( this );
-	shortcutManager.checkShortcuts();
+	YUI_TRACE_SPAN( "checkShortcuts" );
+	priv->shortcutManager->updateShortcuts();
 
 	priv->shortcutCheckPostponed = false;
     }
 }
 
 
+void
+YDialog::invalidateShortcuts( YWidget * widget )
+{
+    if ( priv->shortcutManager )
+	priv->shortcutManager->widgetChanged( widget );
+}
+
+
+void
+YDialog::removeShortcuts( YWidget * widget )
+{
+    if ( priv->shortcutManager )
+	priv->shortcutManager->widgetRemoved( widget );
+}
+
+
 YPushButton *
 YDialog::defaultButton() const
 {
@@ -355,24 +455,94 @@ YDialog::setInitialSize()
 void
 YDialog::recalcLayout()
 {
+    if ( changeBatchDepth > 0 )
+    {
+	if ( std::find( pendingLayoutDialogs.begin(),
+			pendingLayoutDialogs.end(),
+			this ) == pendingLayoutDialogs.end() )
+	{
+	    pendingLayoutDialogs.push_back( this );
+	}
+
+	return;
+    }
+
     yuiDebug() << "Recalculating layout for " << this << endl;
     doLayout();
 }
 
 
+YDialog::ChangeBatch::ChangeBatch()
+    : _dialog( YDialog::currentDialog( false ) )
+{
+    changeBatchDepth++;
+    changeBatches.push_back( this );
+
+    if ( _dialog )
+	_dialog->startMultipleChanges();
+}
+
+
+YDialog::ChangeBatch::~ChangeBatch()
+{
+    changeBatches.erase( std::remove( changeBatches.begin(), changeBatches.end(), this ),
+			 changeBatches.end() );
+
+    if ( --changeBatchDepth == 0 )
+    {
+	std::vector<YDialog *> dialogs;
+	dialogs.swap( pendingLayoutDialogs );
+
+	for ( YDialog * dialog: dialogs )
+	{
+	    try
+	    {
+		yuiDebug() << "Recalculating layout for " << dialog << " after batch" << endl;
+		dialog->doLayout();
+	    }
+	    catch ( YUIException & exception )
+	    {
+		YUI_CAUGHT( exception );
+	    }
+	}
+    }
+
+    if ( _dialog )
+    {
+	YUI_TRACE_SPAN( "doneMultipleChanges" );
+	_dialog->doneMultipleChanges();
+    }
+}
+
+
 void
 YDialog::doLayout()
 {
-    priv->layoutPass = 1;
-    setSize( preferredWidth(), preferredHeight() );
+    // Widgets that requested multiple layout passes calculate their preferred
+    // size depending on the size they got in the previous pass, so the cached
+    // preferred sizes cannot be reused across passes in that case.
+
+    YUI_TRACE_SPAN( "doLayout" );
+
+    if ( priv->multiPassLayout )
+        YWidget::invalidateAllPreferredSizes();
+
+    {
+        YUI_TRACE_SPAN( "layoutPass 1" );
+        priv->layoutPass = 1;
+        setSize( preferredWidth(), preferredHeight() );
+    }
 
     if ( priv->multiPassLayout )
     {
+        YUI_TRACE_SPAN( "layoutPass 2" );
+        YWidget::invalidateAllPreferredSizes();
         priv->layoutPass = 2;
         setSize( preferredWidth(), preferredHeight() );
     }
 
     priv->layoutPass = 0;
+    markModified();
 }
 
 
@@ -386,6 +556,8 @@ YDialog::layoutPass() const
 YEvent *
 YDialog::waitForEvent( int timeout_millisec )
 {
+    YUI_TRACE_SPAN( "waitForEvent" );
+
     if ( ! isTopmostDialog() )
 	YUI_THROW( YUIDialogStackingOrderException() );
 
@@ -403,12 +575,23 @@ YDialog::waitForEvent( int timeout_millisec )
 	checkShortcuts( true );
     }
 
+    for ( YDialogListener * listener: dialogListeners )
+	listener->waitingForEvent( this );
+
     deleteEvent( priv->lastEvent );
     YEvent * event = 0;
 
     do
     {
-	event = filterInvalidEvents( waitForEventInternal( timeout_millisec ) );
+	event = YMacro::playing() ? YMacro::player()->nextEvent( this ) : 0;
+
+	if ( ! event )
+	{
+	    YUI_TRACE_SPAN( "waitForEventInternal" );
+	    event = waitForEventInternal( timeout_millisec );
+	}
+
+	event = filterInvalidEvents( event );
 	event = callEventFilters( event );
 
 	// If there was no event, if filterInvalidEvents() discarded an invalid
@@ -417,6 +600,15 @@ YDialog::waitForEvent( int timeout_millisec )
 
     } while ( ! event );
 
+    if ( YMacro::recording() )
+	YMacro::recorder()->recordEvent( this, event );
+
+    // The user might have changed input values before this event
+    detectInputChanges();
+
+    for ( YDialogListener * listener: dialogListeners )
+	listener->eventReturned( this, event );
+
     priv->lastEvent = event;
 
     return event;
@@ -426,17 +618,38 @@ YDialog::waitForEvent( int timeout_millisec )
 YEvent *
 YDialog::pollEvent()
 {
+    YUI_TRACE_SPAN( "pollEvent" );
+
     if ( ! isTopmostDialog() )
 	YUI_THROW( YUIDialogStackingOrderException() );
 
     if ( ! isOpen() )
 	open();
 
-    YEvent * event = filterInvalidEvents( pollEventInternal() );
+    for ( YDialogListener * listener: dialogListeners )
+	listener->waitingForEvent( this );
+
+    YEvent * event = YMacro::playing() ? YMacro::player()->nextEvent( this ) : 0;
+
+    if ( ! event )
+	event = pollEventInternal();
+
+    event = filterInvalidEvents( event );
 
     if ( event ) // Optimization (calling with 0 wouldn't hurt)
 	event = callEventFilters( event );
 
+    if ( event && YMacro::recording() )
+	YMacro::recorder()->recordEvent( this, event );
+
+    if ( event )
+    {
+	detectInputChanges();
+
+	for ( YDialogListener * listener: dialogListeners )
+	    listener->eventReturned( this, event );
+    }
+
     priv->lastEvent = event;
 
     // Nevermind if filterInvalidEvents() discarded an invalid event.
@@ -454,7 +667,7 @@ YDialog::filterInvalidEvents( YEvent * event )
     if ( ! event )
 	return 0;
 
-    YWidgetEvent * widgetEvent = dynamic_cast<YWidgetEvent *> (event);
+    YWidgetEvent * widgetEvent = event->widgetEvent();
 
     if ( widgetEvent && widgetEvent->widget() )
     {
@@ -549,6 +762,24 @@ YDialog::currentDialog( bool doThrow )
 }
 
 
+void
+YDialog::addListener( YDialogListener * listener )
+{
+    if ( std::find( dialogListeners.begin(), dialogListeners.end(), listener ) == dialogListeners.end() )
+	dialogListeners.push_back( listener );
+}
+
+
+void
+YDialog::removeListener( YDialogListener * listener )
+{
+    dialogListeners.erase( std::remove( dialogListeners.begin(),
+					dialogListeners.end(),
+					listener ),
+			   dialogListeners.end() );
+}
+
+
 bool
 YDialog::deleteTopmostDialog( bool doThrow )
 {
@@ -638,9 +869,186 @@ YDialog::removeEventFilter( YEventFilter * eventFilter )
 }
 
 
+void
+YDialog::registerWidgetId( YWidget * widget )
+{
+    if ( ! widget || ! widget->hasId() )
+	return;
+
+    unregisterWidgetId( widget ); // Prevent duplicate entries
+    priv->widgetIdIndex.emplace( widget->id()->toString(), widget );
+}
+
+
+void
+YDialog::unregisterWidgetId( YWidget * widget )
+{
+    if ( ! widget || ! widget->hasId() )
+	return;
+
+    auto range = priv->widgetIdIndex.equal_range( widget->id()->toString() );
+
+    for ( auto it = range.first; it != range.second; ++it )
+    {
+	if ( it->second == widget )
+	{
+	    priv->widgetIdIndex.erase( it );
+	    return;
+	}
+    }
+}
+
+
+unsigned long
+YDialog::modificationGeneration() const
+{
+    return priv->modificationGeneration;
+}
+
+
+unsigned long
+YDialog::structureGeneration() const
+{
+    return priv->structureGeneration;
+}
+
+
+unsigned long
+YDialog::labelGeneration() const
+{
+    return priv->labelGeneration;
+}
+
+
+unsigned long
+YDialog::markModified( bool structureChanged )
+{
+    priv->modificationGeneration = ++lastModificationGeneration;
+
+    if ( structureChanged )
+    {
+	// Changes of single widgets don't matter anymore, this also drops
+	// all widgets that are deleted
+	priv->structureGeneration = priv->modificationGeneration;
+	priv->labelGeneration	  = priv->modificationGeneration;
+	priv->changedWidgets.clear();
+    }
+
+    return priv->modificationGeneration;
+}
+
+
+void
+YDialog::markLabelChanged()
+{
+    priv->labelGeneration = markModified();
+}
+
+
+unsigned long
+YDialog::registerChange( YWidget * widget )
+{
+    auto it = priv->changedWidgets.find( widget->changeGeneration() );
+
+    if ( it != priv->changedWidgets.end() && it->second == widget )
+	priv->changedWidgets.erase( it );
+
+    unsigned long generation = markModified();
+    priv->changedWidgets.emplace_hint( priv->changedWidgets.end(), generation, widget );
+
+    return generation;
+}
+
+
+std::vector<YWidget *>
+YDialog::changedWidgets( unsigned long since ) const
+{
+    std::vector<YWidget *> result;
+
+    for ( auto it = priv->changedWidgets.upper_bound( since ); it != priv->changedWidgets.end(); ++it )
+	result.push_back( it->second );
+
+    return result;
+}
+
+
+/**
+ * Detect the user input changes of 'widget' and all its descendants.
+ **/
+static bool detectInputChanges( YWidget * widget )
+{
+    bool changed = widget->detectInputChange();
+
+    for ( YWidget * child: *widget )
+    {
+	if ( detectInputChanges( child ) )
+	    changed = true;
+    }
+
+    return changed;
+}
+
+
+bool
+YDialog::detectInputChanges()
+{
+    return ::detectInputChanges( this );
+}
+
+
+bool
+YDialog::findIndexedWidget( YWidgetID *	    id,
+			    const YWidget * ancestor,
+			    YWidget *&	    result ) const
+{
+    result = 0;
+
+    if ( ! id )
+	return false;
+
+    auto range = priv->widgetIdIndex.equal_range( id->toString() );
+
+    for ( auto it = range.first; it != range.second; ++it )
+    {
+	YWidget * candidate = it->second;
+
+	if ( ! candidate->isValid() || ! candidate->id()->isEqual( id ) )
+	    continue;
+
+	// Only descendants of 'ancestor' count
+
+	YWidget * parent = candidate->parent();
+
+	while ( parent && parent != ancestor )
+	    parent = parent->parent();
+
+	if ( ! parent )
+	    continue;
+
+	if ( result )
+	{
+	    // More than one match: Only a tree walk can tell which one
+	    // comes first.
+
+	    result = 0;
+	    return false;
+	}
+
+	result = candidate;
+    }
+
+    return true;
+}
+
+
 YEvent *
 YDialog::callEventFilters( YEvent * event )
 {
+    if ( priv->eventFilterList.empty() )
+	return event;
+
+    YUI_TRACE_SPAN( "callEventFilters" );
+
     YEventFilterList::const_iterator it = priv->eventFilterList.begin();
 
     while ( it != priv->eventFilterList.end() && event )
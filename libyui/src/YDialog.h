@@ -29,12 +29,14 @@
 #include "YSingleChildContainerWidget.h"
 #include <stack>
 #include <map>
+#include <vector>
 
 class YShortcutManager;
 class YPushButton;
 class YDialogPrivate;
 class YEvent;
 class YEventFilter;
+class YDialogListener;
 
 // See YTypes.h for enum YDialogType and enum YDialogColorMode
 
@@ -222,6 +224,17 @@ public:
     static YDialog * topmostDialog( bool doThrow = true )
 	{ return currentDialog( doThrow ); }
 
+    /**
+     * Register a listener that is notified about all dialogs.
+     * The caller keeps the ownership. See YDialogListener.
+     **/
+    static void addListener( YDialogListener * listener );
+
+    /**
+     * Unregister a listener. This does not delete it.
+     **/
+    static void removeListener( YDialogListener * listener );
+
     /**
      * Set the initial dialog size, depending on dialogType:
      * YMainDialog dialogs get the UI's "default main window" size,
@@ -240,9 +253,37 @@ public:
      *
      * The basic idea behind this function is to call it when the dialog
      * changed after it (and its children hierarchy) was initially created.
+     *
+     * Inside a ChangeBatch, this only marks the dialog for a layout pass
+     * at the end of the batch.
      **/
     void recalcLayout();
 
+    /**
+     * Helper class to apply many changes to dialogs in one go:
+     *
+     * While an instance of this class exists, recalcLayout() only marks the
+     * dialog, and each marked dialog gets exactly one layout pass when the
+     * outermost ChangeBatch goes out of scope. The current dialog also gets
+     * startMultipleChanges() and doneMultipleChanges(), so the UI can update
+     * the screen just once.
+     *
+     * Batches can be nested. Don't wait for user input inside a batch.
+     **/
+    class ChangeBatch
+    {
+    public:
+	ChangeBatch();
+	~ChangeBatch();
+
+    private:
+	ChangeBatch( const ChangeBatch & ); // no copy
+	void operator=( const ChangeBatch & );  // no assign
+
+	friend class YDialog;
+	YDialog * _dialog;
+    };
+
     /**
      * Return this dialog's type (YMainDialog / YPopupDialog /YWizardDialog).
      **/
@@ -261,7 +302,8 @@ public:
 
     /**
      * Checks the keyboard shortcuts of widgets in this dialog unless shortcut
-     * checks are postponed or 'force' is 'true'.
+     * checks are postponed or 'force' is 'true'. After the first check, only
+     * widgets that were added, removed or relabelled since are checked.
      *
      * A forced shortcut check resets postponed checking.
      **/
@@ -279,6 +321,27 @@ public:
      **/
     bool shortcutCheckPostponed() const;
 
+    /**
+     * Notify this dialog's keyboard shortcut manager that 'widget' was added
+     * or that its shortcut string (or the items of a selection widget)
+     * changed, so the next shortcut check includes it.
+     *
+     * Notice that applications never need to call this function:
+     * YWidget::addChild() and the widgets' setLabel() methods do it
+     * automatically.
+     **/
+    void invalidateShortcuts( YWidget * widget );
+
+    /**
+     * Notify this dialog's keyboard shortcut manager that 'widget' is
+     * removed from this dialog.
+     *
+     * Notice that applications never need to call this function:
+     * YWidget::removeChild() and the YWidget destructor do it
+     * automatically.
+     **/
+    void removeShortcuts( YWidget * widget );
+
     /**
      * Return this dialog's default button: The button that is activated when
      * the user hits [Return] anywhere in this dialog. Note that this is not
@@ -320,6 +383,117 @@ public:
      **/
     void removeEventFilter( YEventFilter * eventFilter );
 
+    /**
+     * Add a widget to this dialog's widget ID index. The widget has to have
+     * an ID; widgets without an ID are ignored.
+     *
+     * Notice that applications never need to call this function:
+     * YWidget::setId() and YWidget::addChild() do it automatically.
+     **/
+    void registerWidgetId( YWidget * widget );
+
+    /**
+     * Remove a widget from this dialog's widget ID index. This has to be
+     * called before the widget's ID is changed or deleted.
+     *
+     * Notice that applications never need to call this function:
+     * YWidget::setId(), YWidget::removeChild() and the YWidget destructor
+     * do it automatically.
+     **/
+    void unregisterWidgetId( YWidget * widget );
+
+    /**
+     * Look up a widget with the specified ID in this dialog's widget ID
+     * index. Only descendants of 'ancestor' (not 'ancestor' itself) are
+     * considered.
+     *
+     * Returns 'true' if the index could answer the query; in that case
+     * 'result' is set to the widget found or to 0 if there is none.
+     * Returns 'false' if the index cannot answer it unambiguously, e.g. if
+     * several widgets below 'ancestor' have that ID. The caller then has to
+     * walk the widget tree.
+     **/
+    bool findIndexedWidget( YWidgetID *	     id,
+			    const YWidget *  ancestor,
+			    YWidget *&	     result ) const;
+
+    /**
+     * Return this dialog's modification generation: A number that changes
+     * whenever anything in this dialog changes: Widgets are added or
+     * removed, a widget is marked as changed (see YWidget::markChanged()),
+     * the dialog is opened, laid out or becomes the topmost dialog again.
+     * This is meant for caches of information about the widget tree and
+     * for clients that poll the dialog: Nothing changed as long as the
+     * generation is the same.
+     *
+     * Generations are unique and increasing across all dialogs, so a dialog
+     * that is created at the address of a deleted one never has an old
+     * generation.
+     **/
+    unsigned long modificationGeneration() const;
+
+    /**
+     * Return the modification generation of the last structure change of
+     * this dialog: Widgets were added or removed, or the dialog was opened
+     * or became the topmost dialog again. changedWidgets() can only tell
+     * changes after that.
+     **/
+    unsigned long structureGeneration() const;
+
+    /**
+     * Return the modification generation of the last change of a widget ID
+     * or label in this dialog, or of the last structure change if that is
+     * newer. Caches that find widgets by their ID or label only need to be
+     * rebuilt when this changes.
+     **/
+    unsigned long labelGeneration() const;
+
+    /**
+     * Start a new modification generation for this dialog and return it.
+     * 'structureChanged' starts a new structure generation, too.
+     *
+     * Notice that applications never need to call this function: YWidget
+     * and YDialog do it automatically.
+     **/
+    unsigned long markModified( bool structureChanged = false );
+
+    /**
+     * Record a change of 'widget' and return the new modification
+     * generation that becomes its change generation.
+     *
+     * Notice that applications never need to call this function:
+     * YWidget::markChanged() does it.
+     **/
+    unsigned long registerChange( YWidget * widget );
+
+    /**
+     * Record that the ID or the label of a widget changed: Start a new
+     * modification generation that becomes the label generation.
+     *
+     * Notice that applications never need to call this function:
+     * YWidget::markLabelChanged() does it.
+     **/
+    void markLabelChanged();
+
+    /**
+     * Return the widgets of this dialog that changed after the modification
+     * generation 'since', in the order of their last change. This is only
+     * complete if 'since' is not older than structureGeneration().
+     **/
+    std::vector<YWidget *> changedWidgets( unsigned long since ) const;
+
+    /**
+     * Mark the widgets whose user input value changed since the last call
+     * as changed (see YWidget::detectInputChange()). Those values might
+     * change in the UI backend without notice. The dialog does this when it
+     * is opened and before it returns an event to the application; code
+     * that changes them from the outside (e.g. simulated user input) has to
+     * call it afterwards.
+     *
+     * Returns 'true' if any value changed.
+     **/
+    bool detectInputChanges();
+
     /**
      * Highlight a child widget of this dialog. This is meant for debugging:
      * YDialogSpy and similar uses.
@@ -0,0 +1,87 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YDialogListener.h
+
+/-*/
+
+#ifndef YDialogListener_h
+#define YDialogListener_h
+
+
+class YDialog;
+class YEvent;
+
+
+/**
+ * Abstract base class for observers of the dialog stack, e.g. for pushing
+ * notifications to remote clients.
+ *
+ * Unlike YEventFilter, a listener is not bound to one dialog: It is
+ * registered globally with YDialog::addListener() and it is notified for
+ * all dialogs. It cannot change events. The caller keeps the ownership of
+ * the listener and has to remove it with YDialog::removeListener() before
+ * deleting it.
+ *
+ * Widget changes are not reported one by one: waitingForEvent() is called
+ * whenever a dialog starts waiting for (or polling) events, a listener can
+ * collect the changes since its last call with
+ * YDialog::modificationGeneration() and YDialog::changedWidgets(). Values
+ * that the user changed in the UI are detected before eventReturned() (see
+ * YDialog::detectInputChanges()).
+ **/
+class YDialogListener
+{
+public:
+    /**
+     * Constructor.
+     **/
+    YDialogListener() {}
+
+    /**
+     * Destructor.
+     **/
+    virtual ~YDialogListener() {}
+
+    /**
+     * Called when 'dialog' was opened. It is the topmost dialog now.
+     **/
+    virtual void dialogOpened( YDialog * dialog ) {}
+
+    /**
+     * Called at the end of the destructor of an open dialog after it was
+     * removed from the dialog stack. 'dialog' may only be used to
+     * identify it, YDialog::topmostDialog() is the dialog below it (if
+     * there is any).
+     **/
+    virtual void dialogClosed( YDialog * dialog ) {}
+
+    /**
+     * Called when 'dialog' starts waiting for or polling events.
+     **/
+    virtual void waitingForEvent( YDialog * dialog ) {}
+
+    /**
+     * Called with each event that 'dialog' returns to the application
+     * after the event filters were applied.
+     **/
+    virtual void eventReturned( YDialog * dialog, YEvent * event ) {}
+};
+
+
+#endif // YDialogListener_h
@@ -81,6 +81,7 @@ void
 YDownloadProgress::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -166,16 +167,16 @@ YDownloadProgress::propertySet()
 
 
 bool
-YDownloadProgress::setProperty( const string & propertyName, const YPropertyValue & val )
+YDownloadProgress::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if ( propertyName == YUIProperty_Label 		)	setLabel       ( val.stringVal()  );
-    if ( propertyName == YUIProperty_Filename		)	setFilename    ( val.stringVal()  );
-    if ( propertyName == YUIProperty_ExpectedSize	)	setExpectedSize( val.integerVal() );
+    if ( propertyId == YUIPropertyId_Label 		)	setLabel       ( val.stringVal()  );
+    if ( propertyId == YUIPropertyId_Filename		)	setFilename    ( val.stringVal()  );
+    if ( propertyId == YUIPropertyId_ExpectedSize	)	setExpectedSize( val.integerVal() );
     else
     {
-	YWidget::setProperty( propertyName, val );
+	YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special handling necessary
@@ -183,17 +184,17 @@ YDownloadProgress::setProperty( const string & propertyName, const YPropertyValu
 
 
 YPropertyValue
-YDownloadProgress::getProperty( const string & propertyName )
+YDownloadProgress::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if ( propertyName == YUIProperty_Label 		)	return YPropertyValue( label() 		);
-    if ( propertyName == YUIProperty_Filename		)	return YPropertyValue( filename() 	);
-    if ( propertyName == YUIProperty_ExpectedSize	)	return YPropertyValue( expectedSize() 	);
-    if ( propertyName == YUIProperty_CurrentSize	)	return YPropertyValue( currentFileSize());
-    if ( propertyName == YUIProperty_Value		)	return YPropertyValue( currentPercent() );
+    if ( propertyId == YUIPropertyId_Label 		)	return YPropertyValue( label() 		);
+    if ( propertyId == YUIPropertyId_Filename		)	return YPropertyValue( filename() 	);
+    if ( propertyId == YUIPropertyId_ExpectedSize	)	return YPropertyValue( expectedSize() 	);
+    if ( propertyId == YUIPropertyId_CurrentSize	)	return YPropertyValue( currentFileSize());
+    if ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( currentPercent() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
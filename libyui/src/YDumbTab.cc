@@ -121,16 +121,16 @@ YDumbTab::propertySet()
 
 
 bool
-YDumbTab::setProperty( const string & propertyName, const YPropertyValue & val )
+YDumbTab::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
+    if	    ( propertyId == YUIPropertyId_Value		)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_CurrentItem 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Items 	)	return false; // Needs special handling
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -138,15 +138,15 @@ YDumbTab::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YDumbTab::getProperty( const string & propertyName )
+YDumbTab::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_CurrentItem 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Items 	)	return YPropertyValue( YOtherProperty );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
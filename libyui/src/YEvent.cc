@@ -34,11 +34,113 @@
 using std::string;
 
 
+// Events are recycled in size classes of this many bytes
+#define EVENT_POOL_GRANULARITY	16
+
+// Events bigger than this are not recycled
+#define EVENT_POOL_MAX_SIZE	128
+
+// Maximum number of free blocks kept per size class and thread
+#define EVENT_POOL_MAX_FREE	32
+
+#define EVENT_POOL_CLASSES	( EVENT_POOL_MAX_SIZE / EVENT_POOL_GRANULARITY )
+
+
+// Set when the event pool of this thread is destroyed: Events deleted after
+// that (e.g. by static destructors) go directly back to the heap.
+static thread_local bool eventPoolClosed = false;
+
+
+/**
+ * Per-thread pool of free event memory blocks: One singly linked list per
+ * size class, linked through the first word of each free block.
+ **/
+struct YEventPool
+{
+    YEventPool()
+    {
+	for ( int i = 0; i < EVENT_POOL_CLASSES; i++ )
+	{
+	    freeList [i] = 0;
+	    freeCount[i] = 0;
+	}
+    }
+
+    ~YEventPool()
+    {
+	for ( int i = 0; i < EVENT_POOL_CLASSES; i++ )
+	{
+	    while ( freeList[i] )
+	    {
+		void * block = freeList[i];
+		freeList[i] = *static_cast<void **>( block );
+		::operator delete( block );
+	    }
+	}
+
+	eventPoolClosed = true;
+    }
+
+    void *	freeList [ EVENT_POOL_CLASSES ];
+    int		freeCount[ EVENT_POOL_CLASSES ];
+};
+
+static thread_local YEventPool eventPool;
+
+
 unsigned long YEvent::_nextSerial = 0;
 
 
+void *
+YEvent::operator new( size_t size )
+{
+    int sizeClass = ( size - 1 ) / EVENT_POOL_GRANULARITY;
+
+    if ( size > EVENT_POOL_MAX_SIZE || eventPoolClosed )
+	return ::operator new( size );
+
+    void * block = eventPool.freeList[ sizeClass ];
+
+    if ( block )
+    {
+	eventPool.freeList[ sizeClass ] = *static_cast<void **>( block );
+	eventPool.freeCount[ sizeClass ]--;
+
+	return block;
+    }
+
+    // Allocate the full size class so the block can be reused for any event
+    // of that size class
+
+    return ::operator new( ( sizeClass + 1 ) * EVENT_POOL_GRANULARITY );
+}
+
+
+void
+YEvent::operator delete( void * ptr, size_t size ) noexcept
+{
+    if ( ! ptr )
+	return;
+
+    int sizeClass = ( size - 1 ) / EVENT_POOL_GRANULARITY;
+
+    if ( size > EVENT_POOL_MAX_SIZE
+	 || eventPoolClosed
+	 || eventPool.freeCount[ sizeClass ] >= EVENT_POOL_MAX_FREE )
+    {
+	::operator delete( ptr );
+	return;
+    }
+
+    *static_cast<void **>( ptr ) = eventPool.freeList[ sizeClass ];
+    eventPool.freeList[ sizeClass ] = ptr;
+    eventPool.freeCount[ sizeClass ]++;
+}
+
+
 YEvent::YEvent( EventType eventType )
     : _eventType( eventType )
+    , _isWidgetEvent( false )
 {
     _dialog = YDialog::currentDialog( false ); // don't throw
     _serial = _nextSerial++;
@@ -117,6 +219,8 @@ YWidgetEvent::YWidgetEvent( YWidget *	widget,
     , _widget( widget )
     , _reason( reason )
 {
+    _isWidgetEvent = true;
+
     if ( widget )
 	setDialog( widget->findDialog() );
 }
@@ -34,6 +34,7 @@
 class YWidget;
 class YItem;
 class YDialog;
+class YWidgetEvent;
 
 
 /**
@@ -106,6 +107,12 @@ public:
      **/
     YDialog * dialog() const { return _dialog; }
 
+    /**
+     * Return this event as a YWidgetEvent or 0 if it is none. This is much
+     * cheaper than a dynamic_cast.
+     **/
+    inline YWidgetEvent * widgetEvent();
+
     /**
      * Check if this event is valid. Events become invalid in the destructor.
      **/
@@ -121,6 +128,20 @@ public:
      **/
     static const char * toString( EventReason reason );
 
+    /**
+     * Overloaded operator new: Events are allocated from a per-thread pool
+     * of recycled event memory. UIs that poll for events in a tight loop
+     * create and delete lots of events; with the pool, that does not hit
+     * the heap in the steady state.
+     **/
+    static void * operator new( size_t size );
+
+    /**
+     * Operator delete counterpart to our custom operator new. This returns
+     * the memory to the pool of the current thread.
+     **/
+    static void operator delete( void * ptr, size_t size ) noexcept;
+
 
 protected:
 
@@ -149,16 +170,21 @@ private:
     friend void YDialog::deleteEvent( YEvent * event );
     friend void YSimpleEventHandler::deleteEvent( YEvent * event );
 
+    // Deletes events that were queued, but never delivered
+    friend class YNullUI;
 
     //
     // Data members
     //
 
     EventType 			_eventType;
+    bool			_isWidgetEvent;
     unsigned long		_serial;
     YDialog *			_dialog;
 
     static unsigned long	_nextSerial;
+
+    friend class YWidgetEvent;
 };
 
 
@@ -204,6 +230,13 @@ protected:
 };
 
 
+YWidgetEvent *
+YEvent::widgetEvent()
+{
+    return _isWidgetEvent ? static_cast<YWidgetEvent *>( this ) : 0;
+}
+
+
 class YKeyEvent: public YEvent
 {
 public:
@@ -62,6 +62,7 @@ YFrame::~YFrame()
 void YFrame::setLabel( const string & newLabel )
 {
     priv->label = YShortcut::cleanShortcutString( newLabel );
+    labelChanged();
 }
 
 
@@ -91,14 +92,14 @@ YFrame::propertySet()
 
 
 bool
-YFrame::setProperty( const string & propertyName, const YPropertyValue & val )
+YFrame::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if      ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
+    if      ( propertyId == YUIPropertyId_Label )	setLabel( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -106,13 +107,13 @@ YFrame::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YFrame::getProperty( const string & propertyName )
+YFrame::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if      ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
+    if      ( propertyId == YUIPropertyId_Label )	return YPropertyValue( label() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
@@ -134,15 +134,15 @@ YGraph::propertySet()
 
 
 bool
-YGraph::setProperty( const string & propertyName, const YPropertyValue & val )
+YGraph::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if      ( propertyName == YUIProperty_Filename	)	setFilename( val.stringVal() );
-    else if ( propertyName == YUIProperty_Layout	)	setLayoutAlgorithm( val.stringVal() );
+    if      ( propertyId == YUIPropertyId_Filename	)	setFilename( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_Layout	)	setLayoutAlgorithm( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -150,15 +150,15 @@ YGraph::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YGraph::getProperty( const string & propertyName )
+YGraph::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if      ( propertyName == YUIProperty_Filename	)	return YPropertyValue( filename() );
-    else if ( propertyName == YUIProperty_Layout	)	return YPropertyValue( layoutAlgorithm() );
-    else if ( propertyName == YUIProperty_Item		)	return YPropertyValue( activatedNode() );
+    if      ( propertyId == YUIPropertyId_Filename	)	return YPropertyValue( filename() );
+    else if ( propertyId == YUIPropertyId_Layout	)	return YPropertyValue( layoutAlgorithm() );
+    else if ( propertyId == YUIPropertyId_Item		)	return YPropertyValue( activatedNode() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
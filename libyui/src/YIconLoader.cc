@@ -24,20 +24,26 @@
 
 
 #include <sys/stat.h>
+#include <dirent.h>
 #include <sstream>
 
 #define YUILogComponent "ui"
 #include "YUILog.h"
 
 #include "YIconLoader.h"
+#include "YEnvVar.h"
 
 #define FALLBACK_ICON_PATH "/usr/share/icons/hicolor/"
 
+// Set this to use directory indexes, see setUseDirectoryIndex()
+#define ENV_ICON_DIR_INDEX "YUI_ICON_DIR_INDEX"
+
 
 using std::string;
 
 
 YIconLoader::YIconLoader()
+    : _useDirectoryIndex( YEnvVar( ENV_ICON_DIR_INDEX ).isSet() )
 {
     addIconSearchPath( FALLBACK_ICON_PATH );
 }
@@ -51,6 +57,7 @@ YIconLoader::~YIconLoader()
 void YIconLoader::setIconBasePath( string path )
 {
     _iconBasePath = path;
+    clearCache();
 }
 
 
@@ -63,6 +70,21 @@ string YIconLoader::iconBasePath() const
 void YIconLoader::addIconSearchPath( string path )
 {
     _iconDirs.push_front( path );
+    clearCache();
+}
+
+
+void YIconLoader::clearCache()
+{
+    _iconCache.clear();
+    _directoryIndex.clear();
+}
+
+
+void YIconLoader::setUseDirectoryIndex( bool use )
+{
+    _useDirectoryIndex = use;
+    _directoryIndex.clear();
 }
 
 
@@ -77,6 +99,20 @@ string YIconLoader::findIcon( string name )
     if ( name[0] == '/' )
 	return name;
 
+    auto cached = _iconCache.find( name );
+
+    if ( cached != _iconCache.end() )
+	return cached->second;
+
+    string fullPath = lookupIcon( name );
+    _iconCache.emplace( name, fullPath );
+
+    return fullPath;
+}
+
+
+string YIconLoader::lookupIcon( const string & name )
+{
     string fullPath;
 
     // Look in global search path
@@ -118,6 +154,35 @@ string YIconLoader::findIcon( string name )
 
 bool YIconLoader::fileExists( string fname )
 {
+    if ( _useDirectoryIndex )
+    {
+	string::size_type pos = fname.rfind( '/' );
+	string dir  = fname.substr( 0, pos + 1 );
+	string file = fname.substr( pos + 1 );
+
+	auto indexed = _directoryIndex.find( dir );
+
+	if ( indexed == _directoryIndex.end() )
+	{
+	    // Read the directory once. A missing directory gets an empty index.
+
+	    indexed = _directoryIndex.emplace( dir, std::unordered_set<string>() ).first;
+	    DIR * dirHandle = opendir( dir.empty() ? "." : dir.c_str() );
+
+	    if ( dirHandle )
+	    {
+		struct dirent * entry;
+
+		while ( ( entry = readdir( dirHandle ) ) )
+		    indexed->second.insert( entry->d_name );
+
+		closedir( dirHandle );
+	    }
+	}
+
+	return indexed->second.count( file ) > 0;
+    }
+
     struct stat fileInfo;
     int ret = stat( fname.c_str(), &fileInfo );
 
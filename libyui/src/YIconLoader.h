@@ -28,7 +28,16 @@
 
 #include <string>
 #include <list>
-
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * Find icon files in the icon base path and the icon search paths.
+ *
+ * Results are cached by icon name, including icons that were not found, so
+ * each name is looked up in the file system only once. The cache is cleared
+ * when the search paths change.
+ **/
 class YIconLoader
 {
 public:
@@ -46,11 +55,44 @@ public:
 
     void addIconSearchPath( std::string path );
 
+    /**
+     * Forget all cached lookup results, e.g. because icons were installed
+     * while the application is running.
+     **/
+    void clearCache();
+
+    /**
+     * Read each icon directory once and look up icons in that directory
+     * index instead of calling stat() for every candidate file. This helps
+     * on slow (e.g. network) file systems when many different icons are
+     * used. Icons added to a directory after it was read are not found
+     * until clearCache() is called.
+     *
+     * This is off by default unless the environment variable
+     * YUI_ICON_DIR_INDEX is set.
+     **/
+    void setUseDirectoryIndex( bool use );
+
+    /**
+     * Return 'true' if directory indexes are used.
+     **/
+    bool useDirectoryIndex() const { return _useDirectoryIndex; }
+
 private:
 
     std::string                 _iconBasePath;
     std::list <std::string>	_iconDirs;
 
+    bool			_useDirectoryIndex;
+
+    // Icon name -> full path, empty if not found
+    std::unordered_map<std::string, std::string> _iconCache;
+
+    // Directory -> names of all its entries
+    std::unordered_map<std::string, std::unordered_set<std::string> > _directoryIndex;
+
+    std::string lookupIcon( const std::string & name );
+
     bool fileExists( std::string fname );
 };
 
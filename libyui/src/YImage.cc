@@ -85,6 +85,7 @@ void YImage::setImage( const string & imageFileName, bool animated )
 {
     priv->imageFileName = imageFileName;
     priv->animated	= animated;
+    invalidatePreferredSize();
 }
 
 
@@ -110,4 +111,5 @@ bool YImage::autoScale() const
 void YImage::setAutoScale( bool autoScale )
 {
     priv->autoScale = autoScale;
+    invalidatePreferredSize();
 }
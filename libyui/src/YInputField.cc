@@ -77,6 +77,7 @@ string YInputField::label() const
 void YInputField::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -95,6 +96,7 @@ bool YInputField::shrinkable() const
 void YInputField::setShrinkable( bool shrinkable )
 {
     priv->shrinkable = shrinkable;
+    invalidatePreferredSize();
     // setDefaultStretchable( YD_HORIZ, ! shrinkable );
 }
 
@@ -120,6 +122,7 @@ int YInputField::inputMaxLength() const
 void YInputField::setInputMaxLength( int len )
 {
     priv->inputMaxLength = len;
+    invalidatePreferredSize();
 }
 
 
@@ -148,17 +151,17 @@ YInputField::propertySet()
 
 
 bool
-YInputField::setProperty( const string & propertyName, const YPropertyValue & val )
+YInputField::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_ValidChars	)	setValidChars( val.stringVal() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	setInputMaxLength( val.integerVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	setValue( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_ValidChars	)	setValidChars( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_InputMaxLength )	setInputMaxLength( val.integerVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -166,17 +169,17 @@ YInputField::setProperty( const string & propertyName, const YPropertyValue & va
 
 
 YPropertyValue
-YInputField::getProperty( const string & propertyName )
+YInputField::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_ValidChars	)	return YPropertyValue( validChars() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	return YPropertyValue( inputMaxLength() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( value() );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
+    else if ( propertyId == YUIPropertyId_ValidChars	)	return YPropertyValue( validChars() );
+    else if ( propertyId == YUIPropertyId_InputMaxLength )	return YPropertyValue( inputMaxLength() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
 
@@ -93,6 +93,7 @@ void
 YIntField::setMinValue( int val )
 {
     priv->minValue = val;
+    invalidatePreferredSize();
 
     int oldValue = value();
     int newValue = enforceRange ( oldValue );
@@ -113,6 +114,7 @@ void
 YIntField::setMaxValue( int val )
 {
     priv->maxValue = val;
+    invalidatePreferredSize();
 
     int oldValue = value();
     int newValue = enforceRange ( oldValue );
@@ -133,6 +135,7 @@ void
 YIntField::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -162,17 +165,17 @@ YIntField::propertySet()
 
 
 bool
-YIntField::setProperty( const string & propertyName, const YPropertyValue & val )
+YIntField::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	setValue   ( val.integerVal() );
-    else if ( propertyName == YUIProperty_MinValue	)	setMinValue( val.integerVal() );
-    else if ( propertyName == YUIProperty_MaxValue	)	setMaxValue( val.integerVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	setValue   ( val.integerVal() );
+    else if ( propertyId == YUIPropertyId_MinValue	)	setMinValue( val.integerVal() );
+    else if ( propertyId == YUIPropertyId_MaxValue	)	setMaxValue( val.integerVal() );
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -180,16 +183,16 @@ YIntField::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YIntField::getProperty( const string & propertyName )
+YIntField::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    if	    ( propertyName == YUIProperty_MinValue	)	return YPropertyValue( minValue() );
-    if	    ( propertyName == YUIProperty_MaxValue	)	return YPropertyValue( maxValue() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( value() );
+    if	    ( propertyId == YUIPropertyId_MinValue	)	return YPropertyValue( minValue() );
+    if	    ( propertyId == YUIPropertyId_MaxValue	)	return YPropertyValue( maxValue() );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
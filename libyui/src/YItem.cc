@@ -27,6 +27,8 @@
 
 #include <iostream>
 #include "YItem.h"
+#include "YSelectionWidget.h"
+#include "YItemArena.h"
 
 using std::string;
 
@@ -40,6 +42,54 @@ using std::string;
 YItemCollection YItem::_noChildren;
 
 
+void * YItem::operator new( size_t size )
+{
+    return YItemArena::allocate( size );
+}
+
+
+void YItem::operator delete( void * ptr, size_t size ) noexcept
+{
+    YItemArena::deallocate( ptr, size );
+}
+
+
+YItem::~YItem()
+{
+    if ( _owner )
+	_owner->itemDestroyed( this );
+}
+
+
+void
+YItem::setLabel( const string & newLabel )
+{
+    _label = newLabel;
+
+    if ( _owner )
+	_owner->itemLabelChanged( this );
+}
+
+
+void
+YItem::setStatus( int newStatus )
+{
+    int oldStatus = _status;
+    _status = newStatus;
+
+    if ( _owner && ( oldStatus != 0 ) != ( newStatus != 0 ) )
+	_owner->itemSelectionChanged( this );
+}
+
+
+void
+YItem::childAdded( YItem * child )
+{
+    if ( _owner && child )
+	_owner->adoptItem( child, false );
+}
+
+
 string
 YItem::debugLabel() const
 {
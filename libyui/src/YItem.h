@@ -31,6 +31,7 @@
 
 
 class YItem;
+class YSelectionWidget;
 
 // without "documenting" the file, typedefs will be dropped
 //! @file
@@ -64,6 +65,7 @@ public:
 	, _status( selected ? 1 : 0 )
 	, _index( -1 )
 	, _data( 0 )
+	, _owner( 0 )
 	{}
 
     /**
@@ -77,12 +79,13 @@ public:
 	, _status( selected ? 1 : 0 )
 	, _index( -1 )
 	, _data( 0 )
+	, _owner( 0 )
 	{}
 
     /**
      * Destructor.
      **/
-    virtual ~YItem() {}
+    virtual ~YItem();
 
     /**
      * Returns a descriptive name of this widget class for logging,
@@ -99,7 +102,7 @@ public:
     /**
      * Set this item's label.
      **/
-    void setLabel( const std::string & newLabel ) { _label = newLabel; }
+    void setLabel( const std::string & newLabel );
 
     /**
      * Return this item's icon name.
@@ -126,7 +129,7 @@ public:
      * item; if it is desired that only one item is selected at any time, the
      * caller has to take care of that.
      **/
-    void setSelected( bool sel = true ) { _status = sel ? 1 : 0; }
+    void setSelected( bool sel = true ) { setStatus( sel ? 1 : 0 ); }
 
     /**
      * Return the status of this item. This is a bit more generalized than
@@ -140,7 +143,7 @@ public:
      * or nonzero for "selected". Some widgets may make use of other values as
      * well.
      **/
-    void setStatus( int newStatus ) { _status = newStatus; }
+    void setStatus( int newStatus );
 
     /**
      * Set this item's index.
@@ -167,6 +170,15 @@ public:
      **/
     void * data() const { return _data; }
 
+    /**
+     * Return the selection widget this item (or its toplevel parent item)
+     * was added to or 0 if it was not added to any yet.
+     *
+     * The owner keeps track of selected items and labels, so any change to
+     * those is reported to it.
+     **/
+    YSelectionWidget * owner() const { return _owner; }
+
     //
     // Children management stubs.
     //
@@ -229,14 +241,40 @@ public:
      **/
     std::string limitLength( const std::string & text, int limit ) const;
 
+    /**
+     * Overloaded operator new to allocate items from the current item arena
+     * if there is one. See YItemArena.
+     **/
+    void * operator new( size_t size );
+
+    /**
+     * Operator delete counterpart to our custom operator new.
+     **/
+    void operator delete( void * ptr, size_t size ) noexcept;
+
+
+protected:
+
+    /**
+     * Notify the owner of this item (if there is one) that 'child' was added
+     * as a child item of this item.
+     *
+     * Derived classes that handle children have to call this when adding
+     * a child.
+     **/
+    void childAdded( YItem * child );
+
 
 private:
 
+    friend class YSelectionWidget;
+
     std::string	_label;
     std::string	_iconName;
     int         _status;
     int		_index;
     void *	_data;
+    YSelectionWidget * _owner;
 
     /**
      * Static children collection that is always empty so the children
@@ -0,0 +1,399 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YItemArena.cc
+
+/-*/
+
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+#include "YItemArena.h"
+
+
+// Size of the memory chunks the arena allocates from the heap. Chunks are
+// aligned to their size, so the chunk of a block is found by masking its
+// address.
+#define YItemArenaChunkSize	( 64 * 1024 )
+
+// Blocks are handed out in size classes of this many bytes; this also keeps
+// every block aligned suitably for any type
+#define YItemArenaGranularity	alignof( std::max_align_t )
+
+// Objects bigger than this are always allocated from the heap
+#define YItemArenaMaxBlockSize	1024
+
+#define YItemArenaSizeClasses	( YItemArenaMaxBlockSize / YItemArenaGranularity )
+
+// Size of the table of all arena chunks (a power of 2). It is never filled
+// more than 3/4; if an arena can't add another chunk, it falls back to the
+// heap.
+#define YItemArenaRegistryBits	12
+#define YItemArenaRegistrySlots	( size_t( 1 ) << YItemArenaRegistryBits )
+
+// Chunk registry keys of unused and removed slots; chunks are aligned to
+// YItemArenaChunkSize, so they can't have these addresses
+#define YItemArenaEmptySlot	uintptr_t( 0 )
+#define YItemArenaRemovedSlot	uintptr_t( 1 )
+
+static_assert( YItemArenaGranularity >= sizeof( void * ),
+	       "Arena blocks too small for the free list" );
+
+
+// The arena used for new items and cells in this thread
+static thread_local YItemArena * currentArena = 0;
+
+
+namespace
+{
+    /**
+     * The chunks of all arenas with the arena they belong to.
+     *
+     * Items might be deleted in any thread, and every item and cell delete
+     * looks up its chunk here, even for items from the heap. So this is an
+     * open addressing hash table of atomic slots that can be searched
+     * without a lock; only adding and removing chunks is serialized with the
+     * mutex. A slot's arena is written before its key is published, and a
+     * key is only removed when its chunk is freed, i.e. when nobody can
+     * look it up anymore.
+     *
+     * This is never destroyed: Items might be deleted by static destructors.
+     **/
+    struct ChunkRegistry
+    {
+	std::mutex			mutex;
+	std::atomic<uintptr_t>		keys  [ YItemArenaRegistrySlots ];
+	std::atomic<YItemArena *>	arenas[ YItemArenaRegistrySlots ];
+	size_t				usedSlots = 0;	// including removed ones
+	std::atomic<size_t>		count { 0 };	// live chunks
+
+	ChunkRegistry()
+	{
+	    for ( size_t i = 0; i < YItemArenaRegistrySlots; i++ )
+	    {
+		keys  [i].store( YItemArenaEmptySlot, std::memory_order_relaxed );
+		arenas[i].store( 0, std::memory_order_relaxed );
+	    }
+	}
+
+	static size_t home( uintptr_t chunk )
+	{
+	    // Fibonacci hashing of the chunk number
+	    uint64_t hash = uint64_t( chunk / YItemArenaChunkSize ) * 11400714819323198485ULL;
+
+	    return hash >> ( 64 - YItemArenaRegistryBits );
+	}
+
+	static size_t next( size_t slot )
+	{
+	    return ( slot + 1 ) & ( YItemArenaRegistrySlots - 1 );
+	}
+
+	/**
+	 * Return the arena of 'chunk' or 0 if it is not an arena chunk.
+	 * This does not need the mutex.
+	 **/
+	YItemArena * find( uintptr_t chunk ) const
+	{
+	    for ( size_t slot = home( chunk ); ; slot = next( slot ) )
+	    {
+		uintptr_t key = keys[ slot ].load( std::memory_order_acquire );
+
+		if ( key == chunk )
+		    return arenas[ slot ].load( std::memory_order_relaxed );
+
+		if ( key == YItemArenaEmptySlot )
+		    return 0;
+	    }
+	}
+
+	/**
+	 * Add 'chunk' of 'arena'. Return 'false' if the table is too full.
+	 * The caller has to hold the mutex.
+	 **/
+	bool add( uintptr_t chunk, YItemArena * arena )
+	{
+	    if ( usedSlots >= YItemArenaRegistrySlots * 3 / 4 )
+		return false;
+
+	    size_t slot = home( chunk );
+
+	    while ( keys[ slot ].load( std::memory_order_relaxed ) > YItemArenaRemovedSlot )
+		slot = next( slot );
+
+	    if ( keys[ slot ].load( std::memory_order_relaxed ) == YItemArenaEmptySlot )
+		usedSlots++;
+
+	    arenas[ slot ].store( arena, std::memory_order_relaxed );
+	    keys  [ slot ].store( chunk, std::memory_order_release );
+	    count++;
+
+	    return true;
+	}
+
+	/**
+	 * Remove 'chunk'. The caller has to hold the mutex.
+	 **/
+	void remove( uintptr_t chunk )
+	{
+	    size_t slot = home( chunk );
+
+	    while ( keys[ slot ].load( std::memory_order_relaxed ) != chunk )
+		slot = next( slot );
+
+	    count--;
+
+	    if ( keys[ next( slot ) ].load( std::memory_order_relaxed ) != YItemArenaEmptySlot )
+	    {
+		// Other keys might be behind this one: Leave a marker so
+		// searches go on
+		keys[ slot ].store( YItemArenaRemovedSlot, std::memory_order_release );
+		return;
+	    }
+
+	    // End of a probe sequence: Clear this slot and any removed ones
+	    // right before it so the table does not silt up
+
+	    do
+	    {
+		keys[ slot ].store( YItemArenaEmptySlot, std::memory_order_release );
+		usedSlots--;
+		slot = ( slot + YItemArenaRegistrySlots - 1 ) & ( YItemArenaRegistrySlots - 1 );
+	    }
+	    while ( keys[ slot ].load( std::memory_order_relaxed ) == YItemArenaRemovedSlot );
+	}
+    };
+
+    ChunkRegistry & chunkRegistry()
+    {
+	static ChunkRegistry * registry = new ChunkRegistry;
+
+	return *registry;
+    }
+
+
+    int sizeClass( size_t size )
+    {
+	return ( size - 1 ) / YItemArenaGranularity;
+    }
+}
+
+
+YItemArena::YItemArena()
+    : _chunkUsed( 0 )
+    , _freeList( YItemArenaSizeClasses, 0 )
+    , _liveObjects( 0 )
+    , _released( false )
+{
+}
+
+
+YItemArena::~YItemArena()
+{
+    ChunkRegistry & registry = chunkRegistry();
+    std::lock_guard<std::mutex> lock( registry.mutex );
+
+    for ( char * chunk: _chunks )
+    {
+	registry.remove( reinterpret_cast<uintptr_t>( chunk ) );
+	::operator delete( chunk, std::align_val_t( YItemArenaChunkSize ) );
+    }
+}
+
+
+void
+YItemArena::release()
+{
+    if ( currentArena == this )
+	currentArena = 0;
+
+    if ( _liveObjects == 0 )
+	delete this;
+    else
+	_released = true;
+}
+
+
+size_t
+YItemArena::capacity() const
+{
+    return _chunks.size() * YItemArenaChunkSize;
+}
+
+
+bool
+YItemArena::addChunk()
+{
+    char * chunk = static_cast<char *>( ::operator new( YItemArenaChunkSize,
+							 std::align_val_t( YItemArenaChunkSize ) ) );
+    ChunkRegistry & registry = chunkRegistry();
+
+    {
+	std::lock_guard<std::mutex> lock( registry.mutex );
+
+	if ( ! registry.add( reinterpret_cast<uintptr_t>( chunk ), this ) )
+	{
+	    ::operator delete( chunk, std::align_val_t( YItemArenaChunkSize ) );
+	    return false;
+	}
+    }
+
+    _chunks.push_back( chunk );
+    _chunkUsed = 0;
+
+    return true;
+}
+
+
+void *
+YItemArena::allocateBlock( int sizeClass )
+{
+    void * block = _freeList[ sizeClass ];
+
+    if ( block )
+    {
+	_freeList[ sizeClass ] = *static_cast<void **>( block );
+    }
+    else
+    {
+	size_t size = ( sizeClass + 1 ) * YItemArenaGranularity;
+
+	if ( _chunks.empty() || _chunkUsed + size > YItemArenaChunkSize )
+	{
+	    if ( ! addChunk() )
+		return 0;
+	}
+
+	block = _chunks.back() + _chunkUsed;
+	_chunkUsed += size;
+    }
+
+    _liveObjects++;
+
+    return block;
+}
+
+
+void
+YItemArena::deallocateBlock( void * block, int sizeClass )
+{
+    if ( --_liveObjects == 0 )
+    {
+	if ( _released )
+	    delete this;
+	else
+	    reset();
+
+	return;
+    }
+
+    *static_cast<void **>( block ) = _freeList[ sizeClass ];
+    _freeList[ sizeClass ] = block;
+}
+
+
+void
+YItemArena::reset()
+{
+    // Keep the first chunk for the next items; that is all a small selection
+    // widget will ever need.
+
+    if ( _chunks.size() > 1 )
+    {
+	ChunkRegistry & registry = chunkRegistry();
+	std::lock_guard<std::mutex> lock( registry.mutex );
+
+	for ( size_t i = 1; i < _chunks.size(); i++ )
+	{
+	    registry.remove( reinterpret_cast<uintptr_t>( _chunks[i] ) );
+	    ::operator delete( _chunks[i], std::align_val_t( YItemArenaChunkSize ) );
+	}
+
+	_chunks.resize( 1 );
+    }
+
+    _freeList.assign( YItemArenaSizeClasses, 0 );
+    _chunkUsed = 0;
+}
+
+
+YItemArena *
+YItemArena::owner( void * ptr )
+{
+    ChunkRegistry & registry = chunkRegistry();
+
+    if ( registry.count == 0 )
+	return 0;
+
+    uintptr_t chunk = reinterpret_cast<uintptr_t>( ptr ) & ~uintptr_t( YItemArenaChunkSize - 1 );
+
+    return registry.find( chunk );
+}
+
+
+void *
+YItemArena::allocate( size_t size )
+{
+    if ( currentArena && size <= YItemArenaMaxBlockSize )
+    {
+	void * block = currentArena->allocateBlock( sizeClass( size ) );
+
+	if ( block )
+	    return block;
+    }
+
+    return ::operator new( size );
+}
+
+
+void
+YItemArena::deallocate( void * ptr, size_t size )
+{
+    if ( ! ptr )
+	return;
+
+    YItemArena * arena = size <= YItemArenaMaxBlockSize ? owner( ptr ) : 0;
+
+    if ( arena )
+	arena->deallocateBlock( ptr, sizeClass( size ) );
+    else
+	::operator delete( ptr );
+}
+
+
+YItemArena *
+YItemArena::current()
+{
+    return currentArena;
+}
+
+
+YItemArena::Scope::Scope( YItemArena * arena )
+    : _previous( currentArena )
+{
+    currentArena = arena;
+}
+
+
+YItemArena::Scope::~Scope()
+{
+    currentArena = _previous;
+}
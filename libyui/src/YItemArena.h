@@ -0,0 +1,174 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YItemArena.h
+
+/-*/
+
+#ifndef YItemArena_h
+#define YItemArena_h
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+ * Memory arena for items (YItem and derived classes) and table cells
+ * (YTableCell).
+ *
+ * Creating a big table means a lot of small allocations: The item, one cell
+ * per column and their strings. With an arena, they are carved out of a few
+ * big memory blocks instead, and those blocks are released in one go when
+ * the last object in the arena is deleted.
+ *
+ * Each YSelectionWidget can provide an arena with itemArena(). Items and
+ * cells are allocated from it while a YItemArena::Scope is active:
+ *
+ *     YItemCollection items;
+ *
+ *     {
+ *         YItemArena::Scope arenaScope( table->itemArena() );
+ *
+ *         for ( ... )
+ *             items.push_back( new YTableItem( name, version, size ) );
+ *     }
+ *
+ *     table->addItems( std::move( items ) );
+ *
+ * Items and cells are still deleted with 'delete' as usual; this returns
+ * the memory to a free list of the arena (one per size class) where it is
+ * reused for the next items of that size, so replacing the items over and
+ * over again does not make the arena grow. The arena shrinks back to one
+ * chunk when all of its objects are deleted.
+ *
+ * Blocks do not carry a header: The arena of a block is found by the
+ * address of the chunk it is in, so objects allocated from the heap (no
+ * active arena or too big for an arena) do not pay anything extra. That
+ * lookup does not take a lock, so deleting items is not serialized.
+ *
+ * Arenas are not thread-safe; use them only in the UI thread.
+ **/
+class YItemArena
+{
+public:
+
+    /**
+     * Constructor. Use release() rather than delete to get rid of an arena.
+     **/
+    YItemArena();
+
+    /**
+     * Release this arena: It is deleted as soon as no more objects
+     * allocated from it are alive.
+     **/
+    void release();
+
+    /**
+     * Return the number of objects allocated from this arena that are still
+     * alive.
+     **/
+    int liveObjects() const { return _liveObjects; }
+
+    /**
+     * Return the number of bytes of memory held by this arena.
+     **/
+    size_t capacity() const;
+
+    /**
+     * Allocate 'size' bytes for an item or a cell. If there is an active
+     * arena (see YItemArena::Scope), the memory comes from that arena,
+     * otherwise from the heap.
+     *
+     * This is the implementation of operator new for YItem and YTableCell.
+     **/
+    static void * allocate( size_t size );
+
+    /**
+     * Return memory of 'size' bytes that was allocated with allocate().
+     *
+     * This is the implementation of operator delete for YItem and YTableCell.
+     **/
+    static void deallocate( void * ptr, size_t size );
+
+    /**
+     * Return the arena that is currently used for new items and cells
+     * in this thread or 0 if there is none.
+     **/
+    static YItemArena * current();
+
+
+    /**
+     * Helper class to allocate items and cells from an arena during the
+     * lifetime of an instance of this class. Scopes can be nested.
+     **/
+    class Scope
+    {
+    public:
+	Scope( YItemArena * arena );
+	~Scope();
+
+    private:
+	YItemArena * _previous;
+    };
+
+
+private:
+
+    /**
+     * Destructor. Private: Use release() instead.
+     **/
+    ~YItemArena();
+
+    /**
+     * Allocate a block of size class 'sizeClass' from this arena.
+     * Return 0 if no more chunks can be added.
+     **/
+    void * allocateBlock( int sizeClass );
+
+    /**
+     * Return a block of size class 'sizeClass' to this arena.
+     **/
+    void deallocateBlock( void * block, int sizeClass );
+
+    /**
+     * Add a new chunk to this arena. Return 'false' if the registry of all
+     * arena chunks is full.
+     **/
+    bool addChunk();
+
+    /**
+     * Free all chunks except the first one and start over with that one.
+     **/
+    void reset();
+
+    /**
+     * Return the arena that owns the memory at 'ptr' or 0 if it is not
+     * from an arena.
+     **/
+    static YItemArena * owner( void * ptr );
+
+
+    std::vector<char *>	_chunks;
+    size_t		_chunkUsed;	// bytes used in the last chunk
+    std::vector<void *>	_freeList;	// one list per size class
+    int			_liveObjects;
+    bool		_released;
+};
+
+
+#endif // YItemArena_h
@@ -109,6 +109,7 @@ void YItemSelector::setVisibleItems( int newVal )
 	newVal = 1;
 
     priv->visibleItems = newVal;
+    invalidatePreferredSize();
 }
 
 
@@ -236,20 +237,20 @@ YItemSelector::propertySet()
 
 
 bool
-YItemSelector::setProperty( const string & propertyName, const YPropertyValue & val )
+YItemSelector::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentItem	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_SelectedItems	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_ItemStatus    )	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_VisibleItems	)	setVisibleItems( val.integerVal() );
-    else if ( propertyName == YUIProperty_IconPath	)	setIconBasePath( val.stringVal() );
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
+
+    if	    ( propertyId == YUIPropertyId_Value		)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_CurrentItem	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_SelectedItems	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Items		)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_ItemStatus    )	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_VisibleItems	)	setVisibleItems( val.integerVal() );
+    else if ( propertyId == YUIPropertyId_IconPath	)	setIconBasePath( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -257,19 +258,19 @@ YItemSelector::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YItemSelector::getProperty( const string & propertyName )
+YItemSelector::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentItem	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_SelectedItems	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_ItemStatus    )	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_VisibleItems	)	return YPropertyValue( visibleItems() );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
+    propertySet().check( propertyId ); // throws exceptions if not found
+
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_CurrentItem	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_SelectedItems	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Items		)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_ItemStatus    )	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_VisibleItems	)	return YPropertyValue( visibleItems() );
+    else if ( propertyId == YUIPropertyId_IconPath	)	return YPropertyValue( iconBasePath() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
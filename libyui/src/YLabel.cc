@@ -84,6 +84,7 @@ string YLabel::text() const
 void YLabel::setText( const string & newText )
 {
     priv->text = newText;
+    labelChanged();
 }
 
 
@@ -108,6 +109,7 @@ bool YLabel::useBoldFont() const
 void YLabel::setUseBoldFont( bool bold )
 {
     priv->useBoldFont = bold;
+    invalidatePreferredSize();
 }
 
 
@@ -166,16 +168,16 @@ YLabel::propertySet()
 
 
 bool
-YLabel::setProperty( const string & propertyName, const YPropertyValue & val )
+YLabel::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Label )	setText( val.stringVal() );
-    else if ( propertyName == YUIProperty_Value )	setText( val.stringVal() );
-    else if ( propertyName == YUIProperty_Text )	setText( val.stringVal() );
+    if	    ( propertyId == YUIPropertyId_Label )	setText( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_Value )	setText( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_Text )	setText( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -183,16 +185,16 @@ YLabel::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YLabel::getProperty( const string & propertyName )
+YLabel::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if      ( propertyName == YUIProperty_Label )	return YPropertyValue( text() );
-    else if ( propertyName == YUIProperty_Value )	return YPropertyValue( text() );
-    else if ( propertyName == YUIProperty_Text )	return YPropertyValue( text() );
+    if      ( propertyId == YUIPropertyId_Label )	return YPropertyValue( text() );
+    else if ( propertyId == YUIPropertyId_Value )	return YPropertyValue( text() );
+    else if ( propertyId == YUIPropertyId_Text )	return YPropertyValue( text() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
 
@@ -133,7 +133,7 @@ YLayoutBox::preferredSize( YUIDimension dimension )
 	{
 	    // Calculate size of all weighted widgets.
 
-	    size = dominatingChild->preferredSize( primary() )
+	    size = dominatingChild->cachedPreferredSize( primary() )
 		* childrenTotalWeight( primary() )
 		/ dominatingChild->weight( primary() );
 
@@ -154,13 +154,13 @@ YLayoutBox::preferredSize( YUIDimension dimension )
 
 int YLayoutBox::preferredWidth()
 {
-    return preferredSize( YD_HORIZ );
+    return cachedPreferredSize( YD_HORIZ );
 }
 
 
 int YLayoutBox::preferredHeight()
 {
-    return preferredSize( YD_VERT );
+    return cachedPreferredSize( YD_VERT );
 }
 
 
@@ -192,7 +192,7 @@ YLayoutBox::findDominatingChild()
 
 	if ( child->weight( primary() ) != 0 )	// avoid division by zero
 	{
-	    ratio = ( ( double ) child->preferredSize( primary() ) )
+	    ratio = ( ( double ) child->cachedPreferredSize( primary() ) )
 		/ child->weight( primary() );
 
 	    if ( ratio > dominatingRatio ) // we have a new dominating child
@@ -209,7 +209,7 @@ YLayoutBox::findDominatingChild()
 	if ( dominatingChild )
 	{
 	    yuiDebug() << "Found dominating child: "	<< dominatingChild
-		       << " - preferred size: " 	<< dominatingChild->preferredSize( primary() )
+		       << " - preferred size: " 	<< dominatingChild->cachedPreferredSize( primary() )
 		       << ", weight: " 			<< dominatingChild->weight( primary() )
 		       << endl;
 	}
@@ -232,7 +232,7 @@ YLayoutBox::childrenMaxPreferredSize( YUIDimension dimension )
 	  it != childrenEnd();
 	  ++it )
     {
-	maxPreferredSize = std::max( (*it)->preferredSize( dimension ), maxPreferredSize );
+	maxPreferredSize = std::max( (*it)->cachedPreferredSize( dimension ), maxPreferredSize );
     }
 
     return maxPreferredSize;
@@ -265,7 +265,7 @@ YLayoutBox::totalNonWeightedChildrenPreferredSize( YUIDimension dimension )
 	  ++it )
     {
 	if ( ! (*it)->hasWeight( dimension ) ) // non-weighted children only
-	    size += (*it)->preferredSize( dimension );
+	    size += (*it)->cachedPreferredSize( dimension );
     }
 
     return size;
@@ -432,7 +432,7 @@ YLayoutBox::calcPrimaryGeometry( int		newSize,
 	    // of equal size: Give all buttons a weight of 1 and insert a
 	    // stretch (without weight!) between each.
 
-	    int surplusSize = newSize - preferredSize( primary() );
+	    int surplusSize = newSize - cachedPreferredSize( primary() );
 
 	    if ( surplusSize > 0L )
 	    {
@@ -470,11 +470,11 @@ YLayoutBox::calcPrimaryGeometry( int		newSize,
 
 		childSize[i] = distributableSize * child->weight( primary() ) / totalWeight;
 
-		if ( childSize[i] < child->preferredSize( primary() ) )
+		if ( childSize[i] < child->cachedPreferredSize( primary() ) )
 		{
 		    yuiDebug() << "Layout running out of space: "
 			       << "Resizing child widget #" 		<< i << " ("<< child
-			       << ") below its preferred size of "	<< child->preferredSize( primary() )
+			       << ") below its preferred size of "	<< child->cachedPreferredSize( primary() )
 			       << " to " 				<< childSize[i]
 			       << endl;
 		}
@@ -483,7 +483,7 @@ YLayoutBox::calcPrimaryGeometry( int		newSize,
 	    {
 		// Non-weighted children will get their preferred size.
 
-		childSize[i] = child->preferredSize( primary() );
+		childSize[i] = child->cachedPreferredSize( primary() );
 
 
 		if ( child->stretchable( primary() ) )
@@ -577,7 +577,7 @@ YLayoutBox::calcPrimaryGeometry( int		newSize,
 	    if ( ! (*it)->hasWeight( primary() ) )
 	    {
 		loserCount++;
-		childSize[i] = (*it)->preferredSize( primary() );
+		childSize[i] = (*it)->cachedPreferredSize( primary() );
 
 		YAlignment * alignment = dynamic_cast<YAlignment *> (*it);
 
@@ -652,8 +652,8 @@ YLayoutBox::calcPrimaryGeometry( int		newSize,
 
 		    yuiWarning() << "child #" << i <<" ( " << child
 				 << " ) will get " 	<< childSize[i]
-				 << " - "  		<< child->preferredSize( primary() ) - childSize[i] << " too small"
-				 << " (preferred size: "<< child->preferredSize( primary() )
+				 << " - "  		<< child->cachedPreferredSize( primary() ) - childSize[i] << " too small"
+				 << " (preferred size: "<< child->cachedPreferredSize( primary() )
 				 << ", weight: " 	<< child->weight( primary() )
 				 << ", stretchable: " 	<< std::boolalpha << child->stretchable( primary() )
 				 << "), pos: " 		<< childPos[i]
@@ -697,7 +697,7 @@ YLayoutBox::calcSecondaryGeometry( int	 	newSize,
 	  ++it, i++ )
     {
 	YWidget * child = *it;
-	int preferred = child->preferredSize( secondary() );
+	int preferred = child->cachedPreferredSize( secondary() );
 
 	if ( child->stretchable( secondary() ) || newSize < preferred || preferred == 0 )
 	    // Also checking for preferred == 0 to make HSpacing / VSpacing visible in YDialogSpy:
@@ -724,7 +724,7 @@ YLayoutBox::calcSecondaryGeometry( int	 	newSize,
 
 	if ( debugLayout() )
 	{
-	    ( childSize[i] < preferred ? yuiWarning() : yuiDebug() )
+	    ( childSize[i] < preferred ? yuiWarningStream() : yuiDebugStream() )
 		<< "child #"		<< i
 		<< " (" 		<< child
 		<< ") will get " 	<< childSize[i]
@@ -84,6 +84,7 @@ void
 YLogView::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -98,6 +99,7 @@ void
 YLogView::setVisibleLines( int newVisibleLines )
 {
     priv->visibleLines = newVisibleLines;
+    invalidatePreferredSize();
 }
 
 
@@ -264,18 +266,18 @@ YLogView::propertySet()
 
 
 bool
-YLogView::setProperty( const string & propertyName, const YPropertyValue & val )
+YLogView::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if      ( propertyName == YUIProperty_Value         )       setLogText	( val.stringVal()  );
-    else if ( propertyName == YUIProperty_LastLine      )       appendLines     ( val.stringVal()  );
-    else if ( propertyName == YUIProperty_VisibleLines  )       setVisibleLines ( val.integerVal() );
-    else if ( propertyName == YUIProperty_MaxLines      )       setMaxLines     ( val.integerVal() );
-    else if ( propertyName == YUIProperty_Label         )       setLabel        ( val.stringVal()  );
+    if      ( propertyId == YUIPropertyId_Value         )       setLogText	( val.stringVal()  );
+    else if ( propertyId == YUIPropertyId_LastLine      )       appendLines     ( val.stringVal()  );
+    else if ( propertyId == YUIPropertyId_VisibleLines  )       setVisibleLines ( val.integerVal() );
+    else if ( propertyId == YUIPropertyId_MaxLines      )       setMaxLines     ( val.integerVal() );
+    else if ( propertyId == YUIPropertyId_Label         )       setLabel        ( val.stringVal()  );
     else
     {
-        return YWidget::setProperty( propertyName, val );
+        return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -283,17 +285,17 @@ YLogView::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YLogView::getProperty( const string & propertyName )
+YLogView::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if      ( propertyName == YUIProperty_Value         )       return YPropertyValue( logText()      );
-    if      ( propertyName == YUIProperty_LastLine      )       return YPropertyValue( lastLine()     );
-    if      ( propertyName == YUIProperty_VisibleLines  )       return YPropertyValue( visibleLines() );
-    if      ( propertyName == YUIProperty_MaxLines      )       return YPropertyValue( maxLines()     );
-    else if ( propertyName == YUIProperty_Label         )       return YPropertyValue( label()        );
+    if      ( propertyId == YUIPropertyId_Value         )       return YPropertyValue( logText()      );
+    if      ( propertyId == YUIPropertyId_LastLine      )       return YPropertyValue( lastLine()     );
+    if      ( propertyId == YUIPropertyId_VisibleLines  )       return YPropertyValue( visibleLines() );
+    if      ( propertyId == YUIPropertyId_MaxLines      )       return YPropertyValue( maxLines()     );
+    else if ( propertyId == YUIPropertyId_Label         )       return YPropertyValue( label()        );
     else
     {
-        return YWidget::getProperty( propertyName );
+        return YWidget::getPropertyById( propertyId );
     }
 }
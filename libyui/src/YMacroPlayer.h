@@ -27,6 +27,9 @@
 
 #include <string>
 
+class YDialog;
+class YEvent;
+
 /**
  * Abstract base class for macro player.
  *
@@ -62,6 +65,18 @@ public:
      * Return 'true' if a macro is currently being played.
      **/
     virtual bool playing() const = 0;
+
+    /**
+     * Return the next event from the macro for 'dialog', or 0 to let
+     * 'dialog' wait for real user input. The dialog takes over ownership
+     * of the event.
+     *
+     * YDialog calls this in YDialog::waitForEvent() and
+     * YDialog::pollEvent() while a macro is playing. This default
+     * implementation returns 0, for players that feed the events to the
+     * application in some other way.
+     **/
+    virtual YEvent * nextEvent( YDialog * dialog ) { return 0; }
 };
 
 #endif // YMacroPlayer_h
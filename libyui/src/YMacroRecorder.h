@@ -28,6 +28,8 @@
 #include <string>
 
 class YWidget;
+class YDialog;
+class YEvent;
 
 
 /**
@@ -82,6 +84,16 @@ public:
      **/
     virtual void recordMakeScreenShot( bool enabled = false,
 				       const std::string & filename = std::string() ) = 0;
+
+    /**
+     * Record an event that 'dialog' is about to return from
+     * YDialog::waitForEvent() or YDialog::pollEvent().
+     *
+     * YDialog calls this while a macro is being recorded. This default
+     * implementation does nothing, for recorders that record events on
+     * the application level.
+     **/
+    virtual void recordEvent( YDialog * dialog, YEvent * event ) {}
 };
 
 #endif // YMacroRecorder_h
@@ -97,16 +97,16 @@ YMenuBar::propertySet()
 
 
 bool
-YMenuBar::setProperty( const string & propertyName, const YPropertyValue & val )
+YMenuBar::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if      ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_EnabledItems 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
+    if      ( propertyId == YUIPropertyId_Items 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_EnabledItems 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_IconPath 	)	setIconBasePath( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -114,16 +114,16 @@ YMenuBar::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YMenuBar::getProperty( const string & propertyName )
+YMenuBar::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if      ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_EnabledItems 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
+    if      ( propertyId == YUIPropertyId_Items 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_EnabledItems 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_IconPath	)	return YPropertyValue( iconBasePath() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
 
@@ -120,6 +120,8 @@ YMenuWidget::setItemVisible( YMenuItem * item, bool visible )
 {
     if ( item )
         item->setVisible( visible );
+
+    invalidatePreferredSize();
 }
 
 
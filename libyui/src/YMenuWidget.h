@@ -82,6 +82,9 @@ public:
      **/
     virtual void addItems( const YItemCollection & itemCollection );
 
+    // Don't hide the overload that takes ownership of the items
+    using YSelectionWidget::addItems;
+
     /**
      * Add one item. This widget assumes ownership of the item object and will
      * delete it in its destructor.
@@ -77,6 +77,7 @@ string YMultiLineEdit::label() const
 void YMultiLineEdit::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -89,6 +90,7 @@ int YMultiLineEdit::inputMaxLength() const
 void YMultiLineEdit::setInputMaxLength( int len )
 {
     priv->inputMaxLength = len;
+    invalidatePreferredSize();
 }
 
 
@@ -101,6 +103,7 @@ int YMultiLineEdit::defaultVisibleLines() const
 void YMultiLineEdit::setDefaultVisibleLines( int newVisibleLines )
 {
     priv->defaultVisibleLines = newVisibleLines;
+    invalidatePreferredSize();
 }
 
 
@@ -127,16 +130,16 @@ YMultiLineEdit::propertySet()
 
 
 bool
-YMultiLineEdit::setProperty( const string & propertyName, const YPropertyValue & val )
+YMultiLineEdit::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	setInputMaxLength( val.integerVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	setValue( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_InputMaxLength )	setInputMaxLength( val.integerVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -144,15 +147,15 @@ YMultiLineEdit::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YMultiLineEdit::getProperty( const string & propertyName )
+YMultiLineEdit::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	return YPropertyValue( inputMaxLength() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( value() );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
+    else if ( propertyId == YUIPropertyId_InputMaxLength )	return YPropertyValue( inputMaxLength() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
@@ -158,14 +158,14 @@ YMultiProgressMeter::propertySet()
 
 
 bool
-YMultiProgressMeter::setProperty( const string & propertyName, const YPropertyValue & val )
+YMultiProgressMeter::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if ( propertyName == YUIProperty_Values )	return false; // need special processing
+    if ( propertyId == YUIPropertyId_Values )	return false; // need special processing
     else
     {
-	YWidget::setProperty( propertyName, val );
+	YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special handling necessary
@@ -173,13 +173,13 @@ YMultiProgressMeter::setProperty( const string & propertyName, const YPropertyVa
 
 
 YPropertyValue
-YMultiProgressMeter::getProperty( const string & propertyName )
+YMultiProgressMeter::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if ( propertyName == YUIProperty_Values ) 	return YPropertyValue( YOtherProperty );
+    if ( propertyId == YUIPropertyId_Values ) 	return YPropertyValue( YOtherProperty );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
@@ -73,6 +73,7 @@ bool YMultiSelectionBox::shrinkable() const
 void YMultiSelectionBox::setShrinkable( bool shrinkable )
 {
     priv->shrinkable = shrinkable;
+    invalidatePreferredSize();
 }
 
 
@@ -102,18 +103,18 @@ YMultiSelectionBox::propertySet()
 
 
 bool
-YMultiSelectionBox::setProperty( const string & propertyName, const YPropertyValue & val )
+YMultiSelectionBox::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if      ( propertyName == YUIProperty_CurrentItem 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_SelectedItems	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_IconPath      )       setIconBasePath( val.stringVal() );
+    if      ( propertyId == YUIPropertyId_CurrentItem 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_SelectedItems	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Items 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_IconPath      )       setIconBasePath( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -121,17 +122,17 @@ YMultiSelectionBox::setProperty( const string & propertyName, const YPropertyVal
 
 
 YPropertyValue
-YMultiSelectionBox::getProperty( const string & propertyName )
+YMultiSelectionBox::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if      ( propertyName == YUIProperty_CurrentItem 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_SelectedItems	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
+    if      ( propertyId == YUIPropertyId_CurrentItem 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_SelectedItems	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Items 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
 
@@ -0,0 +1,259 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YNullUI.cc
+
+/-*/
+
+
+#include <errno.h>
+#include <poll.h>
+
+#define YUILogComponent "null-ui"
+#include "YUILog.h"
+
+#include "YNullUI.h"
+#include "YNullWidgetFactory.h"
+#include "YUIException.h"
+
+using std::endl;
+
+
+YNullUI * YNullUI::_nullUI = 0;
+
+
+YNullUI *
+YNullUI::create( bool withThreads )
+{
+    if ( ! _nullUI )
+	new YNullUI( withThreads );
+
+    return _nullUI;
+}
+
+
+YNullUI::YNullUI( bool withThreads )
+    : YUI( withThreads )
+{
+    yuiMilestone() << "Start YNullUI" << endl;
+    _nullUI = this;
+
+    topmostConstructorHasFinished();
+}
+
+
+YNullUI::~YNullUI()
+{
+    YDialog::deleteAllDialogs();
+    clearEvents();
+
+    _nullUI = 0;
+    yuiMilestone() << "Stop YNullUI" << endl;
+}
+
+
+YWidgetFactory *
+YNullUI::createWidgetFactory()
+{
+    YNullWidgetFactory * factory = new YNullWidgetFactory();
+    YUI_CHECK_NEW( factory );
+
+    return factory;
+}
+
+
+YOptionalWidgetFactory *
+YNullUI::createOptionalWidgetFactory()
+{
+    YNullOptionalWidgetFactory * factory = new YNullOptionalWidgetFactory();
+    YUI_CHECK_NEW( factory );
+
+    return factory;
+}
+
+
+YApplication *
+YNullUI::createApplication()
+{
+    YNullApplication * app = new YNullApplication();
+    YUI_CHECK_NEW( app );
+
+    return app;
+}
+
+
+void
+YNullUI::queueEvent( YEvent * event )
+{
+    YUI_CHECK_PTR( event );
+
+    std::lock_guard<std::mutex> lock( _eventMutex );
+    _events.push_back( event );
+}
+
+
+void
+YNullUI::queueWidgetEvent( YWidget * widget, YEvent::EventReason reason )
+{
+    queueEvent( new YWidgetEvent( widget, reason ) );
+}
+
+
+void
+YNullUI::queueMenuEvent( const std::string & id )
+{
+    queueEvent( new YMenuEvent( id ) );
+}
+
+
+void
+YNullUI::queueCancelEvent()
+{
+    queueEvent( new YCancelEvent() );
+}
+
+
+void
+YNullUI::clearEvents()
+{
+    std::lock_guard<std::mutex> lock( _eventMutex );
+
+    for ( YEvent * event: _events )
+	delete event;
+
+    _events.clear();
+}
+
+
+int
+YNullUI::pendingEvents() const
+{
+    std::lock_guard<std::mutex> lock( _eventMutex );
+
+    return _events.size();
+}
+
+
+void
+YNullUI::setEventSource( EventSource source )
+{
+    std::lock_guard<std::mutex> lock( _eventMutex );
+    _eventSource = source;
+}
+
+
+YEvent *
+YNullUI::nextEvent( YDialog * dialog )
+{
+    EventSource source;
+
+    {
+	std::lock_guard<std::mutex> lock( _eventMutex );
+
+	if ( ! _events.empty() )
+	{
+	    YEvent * event = _events.front();
+	    _events.pop_front();
+
+	    return event;
+	}
+
+	source = _eventSource;
+    }
+
+    // Call the event source without holding the lock: It might well queue
+    // more events.
+
+    return source ? source( dialog ) : 0;
+}
+
+
+YEvent *
+YNullUI::runPkgSelection( YWidget * packageSelector )
+{
+    yuiError() << "No package selection in the null UI" << endl;
+
+    return 0;
+}
+
+
+void
+YNullUI::idleLoop( int fd_ycp )
+{
+    struct pollfd pfd;
+    pfd.fd     = fd_ycp;
+    pfd.events = POLLIN;
+
+    while ( poll( &pfd, 1, -1 ) < 0 )
+    {
+	if ( errno != EINTR )
+	{
+	    yuiError() << "poll() failed in idleLoop(): errno: " << errno << endl;
+	    break;
+	}
+    }
+}
+
+
+
+
+YNullApplication::YNullApplication()
+    : YApplication()
+    , _displayWidth( 80 )
+    , _displayHeight( 25 )
+{
+}
+
+
+YNullApplication::~YNullApplication()
+{
+}
+
+
+void
+YNullApplication::setDisplaySize( int width, int height )
+{
+    _displayWidth  = width;
+    _displayHeight = height;
+}
+
+
+std::string
+YNullApplication::askForExistingDirectory( const std::string & startDir,
+					   const std::string & headline )
+{
+    return "";
+}
+
+
+std::string
+YNullApplication::askForExistingFile( const std::string & startWith,
+				      const std::string & filter,
+				      const std::string & headline )
+{
+    return "";
+}
+
+
+std::string
+YNullApplication::askForSaveFileName( const std::string & startWith,
+				      const std::string & filter,
+				      const std::string & headline )
+{
+    return "";
+}
@@ -0,0 +1,230 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YNullUI.h
+
+/-*/
+
+#ifndef YNullUI_h
+#define YNullUI_h
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "YUI.h"
+#include "YApplication.h"
+#include "YEvent.h"
+
+
+/**
+ * Headless UI without any output: Its widgets are real YWidget subclasses
+ * with a trivial layout (a fixed or label-based preferred size, setSize()
+ * only stores the new size) and no rendering at all.
+ *
+ * This UI is built into libyui; it does not need a plug-in, a terminal or a
+ * display. It is meant for benchmarking and testing the libyui core (layout
+ * engine, selection widgets, shortcut manager, property system) without the
+ * noise of a real UI. Select it with
+ *
+ *     YUI_PREFERED_BACKEND=null
+ *
+ * or with the '--null' command line switch, or create it directly with
+ * YNullUI::create().
+ *
+ * User input is scripted: Queue events with queueEvent() and friends or set
+ * an event source callback with setEventSource(). When there is no more
+ * input, waiting for an event returns a YTimeoutEvent if a timeout was
+ * specified and a YCancelEvent otherwise, so event loops always terminate.
+ **/
+class YNullUI: public YUI
+{
+public:
+
+    /**
+     * Callback that provides the next event for a dialog. It is called when
+     * the event queue is empty. Return 0 if there is no more input.
+     **/
+    typedef std::function<YEvent * ( YDialog * dialog )> EventSource;
+
+    /**
+     * Create the null UI (if it does not exist yet) and return it.
+     **/
+    static YNullUI * create( bool withThreads = false );
+
+    /**
+     * Return the null UI singleton or 0 if the current UI is a different
+     * one.
+     **/
+    static YNullUI * ui() { return _nullUI; }
+
+    /**
+     * Destructor.
+     **/
+    virtual ~YNullUI();
+
+    /**
+     * Add an event to the end of the event queue. This UI takes ownership of
+     * the event.
+     **/
+    void queueEvent( YEvent * event_disown );
+
+    /**
+     * Queue a widget event for 'widget'.
+     **/
+    void queueWidgetEvent( YWidget * widget,
+			   YEvent::EventReason reason = YEvent::Activated );
+
+    /**
+     * Queue a menu event with the ID 'id'.
+     **/
+    void queueMenuEvent( const std::string & id );
+
+    /**
+     * Queue a cancel event (as if the user closed the window).
+     **/
+    void queueCancelEvent();
+
+    /**
+     * Discard all queued events.
+     **/
+    void clearEvents();
+
+    /**
+     * Return the number of queued events.
+     **/
+    int pendingEvents() const;
+
+    /**
+     * Set a callback that provides events when the queue is empty.
+     * Pass an empty function to remove it.
+     **/
+    void setEventSource( EventSource source );
+
+    /**
+     * Return the next event for 'dialog': From the queue if there is any,
+     * otherwise from the event source. Return 0 if there is no input.
+     **/
+    YEvent * nextEvent( YDialog * dialog );
+
+    /**
+     * Package selection is not supported; this only logs an error and
+     * returns 0.
+     *
+     * Implemented from YUI.
+     **/
+    virtual YEvent * runPkgSelection( YWidget * packageSelector );
+
+    /**
+     * Wait until 'fd_ycp' becomes readable. There is no input to process.
+     *
+     * Implemented from YUI.
+     **/
+    virtual void idleLoop( int fd_ycp );
+
+
+protected:
+
+    /**
+     * Constructor. Use create().
+     **/
+    YNullUI( bool withThreads );
+
+    /**
+     * Implemented from YUI.
+     **/
+    virtual YWidgetFactory * createWidgetFactory();
+
+    /**
+     * Implemented from YUI.
+     **/
+    virtual YOptionalWidgetFactory * createOptionalWidgetFactory();
+
+    /**
+     * Implemented from YUI.
+     **/
+    virtual YApplication * createApplication();
+
+
+private:
+
+    static YNullUI *	_nullUI;
+
+    mutable std::mutex	_eventMutex;
+    std::deque<YEvent *> _events;
+    EventSource		_eventSource;
+};
+
+
+/**
+ * Application object of the null UI: A text mode "display" of a
+ * configurable size without any image or icon support.
+ **/
+class YNullApplication: public YApplication
+{
+public:
+
+    YNullApplication();
+    virtual ~YNullApplication();
+
+    /**
+     * Set the size of the (virtual) display. The default is 80x25.
+     * This is also the size of main dialogs.
+     **/
+    void setDisplaySize( int width, int height );
+
+    //
+    // All of these return an empty string: There is nobody to ask.
+    //
+
+    virtual std::string askForExistingDirectory( const std::string & startDir,
+						 const std::string & headline );
+
+    virtual std::string askForExistingFile( const std::string & startWith,
+					    const std::string & filter,
+					    const std::string & headline );
+
+    virtual std::string askForSaveFileName( const std::string & startWith,
+					    const std::string & filter,
+					    const std::string & headline );
+
+    virtual int	 displayWidth()			{ return _displayWidth;	 }
+    virtual int	 displayHeight()		{ return _displayHeight; }
+    virtual int	 displayDepth()			{ return 8;	 }
+    virtual long displayColors()		{ return 256;	 }
+
+    virtual int	 defaultWidth()			{ return _displayWidth;	 }
+    virtual int	 defaultHeight()		{ return _displayHeight; }
+
+    virtual bool isTextMode()			{ return true;	}
+    virtual bool hasImageSupport()		{ return false; }
+    virtual bool hasIconSupport()		{ return false; }
+    virtual bool hasAnimationSupport()		{ return false; }
+    virtual bool hasFullUtf8Support()		{ return true;	}
+    virtual bool richTextSupportsTable()	{ return false; }
+    virtual bool leftHandedMouse()		{ return false; }
+
+private:
+
+    int _displayWidth;
+    int _displayHeight;
+};
+
+
+#endif // YNullUI_h
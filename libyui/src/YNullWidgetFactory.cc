@@ -0,0 +1,452 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YNullWidgetFactory.cc
+
+/-*/
+
+
+#include "YNullWidgetFactory.h"
+#include "YUIException.h"
+
+using std::string;
+
+
+YNullWidgetFactory::YNullWidgetFactory()
+    : YWidgetFactory()
+{
+    // NOP
+}
+
+
+YNullWidgetFactory::~YNullWidgetFactory()
+{
+    // NOP
+}
+
+
+YNullDialog *
+YNullWidgetFactory::createDialog( YDialogType dialogType, YDialogColorMode colorMode )
+{
+    YNullDialog * dialog = new YNullDialog( dialogType, colorMode );
+    YUI_CHECK_NEW( dialog );
+
+    return dialog;
+}
+
+
+YNullLayoutBox *
+YNullWidgetFactory::createLayoutBox( YWidget * parent, YUIDimension dimension )
+{
+    YNullLayoutBox * layoutBox = new YNullLayoutBox( parent, dimension );
+    YUI_CHECK_NEW( layoutBox );
+
+    return layoutBox;
+}
+
+
+YNullButtonBox *
+YNullWidgetFactory::createButtonBox( YWidget * parent )
+{
+    YNullButtonBox * buttonBox = new YNullButtonBox( parent );
+    YUI_CHECK_NEW( buttonBox );
+
+    return buttonBox;
+}
+
+
+YNullPushButton *
+YNullWidgetFactory::createPushButton( YWidget * parent, const string & label )
+{
+    YNullPushButton * pushButton = new YNullPushButton( parent, label );
+    YUI_CHECK_NEW( pushButton );
+
+    return pushButton;
+}
+
+
+YNullLabel *
+YNullWidgetFactory::createLabel( YWidget * parent, const string & text, bool isHeading, bool isOutputField )
+{
+    YNullLabel * label = new YNullLabel( parent, text, isHeading, isOutputField );
+    YUI_CHECK_NEW( label );
+
+    return label;
+}
+
+
+YNullInputField *
+YNullWidgetFactory::createInputField( YWidget * parent, const string & label, bool passwordMode )
+{
+    YNullInputField * inputField = new YNullInputField( parent, label, passwordMode );
+    YUI_CHECK_NEW( inputField );
+
+    return inputField;
+}
+
+
+YNullCheckBox *
+YNullWidgetFactory::createCheckBox( YWidget * parent, const string & label, bool isChecked )
+{
+    YNullCheckBox * checkBox = new YNullCheckBox( parent, label, isChecked );
+    YUI_CHECK_NEW( checkBox );
+
+    return checkBox;
+}
+
+
+YNullRadioButton *
+YNullWidgetFactory::createRadioButton( YWidget * parent, const string & label, bool isChecked )
+{
+    YNullRadioButton * radioButton = new YNullRadioButton( parent, label, isChecked );
+    YUI_CHECK_NEW( radioButton );
+
+    return radioButton;
+}
+
+
+YNullComboBox *
+YNullWidgetFactory::createComboBox( YWidget * parent, const string & label, bool editable )
+{
+    YNullComboBox * comboBox = new YNullComboBox( parent, label, editable );
+    YUI_CHECK_NEW( comboBox );
+
+    return comboBox;
+}
+
+
+YNullSelectionBox *
+YNullWidgetFactory::createSelectionBox( YWidget * parent, const string & label )
+{
+    YNullSelectionBox * selectionBox = new YNullSelectionBox( parent, label );
+    YUI_CHECK_NEW( selectionBox );
+
+    return selectionBox;
+}
+
+
+YNullTree *
+YNullWidgetFactory::createTree( YWidget * parent, const string & label, bool multiSelection, bool recursiveSelection )
+{
+    YNullTree * tree = new YNullTree( parent, label, multiSelection, recursiveSelection );
+    YUI_CHECK_NEW( tree );
+
+    return tree;
+}
+
+
+YNullTable *
+YNullWidgetFactory::createTable( YWidget * parent, YTableHeader * header, bool multiSelection )
+{
+    YNullTable * table = new YNullTable( parent, header, multiSelection );
+    YUI_CHECK_NEW( table );
+
+    return table;
+}
+
+
+YNullProgressBar *
+YNullWidgetFactory::createProgressBar( YWidget * parent, const string & label, int maxValue )
+{
+    YNullProgressBar * progressBar = new YNullProgressBar( parent, label, maxValue );
+    YUI_CHECK_NEW( progressBar );
+
+    return progressBar;
+}
+
+
+YNullRichText *
+YNullWidgetFactory::createRichText( YWidget * parent, const string & text, bool plainTextMode )
+{
+    YNullRichText * richText = new YNullRichText( parent, text, plainTextMode );
+    YUI_CHECK_NEW( richText );
+
+    return richText;
+}
+
+
+YNullBusyIndicator *
+YNullWidgetFactory::createBusyIndicator( YWidget * parent, const string & label, int timeout )
+{
+    YNullBusyIndicator * busyIndicator = new YNullBusyIndicator( parent, label, timeout );
+    YUI_CHECK_NEW( busyIndicator );
+
+    return busyIndicator;
+}
+
+
+YNullIntField *
+YNullWidgetFactory::createIntField( YWidget * parent, const string & label, int minVal, int maxVal, int initialVal )
+{
+    YNullIntField * intField = new YNullIntField( parent, label, minVal, maxVal, initialVal );
+    YUI_CHECK_NEW( intField );
+
+    return intField;
+}
+
+
+YNullMenuButton *
+YNullWidgetFactory::createMenuButton( YWidget * parent, const string & label )
+{
+    YNullMenuButton * menuButton = new YNullMenuButton( parent, label );
+    YUI_CHECK_NEW( menuButton );
+
+    return menuButton;
+}
+
+
+YNullMultiLineEdit *
+YNullWidgetFactory::createMultiLineEdit( YWidget * parent, const string & label )
+{
+    YNullMultiLineEdit * multiLineEdit = new YNullMultiLineEdit( parent, label );
+    YUI_CHECK_NEW( multiLineEdit );
+
+    return multiLineEdit;
+}
+
+
+YNullImage *
+YNullWidgetFactory::createImage( YWidget * parent, const string & imageFileName, bool animated )
+{
+    YNullImage * image = new YNullImage( parent, imageFileName, animated );
+    YUI_CHECK_NEW( image );
+
+    return image;
+}
+
+
+YNullLogView *
+YNullWidgetFactory::createLogView( YWidget * parent, const string & label, int visibleLines, int storedLines )
+{
+    YNullLogView * logView = new YNullLogView( parent, label, visibleLines, storedLines );
+    YUI_CHECK_NEW( logView );
+
+    return logView;
+}
+
+
+YNullMultiSelectionBox *
+YNullWidgetFactory::createMultiSelectionBox( YWidget * parent, const string & label )
+{
+    YNullMultiSelectionBox * multiSelectionBox = new YNullMultiSelectionBox( parent, label );
+    YUI_CHECK_NEW( multiSelectionBox );
+
+    return multiSelectionBox;
+}
+
+
+YPackageSelector *
+YNullWidgetFactory::createPackageSelector( YWidget * parent, long modeFlags )
+{
+    YUI_THROW( YUIUnsupportedWidgetException( "YPackageSelector" ) );
+    return 0;
+}
+
+
+YWidget *
+YNullWidgetFactory::createPkgSpecial( YWidget * parent, const string & subwidgetName )
+{
+    YUI_THROW( YUIUnsupportedWidgetException( "YPkgSpecial" ) );
+    return 0;
+}
+
+
+YNullSpacing *
+YNullWidgetFactory::createSpacing( YWidget * parent, YUIDimension dim, bool stretchable, YLayoutSize_t size )
+{
+    YNullSpacing * spacing = new YNullSpacing( parent, dim, stretchable, size );
+    YUI_CHECK_NEW( spacing );
+
+    return spacing;
+}
+
+
+YNullEmpty *
+YNullWidgetFactory::createEmpty( YWidget * parent )
+{
+    YNullEmpty * empty = new YNullEmpty( parent );
+    YUI_CHECK_NEW( empty );
+
+    return empty;
+}
+
+
+YNullAlignment *
+YNullWidgetFactory::createAlignment( YWidget * parent, YAlignmentType horAlignment, YAlignmentType vertAlignment )
+{
+    YNullAlignment * alignment = new YNullAlignment( parent, horAlignment, vertAlignment );
+    YUI_CHECK_NEW( alignment );
+
+    return alignment;
+}
+
+
+YNullSquash *
+YNullWidgetFactory::createSquash( YWidget * parent, bool horSquash, bool vertSquash )
+{
+    YNullSquash * squash = new YNullSquash( parent, horSquash, vertSquash );
+    YUI_CHECK_NEW( squash );
+
+    return squash;
+}
+
+
+YNullFrame *
+YNullWidgetFactory::createFrame( YWidget * parent, const string & label )
+{
+    YNullFrame * frame = new YNullFrame( parent, label );
+    YUI_CHECK_NEW( frame );
+
+    return frame;
+}
+
+
+YNullCheckBoxFrame *
+YNullWidgetFactory::createCheckBoxFrame( YWidget * parent, const string & label, bool checked )
+{
+    YNullCheckBoxFrame * frame = new YNullCheckBoxFrame( parent, label, checked );
+    YUI_CHECK_NEW( frame );
+
+    return frame;
+}
+
+
+YNullRadioButtonGroup *
+YNullWidgetFactory::createRadioButtonGroup( YWidget * parent )
+{
+    YNullRadioButtonGroup * radioButtonGroup = new YNullRadioButtonGroup( parent );
+    YUI_CHECK_NEW( radioButtonGroup );
+
+    return radioButtonGroup;
+}
+
+
+YNullReplacePoint *
+YNullWidgetFactory::createReplacePoint( YWidget * parent )
+{
+    YNullReplacePoint * replacePoint = new YNullReplacePoint( parent );
+    YUI_CHECK_NEW( replacePoint );
+
+    return replacePoint;
+}
+
+
+YNullItemSelector *
+YNullWidgetFactory::createItemSelector( YWidget * parent, bool enforceSingleSelection )
+{
+    YNullItemSelector * selector = new YNullItemSelector( parent, enforceSingleSelection );
+    YUI_CHECK_NEW( selector );
+
+    return selector;
+}
+
+
+YNullItemSelector *
+YNullWidgetFactory::createCustomStatusItemSelector( YWidget * parent, const YItemCustomStatusVector & customStates )
+{
+    YNullItemSelector * selector = new YNullItemSelector( parent, customStates );
+    YUI_CHECK_NEW( selector );
+
+    return selector;
+}
+
+
+YNullMenuBar *
+YNullWidgetFactory::createMenuBar( YWidget * parent )
+{
+    YNullMenuBar * menuBar = new YNullMenuBar( parent );
+    YUI_CHECK_NEW( menuBar );
+
+    return menuBar;
+}
+
+
+
+
+
+YNullOptionalWidgetFactory::YNullOptionalWidgetFactory()
+    : YOptionalWidgetFactory()
+{
+    // NOP
+}
+
+
+YNullOptionalWidgetFactory::~YNullOptionalWidgetFactory()
+{
+    // NOP
+}
+
+
+YNullDumbTab *
+YNullOptionalWidgetFactory::createDumbTab( YWidget * parent )
+{
+    YNullDumbTab * dumbTab = new YNullDumbTab( parent );
+    YUI_CHECK_NEW( dumbTab );
+
+    return dumbTab;
+}
+
+
+YNullSlider *
+YNullOptionalWidgetFactory::createSlider( YWidget * parent, const string & label, int minVal, int maxVal, int initialVal )
+{
+    YNullSlider * slider = new YNullSlider( parent, label, minVal, maxVal, initialVal );
+    YUI_CHECK_NEW( slider );
+
+    return slider;
+}
+
+
+YNullDateField *
+YNullOptionalWidgetFactory::createDateField( YWidget * parent, const string & label )
+{
+    YNullDateField * dateField = new YNullDateField( parent, label );
+    YUI_CHECK_NEW( dateField );
+
+    return dateField;
+}
+
+
+YNullTimeField *
+YNullOptionalWidgetFactory::createTimeField( YWidget * parent, const string & label )
+{
+    YNullTimeField * timeField = new YNullTimeField( parent, label );
+    YUI_CHECK_NEW( timeField );
+
+    return timeField;
+}
+
+
+YNullBarGraph *
+YNullOptionalWidgetFactory::createBarGraph( YWidget * parent )
+{
+    YNullBarGraph * barGraph = new YNullBarGraph( parent );
+    YUI_CHECK_NEW( barGraph );
+
+    return barGraph;
+}
+
+
+YNullMultiProgressMeter *
+YNullOptionalWidgetFactory::createMultiProgressMeter( YWidget * parent, YUIDimension dim, const std::vector<float> & maxValues )
+{
+    YNullMultiProgressMeter * multiProgressMeter = new YNullMultiProgressMeter( parent, dim, maxValues );
+    YUI_CHECK_NEW( multiProgressMeter );
+
+    return multiProgressMeter;
+}
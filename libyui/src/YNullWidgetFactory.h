@@ -0,0 +1,183 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YNullWidgetFactory.h
+
+/-*/
+
+#ifndef YNullWidgetFactory_h
+#define YNullWidgetFactory_h
+
+#include "YWidgetFactory.h"
+#include "YOptionalWidgetFactory.h"
+#include "YNullWidgets.h"
+
+
+/**
+ * Widget factory for the mandatory widgets of the null UI (see YNullUI.h).
+ *
+ * The package selector and the ncurses-only PkgSpecial widget are not
+ * supported; creating them throws YUIUnsupportedWidgetException.
+ **/
+class YNullWidgetFactory: public YWidgetFactory
+{
+public:
+
+    //
+    // Dialogs
+    //
+
+    virtual YNullDialog *		createDialog		( YDialogType dialogType, YDialogColorMode colorMode = YDialogNormalColor );
+
+    //
+    // Layout Boxes
+    //
+
+    virtual YNullLayoutBox *		createLayoutBox		( YWidget * parent, YUIDimension dimension );
+    virtual YNullButtonBox *		createButtonBox		( YWidget * parent );
+
+    //
+    // Common Leaf Widgets
+    //
+
+    virtual YNullPushButton *		createPushButton	( YWidget * parent, const std::string & label );
+    virtual YNullLabel *		createLabel		( YWidget * parent, const std::string & text, bool isHeading = false, bool isOutputField = false );
+    virtual YNullInputField *		createInputField	( YWidget * parent, const std::string & label, bool passwordMode = false );
+    virtual YNullCheckBox *		createCheckBox		( YWidget * parent, const std::string & label, bool isChecked = false );
+    virtual YNullRadioButton *		createRadioButton	( YWidget * parent, const std::string & label, bool isChecked = false );
+    virtual YNullComboBox *		createComboBox		( YWidget * parent, const std::string & label, bool editable  = false );
+    virtual YNullSelectionBox *		createSelectionBox	( YWidget * parent, const std::string & label );
+    virtual YNullTree *			createTree		( YWidget * parent, const std::string & label, bool multiselection = false, bool recursiveselection = false );
+    virtual YNullTable *		createTable		( YWidget * parent, YTableHeader * header_disown, bool multiSelection = false );
+    virtual YNullProgressBar *		createProgressBar	( YWidget * parent, const std::string & label, int maxValue = 100 );
+    virtual YNullRichText *		createRichText		( YWidget * parent, const std::string & text = std::string(), bool plainTextMode = false );
+    virtual YNullBusyIndicator *	createBusyIndicator	( YWidget * parent, const std::string & label, int timeout = 1000 );
+
+    //
+    // Less Common Leaf Widgets
+    //
+
+    virtual YNullIntField *		createIntField		( YWidget * parent, const std::string & label, int minVal, int maxVal, int initialVal );
+    virtual YNullMenuButton *		createMenuButton	( YWidget * parent, const std::string & label );
+    virtual YNullMultiLineEdit *	createMultiLineEdit	( YWidget * parent, const std::string & label );
+    virtual YNullImage *		createImage		( YWidget * parent, const std::string & imageFileName, bool animated = false );
+    virtual YNullLogView *		createLogView		( YWidget * parent, const std::string & label, int visibleLines, int storedLines = 0 );
+    virtual YNullMultiSelectionBox *	createMultiSelectionBox ( YWidget * parent, const std::string & label );
+
+    virtual YPackageSelector *		createPackageSelector	( YWidget * parent, long modeFlags = 0 );
+    virtual YWidget *			createPkgSpecial	( YWidget * parent, const std::string & subwidgetName );
+
+    //
+    // Layout Helpers
+    //
+
+    virtual YNullSpacing *		createSpacing		( YWidget * parent, YUIDimension dim, bool stretchable = false, YLayoutSize_t size = 0.0 );
+    virtual YNullEmpty *		createEmpty		( YWidget * parent );
+    virtual YNullAlignment *		createAlignment		( YWidget * parent, YAlignmentType horAlignment, YAlignmentType vertAlignment );
+    virtual YNullSquash *		createSquash		( YWidget * parent, bool horSquash, bool vertSquash );
+
+    //
+    // Visual Grouping
+    //
+
+    virtual YNullFrame *		createFrame		( YWidget * parent, const std::string & label );
+    virtual YNullCheckBoxFrame *	createCheckBoxFrame	( YWidget * parent, const std::string & label, bool checked );
+
+    //
+    // Logical Grouping
+    //
+
+    virtual YNullRadioButtonGroup *	createRadioButtonGroup	( YWidget * parent );
+    virtual YNullReplacePoint *		createReplacePoint	( YWidget * parent );
+
+    //
+    // More leaf widgets
+    //
+
+    virtual YNullItemSelector *		createItemSelector		( YWidget * parent, bool enforceSingleSelection = true );
+    virtual YNullItemSelector *		createCustomStatusItemSelector	( YWidget * parent, const YItemCustomStatusVector & customStates );
+    virtual YNullMenuBar *		createMenuBar			( YWidget * parent );
+
+
+protected:
+
+    friend class YNullUI;
+
+    /**
+     * Constructor. Use YUI::widgetFactory() to get the singleton.
+     **/
+    YNullWidgetFactory();
+
+    /**
+     * Destructor.
+     **/
+    virtual ~YNullWidgetFactory();
+
+}; // class YNullWidgetFactory
+
+
+/**
+ * Widget factory for the optional widgets of the null UI: DumbTab, Slider,
+ * DateField, TimeField, BarGraph and MultiProgressMeter. Everything else is
+ * left to the YOptionalWidgetFactory defaults (i.e. not supported).
+ **/
+class YNullOptionalWidgetFactory: public YOptionalWidgetFactory
+{
+public:
+
+    virtual bool			hasDumbTab()		{ return true; }
+    virtual YNullDumbTab *		createDumbTab		( YWidget * parent );
+
+    virtual bool			hasSlider()		{ return true; }
+    virtual YNullSlider *		createSlider		( YWidget *		parent,
+								  const std::string &	label,
+								  int			minVal,
+								  int			maxVal,
+								  int			initialVal );
+
+    virtual bool			hasDateField()		{ return true; }
+    virtual YNullDateField *		createDateField		( YWidget * parent, const std::string & label );
+
+    virtual bool			hasTimeField()		{ return true; }
+    virtual YNullTimeField *		createTimeField		( YWidget * parent, const std::string & label );
+
+    virtual bool			hasBarGraph()		{ return true; }
+    virtual YNullBarGraph *		createBarGraph		( YWidget * parent );
+
+    virtual bool			hasMultiProgressMeter()	{ return true; }
+    virtual YNullMultiProgressMeter *	createMultiProgressMeter ( YWidget * parent, YUIDimension dim, const std::vector<float> & maxValues );
+
+
+protected:
+
+    friend class YNullUI;
+
+    /**
+     * Constructor. Use YUI::optionalWidgetFactory() to get the singleton.
+     **/
+    YNullOptionalWidgetFactory();
+
+    /**
+     * Destructor.
+     **/
+    virtual ~YNullOptionalWidgetFactory();
+
+}; // class YNullOptionalWidgetFactory
+
+
+#endif // YNullWidgetFactory_h
@@ -0,0 +1,496 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YNullWidgets.cc
+
+/-*/
+
+
+#include <algorithm>
+
+#define YUILogComponent "null-ui"
+#include "YUILog.h"
+
+#include "YNullWidgets.h"
+#include "YNullUI.h"
+#include "YUIException.h"
+#include "YShortcut.h"
+#include "YTreeItem.h"
+#include "YTableItem.h"
+#include "YMenuItem.h"
+#include "YRadioButtonGroup.h"
+
+using std::string;
+
+
+// Preferred size of widgets that show a list of some kind
+#define LIST_WIDTH	20
+#define LIST_HEIGHT	5
+
+// Preferred width of input fields and the like
+#define FIELD_WIDTH	10
+
+
+/**
+ * Return the width of the widest line of 'text' in characters.
+ **/
+static int textWidth( const string & text )
+{
+    int maxWidth = 0;
+    int width	 = 0;
+
+    for ( unsigned char c: text )
+    {
+	if ( c == '\n' )
+	{
+	    maxWidth = std::max( maxWidth, width );
+	    width    = 0;
+	}
+	else if ( ( c & 0xC0 ) != 0x80 ) // Don't count UTF-8 continuation bytes
+	{
+	    width++;
+	}
+    }
+
+    return std::max( maxWidth, width );
+}
+
+
+/**
+ * Return the width of a widget label without its shortcut marker.
+ **/
+static int labelWidth( const string & label )
+{
+    return textWidth( YShortcut::cleanShortcutString( label ) );
+}
+
+
+/**
+ * Return the number of lines of 'text'.
+ **/
+static int textHeight( const string & text )
+{
+    return std::count( text.begin(), text.end(), '\n' ) + 1;
+}
+
+
+/**
+ * Return the height of a label above a widget: 1 if there is a label, 0 if
+ * not.
+ **/
+static int labelHeight( const string & label )
+{
+    return label.empty() ? 0 : 1;
+}
+
+
+/**
+ * Return the null UI. Its event queue is where user actions end up.
+ **/
+static YNullUI * nullUI()
+{
+    YNullUI * ui = YNullUI::ui();
+    YUI_CHECK_PTR( ui );
+
+    return ui;
+}
+
+
+
+
+YNullDialog::YNullDialog( YDialogType dialogType, YDialogColorMode colorMode )
+    : YDialog( dialogType, colorMode )
+{
+}
+
+
+YNullDialog::~YNullDialog()
+{
+}
+
+
+int
+YNullDialog::preferredWidth()
+{
+    if ( dialogType() == YMainDialog || dialogType() == YWizardDialog )
+	return YUI::app()->displayWidth();
+
+    return YDialog::preferredWidth();
+}
+
+
+int
+YNullDialog::preferredHeight()
+{
+    if ( dialogType() == YMainDialog || dialogType() == YWizardDialog )
+	return YUI::app()->displayHeight();
+
+    return YDialog::preferredHeight();
+}
+
+
+YEvent *
+YNullDialog::waitForEventInternal( int timeout_millisec )
+{
+    YEvent * event = nullUI()->nextEvent( this );
+
+    if ( ! event )
+    {
+	if ( timeout_millisec > 0 )
+	    event = new YTimeoutEvent();
+	else
+	    event = new YCancelEvent();
+    }
+
+    return event;
+}
+
+
+YEvent *
+YNullDialog::pollEventInternal()
+{
+    return nullUI()->nextEvent( this );
+}
+
+
+
+
+int
+YNullDumbTab::preferredWidth()
+{
+    int width = hasChildren() ? firstChild()->preferredWidth() : 0;
+
+    return width + 2;
+}
+
+
+int
+YNullDumbTab::preferredHeight()
+{
+    int height = hasChildren() ? firstChild()->preferredHeight() : 0;
+
+    return height + 3;
+}
+
+
+void
+YNullDumbTab::setSize( int newWidth, int newHeight )
+{
+    if ( hasChildren() )
+	firstChild()->setSize( std::max( 0, newWidth - 2 ), std::max( 0, newHeight - 3 ) );
+}
+
+
+void
+YNullDumbTab::activate()
+{
+    YItem * item = selectedItem();
+
+    if ( item )
+	nullUI()->queueEvent( new YMenuEvent( item ) );
+}
+
+
+
+
+int YNullPushButton::preferredWidth()	{ return labelWidth( label() ) + 4; }
+int YNullPushButton::preferredHeight()	{ return 1; }
+
+
+void
+YNullPushButton::activate()
+{
+    nullUI()->queueEvent( new YWidgetEvent( this, YEvent::Activated ) );
+}
+
+
+
+
+int YNullLabel::preferredWidth()	{ return textWidth( text() );  }
+int YNullLabel::preferredHeight()	{ return textHeight( text() ); }
+
+
+
+
+int YNullInputField::preferredWidth()	{ return std::max( FIELD_WIDTH, labelWidth( label() ) ); }
+int YNullInputField::preferredHeight()	{ return labelHeight( label() ) + 1; }
+
+
+
+
+int YNullCheckBox::preferredWidth()	{ return labelWidth( label() ) + 4; }
+int YNullCheckBox::preferredHeight()	{ return 1; }
+
+
+
+
+YNullRadioButton::YNullRadioButton( YWidget * parent, const string & label, bool isChecked )
+    : YRadioButton( parent, label )
+    , _checked( false )
+{
+    if ( buttonGroup() )
+	buttonGroup()->addRadioButton( this );
+
+    setValue( isChecked );
+}
+
+
+int YNullRadioButton::preferredWidth()	{ return labelWidth( label() ) + 4; }
+int YNullRadioButton::preferredHeight()	{ return 1; }
+
+
+void
+YNullRadioButton::setValue( bool checked )
+{
+    _checked = checked;
+
+    if ( checked && buttonGroup() )
+	buttonGroup()->uncheckOtherButtons( this );
+}
+
+
+
+
+int YNullComboBox::preferredWidth()	{ return std::max( FIELD_WIDTH, labelWidth( label() ) ); }
+int YNullComboBox::preferredHeight()	{ return labelHeight( label() ) + 1; }
+
+
+
+
+int YNullSelectionBox::preferredWidth()	 { return std::max( LIST_WIDTH, labelWidth( label() ) ); }
+int YNullSelectionBox::preferredHeight() { return labelHeight( label() ) + LIST_HEIGHT; }
+
+
+
+
+int YNullMultiSelectionBox::preferredWidth()	{ return std::max( LIST_WIDTH, labelWidth( label() ) ); }
+int YNullMultiSelectionBox::preferredHeight()	{ return labelHeight( label() ) + LIST_HEIGHT; }
+
+
+void
+YNullMultiSelectionBox::deleteAllItems()
+{
+    _currentItem = 0;
+    YMultiSelectionBox::deleteAllItems();
+}
+
+
+
+
+int YNullTree::preferredWidth()		{ return std::max( LIST_WIDTH, labelWidth( label() ) ); }
+int YNullTree::preferredHeight()	{ return labelHeight( label() ) + LIST_HEIGHT; }
+
+
+YTreeItem *
+YNullTree::currentItem()
+{
+    return dynamic_cast<YTreeItem *>( selectedItem() );
+}
+
+
+void
+YNullTree::activate()
+{
+    nullUI()->queueEvent( new YWidgetEvent( this, YEvent::Activated ) );
+}
+
+
+
+
+int
+YNullTable::preferredWidth()
+{
+    // Each column is as wide as its header or its widest cell plus a separator
+    int width = 0;
+
+    for ( int col = 0; col < columns(); col++ )
+    {
+	int colWidth = textWidth( header( col ) );
+
+	for ( YItemConstIterator it = itemsBegin(); it != itemsEnd(); ++it )
+	{
+	    const YTableItem * item = dynamic_cast<const YTableItem *>( *it );
+
+	    if ( item && item->hasCell( col ) )
+		colWidth = std::max( colWidth, textWidth( item->cell( col )->label() ) );
+	}
+
+	width += colWidth + 1;
+    }
+
+    return std::max( LIST_WIDTH, width );
+}
+
+
+int YNullTable::preferredHeight()	{ return LIST_HEIGHT + 1; }
+
+
+
+
+int YNullItemSelector::preferredWidth()		{ return LIST_WIDTH; }
+int YNullItemSelector::preferredHeight()	{ return LIST_HEIGHT; }
+
+
+void
+YNullItemSelector::activateItem( YItem * item )
+{
+    selectItem( item, ! item->selected() || enforceSingleSelection() );
+    nullUI()->queueEvent( new YWidgetEvent( this, YEvent::ValueChanged ) );
+}
+
+
+
+
+int YNullMenuButton::preferredWidth()	{ return labelWidth( label() ) + 4; }
+int YNullMenuButton::preferredHeight()	{ return 1; }
+
+
+void
+YNullMenuButton::activateItem( YMenuItem * item )
+{
+    nullUI()->queueEvent( new YMenuEvent( item ) );
+}
+
+
+
+
+int
+YNullMenuBar::preferredWidth()
+{
+    int width = 0;
+
+    for ( YItemConstIterator it = itemsBegin(); it != itemsEnd(); ++it )
+    {
+	const YMenuItem * item = dynamic_cast<const YMenuItem *>( *it );
+
+	if ( ! item || item->isVisible() )
+	    width += labelWidth( (*it)->label() ) + 2;
+    }
+
+    return std::max( LIST_WIDTH, width );
+}
+
+
+int YNullMenuBar::preferredHeight()	{ return 1; }
+
+
+void
+YNullMenuBar::activateItem( YMenuItem * item )
+{
+    nullUI()->queueEvent( new YMenuEvent( item ) );
+}
+
+
+
+
+int YNullProgressBar::preferredWidth()	{ return std::max( FIELD_WIDTH, labelWidth( label() ) ); }
+int YNullProgressBar::preferredHeight()	{ return labelHeight( label() ) + 1; }
+
+
+
+
+int
+YNullRichText::preferredWidth()
+{
+    if ( shrinkable() )
+	return 10;
+
+    // Plain text is not wrapped
+    return std::max( 40, plainTextMode() ? textWidth( value() ) : 0 );
+}
+
+
+int YNullRichText::preferredHeight()	{ return shrinkable() ?	 2 : 10; }
+
+
+void
+YNullRichText::activateLink( const string & url )
+{
+    nullUI()->queueEvent( new YMenuEvent( url ) );
+}
+
+
+
+
+int YNullBusyIndicator::preferredWidth()  { return std::max( FIELD_WIDTH, labelWidth( label() ) ); }
+int YNullBusyIndicator::preferredHeight() { return labelHeight( label() ) + 1; }
+
+
+
+
+int YNullIntField::preferredWidth()	{ return std::max( FIELD_WIDTH, labelWidth( label() ) ); }
+int YNullIntField::preferredHeight()	{ return labelHeight( label() ) + 1; }
+
+
+
+
+int YNullSlider::preferredWidth()	{ return std::max( LIST_WIDTH, labelWidth( label() ) ); }
+int YNullSlider::preferredHeight()	{ return labelHeight( label() ) + 1; }
+
+
+
+
+int YNullMultiLineEdit::preferredWidth()	{ return std::max( LIST_WIDTH, labelWidth( label() ) ); }
+int YNullMultiLineEdit::preferredHeight()	{ return labelHeight( label() ) + defaultVisibleLines(); }
+
+
+
+
+int YNullImage::preferredWidth()	{ return FIELD_WIDTH; }
+int YNullImage::preferredHeight()	{ return LIST_HEIGHT; }
+
+
+
+
+int YNullLogView::preferredWidth()	{ return std::max( LIST_WIDTH, labelWidth( label() ) ); }
+int YNullLogView::preferredHeight()	{ return labelHeight( label() ) + visibleLines(); }
+
+
+
+
+int YNullDateField::preferredWidth()	{ return std::max( FIELD_WIDTH, labelWidth( label() ) ); }
+int YNullDateField::preferredHeight()	{ return labelHeight( label() ) + 1; }
+
+
+
+
+int YNullTimeField::preferredWidth()	{ return std::max( FIELD_WIDTH, labelWidth( label() ) ); }
+int YNullTimeField::preferredHeight()	{ return labelHeight( label() ) + 1; }
+
+
+
+
+int
+YNullBarGraph::preferredWidth()
+{
+    int width = 0;
+
+    for ( int i = 0; i < segments(); i++ )
+	width += std::max( 5, textWidth( segment( i ).label() ) );
+
+    return std::max( LIST_WIDTH, width );
+}
+
+
+int YNullBarGraph::preferredHeight()	{ return 1; }
+
+
+
+
+int YNullMultiProgressMeter::preferredWidth()	{ return horizontal() ? LIST_WIDTH : segments(); }
+int YNullMultiProgressMeter::preferredHeight()	{ return horizontal() ? 1 : LIST_HEIGHT; }
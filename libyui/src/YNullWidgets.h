@@ -0,0 +1,611 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YNullWidgets.h
+
+/-*/
+
+#ifndef YNullWidgets_h
+#define YNullWidgets_h
+
+#include "YAlignment.h"
+#include "YBarGraph.h"
+#include "YBusyIndicator.h"
+#include "YButtonBox.h"
+#include "YCheckBox.h"
+#include "YCheckBoxFrame.h"
+#include "YComboBox.h"
+#include "YDateField.h"
+#include "YDialog.h"
+#include "YDumbTab.h"
+#include "YEmpty.h"
+#include "YFrame.h"
+#include "YImage.h"
+#include "YInputField.h"
+#include "YIntField.h"
+#include "YItemSelector.h"
+#include "YLabel.h"
+#include "YLayoutBox.h"
+#include "YLogView.h"
+#include "YMenuBar.h"
+#include "YMenuButton.h"
+#include "YMultiLineEdit.h"
+#include "YMultiProgressMeter.h"
+#include "YMultiSelectionBox.h"
+#include "YProgressBar.h"
+#include "YPushButton.h"
+#include "YRadioButton.h"
+#include "YRadioButtonGroup.h"
+#include "YReplacePoint.h"
+#include "YRichText.h"
+#include "YSelectionBox.h"
+#include "YSlider.h"
+#include "YSpacing.h"
+#include "YSquash.h"
+#include "YTable.h"
+#include "YTimeField.h"
+#include "YTree.h"
+
+
+//
+// Widgets of the null UI (see YNullUI.h).
+//
+// The layout of leaf widgets is trivial: The preferred size is either
+// fixed or derived from the label, and setSize() does nothing. Container
+// widgets use the layout of their libyui base class. User actions like
+// activate() queue the same events a real UI would send.
+//
+
+
+class YNullDialog: public YDialog
+{
+public:
+    YNullDialog( YDialogType dialogType, YDialogColorMode colorMode );
+    virtual ~YNullDialog();
+
+    /**
+     * Main dialogs use the full display, popups their preferred size.
+     **/
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+
+    virtual void activate() {}
+
+protected:
+    virtual void openInternal() {}
+
+    /**
+     * Return the next scripted event or, if there is none, a timeout event
+     * if a timeout was specified and a cancel event otherwise.
+     **/
+    virtual YEvent * waitForEventInternal( int timeout_millisec );
+
+    /**
+     * Return the next scripted event or 0 if there is none.
+     **/
+    virtual YEvent * pollEventInternal();
+};
+
+
+//
+// Layout containers
+//
+
+class YNullLayoutBox: public YLayoutBox
+{
+public:
+    YNullLayoutBox( YWidget * parent, YUIDimension dim ): YLayoutBox( parent, dim ) {}
+    virtual void moveChild( YWidget * child, int newX, int newY ) {}
+};
+
+
+class YNullButtonBox: public YButtonBox
+{
+public:
+    YNullButtonBox( YWidget * parent ): YButtonBox( parent ) {}
+    virtual void moveChild( YWidget * child, int newX, int newY ) {}
+};
+
+
+class YNullAlignment: public YAlignment
+{
+public:
+    YNullAlignment( YWidget * parent, YAlignmentType horAlign, YAlignmentType vertAlign )
+	: YAlignment( parent, horAlign, vertAlign ) {}
+    virtual void moveChild( YWidget * child, int newX, int newY ) {}
+};
+
+
+class YNullSpacing: public YSpacing
+{
+public:
+    YNullSpacing( YWidget * parent, YUIDimension dim, bool stretchable, YLayoutSize_t layoutUnits )
+	: YSpacing( parent, dim, stretchable, layoutUnits ) {}
+    virtual void setSize( int newWidth, int newHeight ) {}
+};
+
+
+class YNullEmpty: public YEmpty
+{
+public:
+    YNullEmpty( YWidget * parent ): YEmpty( parent ) {}
+    virtual void setSize( int newWidth, int newHeight ) {}
+};
+
+
+class YNullSquash: public YSquash
+{
+public:
+    YNullSquash( YWidget * parent, bool horSquash, bool vertSquash )
+	: YSquash( parent, horSquash, vertSquash ) {}
+};
+
+
+class YNullFrame: public YFrame
+{
+public:
+    YNullFrame( YWidget * parent, const std::string & label ): YFrame( parent, label ) {}
+};
+
+
+class YNullCheckBoxFrame: public YCheckBoxFrame
+{
+public:
+    YNullCheckBoxFrame( YWidget * parent, const std::string & label, bool checked )
+	: YCheckBoxFrame( parent, label, checked ), _checked( checked ) {}
+
+    virtual bool value() { return _checked; }
+    virtual void setValue( bool isChecked ) { _checked = isChecked; }
+
+private:
+    bool _checked;
+};
+
+
+class YNullRadioButtonGroup: public YRadioButtonGroup
+{
+public:
+    YNullRadioButtonGroup( YWidget * parent ): YRadioButtonGroup( parent ) {}
+};
+
+
+class YNullReplacePoint: public YReplacePoint
+{
+public:
+    YNullReplacePoint( YWidget * parent ): YReplacePoint( parent ) {}
+};
+
+
+class YNullDumbTab: public YDumbTab
+{
+public:
+    YNullDumbTab( YWidget * parent ): YDumbTab( parent ) {}
+
+    /**
+     * The size of the single child plus the tab bar and a frame.
+     **/
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight );
+
+    virtual void activate();
+};
+
+
+//
+// Leaf widgets
+//
+
+class YNullPushButton: public YPushButton
+{
+public:
+    YNullPushButton( YWidget * parent, const std::string & label ): YPushButton( parent, label ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual void activate();
+};
+
+
+class YNullLabel: public YLabel
+{
+public:
+    YNullLabel( YWidget * parent, const std::string & text, bool isHeading, bool isOutputField )
+	: YLabel( parent, text, isHeading, isOutputField ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+};
+
+
+class YNullInputField: public YInputField
+{
+public:
+    YNullInputField( YWidget * parent, const std::string & label, bool passwordMode )
+	: YInputField( parent, label, passwordMode ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual std::string value() { return _value; }
+    virtual void setValue( const std::string & text ) { _value = text; }
+
+private:
+    std::string _value;
+};
+
+
+class YNullCheckBox: public YCheckBox
+{
+public:
+    YNullCheckBox( YWidget * parent, const std::string & label, bool isChecked )
+	: YCheckBox( parent, label )
+	, _value( isChecked ? YCheckBox_on : YCheckBox_off ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual YCheckBoxState value() { return _value; }
+    virtual void setValue( YCheckBoxState state ) { _value = state; }
+
+private:
+    YCheckBoxState _value;
+};
+
+
+class YNullRadioButton: public YRadioButton
+{
+public:
+    YNullRadioButton( YWidget * parent, const std::string & label, bool isChecked );
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual bool value() { return _checked; }
+
+    /**
+     * Set the value. Checking this radio button unchecks all others of the
+     * same radio button group.
+     **/
+    virtual void setValue( bool checked );
+
+private:
+    bool _checked;
+};
+
+
+class YNullComboBox: public YComboBox
+{
+public:
+    YNullComboBox( YWidget * parent, const std::string & label, bool editable )
+	: YComboBox( parent, label, editable ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+protected:
+    virtual std::string text() { return _text; }
+    virtual void setText( const std::string & newText ) { _text = newText; }
+
+private:
+    std::string _text;
+};
+
+
+class YNullSelectionBox: public YSelectionBox
+{
+public:
+    YNullSelectionBox( YWidget * parent, const std::string & label )
+	: YSelectionBox( parent, label ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+};
+
+
+class YNullMultiSelectionBox: public YMultiSelectionBox
+{
+public:
+    YNullMultiSelectionBox( YWidget * parent, const std::string & label )
+	: YMultiSelectionBox( parent, label ), _currentItem( 0 ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual YItem * currentItem() { return _currentItem; }
+    virtual void setCurrentItem( YItem * item ) { _currentItem = item; }
+    virtual void deleteAllItems();
+
+private:
+    YItem * _currentItem;
+};
+
+
+class YNullTree: public YTree
+{
+public:
+    YNullTree( YWidget * parent, const std::string & label, bool multiSelection, bool recursiveSelection )
+	: YTree( parent, label, multiSelection, recursiveSelection ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual void rebuildTree() {}
+    virtual YTreeItem * currentItem();
+    virtual void activate();
+};
+
+
+class YNullTable: public YTable
+{
+public:
+    YNullTable( YWidget * parent, YTableHeader * header, bool multiSelection )
+	: YTable( parent, header, multiSelection ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual void cellChanged( const YTableCell * cell ) { invalidatePreferredSize(); }
+};
+
+
+class YNullItemSelector: public YItemSelector
+{
+public:
+    YNullItemSelector( YWidget * parent, bool enforceSingleSelection )
+	: YItemSelector( parent, enforceSingleSelection ) {}
+
+    YNullItemSelector( YWidget * parent, const YItemCustomStatusVector & customStates )
+	: YItemSelector( parent, customStates ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual void activateItem( YItem * item );
+};
+
+
+class YNullMenuButton: public YMenuButton
+{
+public:
+    YNullMenuButton( YWidget * parent, const std::string & label ): YMenuButton( parent, label ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual void rebuildMenuTree() { invalidatePreferredSize(); }
+    virtual void activateItem( YMenuItem * item );
+};
+
+
+class YNullMenuBar: public YMenuBar
+{
+public:
+    YNullMenuBar( YWidget * parent ): YMenuBar( parent ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual void rebuildMenuTree() { invalidatePreferredSize(); }
+    virtual void activateItem( YMenuItem * item );
+};
+
+
+class YNullProgressBar: public YProgressBar
+{
+public:
+    YNullProgressBar( YWidget * parent, const std::string & label, int maxValue )
+	: YProgressBar( parent, label, maxValue ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+};
+
+
+class YNullRichText: public YRichText
+{
+public:
+    YNullRichText( YWidget * parent, const std::string & text, bool plainTextMode )
+	: YRichText( parent, text, plainTextMode ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual void activateLink( const std::string & url );
+};
+
+
+class YNullBusyIndicator: public YBusyIndicator
+{
+public:
+    YNullBusyIndicator( YWidget * parent, const std::string & label, int timeout )
+	: YBusyIndicator( parent, label, timeout ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+};
+
+
+class YNullIntField: public YIntField
+{
+public:
+    YNullIntField( YWidget * parent, const std::string & label, int minValue, int maxValue, int initialValue )
+	: YIntField( parent, label, minValue, maxValue ), _value( minValue )
+	{ setValue( initialValue ); }
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual int value() { return _value; }
+
+protected:
+    virtual void setValueInternal( int val ) { _value = val; }
+
+private:
+    int _value;
+};
+
+
+class YNullSlider: public YSlider
+{
+public:
+    YNullSlider( YWidget * parent, const std::string & label, int minValue, int maxValue, int initialValue )
+	: YSlider( parent, label, minValue, maxValue ), _value( minValue )
+	{ setValue( initialValue ); }
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual int value() { return _value; }
+
+protected:
+    virtual void setValueInternal( int val ) { _value = val; }
+
+private:
+    int _value;
+};
+
+
+class YNullMultiLineEdit: public YMultiLineEdit
+{
+public:
+    YNullMultiLineEdit( YWidget * parent, const std::string & label )
+	: YMultiLineEdit( parent, label ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual std::string value() { return _value; }
+    virtual void setValue( const std::string & text ) { _value = text; }
+
+private:
+    std::string _value;
+};
+
+
+class YNullImage: public YImage
+{
+public:
+    YNullImage( YWidget * parent, const std::string & imageFileName, bool animated )
+	: YImage( parent, imageFileName, animated ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+};
+
+
+class YNullLogView: public YLogView
+{
+public:
+    YNullLogView( YWidget * parent, const std::string & label, int visibleLines, int storedLines )
+	: YLogView( parent, label, visibleLines, storedLines ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+protected:
+    virtual void displayLogText( const std::string & text ) {}
+};
+
+
+class YNullDateField: public YDateField
+{
+public:
+    YNullDateField( YWidget * parent, const std::string & label ): YDateField( parent, label ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual std::string value() { return _value; }
+    virtual void setValue( const std::string & text ) { _value = text; }
+
+private:
+    std::string _value;
+};
+
+
+class YNullTimeField: public YTimeField
+{
+public:
+    YNullTimeField( YWidget * parent, const std::string & label ): YTimeField( parent, label ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+    virtual std::string value() { return _value; }
+    virtual void setValue( const std::string & text ) { _value = text; }
+
+private:
+    std::string _value;
+};
+
+
+class YNullBarGraph: public YBarGraph
+{
+public:
+    YNullBarGraph( YWidget * parent ): YBarGraph( parent ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+protected:
+    virtual void doUpdate() {}
+};
+
+
+class YNullMultiProgressMeter: public YMultiProgressMeter
+{
+public:
+    YNullMultiProgressMeter( YWidget * parent, YUIDimension dim, const std::vector<float> & maxValues )
+	: YMultiProgressMeter( parent, dim, maxValues ) {}
+
+    virtual int preferredWidth();
+    virtual int preferredHeight();
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+protected:
+    virtual void doUpdate() {}
+};
+
+
+#endif // YNullWidgets_h
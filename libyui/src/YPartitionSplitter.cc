@@ -177,14 +177,14 @@ YPartitionSplitter::propertySet()
 
 
 bool
-YPartitionSplitter::setProperty( const string & propertyName, const YPropertyValue & val )
+YPartitionSplitter::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.integerVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	setValue( val.integerVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -192,13 +192,13 @@ YPartitionSplitter::setProperty( const string & propertyName, const YPropertyVal
 
 
 YPropertyValue
-YPartitionSplitter::getProperty( const string & propertyName )
+YPartitionSplitter::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( value() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
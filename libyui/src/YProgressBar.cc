@@ -80,6 +80,7 @@ string YProgressBar::label()
 void YProgressBar::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -128,15 +129,15 @@ YProgressBar::propertySet()
 
 
 bool
-YProgressBar::setProperty( const string & propertyName, const YPropertyValue & val )
+YProgressBar::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.integerVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	setValue( val.integerVal() );
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -144,14 +145,14 @@ YProgressBar::setProperty( const string & propertyName, const YPropertyValue & v
 
 
 YPropertyValue
-YProgressBar::getProperty( const string & propertyName )
+YProgressBar::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( value() );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
@@ -22,12 +22,213 @@
 
 /-*/
 
+#include <string.h>
+#include <functional>
+#include <vector>
+
 #include "YProperty.h"
+#include "YUISymbols.h"
 #include "YUIException.h"
 
 using std::string;
 
 
+/**
+ * Property names for each interned property ID.
+ * This has to be kept in sync with enum YPropertyId.
+ **/
+static const char * propertyIdNames[] =
+{
+    "",		// YUIPropertyId_Unknown
+    YUIProperty_Alive,
+    YUIProperty_Cell,
+    YUIProperty_ContextMenu,
+    YUIProperty_CurrentBranch,
+    YUIProperty_CurrentButton,
+    YUIProperty_CurrentItem,
+    YUIProperty_CurrentSize,
+    YUIProperty_DebugLabel,
+    YUIProperty_EasterEgg,
+    YUIProperty_Enabled,
+    YUIProperty_EnabledItems,
+    YUIProperty_ExpectedSize,
+    YUIProperty_Filename,
+    YUIProperty_Layout,
+    YUIProperty_HelpText,
+    YUIProperty_IconPath,
+    YUIProperty_InputMaxLength,
+    YUIProperty_HWeight,
+    YUIProperty_HStretch,
+    YUIProperty_ID,
+    YUIProperty_Item,
+    YUIProperty_Items,
+    YUIProperty_ItemStatus,
+    YUIProperty_Label,
+    YUIProperty_Labels,
+    YUIProperty_LastLine,
+    YUIProperty_MaxLines,
+    YUIProperty_MaxValue,
+    YUIProperty_MinValue,
+    YUIProperty_MultiSelection,
+    YUIProperty_Notify,
+    YUIProperty_OpenItems,
+    YUIProperty_SelectedItems,
+    YUIProperty_Text,
+    YUIProperty_Timeout,
+    YUIProperty_ValidChars,
+    YUIProperty_Value,
+    YUIProperty_Values,
+    YUIProperty_VisibleLines,
+    YUIProperty_VisibleItems,
+    YUIProperty_VWeight,
+    YUIProperty_VStretch,
+    YUIProperty_WidgetClass,
+    YUIProperty_VScrollValue,
+    YUIProperty_HScrollValue,
+};
+
+static_assert( sizeof( propertyIdNames ) / sizeof( propertyIdNames[0] ) == YUIPropertyId_Count,
+	       "propertyIdNames[] is out of sync with enum YPropertyId" );
+
+
+// Number of slots of the perfect hash table; must be a power of 2
+#define PROPERTY_HASH_SLOTS	256
+
+
+/**
+ * Perfect hash of the well-known property names: The seed of the hash
+ * function is chosen at startup so that no two names end up in the same
+ * slot, so a lookup is one hash calculation and at most one string
+ * comparison to reject names that are not well-known.
+ **/
+class YPropertyNameHash
+{
+public:
+
+    YPropertyNameHash();
+
+    YPropertyId lookup( const string & name ) const;
+
+private:
+
+    static unsigned hash( const char * str, size_t len, unsigned seed );
+
+    bool tryFill( unsigned seed );
+
+    unsigned		_seed;
+    unsigned char	_slots[ PROPERTY_HASH_SLOTS ];
+};
+
+
+YPropertyNameHash::YPropertyNameHash()
+    : _seed( 0 )
+{
+    static_assert( YUIPropertyId_Count <= 256, "YPropertyId does not fit into a slot" );
+
+    while ( ! tryFill( _seed ) )
+    {
+	if ( ++_seed > 100000 )
+	    YUI_THROW( YUIException( "Can't find a perfect hash for the property names" ) );
+    }
+}
+
+
+unsigned
+YPropertyNameHash::hash( const char * str, size_t len, unsigned seed )
+{
+    // FNV-1a with the seed mixed into the offset basis
+
+    unsigned hash = 2166136261u ^ ( seed * 16777619u );
+
+    for ( size_t i = 0; i < len; i++ )
+    {
+	hash ^= (unsigned char) str[i];
+	hash *= 16777619u;
+    }
+
+    return hash ^ ( hash >> 15 );
+}
+
+
+bool
+YPropertyNameHash::tryFill( unsigned seed )
+{
+    memset( _slots, 0, sizeof( _slots ) );
+
+    for ( int id = YUIPropertyId_Unknown + 1; id < YUIPropertyId_Count; id++ )
+    {
+	const char * name = propertyIdNames[ id ];
+	unsigned slot = hash( name, strlen( name ), seed ) & ( PROPERTY_HASH_SLOTS - 1 );
+
+	if ( _slots[ slot ] != 0 )
+	    return false; // collision
+
+	_slots[ slot ] = id;
+    }
+
+    return true;
+}
+
+
+YPropertyId
+YPropertyNameHash::lookup( const string & name ) const
+{
+    unsigned slot = hash( name.data(), name.size(), _seed ) & ( PROPERTY_HASH_SLOTS - 1 );
+    YPropertyId id = (YPropertyId) _slots[ slot ];
+
+    if ( id != YUIPropertyId_Unknown && name == propertyIdNames[ id ] )
+	return id;
+
+    return YUIPropertyId_Unknown;
+}
+
+
+/**
+ * Return the interned name strings, indexed by property ID.
+ **/
+static const string *
+propertyIdStrings()
+{
+    static const std::vector<string> strings( propertyIdNames,
+					      propertyIdNames + YUIPropertyId_Count );
+    return strings.data();
+}
+
+
+YPropertyId
+YProperty::lookupId( const string & name )
+{
+    static YPropertyNameHash propertyNameHash;
+    const string * strings = propertyIdStrings();
+    std::less<const string *> before;
+
+    if ( ! before( &name, strings ) && before( &name, strings + YUIPropertyId_Count ) )
+	return (YPropertyId) ( &name - strings );
+
+    return propertyNameHash.lookup( name );
+}
+
+
+const string &
+YProperty::idString( YPropertyId id )
+{
+    if ( id < YUIPropertyId_Unknown || id >= YUIPropertyId_Count )
+	id = YUIPropertyId_Unknown;
+
+    return propertyIdStrings()[ id ];
+}
+
+
+const char *
+YProperty::idName( YPropertyId id )
+{
+    if ( id < YUIPropertyId_Unknown || id >= YUIPropertyId_Count )
+	return "";
+
+    return propertyIdNames[ id ];
+}
+
+
 string
 YProperty::typeAsStr( YPropertyType type )
 {
@@ -80,7 +281,8 @@ bool YPropertyValue::operator!=( const YPropertyValue &other ) const
 
 YPropertySet::YPropertySet()
 {
-    // NOP
+    for ( int i = 0; i < YUIPropertyId_Count; i++ )
+	_index[i] = -1;
 }
 
 
@@ -103,9 +305,32 @@ YPropertySet::check( const string & propertyName, YPropertyType type ) const
 }
 
 
+void
+YPropertySet::check( YPropertyId propertyId ) const
+{
+    if ( ! contains( propertyId ) )
+	YUI_THROW( YUIUnknownPropertyException( YProperty::idName( propertyId ) ) );
+}
+
+
+void
+YPropertySet::check( YPropertyId propertyId, YPropertyType type ) const
+{
+    if ( ! contains( propertyId, type ) )
+	YUI_THROW( YUIUnknownPropertyException( YProperty::idName( propertyId ) ) );
+}
+
+
 bool
 YPropertySet::contains( const string & propertyName ) const throw()
 {
+    YPropertyId propertyId = YProperty::lookupId( propertyName );
+
+    if ( propertyId != YUIPropertyId_Unknown )
+	return contains( propertyId );
+
+    // Not a well-known property name: Check the other properties
+
     for ( YPropertySet::const_iterator it = _properties.begin();
 	  it != _properties.end();
 	  ++it )
@@ -121,20 +346,21 @@ YPropertySet::contains( const string & propertyName ) const throw()
 bool
 YPropertySet::contains( const string & propertyName, YPropertyType type ) const
 {
+    YPropertyId propertyId = YProperty::lookupId( propertyName );
+
+    if ( propertyId != YUIPropertyId_Unknown )
+	return contains( propertyId, type );
+
+    // Not a well-known property name: Check the other properties
+
     for ( YPropertySet::const_iterator it = _properties.begin();
 	  it != _properties.end();
 	  ++it )
     {
 	if ( it->name() == propertyName )
 	{
-	    if ( it->isReadOnly() )
-		YUI_THROW( YUISetReadOnlyPropertyException( *it ) );
-
-	    if ( it->type() == type ||
-		 it->type() == YOtherProperty )	// "Other" could be anything
-		return true;
-
-	    YUI_THROW( YUIPropertyTypeMismatchException( *it, type ) );
+	    checkType( *it, type );
+	    return true;
 	}
     }
 
@@ -142,9 +368,40 @@ YPropertySet::contains( const string & propertyName, YPropertyType type ) const
 }
 
 
+bool
+YPropertySet::contains( YPropertyId propertyId, YPropertyType type ) const
+{
+    if ( ! contains( propertyId ) )
+	return false;
+
+    checkType( _properties[ _index[ propertyId ] ], type );
+
+    return true;
+}
+
+
+void
+YPropertySet::checkType( const YProperty & prop, YPropertyType type )
+{
+    if ( prop.isReadOnly() )
+	YUI_THROW( YUISetReadOnlyPropertyException( prop ) );
+
+    if ( prop.type() != type &&
+	 prop.type() != YOtherProperty )	// "Other" could be anything
+    {
+	YUI_THROW( YUIPropertyTypeMismatchException( prop, type ) );
+    }
+}
+
+
 void
 YPropertySet::add( const YProperty & prop )
 {
+    // Just like with the linear search, the first property with a name wins
+
+    if ( prop.id() != YUIPropertyId_Unknown && _index[ prop.id() ] < 0 )
+	_index[ prop.id() ] = (short) _properties.size();
+
     _properties.push_back( prop );
 }
 
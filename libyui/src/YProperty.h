@@ -39,6 +39,67 @@ enum YPropertyType
     YIntegerProperty		// YCP Integer == C++ long long
 };
 
+/**
+ * Interned identifiers for the well-known property names (YUIProperty_* in
+ * YUISymbols.h). Comparing those is a lot cheaper than comparing strings,
+ * so setProperty() and getProperty() dispatch on them internally.
+ *
+ * Use YProperty::lookupId() to get the ID for a property name and
+ * YProperty::idName() for the reverse.
+ **/
+enum YPropertyId
+{
+    YUIPropertyId_Unknown = 0,	// not one of the well-known names
+    YUIPropertyId_Alive,
+    YUIPropertyId_Cell,
+    YUIPropertyId_ContextMenu,
+    YUIPropertyId_CurrentBranch,
+    YUIPropertyId_CurrentButton,
+    YUIPropertyId_CurrentItem,
+    YUIPropertyId_CurrentSize,
+    YUIPropertyId_DebugLabel,
+    YUIPropertyId_EasterEgg,
+    YUIPropertyId_Enabled,
+    YUIPropertyId_EnabledItems,
+    YUIPropertyId_ExpectedSize,
+    YUIPropertyId_Filename,
+    YUIPropertyId_Layout,
+    YUIPropertyId_HelpText,
+    YUIPropertyId_IconPath,
+    YUIPropertyId_InputMaxLength,
+    YUIPropertyId_HWeight,
+    YUIPropertyId_HStretch,
+    YUIPropertyId_ID,
+    YUIPropertyId_Item,
+    YUIPropertyId_Items,
+    YUIPropertyId_ItemStatus,
+    YUIPropertyId_Label,
+    YUIPropertyId_Labels,
+    YUIPropertyId_LastLine,
+    YUIPropertyId_MaxLines,
+    YUIPropertyId_MaxValue,
+    YUIPropertyId_MinValue,
+    YUIPropertyId_MultiSelection,
+    YUIPropertyId_Notify,
+    YUIPropertyId_OpenItems,
+    YUIPropertyId_SelectedItems,
+    YUIPropertyId_Text,
+    YUIPropertyId_Timeout,
+    YUIPropertyId_ValidChars,
+    YUIPropertyId_Value,
+    YUIPropertyId_Values,
+    YUIPropertyId_VisibleLines,
+    YUIPropertyId_VisibleItems,
+    YUIPropertyId_VWeight,
+    YUIPropertyId_VStretch,
+    YUIPropertyId_WidgetClass,
+    YUIPropertyId_VScrollValue,
+    YUIPropertyId_HScrollValue,
+
+    YUIPropertyId_Count		// only used for array sizes
+};
+
+
 class YWidget;
 class YProperty;
 
@@ -57,6 +118,7 @@ public:
      **/
     YProperty( const std::string & name, YPropertyType type, bool isReadOnly = false )
 	: _name( name )
+	, _id( lookupId( name ) )
 	, _type( type )
 	, _isReadOnly( isReadOnly )
 	{}
@@ -66,6 +128,12 @@ public:
      **/
     std::string name() const { return _name; }
 
+    /**
+     * Returns the interned ID of this property or YUIPropertyId_Unknown
+     * if the name is not one of the well-known property names.
+     **/
+    YPropertyId id() const { return _id; }
+
     /**
      * Returns the type of this property.
      **/
@@ -86,9 +154,34 @@ public:
      **/
     static std::string typeAsStr( YPropertyType type );
 
+    /**
+     * Returns the interned ID of property name 'name' or
+     * YUIPropertyId_Unknown if it is not one of the well-known property
+     * names.
+     *
+     * This uses a perfect hash of the well-known names that is built upon
+     * the first call, so it costs at most one string comparison. A string
+     * returned by idString() is recognized without any hashing.
+     **/
+    static YPropertyId lookupId( const std::string & name );
+
+    /**
+     * Returns the interned property name string for a property ID
+     * or an empty string for YUIPropertyId_Unknown. The reference stays
+     * valid for the lifetime of the program.
+     **/
+    static const std::string & idString( YPropertyId id );
+
+    /**
+     * Returns the property name for an interned property ID
+     * or an empty string for YUIPropertyId_Unknown.
+     **/
+    static const char * idName( YPropertyId id );
+
 private:
 
     std::string		_name;
+    YPropertyId		_id;
     YPropertyType	_type;
     bool		_isReadOnly;
 };
@@ -227,6 +320,16 @@ public:
     void check( const YProperty & prop ) const
 	{ check( prop.name(), prop.type() ); }
 
+    /**
+     * Same as above, but with an interned property ID.
+     **/
+    void check( YPropertyId propertyId ) const;
+
+    /**
+     * Same as above, but with an interned property ID.
+     **/
+    void check( YPropertyId propertyId, YPropertyType type ) const;
+
     /**
      * Check if a property 'propertyName' exists in this property set.
      * Returns 'true' if it exists, 'false' if not.
@@ -257,6 +360,18 @@ public:
     bool contains( const YProperty & prop ) const
 	{ return contains( prop.name(), prop.type() ); }
 
+    /**
+     * Same as above, but with an interned property ID.
+     * This does not do any string comparison at all.
+     **/
+    bool contains( YPropertyId propertyId ) const throw()
+	{ return propertyId != YUIPropertyId_Unknown && _index[ propertyId ] >= 0; }
+
+    /**
+     * Same as above, but with an interned property ID.
+     **/
+    bool contains( YPropertyId propertyId, YPropertyType type ) const;
+
     /**
      * Returns 'true' if this property set does not contain anything.
      **/
@@ -294,6 +409,12 @@ public:
 
 private:
 
+    /**
+     * Check 'prop' against the expected type 'type' and throw the
+     * appropriate exception if it doesn't match or if it is read-only.
+     **/
+    static void checkType( const YProperty & prop, YPropertyType type );
+
     /**
      * This class uses a simple std::vector as a container to hold the
      * properties: Normally, the number of properties for each widget is so
@@ -301,6 +422,12 @@ private:
      * std::set etc. would not pay off. More likely, it would add overhead.
      **/
     std::vector<YProperty> _properties;
+
+    /**
+     * Index into _properties for each interned property ID
+     * or -1 if this set does not contain that property.
+     **/
+    short _index[ YUIPropertyId_Count ];
 };
 
 
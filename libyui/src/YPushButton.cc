@@ -80,6 +80,7 @@ YPushButton::~YPushButton()
 void YPushButton::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -227,14 +228,14 @@ YPushButton::propertySet()
 
 
 bool
-YPushButton::setProperty( const string & propertyName, const YPropertyValue & val )
+YPushButton::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
+    if ( propertyId == YUIPropertyId_Label )	setLabel( val.stringVal() );
     else
     {
-	YWidget::setProperty( propertyName, val );
+	YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special handling necessary
@@ -242,14 +243,14 @@ YPushButton::setProperty( const string & propertyName, const YPropertyValue & va
 
 
 YPropertyValue
-YPushButton::getProperty( const string & propertyName )
+YPushButton::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
+    if ( propertyId == YUIPropertyId_Label )	return YPropertyValue( label() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
 
@@ -71,10 +71,10 @@ public:
      * Set this button's icon from an icon file in the UI's default icon
      * directory. Clear the icon if the name is empty.
      *
-     * This default implementation does nothing.
+     * This default implementation only invalidates the preferred size.
      * UIs that can handle icons can choose to overwrite this method.
      **/
-    virtual void setIcon( const std::string & iconName ) {}
+    virtual void setIcon( const std::string & iconName ) { invalidatePreferredSize(); }
 
     /**
      * Returns 'true' if this is the dialog's default button, i.e. the one
@@ -181,8 +181,8 @@ public:
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setPropertyById( YPropertyId	         propertyId,
+				  const YPropertyValue & val );
 
     /**
      * Get a property.
@@ -190,7 +190,7 @@ public:
      *
      * This method may throw YUIPropertyExceptions.
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getPropertyById( YPropertyId propertyId );
 
     /**
      * Return this class's property set.
@@ -88,6 +88,7 @@ YRadioButton::~YRadioButton()
 void YRadioButton::setLabel( const string & newLabel )
 {
     priv->label = newLabel;
+    labelChanged();
 }
 
 
@@ -106,6 +107,7 @@ bool YRadioButton::useBoldFont() const
 void YRadioButton::setUseBoldFont( bool bold )
 {
     priv->useBoldFont = bold;
+    invalidatePreferredSize();
 }
 
 
@@ -131,15 +133,15 @@ YRadioButton::propertySet()
 
 
 bool
-YRadioButton::setProperty( const string & propertyName, const YPropertyValue & val )
+YRadioButton::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if      ( propertyName == YUIProperty_Value )	setValue( val.boolVal() );
-    else if ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
+    if      ( propertyId == YUIPropertyId_Value )	setValue( val.boolVal() );
+    else if ( propertyId == YUIPropertyId_Label )	setLabel( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -147,15 +149,15 @@ YRadioButton::setProperty( const string & propertyName, const YPropertyValue & v
 
 
 YPropertyValue
-YRadioButton::getProperty( const string & propertyName )
+YRadioButton::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if      ( propertyName == YUIProperty_Value )	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
+    if      ( propertyId == YUIPropertyId_Value )	return YPropertyValue( value() );
+    else if ( propertyId == YUIPropertyId_Label )	return YPropertyValue( label() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
 
@@ -142,15 +142,15 @@ YRadioButtonGroup::propertySet()
 
 
 bool
-YRadioButtonGroup::setProperty( const string & propertyName, const YPropertyValue & val )
+YRadioButtonGroup::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if ( propertyName == YUIProperty_CurrentButton ||
-	 propertyName == YUIProperty_Value )		return false; // Needs special handling
+    if ( propertyId == YUIPropertyId_CurrentButton ||
+	 propertyId == YUIPropertyId_Value )		return false; // Needs special handling
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -158,14 +158,14 @@ YRadioButtonGroup::setProperty( const string & propertyName, const YPropertyValu
 
 
 YPropertyValue
-YRadioButtonGroup::getProperty( const string & propertyName )
+YRadioButtonGroup::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if ( propertyName == YUIProperty_CurrentButton ||
-	 propertyName == YUIProperty_Value )		return YPropertyValue( YOtherProperty );
+    if ( propertyId == YUIPropertyId_CurrentButton ||
+	 propertyId == YUIPropertyId_Value )		return YPropertyValue( YOtherProperty );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
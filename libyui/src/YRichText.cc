@@ -74,6 +74,7 @@ YRichText::~YRichText()
 void YRichText::setValue( const string & newValue )
 {
     priv->text = newValue;
+    invalidatePreferredSize();
 }
 
 
@@ -92,6 +93,7 @@ bool YRichText::plainTextMode() const
 void YRichText::setPlainTextMode( bool plainTextMode )
 {
     priv->plainTextMode = plainTextMode;
+    invalidatePreferredSize();
 }
 
 
@@ -116,6 +118,7 @@ bool YRichText::shrinkable() const
 void YRichText::setShrinkable( bool shrinkable )
 {
     priv->shrinkable = shrinkable;
+    invalidatePreferredSize();
 }
 
 
@@ -144,17 +147,17 @@ YRichText::propertySet()
 
 
 bool
-YRichText::setProperty( const string & propertyName, const YPropertyValue & val )
+YRichText::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_Text		)	setValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_VScrollValue	)	setVScrollValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_HScrollValue	)	setHScrollValue( val.stringVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	setValue( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_Text		)	setValue( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_VScrollValue	)	setVScrollValue( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_HScrollValue	)	setHScrollValue( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -162,17 +165,17 @@ YRichText::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YRichText::getProperty( const string & propertyName )
+YRichText::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Text		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_VScrollValue	)	return YPropertyValue( vScrollValue() );
-    else if ( propertyName == YUIProperty_HScrollValue	)	return YPropertyValue( hScrollValue() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( value() );
+    else if ( propertyId == YUIPropertyId_Text		)	return YPropertyValue( value() );
+    else if ( propertyId == YUIPropertyId_VScrollValue	)	return YPropertyValue( vScrollValue() );
+    else if ( propertyId == YUIPropertyId_HScrollValue	)	return YPropertyValue( hScrollValue() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
 
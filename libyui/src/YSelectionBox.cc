@@ -74,6 +74,7 @@ bool YSelectionBox::shrinkable() const
 void YSelectionBox::setShrinkable( bool shrinkable )
 {
     priv->shrinkable = shrinkable;
+    invalidatePreferredSize();
 }
 
 
@@ -119,18 +120,18 @@ YSelectionBox::propertySet()
 
 
 bool
-YSelectionBox::setProperty( const string & propertyName, const YPropertyValue & val )
+YSelectionBox::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_CurrentItem 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Items 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_IconPath 	)	setIconBasePath( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -138,17 +139,17 @@ YSelectionBox::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YSelectionBox::getProperty( const string & propertyName )
+YSelectionBox::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_CurrentItem 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Items 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
+    else if ( propertyId == YUIPropertyId_IconPath	)	return YPropertyValue( iconBasePath() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
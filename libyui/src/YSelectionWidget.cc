@@ -27,9 +27,13 @@
 #include "YUILog.h"
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include "YSelectionWidget.h"
 #include "YUIException.h"
+#include "YItemArena.h"
 #include "YApplication.h"
+#include "YUITrace.h"
 
 using std::string;
 
@@ -43,6 +47,10 @@ struct YSelectionWidgetPrivate
 	, enforceSingleSelection( enforceSingleSelection )
         , enforceInitialSelection( true )
 	, recursiveSelection ( recursiveSelection )
+	, labelIndexValid( false )
+	, deletingAllItems( false )
+	, itemArena( 0 )
+	, hasInputSnapshot( false )
 	{}
 
     string		label;
@@ -51,6 +59,25 @@ struct YSelectionWidgetPrivate
     bool		recursiveSelection;
     string		iconBasePath;
     YItemCollection	itemCollection;
+
+    // All items (including child items) with a nonzero status.
+    // Items report any status change, so this is always up to date.
+    std::unordered_set<YItem *>	selectedItems;
+
+    // The first item in depth-first order for each label.
+    // This is only built upon the first findItem() call, and it is dropped
+    // (and rebuilt upon the next call) if it can't be updated cheaply.
+    mutable std::unordered_map<string, YItem *>	labelIndex;
+    mutable bool	labelIndexValid;
+
+    bool		deletingAllItems;
+
+    // Created on demand by YSelectionWidget::itemArena()
+    YItemArena *	itemArena;
+
+    // The selected items at the last detectInputChange() call
+    YItemCollection	inputSnapshot;
+    bool		hasInputSnapshot;
 };
 
 
@@ -74,11 +101,29 @@ YSelectionWidget::YSelectionWidget( YWidget *		parent,
 YSelectionWidget::~YSelectionWidget()
 {
     deleteAllItems();
+
+    if ( priv->itemArena )
+	priv->itemArena->release();
+}
+
+
+YItemArena *
+YSelectionWidget::itemArena()
+{
+    if ( ! priv->itemArena )
+	priv->itemArena = new YItemArena();
+
+    return priv->itemArena;
 }
 
 
 void YSelectionWidget::deleteAllItems()
 {
+    YUI_TRACE_SPAN_DETAIL( "deleteAllItems", std::to_string( itemsCount() ) + " items" );
+
+    // Don't bother with the indexes while destroying the items one by one
+    priv->deletingAllItems = true;
+
     YItemIterator it = itemsBegin();
 
     while ( it != itemsEnd() )
@@ -93,6 +138,15 @@ void YSelectionWidget::deleteAllItems()
     }
 
     priv->itemCollection.clear();
+    priv->selectedItems.clear();
+    priv->labelIndex.clear();
+    priv->labelIndexValid = false;
+    priv->deletingAllItems = false;
+
+    invalidatePreferredSize();
+    invalidateShortcut();
+
+    YUI_TRACE_COUNTER( "items", 0 );
 }
 
 
@@ -105,6 +159,7 @@ string YSelectionWidget::label() const
 void YSelectionWidget::setLabel( const string & newLabel )
 {
     priv->label = newLabel;
+    labelChanged();
 }
 
 
@@ -204,6 +259,9 @@ void YSelectionWidget::addItem( YItem * item )
 
     priv->itemCollection.push_back( item );
     item->setIndex( priv->itemCollection.size() - 1 );
+    adoptItem( item, true );
+    invalidatePreferredSize();
+    invalidateShortcut();
 
     // yuiDebug() << "Adding item \"" << item->label() << "\"" << endl;
 
@@ -227,8 +285,8 @@ void YSelectionWidget::addItem( YItem * item )
 
 	if ( newItemSelected )
 	{
-	    // This looks expensive, but it is not: Even though deselectAllItems()
-	    // searches the complete item list and deselects them all.
+	    // This is cheap: deselectAllItems() only needs to touch the items
+	    // that are currently selected.
 	    //
 	    // This prevents that the calling application does this systematically wrong
 	    // and sets the "selected" flag for more items or children.
@@ -270,6 +328,7 @@ void YSelectionWidget::addItem( const string & itemLabel, bool selected )
 
 void YSelectionWidget::addItems( const YItemCollection & itemCollection )
 {
+    YUI_TRACE_SPAN_DETAIL( "addItems", std::to_string( itemCollection.size() ) + " items" );
     OptimizeChanges below( *this ); // Delay screen updates until this block is left
     priv->itemCollection.reserve( priv->itemCollection.size() + itemCollection.size() );
 
@@ -283,6 +342,289 @@ void YSelectionWidget::addItems( const YItemCollection & itemCollection )
 	// over the children: Any children of this item simply remain in this
 	// item's YItemCollection.
     }
+
+    YUI_TRACE_COUNTER( "items", itemsCount() );
+}
+
+
+void YSelectionWidget::addItems( YItemCollection && itemCollection )
+{
+    YUI_TRACE_SPAN_DETAIL( "addItems", std::to_string( itemCollection.size() ) + " items" );
+
+    if ( ! supportsItemChanges() )
+    {
+	// The UI needs to see each item in addItem()
+
+	addItems( static_cast<const YItemCollection &>( itemCollection ) );
+	itemCollection.clear();
+	return;
+    }
+
+    if ( itemCollection.empty() )
+	return;
+
+    int  first    = priv->itemCollection.size();
+    bool wasEmpty = priv->itemCollection.empty();
+
+    for ( YItemConstIterator it = itemCollection.begin(); it != itemCollection.end(); ++it )
+    {
+	YUI_CHECK_PTR( *it );
+
+	if ( (*it)->parent() )
+	{
+	    YUI_THROW( YUIException( "Item already owned by parent item -"
+				     " call addItems() only for toplevel items!" ) );
+	}
+    }
+
+    priv->itemCollection.insert( priv->itemCollection.end(),
+				 itemCollection.begin(), itemCollection.end() );
+    itemCollection.clear();
+
+    for ( int i = first; i < (int) priv->itemCollection.size(); i++ )
+    {
+	YItem * item = priv->itemCollection[i];
+	item->setIndex( i );
+	adoptItem( item, true );
+    }
+
+    fixSingleSelection( priv->itemCollection.begin() + first,
+			priv->itemCollection.end(),
+			wasEmpty );
+    invalidatePreferredSize();
+    invalidateShortcut();
+
+    YItemChangeList changes;
+    changes.push_back( YItemChange( YItemChange::Inserted, first, priv->itemCollection.size() - first ) );
+    itemsChanged( changes );
+
+    YUI_TRACE_COUNTER( "items", itemsCount() );
+}
+
+
+/**
+ * Add a change to 'changes', merging it with the last one if possible.
+ **/
+static void
+addItemChange( YItemChangeList & changes, YItemChange::Type type, int first, int count )
+{
+    if ( count <= 0 )
+	return;
+
+    if ( ! changes.empty() && changes.back().type == type )
+    {
+	YItemChange & last = changes.back();
+
+	if ( type == YItemChange::Removed && last.first == first )
+	{
+	    last.count += count;
+	    return;
+	}
+
+	if ( type != YItemChange::Removed && last.first + last.count == first )
+	{
+	    last.count += count;
+	    return;
+	}
+    }
+
+    changes.push_back( YItemChange( type, first, count ) );
+}
+
+
+void YSelectionWidget::replaceItems( YItemCollection && newItems )
+{
+    YUI_TRACE_SPAN_DETAIL( "replaceItems", std::to_string( newItems.size() ) + " items" );
+
+    if ( ! supportsItemChanges() )
+    {
+	// The UI can only rebuild everything
+
+	deleteAllItems();
+	addItems( static_cast<const YItemCollection &>( newItems ) );
+	newItems.clear();
+	return;
+    }
+
+    for ( YItemConstIterator it = newItems.begin(); it != newItems.end(); ++it )
+    {
+	YUI_CHECK_PTR( *it );
+
+	if ( (*it)->parent() )
+	{
+	    YUI_THROW( YUIException( "Item already owned by parent item -"
+				     " call replaceItems() only for toplevel items!" ) );
+	}
+    }
+
+    YItem * oldSelectedItem = YSelectionWidget::selectedItem();
+    YItemCollection oldItems;
+    oldItems.swap( priv->itemCollection );
+
+    //
+    // Match the new items with the old ones by key. Duplicate keys are
+    // matched in the order in which they appear.
+    //
+
+    std::unordered_map<string, std::vector<int> > oldPositions;
+
+    for ( int i = oldItems.size() - 1; i >= 0; i-- )
+	oldPositions[ itemKey( oldItems[i] ) ].push_back( i );
+
+    std::vector<int> match( newItems.size(), -1 );
+
+    for ( size_t j = 0; j < newItems.size(); j++ )
+    {
+	std::unordered_map<string, std::vector<int> >::iterator pos = oldPositions.find( itemKey( newItems[j] ) );
+
+	if ( pos != oldPositions.end() && ! pos->second.empty() )
+	{
+	    match[j] = pos->second.back();
+	    pos->second.pop_back();
+	}
+    }
+
+    //
+    // Keep the longest sequence of matches that are in the same order in
+    // the old and the new items; everything else is removed or inserted.
+    //
+
+    std::vector<int> tails;	// index into newItems of the tail of each sequence length
+    std::vector<int> predecessor( newItems.size(), -1 );
+
+    for ( size_t j = 0; j < newItems.size(); j++ )
+    {
+	if ( match[j] < 0 )
+	    continue;
+
+	int lo = 0;
+	int hi = tails.size();
+
+	while ( lo < hi )
+	{
+	    int mid = ( lo + hi ) / 2;
+
+	    if ( match[ tails[ mid ] ] < match[j] )
+		lo = mid + 1;
+	    else
+		hi = mid;
+	}
+
+	predecessor[j] = lo > 0 ? tails[ lo - 1 ] : -1;
+
+	if ( lo == (int) tails.size() )
+	    tails.push_back( j );
+	else
+	    tails[ lo ] = j;
+    }
+
+    std::vector<bool> kept( newItems.size(), false );
+
+    for ( int j = tails.empty() ? -1 : tails.back(); j >= 0; j = predecessor[j] )
+	kept[j] = true;
+
+    //
+    // Build the new item list and the list of changes
+    //
+
+    YItemChangeList changes;
+    YItemCollection obsoleteItems;	// old items that need to be deleted
+    size_t oldPos = 0;
+    size_t newPos = 0;
+
+    priv->itemCollection.reserve( newItems.size() );
+
+    for ( size_t j = 0; j <= newItems.size(); j++ )
+    {
+	if ( j < newItems.size() && ! kept[j] )
+	    continue;
+
+	// The old items up to the next kept one are removed
+
+	size_t oldEnd = j < newItems.size() ? match[j] : oldItems.size();
+	addItemChange( changes, YItemChange::Removed, priv->itemCollection.size(), oldEnd - oldPos );
+
+	for ( ; oldPos < oldEnd; oldPos++ )
+	    obsoleteItems.push_back( oldItems[ oldPos ] );
+
+	// The new items up to the next kept one are inserted
+
+	addItemChange( changes, YItemChange::Inserted, priv->itemCollection.size(), j - newPos );
+
+	for ( ; newPos < j; newPos++ )
+	    priv->itemCollection.push_back( newItems[ newPos ] );
+
+	if ( j == newItems.size() )
+	    break;
+
+	// The kept item itself: Use the old one if nothing changed
+
+	YItem * oldItem = oldItems[ oldPos++ ];
+	YItem * newItem = newItems[ newPos++ ];
+
+	// With single selection, the selection is applied again below (and
+	// the UI shows it separately), so only the new content counts
+
+	if ( priv->enforceSingleSelection )
+	    oldItem->setStatus( newItem->status() );
+
+	if ( itemContentEquals( oldItem, newItem ) )
+	{
+	    priv->itemCollection.push_back( oldItem );
+	    delete newItem;
+	}
+	else
+	{
+	    addItemChange( changes, YItemChange::Changed, priv->itemCollection.size(), 1 );
+	    priv->itemCollection.push_back( newItem );
+	    obsoleteItems.push_back( oldItem );
+	}
+    }
+
+    newItems.clear();
+
+    //
+    // Update the indexes and the selection
+    //
+
+    for ( YItemIterator it = obsoleteItems.begin(); it != obsoleteItems.end(); ++it )
+	disownItem( *it );
+
+    priv->labelIndexValid = false;
+    priv->labelIndex.clear();
+
+    for ( int i = 0; i < (int) priv->itemCollection.size(); i++ )
+    {
+	YItem * item = priv->itemCollection[i];
+	item->setIndex( i );
+
+	if ( item->owner() != this )
+	    adoptItem( item, false );
+    }
+
+    fixSingleSelection( priv->itemCollection.begin(),
+			priv->itemCollection.end(),
+			true );	// wasEmpty: same result as with setItems()
+
+    if ( ! changes.empty() )
+    {
+	invalidatePreferredSize();
+	invalidateShortcut();
+	itemsChanged( changes );
+    }
+    else if ( priv->enforceSingleSelection )
+    {
+	// Only the selection might have changed
+	YItem * item = YSelectionWidget::selectedItem();
+
+	if ( item && item != oldSelectedItem )
+	    selectItem( item, true );
+    }
+
+    for ( YItemIterator it = obsoleteItems.begin(); it != obsoleteItems.end(); ++it )
+	delete *it;
+
+    YUI_TRACE_COUNTER( "items", itemsCount() );
 }
 
 
@@ -348,6 +690,14 @@ YSelectionWidget::itemAt( int index ) const
 YItem *
 YSelectionWidget::selectedItem()
 {
+    if ( priv->selectedItems.empty() )
+	return 0;
+
+    if ( priv->selectedItems.size() == 1 )
+	return *priv->selectedItems.begin();
+
+    // Several items are selected: Find the first one in depth-first order
+
     return findSelectedItem( itemsBegin(), itemsEnd() );
 }
 
@@ -384,12 +734,44 @@ YItemCollection
 YSelectionWidget::selectedItems()
 {
     YItemCollection selectedItems;
+
+    if ( priv->selectedItems.empty() )
+	return selectedItems;
+
+    if ( priv->selectedItems.size() == 1 )
+    {
+	selectedItems.push_back( *priv->selectedItems.begin() );
+	return selectedItems;
+    }
+
+    // Collect them in depth-first order
+
+    selectedItems.reserve( priv->selectedItems.size() );
     findSelectedItems( selectedItems, itemsBegin(), itemsEnd() );
 
     return selectedItems;
 }
 
 
+bool
+YSelectionWidget::detectInputChange()
+{
+    // This marks the widget as changed if the value changed
+    bool valueChanged = YWidget::detectInputChange();
+
+    YItemCollection selected = selectedItems();
+    bool selectionChanged = ! priv->hasInputSnapshot || selected != priv->inputSnapshot;
+
+    priv->inputSnapshot.swap( selected );
+    priv->hasInputSnapshot = true;
+
+    if ( selectionChanged && ! valueChanged )
+	markChanged();
+
+    return valueChanged || selectionChanged;
+}
+
+
 void
 YSelectionWidget::findSelectedItems( YItemCollection &	selectedItems,
 				     YItemConstIterator begin,
@@ -414,7 +796,7 @@ YSelectionWidget::findSelectedItems( YItemCollection &	selectedItems,
 
 bool YSelectionWidget::hasSelectedItem()
 {
-    return selectedItem() != 0;
+    return ! priv->selectedItems.empty();
 }
 
 
@@ -456,7 +838,7 @@ void YSelectionWidget::setItemStatus( YItem * item, int status )
 
 bool YSelectionWidget::itemsContain( YItem * wantedItem ) const
 {
-    return itemsContain( wantedItem, itemsBegin(), itemsEnd() );
+    return wantedItem && wantedItem->owner() == this;
 }
 
 
@@ -490,7 +872,14 @@ YSelectionWidget::itemsContain( YItem *			wantedItem,
 
 void YSelectionWidget::deselectAllItems()
 {
-    deselectAllItems( itemsBegin(), itemsEnd() );
+    // Only the items in the selected items index can be selected.
+    // Deselecting them removes them from the index, so use a copy.
+
+    YItemCollection selectedItems( priv->selectedItems.begin(),
+				   priv->selectedItems.end() );
+
+    for ( YItemIterator it = selectedItems.begin(); it != selectedItems.end(); ++it )
+	(*it)->setSelected( false );
 }
 
 
@@ -512,7 +901,11 @@ void YSelectionWidget::deselectAllItems( YItemIterator	begin,
 YItem *
 YSelectionWidget::findItem( const string & wantedItemLabel ) const
 {
-    return findItem( wantedItemLabel, itemsBegin(), itemsEnd() );
+    ensureLabelIndex();
+
+    std::unordered_map<string, YItem *>::const_iterator it = priv->labelIndex.find( wantedItemLabel );
+
+    return it != priv->labelIndex.end() ? it->second : 0;
 }
 
 
@@ -542,6 +935,175 @@ YSelectionWidget::findItem( const string &	wantedItemLabel,
 }
 
 
+void
+YSelectionWidget::adoptItem( YItem * item, bool appended )
+{
+    item->_owner = this;
+
+    if ( item->selected() )
+	priv->selectedItems.insert( item );
+
+    if ( priv->labelIndexValid )
+    {
+	if ( appended )
+	    priv->labelIndex.emplace( item->label(), item ); // keeps any earlier item
+	else
+	{
+	    priv->labelIndexValid = false;
+	    priv->labelIndex.clear();
+	}
+    }
+
+    for ( YItemIterator it = item->childrenBegin(); it != item->childrenEnd(); ++it )
+	adoptItem( *it, appended );
+}
+
+
+void
+YSelectionWidget::itemSelectionChanged( YItem * item )
+{
+    if ( item->selected() )
+	priv->selectedItems.insert( item );
+    else
+	priv->selectedItems.erase( item );
+}
+
+
+void
+YSelectionWidget::itemLabelChanged( YItem * )
+{
+    // Another item with the old or the new label might come before or after
+    // this one, so this can't simply be updated.
+
+    priv->labelIndexValid = false;
+    priv->labelIndex.clear();
+}
+
+
+void
+YSelectionWidget::itemDestroyed( YItem * item )
+{
+    if ( priv->deletingAllItems )
+	return;
+
+    priv->selectedItems.erase( item );
+
+    if ( priv->labelIndexValid )
+    {
+	priv->labelIndexValid = false;
+	priv->labelIndex.clear();
+    }
+}
+
+
+void
+YSelectionWidget::ensureLabelIndex() const
+{
+    if ( priv->labelIndexValid )
+	return;
+
+    priv->labelIndex.clear();
+    priv->labelIndex.reserve( priv->itemCollection.size() );
+
+    // Walk the items in depth-first order; emplace() doesn't overwrite
+    // an existing entry, so the first item with each label wins, just like
+    // with findItem( label, begin, end ).
+
+    std::vector<YItem *> stack( priv->itemCollection.rbegin(), priv->itemCollection.rend() );
+
+    while ( ! stack.empty() )
+    {
+	YItem * item = stack.back();
+	stack.pop_back();
+
+	priv->labelIndex.emplace( item->label(), item );
+
+	if ( item->hasChildren() )
+	{
+	    YItemCollection children( item->childrenBegin(), item->childrenEnd() );
+	    stack.insert( stack.end(), children.rbegin(), children.rend() );
+	}
+    }
+
+    priv->labelIndexValid = true;
+}
+
+
+void
+YSelectionWidget::disownItem( YItem * item )
+{
+    item->_owner = 0;
+    priv->selectedItems.erase( item );
+
+    for ( YItemIterator it = item->childrenBegin(); it != item->childrenEnd(); ++it )
+	disownItem( *it );
+}
+
+
+void
+YSelectionWidget::fixSingleSelection( YItemConstIterator	begin,
+				      YItemConstIterator	end,
+				      bool			wasEmpty )
+{
+    if ( ! priv->enforceSingleSelection || begin == end )
+	return;
+
+    // Like addItem() for each item: The last item that is selected itself
+    // or has a selected child wins.
+
+    YItem * newItemSelected = 0;
+    bool    selectedInFirst = false;
+
+    for ( YItemConstIterator it = begin; it != end; ++it )
+    {
+	YItem * item = *it;
+	YItem * selected = item->selected() ?
+	    item : findSelectedItem( item->childrenBegin(), item->childrenEnd() );
+
+	if ( selected )
+	{
+	    newItemSelected = selected;
+	    selectedInFirst = ( it == begin );
+	}
+    }
+
+    if ( newItemSelected )
+    {
+	deselectAllItems();
+	newItemSelected->setSelected( true );
+    }
+
+    // addItem() selects the very first item after its own selection handling,
+    // so only a selection in a later item overrides that.
+
+    if ( priv->enforceInitialSelection && wasEmpty &&
+	 ( ! newItemSelected || selectedInFirst ) )
+    {
+	(*begin)->setSelected( true );
+    }
+}
+
+
+string
+YSelectionWidget::itemKey( const YItem * item ) const
+{
+    return item->label();
+}
+
+
+bool
+YSelectionWidget::itemContentEquals( const YItem * oldItem,
+				     const YItem * newItem ) const
+{
+    if ( oldItem->hasChildren() || newItem->hasChildren() )
+	return false;
+
+    return oldItem->label()    == newItem->label()	&&
+	   oldItem->iconName() == newItem->iconName()	&&
+	   oldItem->status()   == newItem->status();
+}
+
+
 void YSelectionWidget::dumpItems() const
 {
     yuiMilestone() << "Items:" << endl;
@@ -30,6 +30,35 @@
 #include "ImplPtr.h"
 
 class YSelectionWidgetPrivate;
+class YItemArena;
+
+
+/**
+ * A range of toplevel items of a YSelectionWidget that was inserted, removed
+ * or changed. See YSelectionWidget::itemsChanged().
+ **/
+struct YItemChange
+{
+    enum Type
+    {
+	Inserted,	// new items at 'first'..'first'+'count'-1
+	Removed,	// 'count' items at 'first' are gone
+	Changed		// the items at 'first'..'first'+'count'-1 were replaced
+    };
+
+    YItemChange( Type type, int first, int count )
+	: type( type )
+	, first( first )
+	, count( count )
+	{}
+
+    Type	type;
+    int		first;
+    int		count;
+};
+
+typedef std::vector<YItemChange> YItemChangeList;
+
 
 /**
  * Base class for various kinds of multi-value widgets.
@@ -116,6 +145,17 @@ public:
      **/
     virtual void addItems( const YItemCollection & itemCollection );
 
+    /**
+     * Add multiple items and take ownership of all of them in one step.
+     * 'itemCollection' is empty afterwards.
+     *
+     * If the UI supports item change notifications (see
+     * supportsItemChanges()), this skips the per-item processing of addItem()
+     * and reports all new items to the UI in one itemsChanged() call.
+     * Otherwise, this is the same as the other addItems() overload.
+     **/
+    void addItems( YItemCollection && itemCollection );
+
     /**
      * Delete all items.
      *
@@ -130,6 +170,33 @@ public:
     void setItems( const YItemCollection & itemCollection )
 	{ deleteAllItems(); addItems( itemCollection ); }
 
+    /**
+     * Replace all items with 'newItems'. This widget assumes ownership of
+     * those items; 'newItems' is empty afterwards.
+     *
+     * Old and new toplevel items are matched by itemKey(). Old items whose
+     * content did not change (see itemContentEquals()) are kept, and the new
+     * duplicates are deleted. Only the inserted, removed and changed ranges
+     * are reported to the UI with itemsChanged(), so it can update just
+     * those.
+     *
+     * The result is the same as with setItems(), including the selection;
+     * UIs that don't support item change notifications simply get
+     * deleteAllItems() and addItems().
+     **/
+    void replaceItems( YItemCollection && newItems );
+
+    /**
+     * Return the memory arena for the items of this widget. It is created
+     * upon the first call.
+     *
+     * Items (and table cells) created while a YItemArena::Scope for this
+     * arena is active are allocated from it, which is much faster for many
+     * items and needs less memory. The arena lives until this widget and
+     * all items allocated from it are deleted. See YItemArena for details.
+     **/
+    YItemArena * itemArena();
+
     /**
      * Return an iterator that points to the first item.
      *
@@ -229,6 +296,14 @@ public:
      **/
     virtual void deselectAllItems();
 
+    /**
+     * Check if the selected items or the user input value changed since the
+     * last call and mark this widget as changed if they did.
+     *
+     * Reimplemented from YWidget.
+     **/
+    virtual bool detectInputChange();
+
     /**
      * Set this widget's base path where to look up icons.
      * If this is a relative path, YUI::qApp()->iconBasePath() is prepended.
@@ -264,6 +339,7 @@ public:
 
     /**
      * Return 'true' if this widget's items contain the specified item.
+     * This does not need to search the items.
      **/
     bool itemsContain( YItem * item ) const;
 
@@ -320,6 +396,42 @@ public:
 
 protected:
 
+    /**
+     * Return 'true' if this UI reimplements itemsChanged() to update its
+     * display for ranges of items. This default implementation returns
+     * 'false'; addItems( YItemCollection && ) and replaceItems() then fall
+     * back to adding all items one by one with addItem().
+     **/
+    virtual bool supportsItemChanges() const { return false; }
+
+    /**
+     * Notification that ranges of toplevel items were inserted, removed or
+     * changed. This is only called if supportsItemChanges() returns 'true'.
+     *
+     * The changes are in the order in which they have to be applied to the
+     * UI's current list of items: Each position refers to the list after
+     * all previous changes were applied. The internal item list and the
+     * selection are already up to date; all items of removed and changed
+     * ranges are still valid during this call, but they are deleted right
+     * afterwards.
+     **/
+    virtual void itemsChanged( const YItemChangeList & /* changes */ ) {}
+
+    /**
+     * Return the key that identifies 'item' for replaceItems().
+     * This default implementation returns the item's label.
+     **/
+    virtual std::string itemKey( const YItem * item ) const;
+
+    /**
+     * Return 'true' if 'newItem' looks exactly like 'oldItem' for
+     * replaceItems(), i.e. the old item can be kept. This default
+     * implementation compares the label, the icon and the status. Items with
+     * children are always considered different.
+     **/
+    virtual bool itemContentEquals( const YItem * oldItem,
+				    const YItem * newItem ) const;
+
     /**
      * Set single selection mode on or off. In single selection mode, only one
      * item can be selected at any time.
@@ -385,6 +497,54 @@ protected:
 
 private:
 
+    friend class YItem;
+
+    /**
+     * Make this widget the owner of 'item' and all its children and add
+     * them to the selected items and label lookup indexes.
+     *
+     * 'appended' means that 'item' was added after all other items in
+     * depth-first order, so the label index can be updated rather than
+     * being rebuilt.
+     **/
+    void adoptItem( YItem * item, bool appended );
+
+    /**
+     * Notification from an item that it was selected or deselected.
+     **/
+    void itemSelectionChanged( YItem * item );
+
+    /**
+     * Notification from an item that its label changed.
+     **/
+    void itemLabelChanged( YItem * item );
+
+    /**
+     * Notification from an item that it is being destroyed.
+     **/
+    void itemDestroyed( YItem * item );
+
+    /**
+     * Release 'item' and all its children from this widget's indexes so
+     * they can be deleted without being part of this widget anymore.
+     **/
+    void disownItem( YItem * item );
+
+    /**
+     * Enforce single selection (if applicable) after items between 'begin'
+     * and 'end' were added in one step, with the same result as adding
+     * them one by one with addItem(). 'wasEmpty' is 'true' if there were no
+     * items before.
+     **/
+    void fixSingleSelection( YItemConstIterator	begin,
+			     YItemConstIterator	end,
+			     bool		wasEmpty );
+
+    /**
+     * Rebuild the label lookup index if necessary.
+     **/
+    void ensureLabelIndex() const;
+
     ImplPtr<YSelectionWidgetPrivate> priv;
 };
 
@@ -23,6 +23,8 @@
 /-*/
 
 
+#include <algorithm>
+
 #define YUILogComponent "ui-shortcuts"
 #include "YUILog.h"
 
@@ -48,9 +50,19 @@ using std::string;
 YShortcutManager::YShortcutManager( YDialog *dialog )
     : _dialog( dialog )
     , _conflictCount( 0 )
+    , _shortcutCount( 0 )
+    , _validCount( 0 )
     , _didCheck( false )
+    , _charsReleased( false )
+    , _resolving( false )
 {
     YUI_CHECK_PTR( _dialog );
+
+    for ( int i=0; i < DIM( _wanted ); i++ )
+    {
+	_wanted[i] = 0;
+	_usedBy[i] = 0;
+    }
 }
 
 
@@ -67,17 +79,68 @@ YShortcutManager::checkShortcuts( bool autoResolve )
 
     clearShortcutList();
     findShortcutWidgets( _dialog->childrenBegin(), _dialog->childrenEnd() );
+    checkNewShortcuts( autoResolve );
+}
 
-    int validCount = 0;
 
-    for ( unsigned i=0; i < _shortcutList.size(); i++ )
+void
+YShortcutManager::updateShortcuts( bool autoResolve )
+{
+    if ( ! _didCheck )
     {
-	if ( _shortcutList[i]->hasValidShortcutChar() )
-	    ++validCount;
+	checkShortcuts( autoResolve );
+	return;
     }
 
-    int validPercent = _shortcutList.size() > 0 ?
-	( 100 * validCount ) / _shortcutList.size() : 0;
+    for ( YWidget * widget: _changedWidgets )
+    {
+	if ( _changedWidgetSet.erase( widget ) ) // Skip widgets removed in the meantime
+	{
+	    removeShortcuts( widget );
+	    addShortcuts( widget );
+	}
+    }
+
+    _changedWidgets.clear();
+
+    if ( _unresolved.empty() )
+	_charsReleased = false;
+
+    if ( _newShortcuts.empty() && ! _charsReleased )
+	return;	// Nothing changed
+
+    yuiDebug() << "Checking " << _newShortcuts.size() << " new keyboard shortcuts" << endl;
+    checkNewShortcuts( autoResolve );
+}
+
+
+void
+YShortcutManager::widgetChanged( YWidget * widget )
+{
+    // Before the first check there is nothing to update, and changes made
+    // while resolving conflicts are already accounted for.
+
+    if ( ! _didCheck || _resolving )
+	return;
+
+    if ( _changedWidgetSet.insert( widget ).second )
+	_changedWidgets.push_back( widget );
+}
+
+
+void
+YShortcutManager::widgetRemoved( YWidget * widget )
+{
+    _changedWidgetSet.erase( widget );
+    removeShortcuts( widget );
+}
+
+
+void
+YShortcutManager::checkNewShortcuts( bool autoResolve )
+{
+    int validPercent = _shortcutCount > 0 ?
+	( 100 * _validCount ) / _shortcutCount : 0;
 
     if ( validPercent < MIN_VALID_PERCENT )
     {
@@ -87,49 +150,54 @@ YShortcutManager::checkShortcuts( bool autoResolve )
         // Japanese, Korean).
 
 	yuiWarning() << "Not enough widgets with valid shortcut characters - no check" << endl;
-	yuiDebug() << "Found " << validCount << " widgets with valid shortcut characters" << endl;
+	yuiDebug() << "Found " << _validCount << " widgets with valid shortcut characters" << endl;
 	return;
     }
 
 
-    // Initialize wanted character counters
-    for ( int i=0; i < DIM( _wanted ); i++ )
-	_wanted[i] = 0;
-
-    // Initialize used character flags
-    for ( int i=0; i < DIM( _wanted ); i++ )
-	_used[i] = false;
-
-    // Count wanted shortcuts
-    for ( unsigned i=0; i < _shortcutList.size(); i++ )
-	_wanted[ (int) _shortcutList[i]->preferred() ]++;
-
+    // Report errors. A shortcut that already uses a character that a new one
+    // wants competes again, so this is the same as checking all shortcuts.
+    // It goes first, so it keeps its character unless priorities say
+    // otherwise.
 
-    // Report errors
-
-    _conflictCount = 0;
+    YShortcutList conflictList;
+    YShortcutList newConflictList;
 
-    for ( unsigned i=0; i < _shortcutList.size(); i++ )
+    for ( unsigned i=0; i < _newShortcuts.size(); i++ )
     {
-	YShortcut *shortcut = _shortcutList[i];
+	YShortcut *shortcut = _newShortcuts[i];
+	int preferred = shortcut->preferred();
 
-	if ( YShortcut::isValid( shortcut->preferred() ) )
+	if ( YShortcut::isValid( preferred ) )
 	{
-	    if ( _wanted[ (int) shortcut->preferred() ] > 1 )	// shortcut char used more than once
+	    if ( _wanted[ preferred ] > 1 )	// shortcut char used more than once
 	    {
+		YShortcut * user = _usedBy[ preferred ];
+
+		if ( user )
+		{
+		    _usedBy[ preferred ] = 0;
+		    user->setConflict();
+		    conflictList.push_back( user );
+		}
+
 		shortcut->setConflict();
-		_conflictCount++;
+		newConflictList.push_back( shortcut );
 
 		yuiDebug() << "Shortcut conflict: '" << shortcut->preferred()
 			   << "' used for " << shortcut << endl;
 	    }
+	    else
+	    {
+		_usedBy[ preferred ] = shortcut;
+	    }
 	}
 	else	// No or invalid shortcut
 	{
 	    if ( shortcut->cleanShortcutString().length() > 0 )
 	    {
 		shortcut->setConflict();
-		_conflictCount++;
+		newConflictList.push_back( shortcut );
 
 		if ( ! shortcut->widget()->autoShortcut() )
 		{
@@ -137,13 +205,12 @@ YShortcutManager::checkShortcuts( bool autoResolve )
 		}
 	    }
 	}
-
-	if ( ! shortcut->conflict() )
-	{
-	    _used[ (int) shortcut->preferred() ] = true;
-	}
     }
 
+    _newShortcuts.clear();
+    _conflictList.insert( _conflictList.end(), conflictList.begin(), conflictList.end() );
+    _conflictList.insert( _conflictList.end(), newConflictList.begin(), newConflictList.end() );
+    _conflictCount = _conflictList.size();
     _didCheck = true;
 
     if ( _conflictCount > 0 )
@@ -157,6 +224,72 @@ YShortcutManager::checkShortcuts( bool autoResolve )
     {
 	yuiDebug() << "No shortcut conflicts" << endl;
     }
+
+    if ( autoResolve )
+	retryUnresolved();
+}
+
+
+bool
+YShortcutManager::hasFreeShortcutChar( YShortcut * shortcut )
+{
+    if ( ! shortcut )
+    {
+	for ( char c = 'A'; c <= 'Z'; c++ )
+	{
+	    if ( ! _usedBy[ (int) c ] )
+		return true;
+	}
+
+	for ( char c = '0'; c <= '9'; c++ )
+	{
+	    if ( ! _usedBy[ (int) c ] )
+		return true;
+	}
+
+	return false;
+    }
+
+    string str = shortcut->cleanShortcutString();
+
+    for ( string::size_type pos = 0; pos < str.length(); pos++ )
+    {
+	char c = YShortcut::normalized( str[ pos ] );
+
+	if ( YShortcut::isValid( c ) && ! _usedBy[ (int) c ] )
+	    return true;
+    }
+
+    return false;
+}
+
+
+void
+YShortcutManager::retryUnresolved()
+{
+    if ( ! _charsReleased )
+	return;
+
+    _charsReleased = false;
+
+    // Only shortcuts that contain a released character can be resolved now.
+    // Stop as soon as all characters are taken again: Going through the
+    // other conflicts by priority like resolveAllConflicts() does would cost
+    // much more, but wouldn't change anything.
+
+    YShortcutList unresolved( _unresolved );
+    _resolving = true;
+
+    for ( YShortcut * shortcut: unresolved )
+    {
+	if ( ! hasFreeShortcutChar() )
+	    break;
+
+	if ( hasFreeShortcutChar( shortcut ) )
+	    resolveConflict( shortcut );
+    }
+
+    _resolving = false;
 }
 
 
@@ -172,24 +305,17 @@ YShortcutManager::resolveAllConflicts()
     }
 
 
-    // Make a list of all shortcuts with conflicts
+    // Take over the list of all shortcuts with conflicts
 
     YShortcutList conflictList;
-    _conflictCount = 0;
+    conflictList.swap( _conflictList );
+    _conflictCount = conflictList.size();
 
-    for ( YShortcutListIterator it = _shortcutList.begin();
-	  it != _shortcutList.end();
-	  ++it )
-    {
-	if ( ( *it )->conflict() )
-	{
-	    conflictList.push_back( *it );
-	    _conflictCount++;
-	}
-    }
 
+    // Resolve each conflict. This changes widget labels; don't treat that
+    // as new changes.
 
-    // Resolve each conflict
+    _resolving = true;
 
     while ( ! conflictList.empty() )
     {
@@ -198,6 +324,7 @@ YShortcutManager::resolveAllConflicts()
         // yuiDebug() << "Picked " << shortcut << endl;
 
 	resolveConflict( shortcut );
+	_conflictCount--;
 
 	if ( shortcut->conflict() )
 	{
@@ -210,6 +337,8 @@ YShortcutManager::resolveAllConflicts()
 	conflictList.erase( conflictList.begin() + prioIndex );
     }
 
+    _resolving = false;
+
     if ( _conflictCount > 0 )
     {
 	yuiDebug() << _conflictCount <<  " shortcut conflict(s) left" << endl;
@@ -222,10 +351,11 @@ YShortcutManager::resolveConflict( YShortcut * shortcut )
 {
     // yuiDebug() << "Picking shortcut for " << shortcut << endl;
 
-    char candidate = shortcut->preferred();			// This is always normalized, no need to normalize again.
+    char current   = shortcut->shortcut();
+    char candidate = current;					// This is always normalized, no need to normalize again.
 
     if ( ! YShortcut::isValid( candidate )			// Can't use this character - pick another one.
-	 || _used[ (int) candidate ] )
+	 || _usedBy[ (int) candidate ] )
     {
 	candidate = 0;						// Restart from scratch - forget the preferred character.
 	string str = shortcut->cleanShortcutString();
@@ -235,7 +365,7 @@ YShortcutManager::resolveConflict( YShortcut * shortcut )
 	    char c = YShortcut::normalized( str[ pos ] );
 	    // yuiDebug() << "Checking '" << c << "'" << endl;
 
-	    if ( YShortcut::isValid(c) && ! _used[ (int) c ] ) 	// Could we use this character?
+	    if ( YShortcut::isValid(c) && ! _usedBy[ (int) c ] ) 	// Could we use this character?
 	    {
 		if ( _wanted[ (int) c ] < _wanted[ (int) candidate ]	// Is this a better choice than what we already have -
 		     || ! YShortcut::isValid( candidate ) )		// or don't we have anything yet?
@@ -252,7 +382,7 @@ YShortcutManager::resolveConflict( YShortcut * shortcut )
 
     if ( YShortcut::isValid( candidate ) )
     {
-	if ( candidate != shortcut->preferred() )
+	if ( candidate != current )
 	{
 	    if ( shortcut->widget()->autoShortcut() )
 	    {
@@ -276,8 +406,11 @@ YShortcutManager::resolveConflict( YShortcut * shortcut )
 		       << endl;
 	}
 
-	_used[ (int) candidate ] = true;
+	_usedBy[ (int) candidate ] = shortcut;
 	shortcut->setConflict( false );
+
+	_unresolved.erase( std::remove( _unresolved.begin(), _unresolved.end(), shortcut ),
+			   _unresolved.end() );
     }
     else	// No unique shortcut found
     {
@@ -288,9 +421,13 @@ YShortcutManager::resolveConflict( YShortcut * shortcut )
 
 	shortcut->clearShortcut();
 	shortcut->setConflict( false );
+
+	if ( std::find( _unresolved.begin(), _unresolved.end(), shortcut ) == _unresolved.end() )
+	    _unresolved.push_back( shortcut );
     }
 
-    _conflictCount--;
+    _wanted[ (int) current ]--;
+    _wanted[ (int) shortcut->shortcut() ]++;
 }
 
 
@@ -400,12 +537,29 @@ YShortcutManager::findShortestWidget( const YShortcutList & conflictList )
 void
 YShortcutManager::clearShortcutList()
 {
-    for ( unsigned i=0; i < _shortcutList.size(); i++ )
+    for ( auto & entry: _widgetShortcuts )
+    {
+	for ( YShortcut * shortcut: entry.second.shortcuts )
+	    delete shortcut;
+    }
+
+    _widgetShortcuts.clear();
+    _newShortcuts.clear();
+    _conflictList.clear();
+    _unresolved.clear();
+    _changedWidgets.clear();
+    _changedWidgetSet.clear();
+
+    for ( int i=0; i < DIM( _wanted ); i++ )
     {
-	delete _shortcutList[i];
+	_wanted[i] = 0;
+	_usedBy[i] = 0;
     }
 
-    _shortcutList.clear();
+    _shortcutCount = 0;
+    _validCount    = 0;
+    _conflictCount = 0;
+    _charsReleased = false;
 }
 
 
@@ -435,28 +589,99 @@ YShortcutManager::findShortcutWidgets( YWidgetListConstIterator begin,
     {
 	YWidget * widget = *it;
 
-	YSelectionWidget * selectionWidget = toSelectionWidget( widget );
+	addShortcuts( widget );
 
-	if ( selectionWidget )
+	if ( widget->hasChildren() )
 	{
-	    for ( YItemConstIterator it = selectionWidget->itemsBegin();
-		  it != selectionWidget->itemsEnd();
-		  ++it )
-	    {
-		YItemShortcut * shortcut = new YItemShortcut( selectionWidget, *it );
-		_shortcutList.push_back( shortcut );
-	    }
+	    findShortcutWidgets( widget->childrenBegin(),
+				 widget->childrenEnd()   );
 	}
-	else if ( ! widget->shortcutString().empty() )
+    }
+}
+
+
+void
+YShortcutManager::addShortcuts( YWidget * widget )
+{
+    YShortcutList shortcuts;
+    YSelectionWidget * selectionWidget = toSelectionWidget( widget );
+
+    if ( selectionWidget )
+    {
+	for ( YItemConstIterator it = selectionWidget->itemsBegin();
+	      it != selectionWidget->itemsEnd();
+	      ++it )
 	{
-	    YShortcut * shortcut = new YShortcut( *it );
-	    _shortcutList.push_back( shortcut );
+	    YItemShortcut * shortcut = new YItemShortcut( selectionWidget, *it );
+	    shortcuts.push_back( shortcut );
 	}
+    }
+    else if ( ! widget->shortcutString().empty() )
+    {
+	YShortcut * shortcut = new YShortcut( widget );
+	shortcuts.push_back( shortcut );
+    }
 
-	if ( widget->hasChildren() )
+    if ( shortcuts.empty() )
+	return;
+
+    WidgetShortcuts & entry = _widgetShortcuts[ widget ];
+    entry.validCount = 0;
+
+    for ( YShortcut * shortcut: shortcuts )
+    {
+	// This also caches shortcut(): removeShortcuts() must not need the widget
+
+	_wanted[ (int) shortcut->shortcut() ]++;
+
+	if ( shortcut->hasValidShortcutChar() )
+	    entry.validCount++;
+    }
+
+    _newShortcuts.insert( _newShortcuts.end(), shortcuts.begin(), shortcuts.end() );
+    _shortcutCount += shortcuts.size();
+    _validCount    += entry.validCount;
+    entry.shortcuts.swap( shortcuts );
+}
+
+
+/**
+ * Remove 'shortcut' from 'list' if it is there.
+ **/
+static void removeFromList( YShortcutList & list, YShortcut * shortcut )
+{
+    if ( ! list.empty() )
+	list.erase( std::remove( list.begin(), list.end(), shortcut ), list.end() );
+}
+
+
+void
+YShortcutManager::removeShortcuts( YWidget * widget )
+{
+    auto found = _widgetShortcuts.find( widget );
+
+    if ( found == _widgetShortcuts.end() )
+	return;
+
+    for ( YShortcut * shortcut: found->second.shortcuts )
+    {
+	int current = shortcut->shortcut();
+	_wanted[ current ]--;
+
+	if ( _usedBy[ current ] == shortcut )
 	{
-	    findShortcutWidgets( widget->childrenBegin(),
-				 widget->childrenEnd()   );
+	    _usedBy[ current ] = 0;
+	    _charsReleased = true;
 	}
+
+	removeFromList( _newShortcuts,	shortcut );
+	removeFromList( _conflictList,	shortcut );
+	removeFromList( _unresolved,	shortcut );
+
+	delete shortcut;
     }
+
+    _shortcutCount -= found->second.shortcuts.size();
+    _validCount    -= found->second.validCount;
+    _widgetShortcuts.erase( found );
 }
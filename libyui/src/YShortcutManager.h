@@ -26,6 +26,9 @@
 #ifndef YShortcutManager_h
 #define YShortcutManager_h
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "YWidget.h"
 #include "YShortcut.h"
 
@@ -34,6 +37,13 @@ class YDialog;
 /**
  * Helper class to manage keyboard shortcuts within one dialog and resolve
  * keyboard shortcut conflicts.
+ *
+ * The shortcut manager keeps its shortcuts and the bookkeeping of wanted and
+ * used shortcut characters between checks: After an initial
+ * checkShortcuts(), updateShortcuts() only checks widgets that were reported
+ * with widgetChanged() or widgetRemoved() and only touches the shortcuts
+ * that compete for the same characters. Each YDialog has such a shortcut
+ * manager, and YWidget reports changes to it automatically.
  **/
 class YShortcutManager
 {
@@ -50,12 +60,41 @@ public:
 
     /**
      * Check the keyboard shortcuts of all children of this dialog
-     * (not for sub-dialogs!).
+     * (not for sub-dialogs!) from scratch.
      *
      * Call resolveAllConflicts() if 'autoResolve' is 'true'.
      **/
     void checkShortcuts( bool autoResolve = true );
 
+    /**
+     * Check only the keyboard shortcuts of widgets that were added, changed
+     * or removed (see widgetChanged() and widgetRemoved()) since the last
+     * check. A widget that already uses a shortcut character that one of
+     * them wants is checked again, too; all other shortcuts are left alone.
+     *
+     * This does a complete checkShortcuts() if there was none yet.
+     *
+     * Call resolveAllConflicts() if 'autoResolve' is 'true'.
+     **/
+    void updateShortcuts( bool autoResolve = true );
+
+    /**
+     * Notification that 'widget' was added to the dialog or that its
+     * shortcut string (or, for selection widgets like YDumbTab, its items)
+     * changed. The widget will be checked in the next updateShortcuts().
+     *
+     * Changes that the shortcut manager makes itself while resolving
+     * conflicts are ignored.
+     **/
+    void widgetChanged( YWidget * widget );
+
+    /**
+     * Notification that 'widget' was removed from the dialog or is about to
+     * be deleted. This releases its shortcut characters. Only the widget
+     * pointer is used, so this is safe in the widget's destructor.
+     **/
+    void widgetRemoved( YWidget * widget );
+
     /**
      * Returns the number of shortcut conflicts.
      * Valid only after checkShortcuts() or resolveAllConflicts().
@@ -106,24 +145,56 @@ public:
 protected:
 
     /**
-     * Delete all members of the internal shortcut list, then empty the list.
+     * Delete all shortcuts and reset the bookkeeping.
      **/
     void clearShortcutList();
 
     /**
      * Recursively search all widgets between iterators 'begin' and 'end' (not
      * those of any sub-dialogs!) for child widgets that could accept a
-     * keyboard shortcut and add these to _shortcutList.
+     * keyboard shortcut and add their shortcuts.
      **/
     void findShortcutWidgets( YWidgetListConstIterator begin,
 			      YWidgetListConstIterator end );
 
+    /**
+     * Create the shortcuts of 'widget' (one for each item of a YDumbTab,
+     * YItemSelector or YMenuBar), if it has any, and add them to the
+     * shortcuts to check next.
+     **/
+    void addShortcuts( YWidget * widget );
+
+    /**
+     * Delete the shortcuts of 'widget' and release their shortcut
+     * characters.
+     **/
+    void removeShortcuts( YWidget * widget );
+
+    /**
+     * Find the conflicts of the shortcuts added since the last check and
+     * resolve them if 'autoResolve' is 'true'.
+     **/
+    void checkNewShortcuts( bool autoResolve );
+
     /**
      * Pick a new shortcut character for 'shortcut' - one that isn't marked as
-     * used in the '_used' array. Unset the conflict marker if that succeeded.
+     * used in the '_usedBy' array. Unset the conflict marker if that succeeded.
      **/
     void resolveConflict( YShortcut * shortcut );
 
+    /**
+     * Return 'true' if any valid shortcut character is still unused or, if
+     * 'shortcut' is specified, if any of the characters in its shortcut
+     * string is.
+     **/
+    bool hasFreeShortcutChar( YShortcut * shortcut = 0 );
+
+    /**
+     * If any shortcut characters were released since the last check, try
+     * again to find a shortcut for those that didn't get any.
+     **/
+    void retryUnresolved();
+
     /**
      * Pick a conflict to resolve from 'conflictList' according to priorities
      * (menu items, wizard buttons, buttons, other widgets) and return its
@@ -157,9 +228,41 @@ protected:
     YDialog *_dialog;
 
     /**
-     * List (owning) of all the shortcuts in this dialog.
+     * The shortcuts of one widget.
+     **/
+    struct WidgetShortcuts
+    {
+	YShortcutList	shortcuts;	///< owning
+	int		validCount;	///< shortcuts with a valid shortcut character
+    };
+
+    /**
+     * All the shortcuts in this dialog by widget.
+     **/
+    std::unordered_map<YWidget *, WidgetShortcuts> _widgetShortcuts;
+
+    /**
+     * Shortcuts that were added since the last check.
      **/
-    YShortcutList _shortcutList;
+    YShortcutList _newShortcuts;
+
+    /**
+     * Conflicts found, but not resolved yet.
+     **/
+    YShortcutList _conflictList;
+
+    /**
+     * Shortcuts for which no free shortcut character could be found.
+     * They are tried again when a shortcut character is released.
+     **/
+    YShortcutList _unresolved;
+
+    /**
+     * Widgets reported by widgetChanged() since the last check, in that
+     * order. Only those still in _changedWidgetSet are valid.
+     **/
+    std::vector<YWidget *> _changedWidgets;
+    std::unordered_set<YWidget *> _changedWidgetSet;
 
     /**
      * Counters for wanted shortcut characters.
@@ -168,9 +271,9 @@ protected:
 
 
     /**
-     * Flags for used shortcut characters.
+     * The shortcut that uses each shortcut character, 0 if it is unused.
      **/
-    bool _used[ sizeof( char ) << 8 ];
+    YShortcut * _usedBy[ sizeof( char ) << 8 ];
 
 
     /**
@@ -178,10 +281,19 @@ protected:
      **/
     int _conflictCount;
 
+    /**
+     * Number of shortcuts and number of shortcuts with a valid shortcut
+     * character.
+     **/
+    int _shortcutCount;
+    int _validCount;
+
 
 private:
 
     bool _didCheck;             ///< has checkShortcuts been called?
+    bool _charsReleased;	///< was a shortcut character released since the last check?
+    bool _resolving;		///< is resolveAllConflicts() running?
 };
 
 
@@ -118,7 +118,7 @@ void YSimpleEventHandler::sendEvent( YEvent * event )
 bool
 YSimpleEventHandler::eventPendingFor( YWidget * widget ) const
 {
-    YWidgetEvent * event = dynamic_cast<YWidgetEvent *> (_pendingEvent);
+    YWidgetEvent * event = _pendingEvent ? _pendingEvent->widgetEvent() : 0;
 
     if ( ! event )
 	return false;
@@ -132,7 +132,7 @@ void YSimpleEventHandler::deletePendingEventsFor( YWidget * widget )
     if ( ! _pendingEvent )
 	return;
 
-    YWidgetEvent * event = dynamic_cast<YWidgetEvent *> (_pendingEvent);
+    YWidgetEvent * event = _pendingEvent ? _pendingEvent->widgetEvent() : 0;
 
     if ( event && event->widget() == widget && event->isValid() )
     {
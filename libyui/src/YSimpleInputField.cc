@@ -70,6 +70,7 @@ string YSimpleInputField::label() const
 void YSimpleInputField::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -95,15 +96,15 @@ YSimpleInputField::propertySet()
 
 
 bool
-YSimpleInputField::setProperty( const string & propertyName, const YPropertyValue & val )
+YSimpleInputField::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	setValue( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -111,14 +112,14 @@ YSimpleInputField::setProperty( const string & propertyName, const YPropertyValu
 
 
 YPropertyValue
-YSimpleInputField::getProperty( const string & propertyName )
+YSimpleInputField::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( value() );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
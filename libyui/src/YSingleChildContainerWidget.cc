@@ -42,7 +42,7 @@ YSingleChildContainerWidget::~YSingleChildContainerWidget()
 int YSingleChildContainerWidget::preferredWidth()
 {
     if ( hasChildren() )
-	return firstChild()->preferredWidth();
+	return firstChild()->cachedPreferredSize( YD_HORIZ );
     else
 	return 0;
 }
@@ -51,7 +51,7 @@ int YSingleChildContainerWidget::preferredWidth()
 int YSingleChildContainerWidget::preferredHeight()
 {
     if ( hasChildren() )
-	return firstChild()->preferredHeight();
+	return firstChild()->cachedPreferredSize( YD_VERT );
     else
 	return 0;
 }
@@ -80,6 +80,7 @@ YTable::setTableHeader( YTableHeader * newHeader )
 
     delete priv->header;
     priv->header = newHeader;
+    invalidatePreferredSize();
 }
 
 
@@ -148,6 +149,46 @@ YTable::hasMultiSelection() const
     return ! YSelectionWidget::enforceSingleSelection();
 }
 
+string
+YTable::itemKey( const YItem * item ) const
+{
+    const YTableItem * tableItem = dynamic_cast<const YTableItem *>( item );
+
+    return tableItem ? tableItem->label( 0 ) : YSelectionWidget::itemKey( item );
+}
+
+
+bool
+YTable::itemContentEquals( const YItem * oldItem,
+			   const YItem * newItem ) const
+{
+    const YTableItem * oldTableItem = dynamic_cast<const YTableItem *>( oldItem );
+    const YTableItem * newTableItem = dynamic_cast<const YTableItem *>( newItem );
+
+    if ( ! oldTableItem || ! newTableItem )
+	return YSelectionWidget::itemContentEquals( oldItem, newItem );
+
+    if ( oldItem->hasChildren()			||
+	 newItem->hasChildren()			||
+	 oldItem->status() != newItem->status()	||
+	 oldTableItem->cellCount() != newTableItem->cellCount() )
+    {
+	return false;
+    }
+
+    for ( int col = 0; col < oldTableItem->cellCount(); col++ )
+    {
+	if ( oldTableItem->label( col )    != newTableItem->label( col ) ||
+	     oldTableItem->iconName( col ) != newTableItem->iconName( col ) )
+	{
+	    return false;
+	}
+    }
+
+    return true;
+}
+
+
 YItem *
 YTable::findItem( const string & wantedItemLabel, int column ) const
 {
@@ -217,20 +258,20 @@ YTable::propertySet()
 
 
 bool
-YTable::setProperty( const string & propertyName, const YPropertyValue & val )
+YTable::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_SelectedItems	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Cell		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Item 		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
+
+    if	    ( propertyId == YUIPropertyId_Value		)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_CurrentItem 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_SelectedItems	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Items 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Cell		)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Item 		)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_IconPath 	)	setIconBasePath( val.stringVal() );
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -238,21 +279,21 @@ YTable::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YTable::getProperty( const string & propertyName )
+YTable::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_SelectedItems	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Cell		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Item 		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
-    else if ( propertyName == YUIProperty_MultiSelection )      return YPropertyValue( hasMultiSelection() );
-    else if ( propertyName == YUIProperty_OpenItems 	)	return YPropertyValue( YOtherProperty );
+    propertySet().check( propertyId ); // throws exceptions if not found
+
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_CurrentItem 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_SelectedItems	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Items 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Cell		)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Item 		)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_IconPath	)	return YPropertyValue( iconBasePath() );
+    else if ( propertyId == YUIPropertyId_MultiSelection )      return YPropertyValue( hasMultiSelection() );
+    else if ( propertyId == YUIPropertyId_OpenItems 	)	return YPropertyValue( YOtherProperty );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
@@ -184,8 +184,8 @@ public:
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setPropertyById( YPropertyId	         propertyId,
+				  const YPropertyValue & val );
 
     /**
      * Get a property.
@@ -193,7 +193,7 @@ public:
      *
      * This method may throw YUIPropertyExceptions.
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getPropertyById( YPropertyId propertyId );
 
     /**
      * Return this class's property set.
@@ -222,6 +222,22 @@ protected:
      **/
     void setTableHeader( YTableHeader * newHeader );
 
+    /**
+     * Return the key that identifies 'item' for replaceItems():
+     * The label of its first cell.
+     *
+     * Reimplemented from YSelectionWidget.
+     **/
+    virtual std::string itemKey( const YItem * item ) const;
+
+    /**
+     * Return 'true' if 'newItem' has the same cells and status as 'oldItem'.
+     *
+     * Reimplemented from YSelectionWidget.
+     **/
+    virtual bool itemContentEquals( const YItem * oldItem,
+				    const YItem * newItem ) const;
+
 private:
 
     ImplPtr<YTablePrivate> priv;
@@ -31,6 +31,7 @@
 
 #include "YTableItem.h"
 #include "YUIException.h"
+#include "YItemArena.h"
 
 using std::string;
 
@@ -157,35 +158,31 @@ YTableItem::addCells( const std::string & label_0,
                       const std::string & label_8,
                       const std::string & label_9 )
 {
-    std::vector<string> labels;
-    labels.reserve(10); // slight optimization
-    labels.push_back( label_0 );
-    labels.push_back( label_1 );
-    labels.push_back( label_2 );
-    labels.push_back( label_3 );
-    labels.push_back( label_4 );
-    labels.push_back( label_5 );
-    labels.push_back( label_6 );
-    labels.push_back( label_7 );
-    labels.push_back( label_8 );
-    labels.push_back( label_9 );
+    // Just pointers: No need to copy the labels once more
+    const string * labels[] =
+    {
+	&label_0, &label_1, &label_2, &label_3, &label_4,
+	&label_5, &label_6, &label_7, &label_8, &label_9
+    };
 
     //
     // Find the last non-empty label
     //
 
-    unsigned lastLabel = labels.size() - 1;
+    unsigned lastLabel = sizeof( labels ) / sizeof( labels[0] ) - 1;
 
-    while ( labels[ lastLabel ].empty() && --lastLabel > 0 )
+    while ( labels[ lastLabel ]->empty() && --lastLabel > 0 )
     {}
 
     //
     // Create cells
     //
 
+    _cells.reserve( _cells.size() + lastLabel + 1 );
+
     for ( unsigned i = 0; i <= lastLabel; ++i )
     {
-	addCell( labels[i] );
+	addCell( *labels[i] );
     }
 }
 
@@ -260,6 +257,96 @@ YTableItem::debugLabel() const
 //----------------------------------------------------------------------
 
 
+YTableCell::YTableCell( const YTableCell & other )
+    : _label( other._label )
+    , _extra( other._extra ? new Extra( *other._extra ) : 0 )
+    , _parent( other._parent )
+    , _column( other._column )
+{
+}
+
+
+YTableCell &
+YTableCell::operator=( const YTableCell & other )
+{
+    if ( this != &other )
+    {
+	_label	= other._label;
+	_parent	= other._parent;
+	_column	= other._column;
+
+	if ( other._extra )
+	    setExtra( other._extra->iconName, other._extra->sortKey );
+	else
+	    setExtra( "", "" );
+    }
+
+    return *this;
+}
+
+
+YTableCell::~YTableCell()
+{
+    delete _extra;
+}
+
+
+void
+YTableCell::setExtra( const string & iconName, const string & sortKey )
+{
+    if ( iconName.empty() && sortKey.empty() )
+    {
+	delete _extra;
+	_extra = 0;
+	return;
+    }
+
+    if ( ! _extra )
+	_extra = new Extra;
+
+    _extra->iconName = iconName;
+    _extra->sortKey  = sortKey;
+}
+
+
+void
+YTableCell::setIconName( const string & newIconName )
+{
+    setExtra( newIconName, sortKey() );
+}
+
+
+void
+YTableCell::setSortKey( const string & newSortKey )
+{
+    setExtra( iconName(), newSortKey );
+}
+
+
+void * YTableCell::operator new( size_t size )
+{
+    return YItemArena::allocate( size );
+}
+
+
+void YTableCell::operator delete( void * ptr, size_t size ) noexcept
+{
+    YItemArena::deallocate( ptr, size );
+}
+
+
+void * YTableCell::Extra::operator new( size_t size )
+{
+    return YItemArena::allocate( size );
+}
+
+
+void YTableCell::Extra::operator delete( void * ptr, size_t size ) noexcept
+{
+    YItemArena::deallocate( ptr, size );
+}
+
+
 void YTableCell::reparent( YTableItem * parent, int column )
 {
     YUI_CHECK_PTR( parent );
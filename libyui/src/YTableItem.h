@@ -279,11 +279,10 @@ public:
     YTableCell( const std::string & label, const std::string & iconName = "",
 		const std::string & sortKey = "" )
         : _label( label )
-        , _iconName( iconName )
-	, _sortKey( sortKey )
+	, _extra( 0 )
 	, _parent( 0 )
 	, _column ( -1 )
-        {}
+        { setExtra( iconName, sortKey ); }
 
     /**
      * Constructor with parent, column no., label and optional icon name for
@@ -295,19 +294,25 @@ public:
 		const std::string &	iconName = "",
 		const std::string &     sortKey = "" )
         : _label( label )
-        , _iconName( iconName )
-	, _sortKey( sortKey )
+	, _extra( 0 )
 	, _parent( parent )
 	, _column ( column )
-        {}
+        { setExtra( iconName, sortKey ); }
 
     /**
-     * Destructor. Not strictly needed inside this class, but useful for
-     * derived classes. Since this is the only virtual method of this class,
-     * the cost of this is a vtable for this class and a pointer to the vtable
-     * in each instance.
+     * Copy constructor.
      **/
-    virtual ~YTableCell() {}
+    YTableCell( const YTableCell & other );
+
+    /**
+     * Assignment operator.
+     **/
+    YTableCell & operator=( const YTableCell & other );
+
+    /**
+     * Destructor. This is virtual because there are derived classes.
+     **/
+    virtual ~YTableCell();
 
     /**
      * Return this cells's label. This is what the user sees in a dialog, so
@@ -327,12 +332,12 @@ public:
     /**
      * Return this cell's icon name.
      **/
-    std::string iconName() const { return _iconName; }
+    std::string iconName() const { return _extra ? _extra->iconName : std::string(); }
 
     /**
      * Return 'true' if this cell has an icon name.
      **/
-    bool hasIconName() const { return ! _iconName.empty(); }
+    bool hasIconName() const { return _extra && ! _extra->iconName.empty(); }
 
     /**
      * Set this cell's icon name.
@@ -341,17 +346,17 @@ public:
      * added to the table widget, call YTable::cellChanged() to notify the
      * table widget about the fact. Only then will the display be updated.
      **/
-    void setIconName( const std::string & newIconName ) { _iconName = newIconName; }
+    void setIconName( const std::string & newIconName );
 
     /**
      * Return this cell's sort key.
      **/
-    std::string sortKey() const { return _sortKey; }
+    std::string sortKey() const { return _extra ? _extra->sortKey : std::string(); }
 
     /**
      * Return 'true' if this cell has a sort key.
      **/
-    bool hasSortKey() const { return ! _sortKey.empty(); }
+    bool hasSortKey() const { return _extra && ! _extra->sortKey.empty(); }
 
     /**
      * Set this cell's sort key.
@@ -360,7 +365,7 @@ public:
      * added to the table widget, call YTable::cellChanged() to notify the
      * table widget about the fact. Only then will the display be updated.
      **/
-    void setSortKey( const std::string & newSortKey ) { _sortKey = newSortKey; }
+    void setSortKey( const std::string & newSortKey );
 
     /**
      * Return this cell's parent item or 0 if it doesn't have one yet.
@@ -387,12 +392,42 @@ public:
      **/
     void reparent( YTableItem * parent, int column );
 
+    /**
+     * Overloaded operator new to allocate cells from the current item arena
+     * if there is one. See YItemArena.
+     **/
+    void * operator new( size_t size );
+
+    /**
+     * Operator delete counterpart to our custom operator new.
+     **/
+    void operator delete( void * ptr, size_t size ) noexcept;
+
 
 private:
 
+    /**
+     * Set the icon name and the sort key. This creates the _extra struct
+     * only if any of them is non-empty.
+     **/
+    void setExtra( const std::string & iconName, const std::string & sortKey );
+
+    /**
+     * Icon name and sort key. Most cells have neither, so they are kept
+     * out of line to keep the cells small.
+     **/
+    struct Extra
+    {
+	std::string	iconName;
+	std::string	sortKey;
+
+	// From the item arena like the cell itself
+	void * operator new( size_t size );
+	void operator delete( void * ptr, size_t size ) noexcept;
+    };
+
     std::string		_label;
-    std::string		_iconName;
-    std::string         _sortKey;
+    Extra *		_extra;
     YTableItem *	_parent;
     int			_column;
 };
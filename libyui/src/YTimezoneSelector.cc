@@ -71,31 +71,31 @@ YTimezoneSelector::propertySet()
 
 
 bool
-YTimezoneSelector::setProperty( const string & propertyName, const YPropertyValue & val )
+YTimezoneSelector::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if ( propertyName == YUIProperty_Value )
+    if ( propertyId == YUIPropertyId_Value )
     {
         setCurrentZone( val.stringVal(), true );
         return true; // success -- no special handling necessary
     }
-    if ( propertyName == YUIProperty_CurrentItem )
+    if ( propertyId == YUIPropertyId_CurrentItem )
     {
         setCurrentZone( val.stringVal(), false );
         return true; // success -- no special handling necessary
     }
-    return YWidget::setProperty( propertyName, val );
+    return YWidget::setPropertyById( propertyId, val );
 }
 
 
 YPropertyValue
-YTimezoneSelector::getProperty( const string & propertyName )
+YTimezoneSelector::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if ( propertyName == YUIProperty_Value ) 	        return YPropertyValue( currentZone() );
-    if ( propertyName == YUIProperty_CurrentItem )      return YPropertyValue( currentZone() );
+    if ( propertyId == YUIPropertyId_Value ) 	        return YPropertyValue( currentZone() );
+    if ( propertyId == YUIPropertyId_CurrentItem )      return YPropertyValue( currentZone() );
     
-    return YWidget::getProperty( propertyName );
+    return YWidget::getPropertyById( propertyId );
 }
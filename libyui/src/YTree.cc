@@ -130,21 +130,21 @@ YTree::propertySet()
 
 
 bool
-YTree::setProperty( const string & propertyName, const YPropertyValue & val )
+YTree::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
+    propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
 
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentBranch )	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_SelectedItems )       return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
+    if	    ( propertyId == YUIPropertyId_Value		)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_CurrentItem 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_CurrentBranch )	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Items 	)	return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_SelectedItems )       return false; // Needs special handling
+    else if ( propertyId == YUIPropertyId_Label		)	setLabel( val.stringVal() );
+    else if ( propertyId == YUIPropertyId_IconPath 	)	setIconBasePath( val.stringVal() );
 
     else
     {
-	return YWidget::setProperty( propertyName, val );
+	return YWidget::setPropertyById( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -152,22 +152,22 @@ YTree::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YTree::getProperty( const string & propertyName )
+YTree::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentBranch )	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
-    else if ( propertyName == YUIProperty_SelectedItems )       return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_MultiSelection )      return YPropertyValue( hasMultiSelection() );
-    else if ( propertyName == YUIProperty_OpenItems 	)	return YPropertyValue( YOtherProperty );
+    propertySet().check( propertyId ); // throws exceptions if not found
+
+    if	    ( propertyId == YUIPropertyId_Value		)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_CurrentItem 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_CurrentBranch )	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Items 	)	return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_Label		)	return YPropertyValue( label() );
+    else if ( propertyId == YUIPropertyId_IconPath	)	return YPropertyValue( iconBasePath() );
+    else if ( propertyId == YUIPropertyId_SelectedItems )       return YPropertyValue( YOtherProperty );
+    else if ( propertyId == YUIPropertyId_MultiSelection )      return YPropertyValue( hasMultiSelection() );
+    else if ( propertyId == YUIPropertyId_OpenItems 	)	return YPropertyValue( YOtherProperty );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
 
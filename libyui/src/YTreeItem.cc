@@ -80,6 +80,7 @@ YTreeItem::~YTreeItem()
 void YTreeItem::addChild( YItem * child )
 {
     _children.push_back( child );
+    childAdded( child );
 }
 
 
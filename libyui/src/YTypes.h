@@ -35,11 +35,16 @@ typedef long long	YFileSize_t;
 
 class YWidget;
 
+// The children of a widget are kept in a std::list. Removing a child does
+// not invalidate the iterators to its siblings, and each widget remembers
+// its position in that list, so it is removed in O(1).
+
 typedef std::list<YWidget *>				YWidgetList;
-typedef std::list<YWidget *>::iterator			YWidgetListIterator;
-typedef std::list<YWidget *>::const_iterator		YWidgetListConstIterator;
-typedef std::list<YWidget *>::reverse_iterator		YWidgetListReverseIterator;
-typedef std::list<YWidget *>::const_reverse_iterator	YWidgetListConstReverseIterator;
+
+typedef YWidgetList::iterator				YWidgetListIterator;
+typedef YWidgetList::const_iterator			YWidgetListConstIterator;
+typedef YWidgetList::reverse_iterator			YWidgetListReverseIterator;
+typedef YWidgetList::const_reverse_iterator		YWidgetListConstReverseIterator;
 
 
 #define YUIAllDimensions	2
@@ -49,8 +49,10 @@
 #include "YButtonBox.h"
 #include "YEnvVar.h"
 #include "YBuiltinCaller.h"
+#include "YUICommandChannel.h"
 #include "YWidgetID.h"
 #include "YUIPlugin.h"
+#include "YUITrace.h"
 
 
 using std::string;
@@ -73,16 +75,40 @@ static bool uiDeleted = false;
 extern void * start_ui_thread( void * yui );
 
 
+struct YUIPrivate
+{
+    YUIPrivate()
+	: commandChannel( 0 )
+	, pendingCaller( 0 )
+	{}
+
+    /**
+     * Command channel to the ui thread. If this is 0, the pipes are used
+     * instead.
+     **/
+    YUICommandChannel * commandChannel;
+
+    /**
+     * Call for the ui thread from callBuiltin() in the pipe fallback mode.
+     * If this is 0, the ui thread calls _builtinCaller.
+     **/
+    YBuiltinCaller * pendingCaller;
+};
+
+
 YUI::YUI( bool withThreads )
     : _withThreads( withThreads )
     , _uiThread( 0 )
     , _builtinCaller( 0 )
     , _terminate_ui_thread( false )
     , _eventsBlocked( false )
+    , priv( new YUIPrivate() )
 {
     yuiMilestone() << "This is libyui " << VERSION << endl;
     yuiMilestone() << "Creating UI " << ( withThreads ? "with" : "without" ) << " threads" << endl;
 
+    YUITrace::startFromEnvironment();
+
     _ui = this;
 }
 
@@ -202,6 +228,24 @@ void YUI::topmostConstructorHasFinished()
 
     if ( _withThreads )
     {
+	if ( ! YEnvVar( "YUI_COMMAND_PIPE" ).isSet() )
+	{
+	    priv->commandChannel = new YUICommandChannel();
+
+	    if ( priv->commandChannel->open() )
+	    {
+#if VERBOSE_COMM
+		yuiDebug() << "Inter-thread command channel set up" << endl;
+#endif
+		_terminate_ui_thread = false;
+		createUIThread();
+		return;
+	    }
+
+	    delete priv->commandChannel;
+	    priv->commandChannel = 0;
+	}
+
 	if ( pipe( pipe_from_ui ) == 0 &&
 	     pipe( pipe_to_ui   ) == 0   )
 	{
@@ -270,16 +314,111 @@ void YUI::shutdownThreads()
     {
 	terminateUIThread();
 	_uiThread = 0;
-	close( pipe_to_ui[0] );
-	close( pipe_to_ui[1] );
-	close( pipe_from_ui[0] );
-	close( pipe_from_ui[1] );
+
+	if ( priv->commandChannel )
+	{
+	    priv->commandChannel->logStatistics();
+	    delete priv->commandChannel;
+	    priv->commandChannel = 0;
+	}
+	else
+	{
+	    close( pipe_to_ui[0] );
+	    close( pipe_to_ui[1] );
+	    close( pipe_from_ui[0] );
+	    close( pipe_from_ui[1] );
+	}
     }
 }
 
 
+/**
+ * Caller for the calls of one YUI::callBuiltins() call: It executes all of
+ * them in the UI thread within one YDialog::ChangeBatch.
+ **/
+class YBuiltinBatchCaller: public YBuiltinCaller
+{
+public:
+
+    YBuiltinBatchCaller( const std::vector<YBuiltinCaller *> & callers )
+	: _callers( callers )
+	{}
+
+    virtual void call()
+    {
+	YUI_TRACE_SPAN_DETAIL( "builtinBatch", std::to_string( _callers.size() ) + " builtins" );
+	YDialog::ChangeBatch batch;
+
+	for ( YBuiltinCaller * caller: _callers )
+	    caller->call();
+    }
+
+private:
+
+    const std::vector<YBuiltinCaller *> & _callers;
+};
+
+
+void YUI::callBuiltin( YBuiltinCaller * caller )
+{
+    YUI_TRACE_SPAN( "callBuiltin" );
+
+    if ( ! _uiThread )
+    {
+	caller->call();
+    }
+    else if ( priv->commandChannel )
+    {
+	uint64_t seqNo = priv->commandChannel->post( &caller, 1 );
+	priv->commandChannel->waitFor( seqNo );
+    }
+    else
+    {
+	priv->pendingCaller = caller;
+	signalUIThread();
+
+	while ( ! waitForUIThread() )
+	{}
+
+	priv->pendingCaller = 0;
+    }
+}
+
+
+void YUI::callBuiltins( const std::vector<YBuiltinCaller *> & callers )
+{
+    if ( callers.empty() )
+	return;
+
+    if ( callers.size() == 1 )
+    {
+	callBuiltin( callers.front() );
+    }
+    else
+    {
+	YBuiltinBatchCaller batchCaller( callers );
+	callBuiltin( &batchCaller );
+    }
+}
+
+
+const YUICommandChannel *
+YUI::commandChannel() const
+{
+    return priv->commandChannel;
+}
+
+
 void YUI::signalUIThread()
 {
+    if ( priv->commandChannel )
+    {
+	// A null caller stands for _builtinCaller
+	YBuiltinCaller * caller = 0;
+	priv->commandChannel->post( &caller, 1 );
+	return;
+    }
+
     static char arbitrary = 42;
     if ( write ( pipe_to_ui[1], & arbitrary, 1 ) == -1 )
 	yuiError() <<  "Writing byte to UI thread failed" << endl;
@@ -292,6 +431,12 @@ void YUI::signalUIThread()
 
 bool YUI::waitForUIThread()
 {
+    if ( priv->commandChannel )
+    {
+	priv->commandChannel->waitFor( priv->commandChannel->lastPosted() );
+	return true;
+    }
+
     char arbitrary;
     int result;
 
@@ -360,6 +505,12 @@ bool YUI::waitForYCPThread()
 
 void YUI::uiThreadMainLoop()
 {
+    if ( priv->commandChannel )
+    {
+	commandChannelMainLoop();
+	return;
+    }
+
     while ( true )
     {
 	idleLoop( pipe_to_ui[0] );
@@ -381,8 +532,13 @@ void YUI::uiThreadMainLoop()
 	    return;
 	}
 
-	if ( _builtinCaller )
-	    _builtinCaller->call();
+	YBuiltinCaller * caller = priv->pendingCaller ? priv->pendingCaller : _builtinCaller;
+
+	if ( caller )
+	{
+	    YUI_TRACE_SPAN( "runBuiltin" );
+	    caller->call();
+	}
 	else
 	    yuiError() << "No builtinCaller set" << endl;
 
@@ -391,6 +547,49 @@ void YUI::uiThreadMainLoop()
 }
 
 
+void YUI::commandChannelMainLoop()
+{
+    std::vector<YUICommandChannel::Request> requests;
+
+    while ( true )
+    {
+	idleLoop( priv->commandChannel->fd() );
+
+	// Like the pipe, the eventfd is non-blocking, and idleLoop() might
+	// return without anything to read.
+
+	if ( ! priv->commandChannel->receive( requests ) )
+	    continue;
+
+	if ( _terminate_ui_thread )
+	{
+	    uiThreadDestructor();
+
+	    for ( const YUICommandChannel::Request & request: requests )
+		priv->commandChannel->completed( request );
+
+	    yuiDebug() << "Shutting down UI main loop" << endl;
+	    return;
+	}
+
+	for ( const YUICommandChannel::Request & request: requests )
+	{
+	    YBuiltinCaller * caller = request.caller ? request.caller : _builtinCaller;
+
+	    if ( caller )
+	    {
+		YUI_TRACE_SPAN( "runBuiltin" );
+		caller->call();
+	    }
+	    else
+		yuiError() << "No builtinCaller set" << endl;
+
+	    priv->commandChannel->completed( request );
+	}
+    }
+}
+
+
 void YUI::setButtonOrderFromEnvironment()
 {
     YButtonOrder buttonOrder    = YButtonBox::layoutPolicy().buttonOrder;
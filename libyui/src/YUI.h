@@ -27,9 +27,11 @@
 
 #include <pthread.h>
 #include <string>
+#include <vector>
 
 #include "YTypes.h"
 #include "YSettings.h"
+#include "ImplPtr.h"
 
 
 class YApplication;
@@ -41,6 +43,8 @@ class YBuiltinCaller;
 class YDialog;
 class YMacroPlayer;
 class YMacroRecorder;
+class YUICommandChannel;
+class YUIPrivate;
 
 
 /**
@@ -203,6 +207,9 @@ public:
      * possibly invovles calling userInput() or pollInput()
      * and writes the answer back to the other thread where the request
      * came from.
+     *
+     * With the command channel, all commands that are queued when the
+     * idle loop is left are executed in one go.
      **/
     void uiThreadMainLoop();
 
@@ -219,6 +226,30 @@ public:
     void setBuiltinCaller( YBuiltinCaller * caller )
 	{ _builtinCaller = caller; }
 
+    /**
+     * Execute 'caller' in the UI thread and wait until it is done. Without
+     * threads, this simply calls it. This does not transfer ownership of
+     * 'caller'.
+     **/
+    void callBuiltin( YBuiltinCaller * caller );
+
+    /**
+     * Execute all 'callers' in the UI thread one after the other and wait
+     * until they are done. The UI thread is woken up only once for all of
+     * them, and they are executed in one YDialog::ChangeBatch: Any layout
+     * recalculation is postponed to the end of the batch, and the screen is
+     * updated only once.
+     **/
+    void callBuiltins( const std::vector<YBuiltinCaller *> & callers );
+
+    /**
+     * Return the command channel to the UI thread or 0 if the UI does not
+     * run with threads or uses the pipe fallback (if $YUI_COMMAND_PIPE is
+     * set or if the system does not support eventfd). This is mostly useful
+     * for its statistics.
+     **/
+    const YUICommandChannel * commandChannel() const;
+
     /**
      * UI-specific runPkgSelection method.
      *
@@ -271,6 +302,11 @@ protected:
     void createUIThread();
     friend void *start_ui_thread( void *ui_int );
 
+    /**
+     * Main loop of the ui thread if it uses the command channel.
+     **/
+    void commandChannelMainLoop();
+
     /**
      * Destructor for the UI thread. This will be called as the last thing the
      * UI thread does.
@@ -281,14 +317,16 @@ protected:
     virtual void uiThreadDestructor();
 
     /**
-     * Signals the ui thread by sending one byte through the pipe
+     * Signals the ui thread to call _builtinCaller: Through the command
+     * channel if there is one, otherwise by sending one byte through the pipe
      * to it.
      **/
     void signalUIThread();
 
     /**
-     * Waits for the ui thread to send one byte through the pipe
-     * to the ycp thread and reads this byte from the pipe.
+     * Waits for the ui thread to finish the call: Through the command channel
+     * if there is one, otherwise by waiting for the ui thread to send one byte
+     * through the pipe to the ycp thread and reading this byte from the pipe.
      **/
     bool waitForUIThread();
 
@@ -370,6 +408,8 @@ protected:
 private:
 
     static YUI * _ui;
+
+    ImplPtr<YUIPrivate> priv;
 };
 
 
@@ -0,0 +1,275 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YUICommandChannel.cc
+
+/-*/
+
+
+#include <string.h>	// strerror()
+#include <unistd.h>	// read(), write(), close()
+#include <errno.h>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#define YUILogComponent "ui"
+#include "YUILog.h"
+
+#include "YUICommandChannel.h"
+
+
+// How often to check for the reply before going to sleep. Most built-in
+// calls are done in a few microseconds; busy waiting for them is much cheaper
+// than a sleep and a wakeup. With the pause between the checks, this is
+// about 10-100 us depending on the CPU.
+#define SPIN_ITERATIONS		2000
+
+using std::endl;
+
+typedef std::chrono::steady_clock Clock;
+
+
+/**
+ * Pause in a busy wait loop: This tells the CPU not to speculate ahead and
+ * leaves the core to the other hardware thread for a moment.
+ **/
+static inline void cpuRelax()
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    __builtin_ia32_pause();
+#elif defined( __aarch64__ ) || defined( __arm__ )
+    asm volatile( "yield" ::: "memory" );
+#else
+    std::this_thread::yield();
+#endif
+}
+
+
+YUICommandChannel::YUICommandChannel()
+    : _fd( -1 )
+    , _lastPosted( 0 )
+    , _lastCompleted( 0 )
+    , _completedSignal( 0 )
+    , _waiting( false )
+    , _callCount( 0 )
+    , _totalLatency( 0 )
+    , _maxLatency( 0 )
+{
+    for ( int i = 0; i < LatencyBuckets; i++ )
+	_latencyHistogram[i] = 0;
+}
+
+
+YUICommandChannel::~YUICommandChannel()
+{
+    if ( _fd >= 0 )
+	close( _fd );
+}
+
+
+bool
+YUICommandChannel::open()
+{
+#ifdef __linux__
+    _fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+
+    if ( _fd < 0 )
+	yuiWarning() << "eventfd() failed: errno: " << errno << " " << strerror( errno ) << endl;
+#endif
+
+    return _fd >= 0;
+}
+
+
+uint64_t
+YUICommandChannel::post( YBuiltinCaller * const * callers, int count )
+{
+    Clock::time_point now = Clock::now();
+
+    {
+	std::lock_guard<std::mutex> lock( _mutex );
+
+	for ( int i = 0; i < count; i++ )
+	{
+	    Request request;
+	    request.caller = callers[i];
+	    request.seqNo  = ++_lastPosted;
+	    request.posted = now;
+
+	    _queue.push_back( request );
+	}
+    }
+
+    uint64_t one = 1;
+
+    if ( write( _fd, &one, sizeof( one ) ) == -1 )
+	yuiError() << "Waking up the UI thread failed: errno: " << errno << " " << strerror( errno ) << endl;
+
+    return _lastPosted;
+}
+
+
+void
+YUICommandChannel::waitFor( uint64_t seqNo )
+{
+    static const bool spin = std::thread::hardware_concurrency() > 1;
+
+    if ( spin )
+    {
+	for ( int i = 0; i < SPIN_ITERATIONS; i++ )
+	{
+	    if ( _lastCompleted.load( std::memory_order_acquire ) >= seqNo )
+		return;
+
+	    cpuRelax();
+	}
+    }
+
+#ifdef __linux__
+
+    // Sleep on a futex: That is much cheaper than a mutex and a condition
+    // variable. If a call is completed between reading the futex value and
+    // going to sleep, the value changed and FUTEX_WAIT returns immediately.
+
+    _waiting = true;
+
+    while ( true )
+    {
+	uint32_t signal = _completedSignal.load();
+
+	if ( _lastCompleted.load() >= seqNo )
+	    break;
+
+	syscall( SYS_futex, &_completedSignal, FUTEX_WAIT_PRIVATE, signal, 0, 0, 0 );
+    }
+
+    _waiting = false;
+
+#else
+
+    std::unique_lock<std::mutex> lock( _mutex );
+
+    _waiting = true;
+    _replyCondition.wait( lock, [&]{ return _lastCompleted >= seqNo; } );
+    _waiting = false;
+
+#endif
+}
+
+
+bool
+YUICommandChannel::receive( std::vector<Request> & requests )
+{
+    uint64_t counter;
+
+    if ( read( _fd, &counter, sizeof( counter ) ) == -1 )
+    {
+	if ( errno != EAGAIN && errno != EINTR )
+	    yuiError() << "Reading from the command channel failed: errno: " << errno << " " << strerror( errno ) << endl;
+
+	return false;
+    }
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    requests.assign( _queue.begin(), _queue.end() );
+    _queue.clear();
+
+    return ! requests.empty();
+}
+
+
+void
+YUICommandChannel::completed( const Request & request )
+{
+    uint64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - request.posted ).count();
+
+    _callCount++;
+    _totalLatency += latency;
+
+    if ( latency > _maxLatency )
+	_maxLatency = latency;
+
+    int bucket = 0;
+
+    for ( uint64_t micros = latency / 1000; micros > 0 && bucket < LatencyBuckets - 1; micros >>= 1 )
+	bucket++;
+
+    _latencyHistogram[ bucket ]++;
+
+    _lastCompleted.store( request.seqNo );
+    _completedSignal++;
+
+    if ( _waiting )
+    {
+#ifdef __linux__
+	syscall( SYS_futex, &_completedSignal, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0 );
+#else
+	// Take the mutex so the notification can't get lost between the
+	// waiting thread checking the condition and going to sleep.
+
+	std::lock_guard<std::mutex> lock( _mutex );
+	_replyCondition.notify_one();
+#endif
+    }
+}
+
+
+double
+YUICommandChannel::averageLatency() const
+{
+    return _callCount > 0 ? _totalLatency / 1000.0 / _callCount : 0.0;
+}
+
+
+double
+YUICommandChannel::latencyPercentile( double percent ) const
+{
+    uint64_t wanted = _callCount * percent / 100.0;
+    uint64_t sum    = 0;
+
+    for ( int bucket = 0; bucket < LatencyBuckets; bucket++ )
+    {
+	sum += _latencyHistogram[ bucket ];
+
+	if ( sum > wanted || sum == _callCount )
+	    return bucket == 0 ? 1.0 : (double) ( 1ULL << bucket );
+    }
+
+    return 0.0;
+}
+
+
+void
+YUICommandChannel::logStatistics() const
+{
+    if ( _callCount == 0 )
+	return;
+
+    yuiMilestone() << "UI thread calls: " << _callCount
+		   << " round trip avg: " << averageLatency() << " us"
+		   << " p50: <" << latencyPercentile( 50 ) << " us"
+		   << " p99: <" << latencyPercentile( 99 ) << " us"
+		   << " max: " << maxLatency() << " us"
+		   << endl;
+}
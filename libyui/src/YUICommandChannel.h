@@ -0,0 +1,189 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YUICommandChannel.h
+
+/-*/
+
+#ifndef YUICommandChannel_h
+#define YUICommandChannel_h
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+
+class YBuiltinCaller;
+
+
+/**
+ * Command channel between the application thread and the UI thread if the UI
+ * runs with threads:
+ *
+ * The application thread posts one or more built-in calls to a queue and
+ * wakes up the UI thread once through an eventfd. The UI thread waits for
+ * that file descriptor in YUI::idleLoop(), executes all queued calls and
+ * reports each one as completed; the application thread waits for the last
+ * one of its calls.
+ *
+ * Compared to the classic one-byte pipe handshake this saves two system
+ * calls per call: The application thread does not need a system call at all
+ * to collect the result of a quick call, and it needs only one wakeup for a
+ * batch of calls.
+ *
+ * The channel also measures the round-trip time (from posting a call until
+ * it is completed) of each call; see logStatistics().
+ **/
+class YUICommandChannel
+{
+public:
+
+    /**
+     * One queued call. A null 'caller' stands for YUI::builtinCaller().
+     **/
+    struct Request
+    {
+	YBuiltinCaller *			caller;
+	uint64_t				seqNo;
+	std::chrono::steady_clock::time_point	posted;
+    };
+
+    /**
+     * Constructor. Call open() before using the channel.
+     **/
+    YUICommandChannel();
+
+    /**
+     * Destructor.
+     **/
+    ~YUICommandChannel();
+
+    /**
+     * Create the eventfd. Returns 'false' if that is not possible on this
+     * system; in that case, the caller should fall back to pipes.
+     **/
+    bool open();
+
+    /**
+     * Return the file descriptor that becomes readable when there are calls
+     * for the UI thread. This is what YUI::idleLoop() should wait for.
+     **/
+    int fd() const { return _fd; }
+
+
+    //
+    // Application thread side
+    //
+
+    /**
+     * Queue 'count' calls and wake up the UI thread once. Returns the
+     * sequence number of the last call; use waitFor() with that to wait
+     * until all of them are done.
+     **/
+    uint64_t post( YBuiltinCaller * const * callers, int count );
+
+    /**
+     * Wait until the call with sequence number 'seqNo' and all calls before
+     * it are completed.
+     **/
+    void waitFor( uint64_t seqNo );
+
+    /**
+     * Return the sequence number of the last call posted.
+     **/
+    uint64_t lastPosted() const { return _lastPosted; }
+
+
+    //
+    // UI thread side
+    //
+
+    /**
+     * Consume the wakeup signal and move all queued calls to 'requests'.
+     * Returns 'false' if there were no calls.
+     **/
+    bool receive( std::vector<Request> & requests );
+
+    /**
+     * Report a call as completed and wake up the application thread if it
+     * waits for it.
+     **/
+    void completed( const Request & request );
+
+
+    //
+    // Statistics
+    //
+
+    /**
+     * Return the number of calls completed so far.
+     **/
+    uint64_t callCount() const { return _callCount; }
+
+    /**
+     * Return the average round-trip time of all calls in microseconds.
+     **/
+    double averageLatency() const;
+
+    /**
+     * Return the round-trip time in microseconds that 'percent' percent of
+     * all calls were faster than. This is only as precise as the histogram
+     * buckets: Powers of two of microseconds.
+     **/
+    double latencyPercentile( double percent ) const;
+
+    /**
+     * Return the longest round-trip time of any call in microseconds.
+     **/
+    double maxLatency() const { return _maxLatency / 1000.0; }
+
+    /**
+     * Write the statistics to the log.
+     **/
+    void logStatistics() const;
+
+
+private:
+
+    // Disable copying
+    YUICommandChannel( const YUICommandChannel & );
+    YUICommandChannel & operator=( const YUICommandChannel & );
+
+    enum { LatencyBuckets = 32 };
+
+    int				_fd;
+    std::mutex			_mutex;
+    std::condition_variable	_replyCondition;		// only without futex support
+    std::deque<Request>		_queue;
+    uint64_t			_lastPosted;		// only used by the application thread
+    std::atomic<uint64_t>	_lastCompleted;
+    std::atomic<uint32_t>	_completedSignal;	// futex word: changes with each completed call
+    std::atomic<bool>		_waiting;
+
+    // Statistics; only changed by the UI thread
+    uint64_t			_callCount;
+    uint64_t			_totalLatency;		// nanoseconds
+    uint64_t			_maxLatency;		// nanoseconds
+    uint64_t			_latencyHistogram[ LatencyBuckets ];	// log2 of microseconds
+};
+
+
+#endif // YUICommandChannel_h
@@ -26,6 +26,8 @@
 #include <unistd.h>		// isatty()a
 #include <sys/stat.h>
 #include <string.h>
+#include <mutex>
+#include <thread>
 
 #define YUILogComponent "ui"
 #include "YUILog.h"
@@ -35,12 +37,67 @@
 #include "YUIException.h"
 #include "YPath.h"
 #include "YSettings.h"
+#include "YNullUI.h"
+#include "YEnvVar.h"
+#include "YUITrace.h"
 
 #include "Libyui_config.h"
 
+#define ENV_PRELOAD_PLUGINS	"YUI_PRELOAD_PLUGINS"
+
 using std::string;
 
 
+namespace
+{
+    std::mutex				startupPhasesMutex;
+    std::vector<YUILoader::StartupPhase>	startupPhases;
+
+    int		preloadEnabled = -1;	// -1: not decided yet
+    bool	preloadStarted = false;
+
+
+    /**
+     * Helper thread for preloading plug-ins. It is joined at the latest at
+     * program exit.
+     **/
+    struct PreloadThread
+    {
+	~PreloadThread() { join(); }
+
+	void join()
+	{
+	    if ( thread.joinable() )
+		thread.join();
+	}
+
+	std::thread thread;
+    };
+
+    PreloadThread preloadThread;
+
+
+    /**
+     * Add the time from construction to destruction as a startup phase.
+     **/
+    class PhaseTimer
+    {
+    public:
+	PhaseTimer( const string & name )
+	    : _name( name )
+	    , _startTime( YUITrace::now() )
+	    {}
+
+	~PhaseTimer()
+	    { YUILoader::addStartupPhase( _name, ( YUITrace::now() - _startTime ) / 1000.0 ); }
+
+    private:
+	string	_name;
+	double	_startTime;
+    };
+}
+
+
 bool rest_enabled()
 {
     const char *env = getenv("YUI_HTTP_PORT");
@@ -50,6 +107,9 @@ bool rest_enabled()
 
 void YUILoader::loadUI( bool withThreads )
 {
+    YUITrace::startFromEnvironment();
+    PhaseTimer timer( "load UI" );
+
     bool isGtk = false;
     const char * envDesktop    = getenv( "XDG_CURRENT_DESKTOP" )  ?: "";
     const char * envDisplay    = getenv( "DISPLAY" )              ?: "";
@@ -80,13 +140,24 @@ void YUILoader::loadUI( bool withThreads )
     bool wantGtk      = ( cmdline.find( "--gtk" )     != -1 );
     bool wantNcurses  = ( cmdline.find( "--ncurses" ) != -1 );
     bool wantQt       = ( cmdline.find( "--qt" )      != -1 );
-    bool haveUIPreset = ( wantGtk || wantNcurses || wantQt );
+    bool wantNull     = ( cmdline.find( "--null" )    != -1 );
+    bool haveUIPreset = ( wantGtk || wantNcurses || wantQt || wantNull );
 
     if ( !haveUIPreset )
     {
 	wantGtk     = ( strcmp( envPreset, YUIPlugin_Gtk )     == 0 );
 	wantNcurses = ( strcmp( envPreset, YUIPlugin_NCurses ) == 0 );
 	wantQt      = ( strcmp( envPreset, YUIPlugin_Qt )      == 0 );
+	wantNull    = ( strcmp( envPreset, YUIPlugin_Null )    == 0 );
+    }
+
+    if ( wantNull )
+    {
+	// Built into libyui: No need to look for a plug-in, a display or a TTY
+	yuiMilestone () << "Using UI: \"" << YUIPlugin_Null << "\"" << endl;
+	YSettings::loadedUI( YUIPlugin_Null, true );
+	loadPlugin( YUIPlugin_Null, withThreads );
+	return;
     }
 
     if ( wantGtk )     wantedGUI = YUIPlugin_Gtk;
@@ -95,9 +166,17 @@ void YUILoader::loadUI( bool withThreads )
 
     yuiMilestone() << "User-selected UI-plugin: \"" << wantedGUI << "\"" << endl;
 
-    bool haveGtk     = pluginExists( YUIPlugin_Gtk );
-    bool haveNcurses = pluginExists( YUIPlugin_NCurses );
-    bool haveQt      = pluginExists( YUIPlugin_Qt );
+    bool haveGtk;
+    bool haveNcurses;
+    bool haveQt;
+
+    {
+	PhaseTimer timer( "find UI plugins" );
+
+	haveGtk     = pluginExists( YUIPlugin_Gtk );
+	haveNcurses = pluginExists( YUIPlugin_NCurses );
+	haveQt      = pluginExists( YUIPlugin_Qt );
+    }
 
     // This reset is intentional, so the loader can work it's magic
     // selecting an UI-plugin as described in the documentation.
@@ -217,6 +296,7 @@ void YUILoader::loadRestAPIPlugin( const string & wantedGUI, bool withThreads )
 
         if ( createUI )
         {
+            PhaseTimer timer( string( "create UI " ) + YUIPlugin_RestAPI );
             YUI * ui = createUI( withThreads );
             // Same as in loadPlugin
             atexit(deleteUI);
@@ -231,6 +311,8 @@ void YUILoader::loadRestAPIPlugin( const string & wantedGUI, bool withThreads )
 
 void YUILoader::deleteUI()
 {
+    waitForPluginPreload();
+
     if ( YUI::_ui )
     {
         yuiMilestone() << "Shutting down UI" << endl;
@@ -243,6 +325,14 @@ void YUILoader::deleteUI()
 
 void YUILoader::loadPlugin( const string & name, bool withThreads )
 {
+    if ( name == YUIPlugin_Null )
+    {
+	PhaseTimer timer( "create UI " + name );
+	YNullUI::create( withThreads );
+	atexit(deleteUI);
+	return;
+    }
+
     if (rest_enabled() && (name == YUIPlugin_NCurses || name == YUIPlugin_Qt))
     {
         loadRestAPIPlugin(name, withThreads);
@@ -257,6 +347,7 @@ void YUILoader::loadPlugin( const string & name, bool withThreads )
 
 	if ( createUI )
 	{
+	    PhaseTimer timer( "create UI " + name );
 	    YUI * ui = createUI( withThreads ); // no threads
 
             // At this point the concrete UI will have loaded its own
@@ -342,3 +433,101 @@ bool YUILoader::pluginExists( const string & pluginBaseName )
 
     return success;
 }
+
+
+std::vector<YUILoader::StartupPhase> YUILoader::startupPhases()
+{
+    std::lock_guard<std::mutex> lock( startupPhasesMutex );
+
+    return ::startupPhases;
+}
+
+
+void YUILoader::addStartupPhase( const string & name, double milliseconds )
+{
+    yuiMilestone() << "Startup: " << name << " took " << milliseconds << " ms" << endl;
+
+    if ( YUITrace::isEnabled() )
+	YUITrace::span( YUILogComponent, "startup", YUITrace::now() - milliseconds * 1000.0, name );
+
+    std::lock_guard<std::mutex> lock( startupPhasesMutex );
+    ::startupPhases.push_back( { name, milliseconds } );
+}
+
+
+void YUILoader::enablePluginPreload( bool enable )
+{
+    preloadEnabled = enable ? 1 : 0;
+}
+
+
+bool YUILoader::pluginPreloadEnabled()
+{
+    if ( preloadEnabled < 0 )
+    {
+	YEnvVar env( ENV_PRELOAD_PLUGINS );
+	preloadEnabled = ( env.isSet() && ! env.isEqual( "0" ) ) ? 1 : 0;
+    }
+
+    return preloadEnabled > 0;
+}
+
+
+void YUILoader::startPluginPreload()
+{
+    if ( preloadStarted || ! pluginPreloadEnabled() )
+	return;
+
+    // Only the NCurses plug-ins are safe to load outside the main thread;
+    // other UIs call preloadPlugins() from their event loop (see
+    // enablePluginPreload())
+
+    if ( YSettings::loadedUI() != YUIPlugin_NCurses )
+	return;
+
+    preloadStarted = true;
+
+    preloadThread.thread = std::thread( []()
+	{
+	    loadOptionalPlugins();
+	} );
+}
+
+
+void YUILoader::preloadPlugins()
+{
+    if ( preloadStarted || ! pluginPreloadEnabled() )
+	return;
+
+    preloadStarted = true;
+    PhaseTimer timer( "preload plugins" );
+    loadOptionalPlugins();
+}
+
+
+void YUILoader::loadOptionalPlugins()
+{
+    string ui = YSettings::loadedUI();
+
+    std::vector<string> plugins;
+    plugins.push_back( ui + YUIPlugin_PackageSelectorSuffix );
+    plugins.push_back( ui + YUIPlugin_GraphSuffix );
+
+    // The libraries stay loaded when the YUIPlugin objects go out of scope,
+    // so the UI's own YUIPlugin for them later only finds them in memory.
+
+    for ( const string & plugin: plugins )
+    {
+	if ( pluginExists( plugin ) )
+	{
+	    yuiMilestone() << "Preloading UI plugin " << plugin << endl;
+	    YUIPlugin preloaded( plugin.c_str() );
+	}
+    }
+}
+
+
+void YUILoader::waitForPluginPreload()
+{
+    preloadThread.join();
+}
@@ -28,6 +28,7 @@
 
 
 #include <string>
+#include <vector>
 
 #include "YUI.h"
 #include "YExternalWidgets.h"
@@ -42,6 +43,13 @@
 #define YUIPlugin_Ncurses_RestAPI       "ncurses-rest-api"
 #define YUIPlugin_Qt_RestAPI            "qt-rest-api"
 
+// Not a plug-in, but built into libyui: see YNullUI.h
+#define YUIPlugin_Null                  "null"
+
+// Optional plug-ins of a UI are named after it, e.g. "qt-pkg", "qt-graph"
+#define YUIPlugin_PackageSelectorSuffix "-pkg"
+#define YUIPlugin_GraphSuffix           "-graph"
+
 /**
  * Class to load one of the concrete UI plug-ins: Qt, NCurses, Gtk;
  * or one of the corresponding REST APIs used for automated testing.
@@ -72,14 +80,19 @@ public:
      * - specifing one of the switches on the
      *   command-line of the program
      *    - '--gtk',
-     *    - '--ncurses', or
-     *    - '--qt'
+     *    - '--ncurses',
+     *    - '--qt', or
+     *    - '--null'
      *
      * - setting the environment variable
      *   YUI_PREFERED_BACKEND to one of
      *    - 'gtk',
-     *    - 'ncurses', or
-     *    - 'qt'
+     *    - 'ncurses',
+     *    - 'qt', or
+     *    - 'null'
+     *
+     * 'null' is the headless UI built into libyui (see YNullUI.h); it is
+     * always available and never chosen automatically.
      *
      * If a command-line switch is given to the program, the
      * setting from the environment variable will be overridden
@@ -109,6 +122,7 @@ public:
 
     /**
      * Load a UI plug-in. 'name' is one of the YUIPlugin_ -defines above.
+     * YUIPlugin_Null creates the built-in null UI.
      *
      * This might throw exceptions.
      **/
@@ -137,6 +151,73 @@ public:
     static void loadExternalWidgets( const std::string & name,
                                      const std::string & symbol = "_Z21createExternalWidgetsPKc" );
 
+    /**
+     * One timed step of starting up the UI.
+     **/
+    struct StartupPhase
+    {
+        std::string name;
+        double      milliseconds;
+    };
+
+    /**
+     * Return the timed startup steps so far in the order they were
+     * completed: Checking which UI plug-ins exist, loading each plug-in
+     * library (see also YUIPlugin::loadTime()) and creating the UI. Each
+     * step is also logged when it is completed.
+     **/
+    static std::vector<StartupPhase> startupPhases();
+
+    /**
+     * Add a startup step. UI plug-ins can use this for their own expensive
+     * initialization.
+     **/
+    static void addStartupPhase( const std::string & name, double milliseconds );
+
+    /**
+     * Enable or disable loading the optional plug-ins of the current UI
+     * (package selector, graph) on a helper thread after the first dialog
+     * is opened, so using them later doesn't block the UI with loading a
+     * big library. Those plug-ins still have to be created by the UI as
+     * usual, which is then fast.
+     *
+     * The helper thread is only used for the NCurses UI: Loading the Qt
+     * plug-ins runs static initializers of Qt libraries that must not run
+     * outside the main thread. The Qt UI calls preloadPlugins() from its
+     * event loop instead when it is idle after showing the first dialog.
+     *
+     * This is disabled by default unless the environment variable
+     * YUI_PRELOAD_PLUGINS is set to anything but "0".
+     **/
+    static void enablePluginPreload( bool enable = true );
+
+    /**
+     * Return 'true' if the optional plug-ins are loaded in the background.
+     **/
+    static bool pluginPreloadEnabled();
+
+    /**
+     * Start loading the optional plug-ins in the background if that is
+     * enabled and hasn't been started yet. YDialog calls this when a dialog
+     * is opened.
+     **/
+    static void startPluginPreload();
+
+    /**
+     * Load the optional plug-ins in the calling thread now if that is
+     * enabled and hasn't been started yet. This is for UIs whose plug-ins
+     * can't be loaded in a helper thread: They call this from their event
+     * loop when it is idle, after the first dialog is shown. This is added
+     * as startup phase "preload plugins".
+     **/
+    static void preloadPlugins();
+
+    /**
+     * Wait until the background loading of the optional plug-ins is
+     * finished. deleteUI() does this.
+     **/
+    static void waitForPluginPreload();
+
 private:
     YUILoader()  {}
     ~YUILoader() {}
@@ -155,6 +236,12 @@ private:
     static void loadExternalWidgetsPlugin( const std::string & name,
                                            const std::string & plugin_name,
                                            const std::string & symbol );
+
+    /**
+     * Load the optional plug-ins of the current UI (package selector,
+     * graph) that exist, in the calling thread.
+     **/
+    static void loadOptionalPlugins();
 };
 
 
@@ -24,11 +24,17 @@
 
 
 #include <string.h>
+#include <signal.h>
 
 #include <ostream>
 #include <fstream>
 #include <vector>
-#include <pthread.h>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
 
 #define YUILogComponent "ui"
 #include "YUILog.h"
@@ -50,6 +56,501 @@ static void stdLogger( YUILogLevel_t	logLevel,
 static ostream * stdLogStream = &cerr;
 
 
+/**
+ * Ring buffer for log lines of one thread for the asynchronous standard
+ * logger.
+ *
+ * This is lock-free for exactly one producer (the thread that owns the ring
+ * buffer) and one consumer (whoever holds the async log writer's drain
+ * mutex).
+ **/
+class YUILogRingBuffer
+{
+public:
+
+    YUILogRingBuffer( size_t capacity )
+	: _slots( capacity )
+	, _head( 0 )
+	, _tail( 0 )
+	, _closed( false )
+	{}
+
+    /**
+     * Add a line. Return 'false' if the ring buffer is full.
+     * Only the owning thread may call this.
+     **/
+    bool push( string & line )
+    {
+	size_t head = _head.load( std::memory_order_relaxed );
+
+	if ( head - _tail.load( std::memory_order_acquire ) >= _slots.size() )
+	    return false;
+
+	_slots[ head % _slots.size() ].swap( line );
+	_head.store( head + 1, std::memory_order_release );
+
+	return true;
+    }
+
+    /**
+     * Write all lines to 'stream' and remove them from the ring buffer.
+     * Return the number of lines written.
+     **/
+    size_t drain( ostream & stream )
+    {
+	size_t tail  = _tail.load( std::memory_order_relaxed );
+	size_t head  = _head.load( std::memory_order_acquire );
+	size_t count = head - tail;
+
+	for ( ; tail != head; ++tail )
+	{
+	    string & line = _slots[ tail % _slots.size() ];
+	    stream << line << '\n';
+	    line.clear();	// Keep the capacity for the next line
+	}
+
+	_tail.store( tail, std::memory_order_release );
+
+	return count;
+    }
+
+    size_t fillLevel() const
+	{ return _head.load( std::memory_order_acquire ) - _tail.load( std::memory_order_acquire ); }
+
+    size_t capacity() const		{ return _slots.size(); }
+    bool   isEmpty() const		{ return fillLevel() == 0; }
+
+    /**
+     * The owning thread has exited; the ring buffer can be discarded as soon
+     * as it is empty.
+     **/
+    bool   isClosed() const		{ return _closed.load(); }
+    void   close()			{ _closed.store( true ); }
+
+private:
+
+    std::vector<string>	_slots;
+    std::atomic<size_t>	_head;	// Next slot to write; only changed by the producer
+    std::atomic<size_t>	_tail;	// Next slot to read;  only changed by the consumer
+    std::atomic<bool>	_closed;
+};
+
+
+typedef std::shared_ptr<YUILogRingBuffer> YUILogRingBufferPtr;
+
+
+/**
+ * Background writer for the asynchronous standard logger: It collects log
+ * lines from the ring buffers of all threads and writes them in batches to
+ * the standard log stream.
+ **/
+class YUIAsyncLogWriter
+{
+public:
+
+    /**
+     * Start the writer thread.
+     **/
+    static void start( YUILogOverflowPolicy overflowPolicy, int bufferLines );
+
+    /**
+     * Write all pending log lines and stop the writer thread.
+     **/
+    static void stop();
+
+    /**
+     * Return 'true' if the writer is running.
+     **/
+    static bool isRunning() { return _running.load(); }
+
+    /**
+     * Queue a log line for the writer thread. This is called in the thread
+     * that logs. Returns 'false' if the line could not be queued because the
+     * writer is not running; the caller has to write it itself then.
+     **/
+    static bool write( string & line, YUILogLevel_t logLevel );
+
+    /**
+     * Write all pending log lines now.
+     *
+     * If 'emergency' is true, this does not wait for locks held by other
+     * threads; this is for use in signal handlers.
+     **/
+    static void flush( bool emergency = false );
+
+    /**
+     * Return the number of discarded log lines.
+     **/
+    static long droppedLines() { return _droppedLines.load(); }
+
+    /**
+     * Lock that needs to be held while the standard log stream is written to
+     * or changed.
+     **/
+    static std::mutex & streamMutex() { return _drainMutex; }
+
+private:
+
+    /**
+     * Return the ring buffer of the current thread. Create and register it
+     * if there is none yet.
+     **/
+    static YUILogRingBuffer * threadRingBuffer();
+
+    /**
+     * Main loop of the writer thread.
+     **/
+    static void run();
+
+    /**
+     * Write the contents of all ring buffers to the log stream and discard
+     * ring buffers of threads that exited. The caller has to hold
+     * _drainMutex.
+     *
+     * If 'emergency' is true, this does not wait for any other lock.
+     **/
+    static void drainAll( bool emergency = false );
+
+    /**
+     * Wake up the writer thread.
+     **/
+    static void wakeUp();
+
+    /**
+     * Wake up threads that wait for free space in their ring buffer
+     * (YUI_LOG_OVERFLOW_BLOCK).
+     **/
+    static void notifyDrained();
+
+    /**
+     * Handler for SIGABRT: Write pending log lines, then continue with the
+     * default action. This is only installed if there is no other handler.
+     **/
+    static void abortHandler( int sig );
+
+    /**
+     * Holder for the per-thread ring buffer. Its destructor is called when
+     * the thread exits.
+     **/
+    struct ThreadRingBuffer
+    {
+	ThreadRingBuffer() : generation( 0 ) {}
+	~ThreadRingBuffer() { if ( ringBuffer ) ringBuffer->close(); _threadExiting = true; }
+
+	YUILogRingBufferPtr	ringBuffer;
+	int			generation;
+    };
+
+    static std::atomic<bool>		_running;
+    static std::atomic<bool>		_stopRequested;
+    static std::atomic<int>		_generation;
+    static std::atomic<long>		_droppedLines;
+    static YUILogOverflowPolicy		_overflowPolicy;
+    static size_t			_bufferLines;
+    static std::thread			_thread;
+    static std::mutex			_ringBuffersMutex;
+    static std::vector<YUILogRingBufferPtr> _ringBuffers;
+    static std::mutex			_drainMutex;
+    static std::mutex			_wakeUpMutex;
+    static std::condition_variable	_wakeUp;
+    static bool				_wakeUpRequested;
+    static std::mutex			_drainedMutex;
+    static std::condition_variable	_drained;
+    static struct sigaction		_oldAbortAction;
+    static bool				_abortHandlerInstalled;
+    static bool				_exitHandlerInstalled;
+
+    // Set when the current thread's ring buffer holder is destroyed:
+    // Log output from other thread-local destructors after that point
+    // (e.g. flushing an incomplete line) has to be written synchronously.
+    static thread_local bool		_threadExiting;
+};
+
+
+std::atomic<bool>		 YUIAsyncLogWriter::_running( false );
+std::atomic<bool>		 YUIAsyncLogWriter::_stopRequested( false );
+std::atomic<int>		 YUIAsyncLogWriter::_generation( 0 );
+std::atomic<long>		 YUIAsyncLogWriter::_droppedLines( 0 );
+YUILogOverflowPolicy		 YUIAsyncLogWriter::_overflowPolicy = YUI_LOG_OVERFLOW_DROP;
+size_t				 YUIAsyncLogWriter::_bufferLines = 4096;
+std::thread			 YUIAsyncLogWriter::_thread;
+std::mutex			 YUIAsyncLogWriter::_ringBuffersMutex;
+std::vector<YUILogRingBufferPtr> YUIAsyncLogWriter::_ringBuffers;
+std::mutex			 YUIAsyncLogWriter::_drainMutex;
+std::mutex			 YUIAsyncLogWriter::_wakeUpMutex;
+std::condition_variable		 YUIAsyncLogWriter::_wakeUp;
+bool				 YUIAsyncLogWriter::_wakeUpRequested = false;
+std::mutex			 YUIAsyncLogWriter::_drainedMutex;
+std::condition_variable		 YUIAsyncLogWriter::_drained;
+struct sigaction		 YUIAsyncLogWriter::_oldAbortAction;
+bool				 YUIAsyncLogWriter::_abortHandlerInstalled = false;
+bool				 YUIAsyncLogWriter::_exitHandlerInstalled = false;
+thread_local bool		 YUIAsyncLogWriter::_threadExiting = false;
+
+// How often the writer thread writes pending log lines if nobody wakes it up
+#define ASYNC_LOG_WRITE_INTERVAL_MILLISEC	50
+
+
+void
+YUIAsyncLogWriter::start( YUILogOverflowPolicy overflowPolicy, int bufferLines )
+{
+    stop();
+
+    _overflowPolicy = overflowPolicy;
+    _bufferLines    = bufferLines > 0 ? bufferLines : 1;
+    _generation++;	// Make all threads create new ring buffers
+    _stopRequested  = false;
+    _running	    = true;
+    _thread	    = std::thread( run );
+
+    if ( ! _exitHandlerInstalled )
+    {
+	atexit( stop );
+	_exitHandlerInstalled = true;
+    }
+
+    // Don't replace a handler that the application or another library
+    // installed: It might never return to ours.
+
+    struct sigaction current;
+    sigaction( SIGABRT, 0, &current );
+
+    if ( ! ( current.sa_flags & SA_SIGINFO ) && current.sa_handler == SIG_DFL )
+    {
+	struct sigaction action;
+	memset( &action, 0, sizeof( action ) );
+	action.sa_handler = abortHandler;
+	sigemptyset( &action.sa_mask );
+	sigaction( SIGABRT, &action, &_oldAbortAction );
+	_abortHandlerInstalled = true;
+    }
+}
+
+
+void
+YUIAsyncLogWriter::stop()
+{
+    if ( ! _running )
+	return;
+
+    if ( _abortHandlerInstalled )
+    {
+	// Only restore the old handler if nobody replaced ours in the meantime
+
+	struct sigaction current;
+	sigaction( SIGABRT, 0, &current );
+
+	if ( ! ( current.sa_flags & SA_SIGINFO ) && current.sa_handler == abortHandler )
+	    sigaction( SIGABRT, &_oldAbortAction, 0 );
+
+	_abortHandlerInstalled = false;
+    }
+
+    _stopRequested = true;
+    wakeUp();
+    notifyDrained();	// Threads waiting for free space give up
+
+    if ( _thread.joinable() )
+	_thread.join();
+
+    _running = false;
+
+    // Write anything that was logged while the writer thread was shutting down
+
+    std::lock_guard<std::mutex> lock( _drainMutex );
+    drainAll();
+}
+
+
+YUILogRingBuffer *
+YUIAsyncLogWriter::threadRingBuffer()
+{
+    static thread_local ThreadRingBuffer threadRingBuffer;
+
+    if ( ! threadRingBuffer.ringBuffer || threadRingBuffer.generation != _generation )
+    {
+	if ( threadRingBuffer.ringBuffer )
+	    threadRingBuffer.ringBuffer->close();
+
+	threadRingBuffer.ringBuffer = std::make_shared<YUILogRingBuffer>( _bufferLines );
+	threadRingBuffer.generation = _generation;
+
+	std::lock_guard<std::mutex> lock( _ringBuffersMutex );
+	_ringBuffers.push_back( threadRingBuffer.ringBuffer );
+    }
+
+    return threadRingBuffer.ringBuffer.get();
+}
+
+
+bool
+YUIAsyncLogWriter::write( string & line, YUILogLevel_t logLevel )
+{
+    if ( ! _running || _stopRequested || _threadExiting )
+	return false;
+
+    YUILogRingBuffer * ringBuffer = threadRingBuffer();
+
+    while ( ! ringBuffer->push( line ) )
+    {
+	if ( _overflowPolicy == YUI_LOG_OVERFLOW_DROP )
+	{
+	    _droppedLines++;
+	    wakeUp();
+
+	    return true;
+	}
+
+	// YUI_LOG_OVERFLOW_BLOCK: Wait until the writer thread made room.
+	// It notifies after each drain; the timeout is only a safety net.
+
+	if ( ! _running || _stopRequested )
+	    return false;
+
+	wakeUp();
+
+	std::unique_lock<std::mutex> lock( _drainedMutex );
+	_drained.wait_for( lock, std::chrono::milliseconds( ASYNC_LOG_WRITE_INTERVAL_MILLISEC ),
+			   [ ringBuffer ]()
+			   {
+			       return ringBuffer->fillLevel() < ringBuffer->capacity() || _stopRequested;
+			   } );
+    }
+
+    // Errors should reach the log file as soon as possible, and a ring
+    // buffer that is filling up should be written before it overflows
+
+    if ( logLevel == YUI_LOG_ERROR || ringBuffer->fillLevel() >= ringBuffer->capacity() / 2 )
+	wakeUp();
+
+    return true;
+}
+
+
+void
+YUIAsyncLogWriter::flush( bool emergency )
+{
+    if ( ! _running )
+	return;
+
+    if ( emergency )
+    {
+	// In a signal handler we can't wait for locks: The thread holding them
+	// might be the one that was interrupted. Just give up in that case.
+
+	if ( _drainMutex.try_lock() )
+	{
+	    drainAll( true );
+	    _drainMutex.unlock();
+	}
+    }
+    else
+    {
+	std::lock_guard<std::mutex> lock( _drainMutex );
+	drainAll();
+    }
+}
+
+
+void
+YUIAsyncLogWriter::run()
+{
+    while ( ! _stopRequested )
+    {
+	{
+	    std::unique_lock<std::mutex> lock( _wakeUpMutex );
+	    _wakeUp.wait_for( lock, std::chrono::milliseconds( ASYNC_LOG_WRITE_INTERVAL_MILLISEC ),
+			      []() { return _wakeUpRequested || _stopRequested; } );
+	    _wakeUpRequested = false;
+	}
+
+	std::lock_guard<std::mutex> lock( _drainMutex );
+	drainAll();
+    }
+}
+
+
+void
+YUIAsyncLogWriter::drainAll( bool emergency )
+{
+    // Only a thread that registers a new ring buffer holds this mutex, and
+    // only very briefly, so waiting is no problem - except in a signal
+    // handler which might have interrupted that very thread.
+
+    if ( emergency )
+    {
+	if ( ! _ringBuffersMutex.try_lock() )
+	    return;
+    }
+    else
+    {
+	_ringBuffersMutex.lock();
+    }
+
+    std::vector<YUILogRingBufferPtr> ringBuffers = _ringBuffers;
+
+    // Discard ring buffers of threads that exited once they are empty
+
+    for ( std::vector<YUILogRingBufferPtr>::iterator it = _ringBuffers.begin(); it != _ringBuffers.end(); )
+    {
+	if ( (*it)->isClosed() && (*it)->isEmpty() )
+	    it = _ringBuffers.erase( it );
+	else
+	    ++it;
+    }
+
+    _ringBuffersMutex.unlock();
+
+    size_t count = 0;
+
+    for ( std::vector<YUILogRingBufferPtr>::iterator it = ringBuffers.begin(); it != ringBuffers.end(); ++it )
+	count += (*it)->drain( *stdLogStream );
+
+    if ( count > 0 )
+    {
+	stdLogStream->flush();
+
+	// Not from a signal handler: That might deadlock
+	if ( ! emergency )
+	    notifyDrained();
+    }
+}
+
+
+void
+YUIAsyncLogWriter::wakeUp()
+{
+    // A request while the writer thread is busy draining must not get lost
+    {
+	std::lock_guard<std::mutex> lock( _wakeUpMutex );
+	_wakeUpRequested = true;
+    }
+
+    _wakeUp.notify_one();
+}
+
+
+void
+YUIAsyncLogWriter::notifyDrained()
+{
+    // Taking the lock makes sure that a thread that just found its ring
+    // buffer full is already waiting and does not miss this.
+
+    std::lock_guard<std::mutex> lock( _drainedMutex );
+    _drained.notify_all();
+}
+
+
+void
+YUIAsyncLogWriter::abortHandler( int sig )
+{
+    flush( true );
+
+    sigaction( SIGABRT, &_oldAbortAction, 0 );
+    raise( sig );
+}
+
+
 /**
  * Stream buffer class that will use the YUILog's logger function.
  *
@@ -181,13 +682,21 @@ YUILogBuffer::overflow( int ch )
 
 void YUILogBuffer::flush()
 {
-    writeBuffer( "\n", 1 );
+    // Nothing to do if the last line is complete. Don't write an empty line:
+    // The source location of the last line might no longer be valid.
+
+    if ( ! buffer.empty() )
+	writeBuffer( "\n", 1 );
 }
 
 
 
 
 
+// Set when the current thread's YPerThreadLogInfo is destroyed
+static thread_local bool threadLogInfoDestroyed = false;
+
+
 /**
  * Helper class: Per-thread logging information.
  *
@@ -208,6 +717,10 @@ void YUILogBuffer::flush()
  * formatting, not writing another thread's data structures without control -
  * which can easily happen if multiple threads are working on the same output
  * buffer, i.e. manipulate the same string.
+ *
+ * There is one instance of this per thread in thread-local storage; see
+ * currentThreadLogInfo(). It is destroyed when its thread exits, which
+ * flushes any incomplete last line of that thread.
  **/
 struct YPerThreadLogInfo
 {
@@ -215,12 +728,9 @@ struct YPerThreadLogInfo
      * Constructor
      **/
     YPerThreadLogInfo()
-	: threadHandle( pthread_self() )
-	, logBuffer()
+	: logBuffer()
 	, logStream( &logBuffer )
-        {
-            // cerr << "New thread with ID " << hex << threadHandle << dec << endl;
-        }
+        {}
 
     /**
      * Destructor
@@ -228,14 +738,7 @@ struct YPerThreadLogInfo
     ~YPerThreadLogInfo()
         {
             logBuffer.flush();
-        }
-
-    /**
-     * Check if this per-thread logging information belongs to the specified thread.
-     **/
-    bool isThread( pthread_t otherThreadHandle )
-        {
-            return pthread_equal( otherThreadHandle, this->threadHandle );
+            threadLogInfoDestroyed = true;
         }
 
 
@@ -243,12 +746,35 @@ struct YPerThreadLogInfo
     // Data members
     //
 
-    pthread_t		threadHandle;
     YUILogBuffer	logBuffer;
     ostream             logStream;
 };
 
 
+/**
+ * Return the per-thread logging information for the current thread.
+ * It is created upon the first call in each thread.
+ *
+ * The main thread's thread-local objects are destroyed before static objects
+ * and atexit() handlers (like YUILoader::deleteUI()), which may still log.
+ * From then on, this thread gets a replacement that is never deleted.
+ **/
+static YPerThreadLogInfo *
+currentThreadLogInfo()
+{
+    static thread_local YPerThreadLogInfo threadLogInfo;
+
+    if ( threadLogInfoDestroyed )
+    {
+	static thread_local YPerThreadLogInfo * lateThreadLogInfo = new YPerThreadLogInfo();
+
+	return lateThreadLogInfo;
+    }
+
+    return &threadLogInfo;
+}
+
+
 
 
 struct YUILogPrivate
@@ -261,43 +787,9 @@ struct YUILogPrivate
 	, enableDebugLoggingHook( 0 )
 	, debugLoggingEnabledHook( 0 )
 	, enableDebugLogging( false )
+	, minLogLevel( YUI_LOG_DEBUG )
 	{}
 
-    /**
-     * Destructor
-     **/
-    ~YUILogPrivate()
-        {
-            for ( unsigned i=0; i < threadLogInfo.size(); i++ )
-                delete threadLogInfo[i];
-        }
-
-    /**
-     * Find the per-thread logging information for the current thread.
-     * Create a new one if it doesn't exist yet.
-     **/
-    YPerThreadLogInfo * findCurrentThread()
-        {
-            pthread_t thisThread = pthread_self();
-
-            // Search backwards: Slight optimization for the UI.
-            // The UI thread does the most logging, but it is created after the
-            // main thread.
-
-            for ( std::vector<YPerThreadLogInfo *>::reverse_iterator it = threadLogInfo.rbegin();
-                  it != threadLogInfo.rend();
-                  ++it )
-            {
-                if ( (*it)->isThread( thisThread ) )
-                    return (*it);
-            }
-
-            YPerThreadLogInfo * newThreadLogInfo = new YPerThreadLogInfo();
-            threadLogInfo.push_back( newThreadLogInfo );
-
-            return newThreadLogInfo;
-        }
-
     //
     // Data members
     //
@@ -308,13 +800,16 @@ struct YUILogPrivate
     YUIEnableDebugLoggingFunction	enableDebugLoggingHook;
     YUIDebugLoggingEnabledFunction	debugLoggingEnabledHook;
     bool				enableDebugLogging;
-
-    std::vector<YPerThreadLogInfo *>    threadLogInfo;
+    YUILogLevel_t			minLogLevel;
 };
 
 
 
 
+// Debug logging is disabled by default
+std::atomic<int> YUILog::_logLevelThreshold( YUI_LOG_MILESTONE );
+
+
 YUILog::YUILog()
     : priv( new YUILogPrivate() )
 {
@@ -332,13 +827,11 @@ YUILog::~YUILog()
 YUILog *
 YUILog::instance()
 {
-    static YUILog * instance = 0;
+    // Initializing a function-local static is thread-safe,
+    // so the first log calls from several threads can't race here.
 
-    if ( ! instance )
-    {
-	instance = new YUILog();
-	YUI_CHECK_NEW( instance );
-    }
+    static YUILog * instance = new YUILog();
+    YUI_CHECK_NEW( instance );
 
     return instance;
 }
@@ -347,6 +840,9 @@ YUILog::instance()
 bool
 YUILog::setLogFileName( const string & logFileName )
 {
+    // Don't pull the stream away under the asynchronous log writer's feet
+    std::lock_guard<std::mutex> lock( YUIAsyncLogWriter::streamMutex() );
+
     instance()->priv->logFileName = logFileName;
 
     std::ofstream & logStream = instance()->priv->stdLogStream;
@@ -380,6 +876,39 @@ YUILog::setLogFileName( const string & logFileName )
 }
 
 
+void
+YUILog::enableAsyncLogging( bool		 enable,
+			    YUILogOverflowPolicy overflowPolicy,
+			    int			 bufferLines )
+{
+    if ( enable )
+	YUIAsyncLogWriter::start( overflowPolicy, bufferLines );
+    else
+	YUIAsyncLogWriter::stop();
+}
+
+
+bool
+YUILog::asyncLoggingEnabled()
+{
+    return YUIAsyncLogWriter::isRunning();
+}
+
+
+void
+YUILog::flushAsyncLog()
+{
+    YUIAsyncLogWriter::flush();
+}
+
+
+long
+YUILog::droppedLogLines()
+{
+    return YUIAsyncLogWriter::droppedLines();
+}
+
+
 string
 YUILog::logFileName()
 {
@@ -390,10 +919,33 @@ YUILog::logFileName()
 void
 YUILog::enableDebugLogging( bool debugLogging )
 {
-    instance()->priv->enableDebugLogging = debugLogging;
+    YUILogPrivate * priv = instance()->priv.get();
+    priv->enableDebugLogging = debugLogging;
+
+    if ( priv->enableDebugLoggingHook )
+	priv->enableDebugLoggingHook( debugLogging );
+
+    if ( priv->minLogLevel <= YUI_LOG_MILESTONE )
+	priv->minLogLevel = debugLogging ? YUI_LOG_DEBUG : YUI_LOG_MILESTONE;
+
+    updateLogLevelThreshold();
+}
+
+
+void
+YUILog::updateLogLevelThreshold()
+{
+    YUILogPrivate * priv = instance()->priv.get();
+    int threshold = priv->minLogLevel;
+
+    // The standard logger drops debug logging if it is disabled; a custom
+    // logger or the debug logging hooks report what they want with
+    // setMinLogLevel().
 
-    if ( instance()->priv->enableDebugLoggingHook )
-	instance()->priv->enableDebugLoggingHook( debugLogging );
+    if ( priv->loggerFunction == stdLogger && ! priv->debugLoggingEnabledHook )
+	threshold = priv->enableDebugLogging ? YUI_LOG_DEBUG : YUI_LOG_MILESTONE;
+
+    _logLevelThreshold.store( threshold );
 }
 
 
@@ -414,6 +966,7 @@ YUILog::setLoggerFunction( YUILoggerFunction loggerFunction )
 	loggerFunction = stdLogger;
 
     instance()->priv->loggerFunction = loggerFunction;
+    updateLogLevelThreshold();
 }
 
 
@@ -435,6 +988,7 @@ YUILog::setEnableDebugLoggingHooks( YUIEnableDebugLoggingFunction  enableFunctio
 {
     instance()->priv->enableDebugLoggingHook  = enableFunction;
     instance()->priv->debugLoggingEnabledHook = isEnabledFunction;
+    updateLogLevelThreshold();
 }
 
 
@@ -452,6 +1006,21 @@ YUILog::debugLoggingEnabledHook()
 }
 
 
+void
+YUILog::setMinLogLevel( YUILogLevel_t logLevel )
+{
+    instance()->priv->minLogLevel = logLevel;
+    updateLogLevelThreshold();
+}
+
+
+YUILogLevel_t
+YUILog::minLogLevel()
+{
+    return instance()->priv->minLogLevel;
+}
+
+
 ostream &
 YUILog::log( YUILogLevel_t	logLevel,
 	     const char *	logComponent,
@@ -459,7 +1028,7 @@ YUILog::log( YUILogLevel_t	logLevel,
 	     int 		lineNo,
 	     const char * 	functionName )
 {
-    YPerThreadLogInfo * threadLogInfo = priv->findCurrentThread();
+    YPerThreadLogInfo * threadLogInfo = currentThreadLogInfo();
 
     if ( ! threadLogInfo->logBuffer.buffer.empty() )	// Leftovers from previous logging?
     {
@@ -563,6 +1132,29 @@ stdLogger( YUILogLevel_t	logLevel,
     if ( ! message )
 	message = "";
 
+    if ( YUIAsyncLogWriter::isRunning() )
+    {
+	string line;
+	line.reserve( 64 + strlen( message ) );
+	line += "<";
+	line += logLevelStr;
+	line += "> [";
+	line += logComponent;
+	line += "] ";
+	line += sourceFileName;
+	line += ":";
+	line += std::to_string( sourceLineNo );
+	line += " ";
+	line += sourceFunctionName;
+	line += "(): ";
+	line += message;
+
+	if ( YUIAsyncLogWriter::write( line, logLevel ) )
+	    return;
+    }
+
+    std::lock_guard<std::mutex> lock( YUIAsyncLogWriter::streamMutex() );
+
     (*stdLogStream) << "<" << logLevelStr  << "> "
 		    << "[" << logComponent << "] "
 		    << sourceFileName	   << ":" << sourceLineNo << " "
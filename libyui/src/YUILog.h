@@ -30,6 +30,7 @@
 
 #include <iostream>
 #include <string>
+#include <atomic>
 
 #include "ImplPtr.h"
 
@@ -53,11 +54,30 @@ using std::endl;
 // Unless the underlying logger function handles this differently,
 // Milestone, Warning and Error are always logged, Debug only when enabled.
 //
+// If a log level is disabled, the complete logging statement is skipped,
+// i.e. nothing after yuiDebug() is evaluated. So don't rely on any side
+// effects in logging statements. This also means that these macros can
+// only be used in statements like above; if you need the log stream
+// itself, e.g. to pass it to a function, use yuiDebugStream() etc.
+//
+// To compile out log levels completely (e.g. debug logging in release
+// builds), #define YUI_LOG_MIN_LEVEL to the lowest log level to keep,
+// e.g. -DYUI_LOG_MIN_LEVEL=1 to drop all debug logging.
+//
 
-#define yuiDebug()	YUILog::debug    ( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
-#define yuiMilestone()	YUILog::milestone( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
-#define yuiWarning()	YUILog::warning  ( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
-#define yuiError()	YUILog::error    ( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
+#define yuiDebug()	YUI_LOG_IF( YUI_LOG_DEBUG     ) yuiDebugStream()
+#define yuiMilestone()	YUI_LOG_IF( YUI_LOG_MILESTONE ) yuiMilestoneStream()
+#define yuiWarning()	YUI_LOG_IF( YUI_LOG_WARNING   ) yuiWarningStream()
+#define yuiError()	YUI_LOG_IF( YUI_LOG_ERROR     ) yuiErrorStream()
+
+#define yuiDebugStream()	YUILog::debug    ( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
+#define yuiMilestoneStream()	YUILog::milestone( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
+#define yuiWarningStream()	YUILog::warning  ( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
+#define yuiErrorStream()	YUILog::error    ( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
+
+#ifndef YUI_LOG_MIN_LEVEL
+#define YUI_LOG_MIN_LEVEL	0	// YUI_LOG_DEBUG: Keep everything
+#endif
 
 
 //
@@ -77,6 +97,37 @@ enum YUILogLevel_t
 };
 
 
+/**
+ * Skip the rest of the statement if the specified log level is disabled.
+ *
+ * The operator& of YUILogVoidify has a lower precedence than operator<<,
+ * so the complete "stream << a << b" expression becomes its operand.
+ * Unlike an "if" this is safe in unbraced if / else statements.
+ **/
+#define YUI_LOG_IF( logLevel )					\
+    ! YUILog::logLevelEnabled( logLevel ) ? (void) 0 : YUILogVoidify() &
+
+
+/**
+ * Helper class for YUI_LOG_IF: Turn a log stream expression into void.
+ **/
+class YUILogVoidify
+{
+public:
+    void operator&( std::ostream & ) {}
+};
+
+
+/**
+ * What to do when the buffer of the asynchronous standard logger is full.
+ **/
+enum YUILogOverflowPolicy
+{
+    YUI_LOG_OVERFLOW_DROP = 0,	// Discard the new log line (and count it)
+    YUI_LOG_OVERFLOW_BLOCK	// Wait until the writer thread made room
+};
+
+
 /**
  * Logger function.
  *
@@ -124,6 +175,22 @@ public:
      **/
     static YUILog * instance();
 
+    /**
+     * Return 'true' if log lines with the specified log level would be
+     * passed on to the logger function. This is very cheap; it is used by
+     * the yuiDebug() etc. macros to skip disabled logging statements
+     * completely.
+     *
+     * With the standard logger function and without debug logging hooks
+     * this follows enableDebugLogging(); otherwise it uses the level
+     * reported with setMinLogLevel().
+     **/
+    static bool logLevelEnabled( YUILogLevel_t logLevel )
+    {
+	return logLevel >= YUI_LOG_MIN_LEVEL &&
+	    logLevel >= _logLevelThreshold.load( std::memory_order_relaxed );
+    }
+
     /**
      * Enable or disable debug logging.
      **/
@@ -158,6 +225,52 @@ public:
      **/
     static bool setLogFileName( const std::string & logFileName );
 
+    /**
+     * Enable or disable asynchronous logging for the standard logger
+     * function.
+     *
+     * When enabled, the standard logger function does not write to the log
+     * file (or stderr) directly; it only formats the log line and puts it
+     * into a ring buffer of the calling thread. A background writer thread
+     * collects the lines from all threads and writes them in batches. So
+     * slow log disks (NFS etc.) no longer slow down the caller, in
+     * particular the UI thread.
+     *
+     * 'bufferLines' is the capacity of each thread's ring buffer.
+     * 'overflowPolicy' specifies what happens when a thread's buffer is
+     * full because the writer thread cannot keep up.
+     *
+     * The order of log lines is preserved within each thread, but lines of
+     * different threads might be written in a different order than they
+     * were logged.
+     *
+     * Pending log lines are written when asynchronous logging is disabled,
+     * upon flushAsyncLog(), upon program exit and upon abort().
+     *
+     * This has no effect on custom logger functions; see setLoggerFunction().
+     **/
+    static void enableAsyncLogging( bool		 enable		= true,
+				    YUILogOverflowPolicy overflowPolicy = YUI_LOG_OVERFLOW_DROP,
+				    int			 bufferLines	= 4096 );
+
+    /**
+     * Return 'true' if asynchronous logging is enabled, 'false' if not.
+     **/
+    static bool asyncLoggingEnabled();
+
+    /**
+     * Write all pending log lines of the asynchronous standard logger and
+     * wait until that is done. This does nothing if asynchronous logging is
+     * not enabled.
+     **/
+    static void flushAsyncLog();
+
+    /**
+     * Return the number of log lines that were discarded so far because a
+     * ring buffer of the asynchronous standard logger was full.
+     **/
+    static long droppedLogLines();
+
     /**
      * Return the current log file name or an empty string if stderr is used.
      * Notice that this information is only relevant as long as the standard
@@ -209,6 +322,27 @@ public:
      **/
     static YUIDebugLoggingEnabledFunction debugLoggingEnabledHook();
 
+    /**
+     * Set the lowest log level that a custom logger function or the debug
+     * logging hooks want to get. Logging statements below that level are
+     * skipped by yuiDebug() etc. without evaluating them, so the
+     * application should call this again whenever that changes, e.g. when
+     * it switches its own debug logging on or off.
+     *
+     * The default is YUI_LOG_DEBUG, i.e. everything is passed on and the
+     * logger function decides. enableDebugLogging() switches between
+     * YUI_LOG_DEBUG and YUI_LOG_MILESTONE unless a higher level was set.
+     *
+     * This is not used for the standard logger function without debug
+     * logging hooks; that one always follows enableDebugLogging().
+     **/
+    static void setMinLogLevel( YUILogLevel_t logLevel );
+
+    /**
+     * Return the log level set with setMinLogLevel().
+     **/
+    static YUILogLevel_t minLogLevel();
+
     /**
      * Return the base name without path from a file name with path.
      **/
@@ -229,11 +363,20 @@ private:
      **/
     ~YUILog();
 
+    /**
+     * Recalculate the lowest log level that can pass logLevelEnabled()
+     * after the debug logging status, the logger function or the debug
+     * logging hooks changed.
+     **/
+    static void updateLogLevelThreshold();
+
     //
     // Data
     //
 
     ImplPtr<YUILogPrivate> priv;
+
+    static std::atomic<int> _logLevelThreshold;
 };
 
 
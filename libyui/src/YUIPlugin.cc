@@ -29,6 +29,8 @@
 #include "YUILog.h"
 
 #include "YUIPlugin.h"
+#include "YUILoader.h"
+#include "YUITrace.h"
 #include "YPath.h"
 
 #include "Libyui_config.h"
@@ -42,10 +44,14 @@ YUIPlugin::YUIPlugin( const char * pluginLibBaseName )
     _pluginLibBaseName = string( pluginLibBaseName );
 
     string pluginFilename = pluginLibFullPath();
+    double startTime = YUITrace::now();
 
     _pluginLibHandle = dlopen( pluginFilename.c_str(),
 			       RTLD_NOW | RTLD_GLOBAL);
 
+    _loadTime = ( YUITrace::now() - startTime ) / 1000.0;
+    YUILoader::addStartupPhase( "load plugin " + _pluginLibBaseName, _loadTime );
+
     if ( ! _pluginLibHandle )
     {
 	_errorMsg = dlerror();
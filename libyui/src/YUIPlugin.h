@@ -83,6 +83,13 @@ public:
      **/
     std::string errorMsg() const;
 
+    /**
+     * Returns the time in milliseconds it took to load the plugin library
+     * in the constructor. This is also logged and added to the startup
+     * phases (see YUILoader::startupPhases()).
+     **/
+    double loadTime() const { return _loadTime; }
+
 protected:
 
     /**
@@ -105,6 +112,7 @@ private:
     std::string	_pluginLibBaseName;
     void * 	_pluginLibHandle;
     std::string	_errorMsg;
+    double	_loadTime;
 };
 
 
@@ -0,0 +1,207 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YUITrace.cc
+
+/-*/
+
+
+#include <stdio.h>		// snprintf()
+#include <unistd.h>		// getpid()
+#include <sys/syscall.h>	// SYS_gettid
+#include <fstream>
+#include <mutex>
+
+#define YUILogComponent "ui"
+#include "YUILog.h"
+
+#include "YUITrace.h"
+#include "YEnvVar.h"
+
+#define ENV_TRACE	"YUI_TRACE"
+
+using std::string;
+
+
+std::atomic<bool> YUITrace::_enabled( false );
+
+
+namespace
+{
+    /**
+     * The trace file. Destroying it at program exit terminates the JSON
+     * array and flushes the file.
+     **/
+    struct TraceWriter
+    {
+	~TraceWriter() { YUITrace::stop(); }
+
+	std::mutex	mutex;
+	std::ofstream	file;
+	bool		firstEvent = true;
+	double		startTime  = 0.0;
+	long		pid	   = 0;
+    };
+
+    TraceWriter traceWriter;
+
+
+    long threadId()
+    {
+	static thread_local long tid = syscall( SYS_gettid );
+
+	return tid;
+    }
+
+
+    string jsonString( const char * str )
+    {
+	string result( "\"" );
+
+	for ( const char * pos = str; *pos; ++pos )
+	{
+	    unsigned char c = *pos;
+
+	    switch ( c )
+	    {
+		case '"':  result += "\\\""; break;
+		case '\\': result += "\\\\"; break;
+		case '\n': result += "\\n";  break;
+		case '\t': result += "\\t";  break;
+
+		default:
+		    if ( c < 0x20 )
+		    {
+			char buf[8];
+			snprintf( buf, sizeof( buf ), "\\u%04x", c );
+			result += buf;
+		    }
+		    else
+		    {
+			result += c;
+		    }
+	    }
+	}
+
+	return result + "\"";
+    }
+
+
+    /**
+     * Write one event with the fields common to all event types.
+     * 'fields' are the type specific fields, including the leading comma.
+     **/
+    void writeEvent( const char *   category,
+		     const char *   name,
+		     char	    phase,
+		     double	    timestamp,
+		     const string & fields )
+    {
+	char buf[128];
+	snprintf( buf, sizeof( buf ), ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%ld,\"tid\":%ld",
+		  phase, timestamp - traceWriter.startTime, traceWriter.pid, threadId() );
+
+	string event = "{\"name\":" + jsonString( name )
+	    + ",\"cat\":" + jsonString( category )
+	    + buf + fields + "}";
+
+	std::lock_guard<std::mutex> lock( traceWriter.mutex );
+
+	if ( ! traceWriter.file.is_open() )	// stopped in the meantime
+	    return;
+
+	traceWriter.file << ( traceWriter.firstEvent ? "[\n" : ",\n" ) << event;
+	traceWriter.firstEvent = false;
+    }
+}
+
+
+bool YUITrace::start( const string & fileName )
+{
+    stop();
+
+    std::lock_guard<std::mutex> lock( traceWriter.mutex );
+
+    traceWriter.file.open( fileName.c_str(), std::ios::out | std::ios::trunc );
+
+    if ( ! traceWriter.file.is_open() )
+    {
+	yuiError() << "Can't open trace file " << fileName << endl;
+	return false;
+    }
+
+    yuiMilestone() << "Writing trace events to " << fileName << endl;
+
+    traceWriter.firstEvent = true;
+    traceWriter.startTime  = now();
+    traceWriter.pid	   = getpid();
+    _enabled = true;
+
+    return true;
+}
+
+
+void YUITrace::startFromEnvironment()
+{
+    if ( isEnabled() )
+	return;
+
+    YEnvVar env( ENV_TRACE );
+
+    if ( env.isSet() && ! env.value().empty() )
+	start( env.value() );
+}
+
+
+void YUITrace::stop()
+{
+    _enabled = false;
+
+    std::lock_guard<std::mutex> lock( traceWriter.mutex );
+
+    if ( traceWriter.file.is_open() )
+    {
+	traceWriter.file << ( traceWriter.firstEvent ? "[]\n" : "\n]\n" );
+	traceWriter.file.close();
+    }
+}
+
+
+void YUITrace::span( const char *   category,
+		     const char *   name,
+		     double	    startTime,
+		     const string & detail )
+{
+    char buf[64];
+    snprintf( buf, sizeof( buf ), ",\"dur\":%.3f", now() - startTime );
+    string fields( buf );
+
+    if ( ! detail.empty() )
+	fields += ",\"args\":{\"detail\":" + jsonString( detail.c_str() ) + "}";
+
+    writeEvent( category, name, 'X', startTime, fields );
+}
+
+
+void YUITrace::counter( const char * category,
+			const char * name,
+			long long    value )
+{
+    writeEvent( category, name, 'C', now(),
+		",\"args\":{\"value\":" + std::to_string( value ) + "}" );
+}
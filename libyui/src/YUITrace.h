@@ -0,0 +1,202 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YUITrace.h
+
+/-*/
+
+#ifndef YUITrace_h
+#define YUITrace_h
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+
+/**
+ * Lightweight tracing: Timed spans and counters written in the Chrome
+ * trace event format, to be viewed with chrome://tracing or Perfetto.
+ *
+ * Tracing is enabled at runtime with the environment variable
+ *
+ *     YUI_TRACE=/tmp/yui-trace.json
+ *
+ * which is read when the UI is created, or with YUITrace::start().
+ * When tracing is not enabled, a span costs a single check of a flag.
+ *
+ * Use the macros below rather than the classes directly: They use the
+ * YUILogComponent of the source file as the trace category, and they
+ * compile to nothing if YUI_NO_TRACING is defined (see the TRACING CMake
+ * option).
+ *
+ *     void NCDialog::wRedraw()
+ *     {
+ *         YUI_TRACE_SPAN( "dialogRedraw" );
+ *         ...
+ *     }
+ *
+ *     YUI_TRACE_SPAN_DETAIL( "setProperty", propertyName );
+ *     YUI_TRACE_COUNTER( "items", itemsCount() );
+ *
+ * The detail of a span is a string that is only evaluated when tracing is
+ * enabled.
+ **/
+class YUITrace
+{
+public:
+
+    /**
+     * Return 'true' if trace events are being written.
+     **/
+    static bool isEnabled() { return _enabled.load( std::memory_order_relaxed ); }
+
+    /**
+     * Start writing trace events to 'fileName'. Any previous trace file is
+     * closed first. Return 'true' on success.
+     *
+     * Don't call this (or stop()) while other threads might be tracing.
+     **/
+    static bool start( const std::string & fileName );
+
+    /**
+     * Start tracing if the YUI_TRACE environment variable is set to a file
+     * name and tracing is not enabled yet. YUI does this in its
+     * constructor.
+     **/
+    static void startFromEnvironment();
+
+    /**
+     * Stop tracing and close the trace file. This happens automatically at
+     * program exit.
+     **/
+    static void stop();
+
+    /**
+     * Return the current time in microseconds on the trace clock.
+     **/
+    static double now()
+    {
+	using namespace std::chrono;
+	return duration<double, std::micro>( steady_clock::now().time_since_epoch() ).count();
+    }
+
+    /**
+     * Write a complete span from 'startTime' (see now()) until now.
+     **/
+    static void span( const char *	  category,
+		      const char *	  name,
+		      double		  startTime,
+		      const std::string & detail = std::string() );
+
+    /**
+     * Write the current value of a counter.
+     **/
+    static void counter( const char * category,
+			 const char * name,
+			 long long    value );
+
+private:
+
+    static std::atomic<bool> _enabled;
+};
+
+
+/**
+ * Span from the construction to the destruction of this object.
+ * Use the YUI_TRACE_SPAN() macros instead of this class.
+ **/
+class YUITraceSpan
+{
+public:
+
+    YUITraceSpan( const char * category, const char * name )
+	: _category( category )
+	, _name( name )
+	, _active( YUITrace::isEnabled() )
+	, _startTime( _active ? YUITrace::now() : 0.0 )
+	{}
+
+    ~YUITraceSpan()
+	{
+	    if ( _active )
+		YUITrace::span( _category, _name, _startTime, _detail );
+	}
+
+    /**
+     * Return 'true' if this span will be written.
+     **/
+    bool isActive() const { return _active; }
+
+    /**
+     * Set a detail text that is written with this span.
+     **/
+    void setDetail( const std::string & detail ) { _detail = detail; }
+
+private:
+
+    YUITraceSpan( const YUITraceSpan & );	// no copy
+    void operator=( const YUITraceSpan & );	// no assign
+
+    const char *	_category;
+    const char *	_name;
+    bool		_active;
+    double		_startTime;
+    std::string		_detail;
+};
+
+
+#define YUI_TRACE_CONCAT2( A, B )	A ## B
+#define YUI_TRACE_CONCAT( A, B )	YUI_TRACE_CONCAT2( A, B )
+
+#ifndef YUI_NO_TRACING
+
+/**
+ * Trace the rest of the current scope as a span called NAME.
+ **/
+#define YUI_TRACE_SPAN( NAME )	\
+    YUITraceSpan YUI_TRACE_CONCAT( _yuiTraceSpan, __LINE__ )( YUILogComponent, NAME )
+
+/**
+ * Like YUI_TRACE_SPAN(), with a detail text. DETAIL is only evaluated if
+ * tracing is enabled.
+ **/
+#define YUI_TRACE_SPAN_DETAIL( NAME, DETAIL )						\
+    YUITraceSpan YUI_TRACE_CONCAT( _yuiTraceSpan, __LINE__ )( YUILogComponent, NAME );	\
+    if ( YUI_TRACE_CONCAT( _yuiTraceSpan, __LINE__ ).isActive() )			\
+	YUI_TRACE_CONCAT( _yuiTraceSpan, __LINE__ ).setDetail( DETAIL )
+
+/**
+ * Write the current VALUE of the counter NAME.
+ **/
+#define YUI_TRACE_COUNTER( NAME, VALUE )				\
+    do									\
+    {									\
+	if ( YUITrace::isEnabled() )					\
+	    YUITrace::counter( YUILogComponent, NAME, VALUE );		\
+    } while ( 0 )
+
+#else // YUI_NO_TRACING
+
+#define YUI_TRACE_SPAN( NAME )			do {} while ( 0 )
+#define YUI_TRACE_SPAN_DETAIL( NAME, DETAIL )	do {} while ( 0 )
+#define YUI_TRACE_COUNTER( NAME, VALUE )	do {} while ( 0 )
+
+#endif // YUI_NO_TRACING
+
+
+#endif // YUITrace_h
@@ -42,6 +42,7 @@
 #include "YMacroRecorder.h"
 
 #include "YChildrenManager.h"
+#include "YUITrace.h"
 
 #define MAX_DEBUG_LABEL_LEN	50
 #define YWIDGET_MAGIC		42
@@ -61,6 +62,8 @@ struct YWidgetPrivate
     YWidgetPrivate( YWidgetChildrenManager * manager, YWidget * parentWidget = 0 )
 	: childrenManager( manager )
 	, parent( parentWidget )
+	, childOf( 0 )
+	, dialog( 0 )
 	, beingDestroyed( false )
 	, enabled( true )
 	, notify( false )
@@ -70,11 +73,17 @@ struct YWidgetPrivate
 	, toolkitWidgetRep( 0 )
 	, id( 0 )
 	, functionKey( 0 )
+	, changeGeneration( 0 )
+	, hasInputSnapshot( false )
     {
 	stretch.hor	= false;
 	stretch.vert	= false;
 	weight.hor	= 0;
 	weight.vert	= 0;
+	preferredSize.hor	= 0;
+	preferredSize.vert	= 0;
+	preferredSizeGeneration.hor	= 0;
+	preferredSizeGeneration.vert	= 0;
     }
 
     //
@@ -83,6 +92,9 @@ struct YWidgetPrivate
 
     YWidgetChildrenManager *	childrenManager;
     YWidget *			parent;
+    YWidget *			childOf;	// whose children manager lists this widget
+    YWidgetListIterator		childPos;	// position in that list
+    YDialog *			dialog;		// cached result of findDialog()
     bool			beingDestroyed;
     bool			enabled;
     bool			notify;
@@ -95,12 +107,91 @@ struct YWidgetPrivate
     YBothDim<int>		weight;
     int				functionKey;
     string			helpText;
+    YBothDim<int>		preferredSize;
+    YBothDim<int>		preferredSizeGeneration; // 0: not cached
+    unsigned long		changeGeneration;	 // 0: not changed
+    YPropertyValue		inputSnapshot;		 // see detectInputChange()
+    bool			hasInputSnapshot;
 };
 
 
 
 
 bool YWidget::_usedOperatorNew = false;
+std::atomic<int> YWidget::_findWidgetFallbackCount( 0 );
+int  YWidget::_preferredSizeGeneration = 1;
+
+
+/**
+ * Add 'widget' and all its descendants that have an ID to the widget ID
+ * index of 'dialog' (or remove them from it).
+ **/
+static void updateWidgetIdIndex( YDialog * dialog, YWidget * widget, bool add )
+{
+    if ( widget->hasId() )
+    {
+	if ( add )
+	    dialog->registerWidgetId( widget );
+	else
+	    dialog->unregisterWidgetId( widget );
+    }
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	updateWidgetIdIndex( dialog, *it, add );
+    }
+}
+
+
+/**
+ * Tell the shortcut manager of 'dialog' that 'widget' and all its
+ * descendants were added (or removed).
+ **/
+static void updateShortcuts( YDialog * dialog, YWidget * widget, bool add )
+{
+    if ( add )
+	dialog->invalidateShortcuts( widget );
+    else
+	dialog->removeShortcuts( widget );
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	updateShortcuts( dialog, *it, add );
+    }
+}
+
+
+/**
+ * Recursively find a widget by its ID the slow way: By walking the widget
+ * tree below 'widget'.
+ **/
+static YWidget * findWidgetInTree( const YWidget * widget, YWidgetID * id )
+{
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	YWidget * child = *it;
+	YUI_CHECK_WIDGET( child );
+
+	if ( child->id() && child->id()->isEqual( id ) )
+	    return child;
+
+	if ( child->hasChildren() )
+	{
+	    YWidget * found = findWidgetInTree( child, id );
+
+	    if ( found )
+		return found;
+	}
+    }
+
+    return 0;
+}
 
 
 YWidget::YWidget( YWidget * parent )
@@ -149,6 +240,17 @@ YWidget::~YWidget()
     deleteChildren();
     YUI::ui()->deleteNotify( this );
 
+    YDialog * dialog = findDialog();
+
+    if ( dialog && ! dialog->beingDestroyed() )
+    {
+	if ( priv->id )
+	    dialog->unregisterWidgetId( this );
+
+	dialog->removeShortcuts( this );
+	dialog->markModified( true );
+    }
+
     if ( parent() && ! parent()->beingDestroyed() )
 	parent()->removeChild( this );
 
@@ -182,7 +284,7 @@ void
 YWidget::addChild( YWidget * child )
 {
 #if CHECK_FOR_DUPLICATE_CHILDREN
-    if ( child && childrenManager()->contains( child ) )
+    if ( child && child->priv->childOf == this )
     {
 	yuiError() << this << " already contains " << child << endl;
 	YUI_THROW( YUIInvalidChildException<YWidget>( this, child ) );
@@ -190,6 +292,34 @@ YWidget::addChild( YWidget * child )
 #endif
 
     childrenManager()->add( child );
+    invalidatePreferredSize();
+
+    if ( child )
+    {
+	child->priv->childOf = this;
+
+	// add() appends the child. With a std::list that position stays valid
+	// until the child is removed, so removeChild() does not need to search.
+
+	child->priv->childPos = std::prev( childrenManager()->end() );
+
+	if ( child->hasChildren() )
+	    child->forgetDialog();
+    }
+
+    YDialog * dialog = child ? findDialog() : 0;
+
+    if ( dialog )
+    {
+	// A newly created child has neither an ID nor children yet, so this
+	// is only relevant for subtrees that are added later.
+
+	if ( child->hasId() || child->hasChildren() )
+	    updateWidgetIdIndex( dialog, child, true );
+
+	updateShortcuts( dialog, child, true );
+	dialog->markModified( true );
+    }
 }
 
 
@@ -199,29 +329,56 @@ YWidget::removeChild( YWidget * child )
     if ( ! beingDestroyed() )
     {
 	// yuiDebug() << "Removing " << child << " from " << this << endl;
-	childrenManager()->remove( child );
+
+	if ( child && child->priv->childOf == this )
+	{
+	    childrenManager()->erase( child->priv->childPos );
+	    child->priv->childOf = 0;
+	    child->forgetDialog();
+	}
+
+	invalidatePreferredSize();
+
+	if ( child && ! child->beingDestroyed() )
+	{
+	    YDialog * dialog = findDialog();
+
+	    if ( dialog )
+	    {
+		updateWidgetIdIndex( dialog, child, false );
+		updateShortcuts( dialog, child, false );
+		dialog->markModified( true );
+	    }
+	}
     }
 }
 
 
+bool
+YWidget::contains( YWidget * child ) const
+{
+    return child && child->priv->childOf == this;
+}
+
+
 void
 YWidget::deleteChildren()
 {
-    YWidgetList::const_iterator it = childrenBegin();
+    // Take the children out of the children manager first: Each child
+    // removes itself from its parent while being destroyed (unless the
+    // parent is being destroyed, too).
 
-    while ( it != childrenEnd() )
-    {
-	YWidget * child = *it;
-	++it;
+    YWidgetList children = childrenManager()->takeAll();
 
+    for ( YWidget * child: children )
+    {
 	if ( child->isValid() )
 	{
 	    // yuiDebug() << "Deleting " << child << endl;
+	    child->priv->childOf = 0;
 	    delete child;
 	}
     }
-
-    childrenManager()->clear();
 }
 
 
@@ -300,6 +457,7 @@ YWidget::setParent( YWidget * newParent )
     }
 
     priv->parent = newParent;
+    forgetDialog();
 }
 
 
@@ -342,6 +500,7 @@ bool YWidget::hasFunctionKey() const
 void YWidget::setFunctionKey( int fkey_no )
 {
     priv->functionKey = fkey_no;
+    markChanged();
 }
 
 
@@ -354,6 +513,7 @@ string YWidget::helpText() const
 void YWidget::setHelpText( const string & helpText )
 {
     priv->helpText = helpText;
+    markChanged();
 }
 
 
@@ -366,10 +526,23 @@ YWidget::id() const
 
 void YWidget::setId( YWidgetID * newId )
 {
+    YDialog * dialog = findDialog();
+
     if ( priv->id )
+    {
+	if ( dialog )
+	    dialog->unregisterWidgetId( this );
+
 	delete priv->id;
+    }
 
     priv->id = newId;
+
+    if ( dialog && priv->id )
+	dialog->registerWidgetId( this );
+
+    markLabelChanged();
+    markChanged();
 }
 
 
@@ -381,19 +554,39 @@ bool YWidget::hasId() const
 
 YDialog * YWidget::findDialog()
 {
+    // Events and widget ID lookups need this all the time, so the result is
+    // cached. A widget can't move to another dialog without being removed
+    // from its parent and added to another one, which clears the cache.
+
+    if ( priv->dialog )
+	return priv->dialog;
+
     YWidget * widget = this;
+    YDialog * dialog = 0;
 
-    while ( widget )
+    while ( widget && ! dialog )
     {
-	YDialog * dialog = dynamic_cast<YDialog *> (widget);
-
-	if ( dialog )
-	    return dialog;
+	if ( widget->priv->dialog )
+	    dialog = widget->priv->dialog;
 	else
+	{
+	    dialog = dynamic_cast<YDialog *> (widget);
 	    widget = widget->parent();
+	}
     }
 
-    return 0;
+    priv->dialog = dialog;
+
+    return dialog;
+}
+
+
+void YWidget::forgetDialog()
+{
+    priv->dialog = 0;
+
+    for ( YWidget * child: *this )
+	child->forgetDialog();
 }
 
 
@@ -437,6 +630,17 @@ YWidget::propertySet()
 bool
 YWidget::setProperty( const string & propertyName, const YPropertyValue & val )
 {
+    YUI_TRACE_SPAN_DETAIL( "setProperty", propertyName );
+    YPropertyId propertyId = YProperty::lookupId( propertyName );
+
+    if ( propertyId != YUIPropertyId_Unknown )
+    {
+	bool success = setPropertyById( propertyId, val );
+	markChanged();
+
+	return success;
+    }
+
     try
     {
 	propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
@@ -447,14 +651,6 @@ YWidget::setProperty( const string & propertyName, const YPropertyValue & val )
 	throw;
     }
 
-    if      ( propertyName == YUIProperty_Enabled  )	setEnabled( val.boolVal() );
-    else if ( propertyName == YUIProperty_Notify   )	setNotify ( val.boolVal() );
-    else if ( propertyName == YUIProperty_HelpText )	setHelpText( val.stringVal() );
-    else if ( propertyName == YUIProperty_HWeight  )	setWeight( YD_HORIZ, val.integerVal() );
-    else if ( propertyName == YUIProperty_VWeight  )	setWeight( YD_VERT , val.integerVal() );
-    else if ( propertyName == YUIProperty_HStretch )	setStretchable( YD_HORIZ, val.boolVal() );
-    else if ( propertyName == YUIProperty_VStretch )	setStretchable( YD_VERT , val.boolVal() );
-
     return true; // success -- no special processing necessary
 }
 
@@ -462,6 +658,12 @@ YWidget::setProperty( const string & propertyName, const YPropertyValue & val )
 YPropertyValue
 YWidget::getProperty( const string & propertyName )
 {
+    YUI_TRACE_SPAN_DETAIL( "getProperty", propertyName );
+    YPropertyId propertyId = YProperty::lookupId( propertyName );
+
+    if ( propertyId != YUIPropertyId_Unknown )
+	return getPropertyById( propertyId );
+
     try
     {
 	propertySet().check( propertyName ); // throws exceptions if not found
@@ -472,17 +674,73 @@ YWidget::getProperty( const string & propertyName )
 	throw;
     }
 
-    if ( propertyName == YUIProperty_Enabled 		) return YPropertyValue( isEnabled() 	);
-    if ( propertyName == YUIProperty_Notify  		) return YPropertyValue( notify()   	);
-    if ( propertyName == YUIProperty_ContextMenu	) return YPropertyValue( notifyContextMenu() );
-    if ( propertyName == YUIProperty_WidgetClass	) return YPropertyValue( widgetClass() 	);
-    if ( propertyName == YUIProperty_HelpText		) return YPropertyValue( helpText() 	);
-    if ( propertyName == YUIProperty_DebugLabel		) return YPropertyValue( debugLabel()	);
-    if ( propertyName == YUIProperty_HWeight		) return YPropertyValue( weight( YD_HORIZ ) );
-    if ( propertyName == YUIProperty_VWeight		) return YPropertyValue( weight( YD_VERT  ) );
-    if ( propertyName == YUIProperty_HStretch		) return YPropertyValue( stretchable( YD_HORIZ ) );
-    if ( propertyName == YUIProperty_VStretch		) return YPropertyValue( stretchable( YD_VERT  ) );
-    if ( propertyName == YUIProperty_ID	&& this->hasId() ) return YPropertyValue(this->id()->toString());
+    return YPropertyValue( false ); // NOTREACHED
+}
+
+
+bool
+YWidget::setPropertyById( YPropertyId propertyId, const YPropertyValue & val )
+{
+    try
+    {
+	propertySet().check( propertyId, val.type() ); // throws exceptions if not found or type mismatch
+    }
+    catch( YUIPropertyException & exception )
+    {
+	exception.setWidget( this );
+	throw;
+    }
+
+    switch ( propertyId )
+    {
+	case YUIPropertyId_Enabled:	setEnabled( val.boolVal() );			break;
+	case YUIPropertyId_Notify:	setNotify ( val.boolVal() );			break;
+	case YUIPropertyId_HelpText:	setHelpText( val.stringVal() );			break;
+	case YUIPropertyId_HWeight:	setWeight( YD_HORIZ, val.integerVal() );	break;
+	case YUIPropertyId_VWeight:	setWeight( YD_VERT , val.integerVal() );	break;
+	case YUIPropertyId_HStretch:	setStretchable( YD_HORIZ, val.boolVal() );	break;
+	case YUIPropertyId_VStretch:	setStretchable( YD_VERT , val.boolVal() );	break;
+	default:							break;
+    }
+
+    return true; // success -- no special processing necessary
+}
+
+
+YPropertyValue
+YWidget::getPropertyById( YPropertyId propertyId )
+{
+    try
+    {
+	propertySet().check( propertyId ); // throws exceptions if not found
+    }
+    catch( YUIPropertyException & exception )
+    {
+	exception.setWidget( this );
+	throw;
+    }
+
+    switch ( propertyId )
+    {
+	case YUIPropertyId_Enabled:	return YPropertyValue( isEnabled() 	);
+	case YUIPropertyId_Notify:	return YPropertyValue( notify()   	);
+	case YUIPropertyId_ContextMenu:	return YPropertyValue( notifyContextMenu() );
+	case YUIPropertyId_WidgetClass:	return YPropertyValue( widgetClass() 	);
+	case YUIPropertyId_HelpText:	return YPropertyValue( helpText() 	);
+	case YUIPropertyId_DebugLabel:	return YPropertyValue( debugLabel()	);
+	case YUIPropertyId_HWeight:	return YPropertyValue( weight( YD_HORIZ ) );
+	case YUIPropertyId_VWeight:	return YPropertyValue( weight( YD_VERT  ) );
+	case YUIPropertyId_HStretch:	return YPropertyValue( stretchable( YD_HORIZ ) );
+	case YUIPropertyId_VStretch:	return YPropertyValue( stretchable( YD_VERT  ) );
+
+	case YUIPropertyId_ID:
+	    if ( hasId() )
+		return YPropertyValue( id()->toString() );
+	    break;
+
+	default:
+	    break;
+    }
 
     return YPropertyValue( false ); // NOTREACHED
 }
@@ -506,6 +764,7 @@ void
 YWidget::setEnabled( bool enabled )
 {
     priv->enabled = enabled;
+    markChanged();
 }
 
 
@@ -528,6 +787,7 @@ void YWidget::setShortcutString( const string & str )
 void YWidget::setNotify( bool notify )
 {
     priv->notify = notify;
+    markChanged();
 }
 
 
@@ -563,15 +823,124 @@ int YWidget::preferredSize( YUIDimension dim )
 }
 
 
+int YWidget::cachedPreferredSize( YUIDimension dim )
+{
+    if ( priv->preferredSizeGeneration[ dim ] != _preferredSizeGeneration )
+    {
+	priv->preferredSize[ dim ] = preferredSize( dim );
+	priv->preferredSizeGeneration[ dim ] = _preferredSizeGeneration;
+    }
+
+    return priv->preferredSize[ dim ];
+}
+
+
+void YWidget::invalidateShortcut()
+{
+    YDialog * dialog = findDialog();
+
+    if ( dialog && ! dialog->beingDestroyed() )
+	dialog->invalidateShortcuts( this );
+
+    markChanged();
+}
+
+
+void YWidget::invalidatePreferredSize()
+{
+    // Always go all the way up: Some containers (in particular in the
+    // UI backends) query their children directly without the cache, so a
+    // parent might have a valid cached value even if its child doesn't.
+
+    for ( YWidget * widget = this; widget; widget = widget->parent() )
+    {
+	widget->priv->preferredSizeGeneration.hor  = 0;
+	widget->priv->preferredSizeGeneration.vert = 0;
+    }
+
+    // Whatever changes the size (labels, items, ...) is a visible change
+    markChanged();
+}
+
+
+void YWidget::markChanged()
+{
+    YDialog * dialog = findDialog();
+
+    if ( dialog && ! dialog->beingDestroyed() )
+	priv->changeGeneration = dialog->registerChange( this );
+}
+
+
+YPropertyValue YWidget::userInputValue()
+{
+    return getProperty( userInputProperty() );
+}
+
+
+bool YWidget::detectInputChange()
+{
+    if ( ! userInputProperty() )
+	return false;
+
+    YPropertyValue value = userInputValue();
+
+    // Only simple values can be compared
+    if ( value.type() == YOtherProperty || value.type() == YUnknownPropertyType )
+	return false;
+
+    bool changed = ! priv->hasInputSnapshot || value != priv->inputSnapshot;
+
+    priv->inputSnapshot	   = value;
+    priv->hasInputSnapshot = true;
+
+    if ( changed )
+	markChanged();
+
+    return changed;
+}
+
+
+void YWidget::markLabelChanged()
+{
+    YDialog * dialog = findDialog();
+
+    if ( dialog && ! dialog->beingDestroyed() )
+	dialog->markLabelChanged();
+}
+
+
+void YWidget::labelChanged()
+{
+    invalidatePreferredSize();
+    markLabelChanged();
+    invalidateShortcut();
+}
+
+
+unsigned long YWidget::changeGeneration() const
+{
+    return priv->changeGeneration;
+}
+
+
+void YWidget::invalidateAllPreferredSizes()
+{
+    ++_preferredSizeGeneration;
+}
+
+
 void YWidget::setStretchable( YUIDimension dim, bool newStretch )
 {
     priv->stretch[ dim ] = newStretch;
+    invalidatePreferredSize();
 }
 
 
 void YWidget::setDefaultStretchable( YUIDimension dim, bool newStretch )
 {
     priv->stretch[ dim ] |= newStretch;
+    invalidatePreferredSize();
 }
 
 
@@ -590,6 +959,7 @@ int YWidget::weight( YUIDimension dim )
 void YWidget::setWeight( YUIDimension dim, int weight )
 {
     priv->weight[ dim ] = weight;
+    invalidatePreferredSize();
 }
 
 
@@ -620,25 +990,18 @@ YWidget::findWidget( YWidgetID * id, bool doThrow ) const
 	return 0;
     }
 
-    for ( YWidgetListConstIterator it = childrenBegin();
-	  it != childrenEnd();
-	  ++it )
-    {
-	YWidget * child = *it;
-	YUI_CHECK_WIDGET( child );
+    YWidget * found = 0;
+    YDialog * dialog = const_cast<YWidget *>( this )->findDialog();
 
-	if ( child->id() && child->id()->isEqual( id ) )
-	    return child;
-
-	if ( child->hasChildren() )
-	{
-	    YWidget * found = child->findWidget( id, false );
-
-	    if ( found )
-		return found;
-	}
+    if ( ! dialog || ! dialog->findIndexedWidget( id, this, found ) )
+    {
+	++_findWidgetFallbackCount;
+	found = findWidgetInTree( this, id );
     }
 
+    if ( found )
+	return found;
+
     if ( doThrow )
 	YUI_THROW( YUIWidgetNotFoundException( id->toString() ) );
 
@@ -646,6 +1009,12 @@ YWidget::findWidget( YWidgetID * id, bool doThrow ) const
 }
 
 
+int YWidget::findWidgetFallbackCount()
+{
+    return _findWidgetFallbackCount;
+}
+
+
 void YWidget::setChildrenEnabled( bool enabled )
 {
     for ( YWidgetListConstIterator it = childrenBegin();
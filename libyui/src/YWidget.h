@@ -27,6 +27,7 @@
 
 #include <string>
 #include <iosfwd>
+#include <atomic>
 
 #include "YTypes.h"
 #include "YProperty.h"
@@ -41,9 +42,9 @@ class YWidgetID;
 class YMacroRecorder;
 
 
-typedef YChildrenManager<YWidget>	YWidgetChildrenManager;
-typedef YSingleChildManager<YWidget>	YSingleWidgetChildManager;
-typedef YChildrenRejector<YWidget>	YWidgetChildrenRejector;
+typedef YChildrenManager<YWidget, YWidgetList>		YWidgetChildrenManager;
+typedef YSingleChildManager<YWidget, YWidgetList>	YSingleWidgetChildManager;
+typedef YChildrenRejector<YWidget, YWidgetList>		YWidgetChildrenRejector;
 
 class YWidgetPrivate;
 
@@ -138,7 +139,12 @@ public:
     virtual const YPropertySet & propertySet();
 
     /**
-     * Set a property. Derived classes need to implement this.
+     * Set a property by name.
+     *
+     * This looks up the interned ID of the property name and calls
+     * setPropertyById(). Derived classes should reimplement that one; this
+     * one only if they need to handle property names that are not
+     * well-known.
      *
      * This method may throw exceptions, for example
      *	 - if there is no property with that name
@@ -153,13 +159,52 @@ public:
 			      const YPropertyValue & val );
 
     /**
-     * Get a property. Derived classes need to implement this.
+     * Get a property by name.
+     *
+     * This looks up the interned ID of the property name and calls
+     * getPropertyById(). Derived classes should reimplement that one.
      *
      * This method may throw exceptions, for example
      *	 - if there is no property with that name
      **/
     virtual YPropertyValue getProperty( const std::string & propertyName );
 
+    /**
+     * Set a property by its interned ID. Callers that set properties in
+     * tight loops should prefer this one.
+     *
+     * This goes through the version that takes the property name with the
+     * interned name string, so a derived class that only reimplements
+     * that one still gets the call; the ID is taken from the interned
+     * string without any string comparison.
+     **/
+    bool setProperty( YPropertyId propertyId, const YPropertyValue & val )
+	{ return setProperty( YProperty::idString( propertyId ), val ); }
+
+    /**
+     * Get a property by its interned ID. See setProperty() above.
+     **/
+    YPropertyValue getProperty( YPropertyId propertyId )
+	{ return getProperty( YProperty::idString( propertyId ) ); }
+
+    /**
+     * Set a property. Derived classes need to implement this.
+     *
+     * This is called by setProperty() for all well-known property names
+     * with the interned ID instead of the name, so it does not need any
+     * string comparison. Applications should call setProperty() instead.
+     **/
+    virtual bool setPropertyById( YPropertyId	         propertyId,
+				  const YPropertyValue & val );
+
+    /**
+     * Get a property. Derived classes need to implement this.
+     *
+     * This is called by getProperty() for all well-known property names.
+     * Applications should call getProperty() instead.
+     **/
+    virtual YPropertyValue getPropertyById( YPropertyId propertyId );
+
 
     //
     // Children Management
@@ -253,8 +298,7 @@ public:
     /**
      * Checks if 'child' is a (direct!) child of this widget.
      **/
-    bool contains( YWidget * child ) const
-	{ return childrenManager()->contains( child ); }
+    bool contains( YWidget * child ) const;
 
     /**
      * Add a new child.
@@ -301,9 +345,21 @@ public:
      * If there is no widget with that ID, this function throws a
      * YUIWidgetNotFoundException if 'doThrow' is 'true'. It returns 0 if
      * 'doThrow' is 'false'.
+     *
+     * If this widget belongs to a dialog, this uses the dialog's widget ID
+     * index, so the cost does not depend on the number of widgets. Only if
+     * the index cannot answer the query unambiguously (no dialog, duplicate
+     * IDs) this falls back to walking the widget tree.
      **/
     YWidget * findWidget( YWidgetID * id, bool doThrow = true ) const;
 
+    /**
+     * Return the number of findWidget() calls so far that could not be
+     * answered from a dialog's widget ID index and had to fall back to
+     * walking the widget tree. This is useful for performance diagnostics.
+     **/
+    static int findWidgetFallbackCount();
+
 
     //
     // Geometry Management
@@ -335,6 +391,79 @@ public:
      **/
     virtual int preferredSize( YUIDimension dim );
 
+    /**
+     * Preferred size of the widget in the specified dimension, using the
+     * value cached from an earlier call if it is still valid. Otherwise this
+     * calls preferredSize() and caches the result.
+     *
+     * Layout containers should use this when querying their children so
+     * each widget's preferred size is calculated only once per layout, and
+     * only again after something changed that affects it.
+     **/
+    int cachedPreferredSize( YUIDimension dim );
+
+    /**
+     * Invalidate the cached preferred size of this widget and of all its
+     * parents up to the dialog.
+     *
+     * This is done automatically when children are added or removed or when
+     * the stretchable state or the weight change. Derived classes need to
+     * call this whenever anything else changes that affects their preferred
+     * size, typically their content (label, text, items, ...).
+     *
+     * This also marks this widget as changed, see markChanged().
+     **/
+    void invalidatePreferredSize();
+
+    /**
+     * Mark this widget as changed: Something that can be queried from the
+     * outside (properties, items, value) changed. This starts a new
+     * modification generation of the dialog and records it as this
+     * widget's change generation.
+     *
+     * This is done automatically by setProperty(), invalidatePreferredSize(),
+     * invalidateShortcut() and the YWidget setters. Derived classes only
+     * need to call this for changes that don't go through any of them.
+     **/
+    void markChanged();
+
+    /**
+     * Check if the value of the user input property (see
+     * userInputProperty()) changed since the last call and mark this widget
+     * as changed if it did. The UI backend might change that value without
+     * notice, so this compares it with a snapshot taken by the last call.
+     * Without a snapshot (the first call) the value counts as changed.
+     *
+     * Returns 'true' if the value changed.
+     *
+     * Derived classes can reimplement this for values that are not
+     * property values at all, e.g. the selected items.
+     **/
+    virtual bool detectInputChange();
+
+    /**
+     * Notify the dialog that the label of this widget changed (see
+     * YDialog::labelGeneration()). Derived classes need to call this
+     * whenever their label changes, in addition to markChanged() or
+     * invalidatePreferredSize(); labelChanged() does all of that.
+     * setId() does this automatically.
+     **/
+    void markLabelChanged();
+
+    /**
+     * Return the dialog modification generation of the last change of this
+     * widget (see markChanged() and YDialog::modificationGeneration()),
+     * or 0 if it was not marked as changed yet.
+     **/
+    unsigned long changeGeneration() const;
+
+    /**
+     * Invalidate the cached preferred sizes of all widgets, e.g. because
+     * fonts or the language changed. This does not traverse any widget tree;
+     * the values are recalculated lazily.
+     **/
+    static void invalidateAllPreferredSizes();
+
     /**
      * Set the new size of the widget.
      *
@@ -567,6 +696,17 @@ public:
      **/
     virtual void setShortcutString( const std::string & str );
 
+    /**
+     * Tell the dialog's keyboard shortcut manager that the shortcut string
+     * of this widget changed, so the next shortcut check includes this
+     * widget again.
+     *
+     * Derived classes need to call this whenever the string that
+     * shortcutString() returns changes, typically in setLabel().
+     * Selection widgets also call it when their items change.
+     **/
+    void invalidateShortcut();
+
     /**
      * The name of the widget property that will return user input, if there is
      * any.  Widgets that do have user input (such as InputField, ComboBox,
@@ -648,6 +788,24 @@ public:
 
 protected:
 
+    /**
+     * Return the value of the user input property as a string, boolean or
+     * integer property value for detectInputChange(). This default
+     * implementation returns that property.
+     *
+     * Derived classes need to reimplement this if that property is of type
+     * YOtherProperty.
+     **/
+    virtual YPropertyValue userInputValue();
+
+    /**
+     * Notify everybody who needs to know that the label of this widget
+     * changed: Invalidate the preferred size and the shortcut and mark the
+     * label as changed in the dialog. Derived classes call this from their
+     * label setters.
+     **/
+    void labelChanged();
+
     /**
      * Returns this widget's children manager.
      **/
@@ -692,6 +850,12 @@ private:
      **/
     void invalidate();
 
+    /**
+     * Forget the cached dialog of this widget and of all its children after
+     * this widget was added to or removed from a parent.
+     **/
+    void forgetDialog();
+
     /**
      * Disable copy constructor.
      **/
@@ -712,6 +876,8 @@ private:
     ImplPtr<YWidgetPrivate>	priv;
     static YPropertySet		_propertySet;
     static bool			_usedOperatorNew;
+    static std::atomic<int>	_findWidgetFallbackCount;
+    static int			_preferredSizeGeneration;
 
 
 #include "YWidget_OptimizeChanges.h"
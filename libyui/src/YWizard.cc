@@ -130,13 +130,13 @@ YWizard::propertySet()
 
 
 YPropertyValue
-YWizard::getProperty( const string & propertyName )
+YWizard::getPropertyById( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
+    propertySet().check( propertyId ); // throws exceptions if not found
 
-    if ( propertyName == YUIProperty_CurrentItem )	return YPropertyValue( YOtherProperty );
+    if ( propertyId == YUIPropertyId_CurrentItem )	return YPropertyValue( YOtherProperty );
     else
     {
-	return YWidget::getProperty( propertyName );
+	return YWidget::getPropertyById( propertyId );
     }
 }
@@ -0,0 +1,143 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for recording and playing binary macros
+
+#define BOOST_TEST_MODULE YBinaryMacro_tests
+#include <boost/test/unit_test.hpp>
+
+#include <stdio.h>	// remove()
+#include <fstream>
+
+#include "YNullUI.h"
+#include "YNullTestUI.h"
+#include "YDialog.h"
+#include "YLayoutBox.h"
+#include "YInputField.h"
+#include "YCheckBox.h"
+#include "YPushButton.h"
+#include "YWidgetID.h"
+#include "YMacro.h"
+#include "YBinaryMacroRecorder.h"
+#include "YBinaryMacroPlayer.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+static const char * macroFile = "YBinaryMacro_test.ymacro";
+
+
+// A dialog with an input field "name", a check box "agree" and a button "ok"
+static YDialog * createDialog()
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    factory()->createInputField( vbox, "&Name" )->setId( new YStringWidgetID( "name" ) );
+    factory()->createCheckBox( vbox, "&Agree" )->setId( new YStringWidgetID( "agree" ) );
+    factory()->createPushButton( vbox, "&OK" )->setId( new YStringWidgetID( "ok" ) );
+    dialog->open();
+
+    return dialog;
+}
+
+
+static YWidget * widget( YDialog * dialog, const char * id )
+{
+    YStringWidgetID widgetId( id );
+
+    return dialog->findWidget( &widgetId );
+}
+
+
+BOOST_AUTO_TEST_CASE( record_and_play )
+{
+    // Record a session: The user fills in the dialog and clicks "OK"
+
+    YDialog * dialog = createDialog();
+
+    YMacro::setRecorder( new YBinaryMacroRecorder() );
+    YMacro::record( macroFile );
+    BOOST_CHECK( YMacro::recording() );
+
+    dynamic_cast<YInputField *>( widget( dialog, "name" ) )->setValue( "Tux" );
+    dynamic_cast<YCheckBox *>( widget( dialog, "agree" ) )->setChecked( true );
+    YNullUI::ui()->queueWidgetEvent( widget( dialog, "ok" ) );
+
+    BOOST_CHECK( dialog->waitForEvent()->widget() == widget( dialog, "ok" ) );
+
+    YMacro::endRecording();
+    YMacro::setRecorder( 0 );
+    dialog->destroy();
+
+    // Play it in a new dialog
+
+    dialog = createDialog();
+
+    YBinaryMacroPlayer * player = new YBinaryMacroPlayer();
+    YMacro::setPlayer( player );
+    YMacro::play( macroFile );
+    BOOST_CHECK( YMacro::playing() );
+
+    YEvent * event = dialog->waitForEvent();
+
+    BOOST_CHECK_EQUAL( event->eventType(), YEvent::WidgetEvent );
+    BOOST_CHECK( event->widget() == widget( dialog, "ok" ) );
+    BOOST_CHECK_EQUAL( dynamic_cast<YInputField *>( widget( dialog, "name" ) )->value(), "Tux" );
+    BOOST_CHECK( dynamic_cast<YCheckBox *>( widget( dialog, "agree" ) )->isChecked() );
+
+    // The macro is finished: Back to (scripted) user input
+    event = dialog->waitForEvent();
+    BOOST_CHECK_EQUAL( event->eventType(), YEvent::CancelEvent );
+    BOOST_CHECK( ! YMacro::playing() );
+
+    BOOST_CHECK_EQUAL( player->steps().size(), 1 );
+    BOOST_CHECK_EQUAL( player->steps().front().widgetId, "ok" );
+    BOOST_CHECK( player->steps().front().properties >= 2 );
+
+    YMacro::setPlayer( 0 );
+    dialog->destroy();
+    remove( macroFile );
+}
+
+
+BOOST_AUTO_TEST_CASE( broken_file )
+{
+    {
+	std::ofstream file( macroFile );
+	file << "not a macro";
+    }
+
+    YDialog * dialog = createDialog();
+
+    YMacro::setPlayer( new YBinaryMacroPlayer() );
+    YMacro::play( macroFile );
+    BOOST_CHECK( ! YMacro::playing() );
+    BOOST_CHECK_EQUAL( dialog->waitForEvent()->eventType(), YEvent::CancelEvent );
+
+    YMacro::setPlayer( 0 );
+    dialog->destroy();
+    remove( macroFile );
+}
@@ -0,0 +1,156 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for YChildrenManager and the children handling of
+// YWidget
+
+#define BOOST_TEST_MODULE YChildrenManager_tests
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
+
+#include "YNullTestUI.h"
+#include "YChildrenManager.h"
+#include "YDialog.h"
+#include "YLayoutBox.h"
+#include "YPushButton.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// both storage variants of the children manager
+typedef boost::mpl::list< std::list<int *>, std::vector<int *> > ChildrenLists;
+
+static int children[4];
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( add, List, ChildrenLists )
+{
+    YChildrenManager<int, List> manager( 0 );
+    BOOST_CHECK( manager.empty() );
+    BOOST_CHECK( manager.firstChild() == 0 );
+
+    for ( int & child: children )
+	manager.add( &child );
+
+    BOOST_CHECK_EQUAL( manager.count(), 4 );
+    BOOST_CHECK( manager.firstChild() == &children[0] );
+    BOOST_CHECK( manager.lastChild() == &children[3] );
+    BOOST_CHECK( manager.contains( &children[2] ) );
+
+    // the order is kept
+    int i = 0;
+
+    for ( int * child: manager )
+	BOOST_CHECK( child == &children[i++] );
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( remove_children, List, ChildrenLists )
+{
+    YChildrenManager<int, List> manager( 0 );
+
+    for ( int & child: children )
+	manager.add( &child );
+
+    manager.remove( &children[3] );
+    manager.remove( &children[0] );
+    // not a child (anymore)
+    manager.remove( &children[0] );
+
+    BOOST_CHECK_EQUAL( manager.count(), 2 );
+    BOOST_CHECK( manager.firstChild() == &children[1] );
+    BOOST_CHECK( manager.lastChild() == &children[2] );
+    BOOST_CHECK( ! manager.contains( &children[0] ) );
+
+    manager.erase( manager.begin() );
+    BOOST_CHECK_EQUAL( manager.count(), 1 );
+    BOOST_CHECK( manager.firstChild() == &children[2] );
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( take_all, List, ChildrenLists )
+{
+    YChildrenManager<int, List> manager( 0 );
+
+    for ( int & child: children )
+	manager.add( &child );
+
+    List taken = manager.takeAll();
+
+    BOOST_CHECK( manager.empty() );
+    BOOST_CHECK_EQUAL( taken.size(), 4 );
+    BOOST_CHECK( taken.front() == &children[0] );
+    BOOST_CHECK( taken.back() == &children[3] );
+
+    manager.add( &children[1] );
+    BOOST_CHECK_EQUAL( manager.count(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE( widget_children )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YPushButton * first = factory()->createPushButton( vbox, "First" );
+    YPushButton * middle = factory()->createPushButton( vbox, "Middle" );
+    YPushButton * last = factory()->createPushButton( vbox, "Last" );
+
+    BOOST_CHECK_EQUAL( vbox->childrenCount(), 3 );
+    BOOST_CHECK( vbox->contains( middle ) );
+
+    YWidgetListConstIterator lastPos = std::prev( vbox->childrenEnd() );
+
+    delete middle;
+    BOOST_CHECK_EQUAL( vbox->childrenCount(), 2 );
+    BOOST_CHECK( vbox->firstChild() == first );
+    BOOST_CHECK( vbox->lastChild() == last );
+
+    // removing a child keeps the iterators to its siblings
+    BOOST_CHECK( *lastPos == last );
+
+    // removed in any order, a child can be added again
+    vbox->removeChild( first );
+    first->setParent( 0 );
+    BOOST_CHECK( ! vbox->contains( first ) );
+    first->setParent( vbox );
+    vbox->addChild( first );
+    BOOST_CHECK( vbox->lastChild() == first );
+
+    delete last;
+    delete first;
+    BOOST_CHECK( ! vbox->hasChildren() );
+
+    factory()->createPushButton( vbox, "Again" );
+    BOOST_CHECK_EQUAL( vbox->childrenCount(), 1 );
+
+    // deleteChildren() takes all children before deleting them
+    vbox->deleteChildren();
+    BOOST_CHECK( ! vbox->hasChildren() );
+
+    dialog->destroy();
+}
@@ -0,0 +1,112 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#define BOOST_TEST_MODULE YEvent_tests
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <vector>
+
+#include "YNullTestUI.h"
+#include "YDialog.h"
+#include "YEvent.h"
+#include "YPushButton.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// A widget event subclass as UIs might define one
+class DerivedWidgetEvent: public YWidgetEvent
+{
+public:
+    DerivedWidgetEvent( YWidget * widget )
+	: YWidgetEvent( widget, ValueChanged )
+	{}
+};
+
+
+BOOST_AUTO_TEST_CASE( widget_event_tag )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YPushButton * button = factory()->createPushButton( dialog, "OK" );
+
+    std::vector<YEvent *> events =
+    {
+	new YWidgetEvent( button ),
+	new YWidgetEvent( button, YEvent::ContextMenuActivated, YEvent::WidgetEvent ),
+	new DerivedWidgetEvent( button ),
+	new YKeyEvent( "F1", button ),
+	new YMenuEvent( "menu" ),
+	new YCancelEvent(),
+	new YDebugEvent(),
+	new YSpecialKeyEvent( "key" ),
+	new YTimeoutEvent()
+    };
+
+    // widgetEvent() must agree with dynamic_cast for all event types
+    for ( YEvent * event: events )
+    {
+	BOOST_CHECK( event->widgetEvent() == dynamic_cast<YWidgetEvent *>( event ) );
+	dialog->deleteEvent( event );
+    }
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( event_pool_reuse )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YPushButton * button = factory()->createPushButton( dialog, "OK" );
+
+    // a deleted event's memory is used for the next event of that size
+    YEvent * event = new YWidgetEvent( button );
+    void * memory  = event;
+    dialog->deleteEvent( event );
+
+    event = new YWidgetEvent( button );
+    BOOST_CHECK( (void *) event == memory );
+    dialog->deleteEvent( event );
+
+    // creating and deleting events over and over again keeps using the
+    // same few blocks
+    std::set<void *> blocks;
+
+    for ( int i = 0; i < 1000; i++ )
+    {
+	YEvent * widgetEvent  = new YWidgetEvent( button );
+	YEvent * timeoutEvent = new YTimeoutEvent();
+
+	blocks.insert( widgetEvent );
+	blocks.insert( timeoutEvent );
+
+	dialog->deleteEvent( timeoutEvent );
+	dialog->deleteEvent( widgetEvent );
+    }
+
+    BOOST_CHECK( blocks.size() <= 2 );
+
+    dialog->destroy();
+}
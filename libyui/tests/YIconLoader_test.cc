@@ -0,0 +1,170 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the lookup cache and the directory index of
+// YIconLoader. It works on a temporary icon directory.
+
+#define BOOST_TEST_MODULE YIconLoader_tests
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "YIconLoader.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// A temporary icon directory with a "base/" and a "theme/22x22/apps/"
+// subdirectory; it is removed with everything that was added to it
+struct IconDir
+{
+    IconDir()
+    {
+	char dirTemplate[] = "/tmp/YIconLoader_test.XXXXXX";
+	path = mkdtemp( dirTemplate );
+	path += "/";
+	dirs.push_back( path );
+
+	addDir( "base/" );
+	addDir( "theme/" );
+	addDir( "theme/22x22/" );
+	addDir( "theme/22x22/apps/" );
+    }
+
+    ~IconDir()
+    {
+	for ( const std::string & file: files )
+	    unlink( file.c_str() );
+
+	for ( auto dir = dirs.rbegin(); dir != dirs.rend(); ++dir )
+	    rmdir( dir->c_str() );
+    }
+
+    void addDir( const std::string & dir )
+    {
+	mkdir( ( path + dir ).c_str(), 0700 );
+	dirs.push_back( path + dir );
+    }
+
+    // create an (empty) icon file and return its full path
+    std::string addIcon( const std::string & file )
+    {
+	std::ofstream( path + file ).close();
+	files.push_back( path + file );
+
+	return path + file;
+    }
+
+    std::string			path;
+    std::vector<std::string>	dirs;
+    std::vector<std::string>	files;
+};
+
+
+BOOST_AUTO_TEST_CASE( negative_cache )
+{
+    IconDir iconDir;
+    YIconLoader loader;
+    loader.setUseDirectoryIndex( false );
+    loader.setIconBasePath( iconDir.path + "base/" );
+
+    BOOST_CHECK_EQUAL( loader.findIcon( "new" ), "" );
+
+    // the failed lookup is cached
+    std::string icon = iconDir.addIcon( "base/new.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "new" ), "" );
+
+    loader.clearCache();
+    BOOST_CHECK_EQUAL( loader.findIcon( "new" ), icon );
+
+    // so is the successful one, even if the file goes away
+    unlink( icon.c_str() );
+    BOOST_CHECK_EQUAL( loader.findIcon( "new" ), icon );
+
+    loader.clearCache();
+    BOOST_CHECK_EQUAL( loader.findIcon( "new" ), "" );
+}
+
+BOOST_AUTO_TEST_CASE( search_path_clears_cache )
+{
+    IconDir iconDir;
+    YIconLoader loader;
+    loader.setUseDirectoryIndex( false );
+
+    std::string icon = iconDir.addIcon( "theme/22x22/apps/themed.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "themed" ), "" );
+
+    loader.addIconSearchPath( iconDir.path + "theme/" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "themed" ), icon );
+
+    // the base path has precedence
+    std::string baseIcon = iconDir.addIcon( "base/themed.png" );
+    loader.setIconBasePath( iconDir.path + "base/" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "themed" ), baseIcon );
+}
+
+BOOST_AUTO_TEST_CASE( directory_index )
+{
+    IconDir iconDir;
+    YIconLoader loader;
+    loader.setUseDirectoryIndex( true );
+    loader.setIconBasePath( iconDir.path + "base/" );
+    loader.addIconSearchPath( iconDir.path + "theme/" );
+
+    std::string icon = iconDir.addIcon( "theme/22x22/apps/first.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "first" ), icon );
+
+    // the directory was read with the first lookup: a new icon in it is
+    // not found until the cache is cleared
+    std::string newIcon = iconDir.addIcon( "theme/22x22/apps/second.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "second" ), "" );
+
+    loader.clearCache();
+    BOOST_CHECK_EQUAL( loader.findIcon( "second" ), newIcon );
+
+    // relative paths use the index of their own directory
+    std::string subIcon = iconDir.addIcon( "theme/22x22/sub.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "22x22/sub" ), subIcon );
+
+    // missing directories don't get in the way
+    loader.addIconSearchPath( iconDir.path + "missing/" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "first" ), icon );
+}
+
+BOOST_AUTO_TEST_CASE( directory_index_from_environment )
+{
+    setenv( "YUI_ICON_DIR_INDEX", "1", 1 );
+    BOOST_CHECK( YIconLoader().useDirectoryIndex() );
+
+    unsetenv( "YUI_ICON_DIR_INDEX" );
+    BOOST_CHECK( ! YIconLoader().useDirectoryIndex() );
+}
@@ -0,0 +1,183 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the item arena: Memory of deleted items has to be
+// reused and returned when all items are gone.
+
+#define BOOST_TEST_MODULE YItemArena_tests
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "YNullTestUI.h"
+#include "YDialog.h"
+#include "YItem.h"
+#include "YItemArena.h"
+#include "YLayoutBox.h"
+#include "YSelectionBox.h"
+#include "YTableItem.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// 'count' items from the arena of 'widget', 'generation' makes the labels
+// differ from the previous ones
+static YItemCollection createItems( YSelectionWidget * widget, int count, int generation )
+{
+    YItemArena::Scope arenaScope( widget->itemArena() );
+    YItemCollection items;
+
+    for ( int i = 0; i < count; i++ )
+    {
+	YTableItem * item = new YTableItem( "Item " + std::to_string( i ),
+					    std::to_string( generation ) );
+	item->cell( 1 )->setSortKey( "key" );
+	items.push_back( item );
+    }
+
+    return items;
+}
+
+
+BOOST_AUTO_TEST_CASE( replace_items )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YSelectionBox * box = factory()->createSelectionBox( dialog, "" );
+    YItemArena * arena = box->itemArena();
+
+    box->replaceItems( createItems( box, 1000, 0 ) );
+    box->replaceItems( createItems( box, 1000, 1 ) );
+    size_t capacity = arena->capacity();
+
+    BOOST_CHECK( capacity > 0 );
+    // the item, its two cells and the sort key of the second one
+    BOOST_CHECK_EQUAL( arena->liveObjects(), 1000 * 4 );
+
+    // the old items are deleted after the new ones are created: the memory
+    // of the previous generation is reused
+    for ( int generation = 2; generation < 20; generation++ )
+	box->replaceItems( createItems( box, 1000, generation ) );
+
+    BOOST_CHECK_EQUAL( arena->capacity(), capacity );
+    BOOST_CHECK_EQUAL( arena->liveObjects(), 1000 * 4 );
+
+    // all items gone: the arena keeps only one chunk
+    box->deleteAllItems();
+    BOOST_CHECK_EQUAL( arena->liveObjects(), 0 );
+    BOOST_CHECK( arena->capacity() < capacity );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( heap_items )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YSelectionBox * box = factory()->createSelectionBox( dialog, "" );
+    YItemArena * arena = box->itemArena();
+
+    box->addItem( createItems( box, 1, 0 ).front() );
+    BOOST_CHECK_EQUAL( arena->liveObjects(), 4 );
+
+    // items from the heap and from the arena can be mixed
+    YTableItem * item = new YTableItem( "Heap", "item" );
+    item->cell( 0 )->setIconName( "icon" );
+    box->addItem( item );
+    BOOST_CHECK_EQUAL( arena->liveObjects(), 4 );
+
+    box->deleteAllItems();
+    BOOST_CHECK_EQUAL( arena->liveObjects(), 0 );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( many_arenas )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    std::vector<YSelectionBox *> boxes;
+
+    // several chunks per arena, deleted in a different order than created
+    for ( int i = 0; i < 20; i++ )
+    {
+	YSelectionBox * box = factory()->createSelectionBox( vbox, "" );
+	box->addItems( createItems( box, 2000, i ) );
+	boxes.push_back( box );
+    }
+
+    size_t capacity = boxes.front()->itemArena()->capacity();
+
+    for ( size_t i = 0; i < boxes.size(); i += 2 )
+	boxes[i]->deleteAllItems();
+
+    // only one chunk left
+    size_t oneChunk = boxes.front()->itemArena()->capacity();
+    BOOST_CHECK( oneChunk < capacity );
+
+    for ( size_t i = 1; i < boxes.size(); i += 2 )
+    {
+	BOOST_CHECK_EQUAL( boxes[i]->itemArena()->liveObjects(), 2000 * 4 );
+	boxes[i]->replaceItems( createItems( boxes[i], 2000, 100 ) );
+	boxes[i]->deleteAllItems();
+    }
+
+    for ( YSelectionBox * box: boxes )
+    {
+	BOOST_CHECK_EQUAL( box->itemArena()->liveObjects(), 0 );
+	BOOST_CHECK_EQUAL( box->itemArena()->capacity(), oneChunk );
+    }
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( heap_items_in_threads )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YSelectionBox * box = factory()->createSelectionBox( dialog, "" );
+    box->addItems( createItems( box, 2000, 0 ) );
+
+    // with arena chunks around, items from the heap can still be created
+    // and deleted in other threads
+    std::vector<std::thread> threads;
+
+    for ( int t = 0; t < 4; t++ )
+    {
+	threads.emplace_back( []()
+	    {
+		for ( int i = 0; i < 10000; i++ )
+		    delete new YTableItem( "Heap", "item" );
+	    } );
+    }
+
+    for ( std::thread & thread: threads )
+	thread.join();
+
+    BOOST_CHECK_EQUAL( box->itemArena()->liveObjects(), 2000 * 4 );
+
+    dialog->destroy();
+}
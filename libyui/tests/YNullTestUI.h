@@ -0,0 +1,39 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+// Helpers shared by the unit tests that need the headless null UI
+
+#ifndef YNullTestUI_h
+#define YNullTestUI_h
+
+#include <cstdlib>
+
+#include "YUI.h"
+#include "YUILoader.h"
+#include "YWidgetFactory.h"
+
+
+// Create the null UI (once) the same way an application would and return
+// its widget factory
+inline YWidgetFactory * factory()
+{
+    setenv( "YUI_PREFERED_BACKEND", YUIPlugin_Null, 1 );
+
+    return YUI::widgetFactory();
+}
+
+#endif // YNullTestUI_h
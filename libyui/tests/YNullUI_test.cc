@@ -0,0 +1,611 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the headless null UI
+
+#define BOOST_TEST_MODULE YNullUI_tests
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include "YNullUI.h"
+#include "YNullTestUI.h"
+#include "YOptionalWidgetFactory.h"
+#include "YDialog.h"
+#include "YDialogListener.h"
+#include "YEvent.h"
+#include "YLabel.h"
+#include "YLayoutBox.h"
+#include "YPushButton.h"
+#include "YRadioButton.h"
+#include "YRadioButtonGroup.h"
+#include "YComboBox.h"
+#include "YRichText.h"
+#include "YMultiLineEdit.h"
+#include "YLogView.h"
+#include "YTable.h"
+#include "YTableHeader.h"
+#include "YTableItem.h"
+#include "YMenuBar.h"
+#include "YMenuItem.h"
+#include "YUIException.h"
+#include "YWidgetID.h"
+#include "YNullWidgets.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+BOOST_AUTO_TEST_CASE( selected_by_environment )
+{
+    factory();
+
+    BOOST_CHECK( YNullUI::ui() );
+    BOOST_CHECK( YNullUI::ui() == YUI::ui() );
+    BOOST_CHECK( YUI::optionalWidgetFactory()->hasDumbTab() );
+    BOOST_CHECK( ! YUI::optionalWidgetFactory()->hasWizard() );
+}
+
+BOOST_AUTO_TEST_CASE( layout )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    factory()->createLabel( vbox, "Hello\nWorld" );
+    factory()->createPushButton( vbox, "OK" );
+    dialog->open();
+
+    // two label lines plus the button, the button is the widest widget
+    BOOST_CHECK_EQUAL( dialog->preferredWidth(), 6 );
+    BOOST_CHECK_EQUAL( dialog->preferredHeight(), 3 );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( content_changes_layout )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YRichText * richText = factory()->createRichText( vbox, "short", true );
+    dialog->open();
+
+    // the cached preferred sizes must not survive content changes
+    BOOST_CHECK_EQUAL( dialog->preferredWidth(), 40 );
+    richText->setValue( std::string( 50, 'x' ) );
+    BOOST_CHECK_EQUAL( dialog->preferredWidth(), 50 );
+
+    YTableHeader * header = new YTableHeader();
+    header->addColumn( "Name" );
+    YTable * table = factory()->createTable( vbox, header );
+    YTableItem * item = new YTableItem( "a" );
+    table->addItem( item );
+    BOOST_CHECK_EQUAL( table->preferredWidth(), 20 );
+
+    item->cell( 0 )->setLabel( std::string( 59, 'y' ) );
+    table->cellChanged( item->cell( 0 ) );
+    BOOST_CHECK_EQUAL( dialog->preferredWidth(), 60 );
+
+    YMenuBar * menuBar = factory()->createMenuBar( vbox );
+    YMenuItem * menu = new YMenuItem( std::string( 70, 'm' ) );
+    new YMenuItem( menu, "Child" );
+    menuBar->addItem( menu );
+    menuBar->rebuildMenuTree();
+    BOOST_CHECK_EQUAL( dialog->preferredWidth(), 72 );
+
+    menuBar->setItemVisible( menu, false );
+    BOOST_CHECK_EQUAL( dialog->preferredWidth(), 60 );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( size_setters_layout )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YMultiLineEdit * edit = factory()->createMultiLineEdit( vbox, "" );
+    YLogView * logView = factory()->createLogView( vbox, "", 2 );
+    edit->setDefaultVisibleLines( 3 );
+    dialog->open();
+
+    // setters that only change the size hints must invalidate the cache, too
+    BOOST_CHECK_EQUAL( dialog->preferredHeight(), 5 );
+    edit->setDefaultVisibleLines( 10 );
+    BOOST_CHECK_EQUAL( dialog->preferredHeight(), 12 );
+    logView->setVisibleLines( 7 );
+    BOOST_CHECK_EQUAL( dialog->preferredHeight(), 17 );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( scripted_events )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YPushButton * button = factory()->createPushButton( dialog, "OK" );
+    dialog->open();
+
+    button->activate();
+    YEvent * event = dialog->waitForEvent();
+    BOOST_CHECK_EQUAL( event->eventType(), YEvent::WidgetEvent );
+    BOOST_CHECK( event->widget() == button );
+
+    // no more input: a timeout with a timeout, otherwise a cancel event
+    BOOST_CHECK_EQUAL( dialog->waitForEvent( 100 )->eventType(), YEvent::TimeoutEvent );
+    BOOST_CHECK_EQUAL( dialog->waitForEvent()->eventType(), YEvent::CancelEvent );
+    BOOST_CHECK( dialog->pollEvent() == 0 );
+
+    int count = 0;
+    YNullUI::ui()->setEventSource( [&]( YDialog * ) -> YEvent *
+        { return ++count <= 3 ? new YMenuEvent( "next" ) : 0; } );
+
+    int menuEvents = 0;
+
+    while ( dialog->waitForEvent()->eventType() == YEvent::MenuEvent )
+        menuEvents++;
+
+    BOOST_CHECK_EQUAL( menuEvents, 3 );
+
+    YNullUI::ui()->setEventSource( YNullUI::EventSource() );
+    YNullUI::ui()->queueMenuEvent( "left over" );
+    BOOST_CHECK_EQUAL( YNullUI::ui()->pendingEvents(), 1 );
+    YNullUI::ui()->clearEvents();
+    BOOST_CHECK_EQUAL( YNullUI::ui()->pendingEvents(), 0 );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( widget_values )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+
+    YRadioButtonGroup * group = factory()->createRadioButtonGroup( vbox );
+    YLayoutBox * hbox = factory()->createHBox( group );
+    YRadioButton * first  = factory()->createRadioButton( hbox, "First", true );
+    YRadioButton * second = factory()->createRadioButton( hbox, "Second" );
+
+    second->setValue( true );
+    BOOST_CHECK( ! first->value() );
+    BOOST_CHECK( group->currentButton() == second );
+
+    YComboBox * comboBox = factory()->createComboBox( vbox, "Combo" );
+    comboBox->addItem( new YItem( "a" ) );
+    comboBox->addItem( new YItem( "b" ) );
+    comboBox->setValue( "b" );
+    BOOST_CHECK_EQUAL( comboBox->value(), "b" );
+    BOOST_CHECK_THROW( comboBox->setValue( "c" ), YUIException );
+
+    dialog->destroy();
+}
+
+// a label that only reimplements the property methods that take a name
+class UpperCaseLabel: public YNullLabel
+{
+public:
+    UpperCaseLabel( YWidget * parent )
+	: YNullLabel( parent, "", false, false ) {}
+
+    virtual bool setProperty( const std::string & propertyName, const YPropertyValue & val )
+    {
+	if ( propertyName == YUIProperty_Label )
+	{
+	    std::string text = val.stringVal();
+
+	    for ( char & c: text )
+		c = toupper( c );
+
+	    setText( text );
+	    return true;
+	}
+
+	return YNullLabel::setProperty( propertyName, val );
+    }
+
+    virtual YPropertyValue getProperty( const std::string & propertyName )
+    {
+	if ( propertyName == YUIProperty_Label )
+	    return YPropertyValue( "label: " + text() );
+
+	return YNullLabel::getProperty( propertyName );
+    }
+};
+
+BOOST_AUTO_TEST_CASE( name_based_property_override )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YWidget * label = new UpperCaseLabel( vbox );
+
+    // the calls with the property ID reach the reimplemented versions
+    label->setProperty( YUIPropertyId_Label, YPropertyValue( "abc" ) );
+    BOOST_CHECK_EQUAL( label->getProperty( YUIPropertyId_Label ).stringVal(), "label: ABC" );
+    BOOST_CHECK_EQUAL( label->getProperty( YUIProperty_Label ).stringVal(), "label: ABC" );
+
+    // the others are still handled by YLabel
+    label->setProperty( YUIPropertyId_Enabled, YPropertyValue( false ) );
+    BOOST_CHECK( ! label->isEnabled() );
+    BOOST_CHECK_EQUAL( label->getProperty( YUIPropertyId_Value ).stringVal(), "ABC" );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( modification_generation )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YPushButton * button = factory()->createPushButton( vbox, "OK" );
+
+    dialog->open();
+
+    unsigned long generation = dialog->modificationGeneration();
+    button->setLabel( "Cancel" );
+    button->setEnabled( false );
+    BOOST_CHECK( dialog->modificationGeneration() > generation );
+    BOOST_CHECK( dialog->structureGeneration() <= generation );
+    BOOST_CHECK( button->changeGeneration() == dialog->modificationGeneration() );
+
+    // each widget only once
+    std::vector<YWidget *> changed = dialog->changedWidgets( generation );
+    BOOST_CHECK_EQUAL( changed.size(), 1 );
+    BOOST_CHECK( changed[0] == button );
+    BOOST_CHECK( dialog->changedWidgets( dialog->modificationGeneration() ).empty() );
+
+    generation = dialog->modificationGeneration();
+    button->setId( new YStringWidgetID( "cancel" ) );
+    BOOST_CHECK( dialog->modificationGeneration() != generation );
+
+    generation = dialog->modificationGeneration();
+    delete button;
+    BOOST_CHECK( dialog->structureGeneration() > generation );
+
+    // the deleted button is gone, only the layout box changed afterwards
+    changed = dialog->changedWidgets( 0 );
+    BOOST_CHECK_EQUAL( changed.size(), 1 );
+    BOOST_CHECK( changed[0] == vbox );
+
+    // a new dialog never starts with the generation of another one
+    YDialog * popup = factory()->createPopupDialog();
+    BOOST_CHECK( popup->modificationGeneration() > dialog->modificationGeneration() );
+
+    popup->destroy();
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( label_generation )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YPushButton * button = factory()->createPushButton( vbox, "OK" );
+    YComboBox * combo = factory()->createComboBox( vbox, "Combo", true );
+
+    dialog->open();
+
+    // other changes keep the label generation
+    unsigned long generation = dialog->labelGeneration();
+    button->setEnabled( false );
+    combo->setValue( "text" );
+    BOOST_CHECK( dialog->modificationGeneration() > generation );
+    BOOST_CHECK_EQUAL( dialog->labelGeneration(), generation );
+
+    button->setLabel( "Cancel" );
+    BOOST_CHECK( dialog->labelGeneration() > generation );
+
+    generation = dialog->labelGeneration();
+    combo->setProperty( "Label", YPropertyValue( "Other" ) );
+    BOOST_CHECK( dialog->labelGeneration() > generation );
+
+    generation = dialog->labelGeneration();
+    button->setId( new YStringWidgetID( "cancel" ) );
+    BOOST_CHECK( dialog->labelGeneration() > generation );
+
+    // a structure change is a label change, too
+    generation = dialog->labelGeneration();
+    factory()->createPushButton( vbox, "New" );
+    BOOST_CHECK( dialog->labelGeneration() > generation );
+    BOOST_CHECK_EQUAL( dialog->labelGeneration(), dialog->structureGeneration() );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( input_changes )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YComboBox * combo = factory()->createComboBox( vbox, "Combo", true );
+    YTableHeader * header = new YTableHeader();
+    header->addColumn( "Name" );
+    YTable * table = factory()->createTable( vbox, header );
+    YTableItem * a = new YTableItem( "a" );
+    YTableItem * b = new YTableItem( "b" );
+    table->addItem( a );
+    table->addItem( b );
+
+    // opening takes the snapshot
+    dialog->open();
+    unsigned long generation = dialog->modificationGeneration();
+
+    // nothing changed: same generation, also across the event loop
+    BOOST_CHECK( ! dialog->detectInputChanges() );
+    BOOST_CHECK( dialog->pollEvent() == 0 );
+    BOOST_CHECK_EQUAL( dialog->modificationGeneration(), generation );
+
+    // values changed without notice, like the UI backend does
+    b->setSelected( true );
+    a->setSelected( false );
+    BOOST_CHECK_EQUAL( dialog->modificationGeneration(), generation );
+
+    BOOST_CHECK( dialog->detectInputChanges() );
+    std::vector<YWidget *> changed = dialog->changedWidgets( generation );
+    BOOST_CHECK_EQUAL( changed.size(), 1 );
+    BOOST_CHECK( changed[0] == table );
+
+    generation = dialog->modificationGeneration();
+    combo->setValue( "text" );
+    BOOST_CHECK( dialog->detectInputChanges() );
+    BOOST_CHECK( combo->changeGeneration() > generation );
+
+    // reported only once
+    generation = dialog->modificationGeneration();
+    BOOST_CHECK( ! dialog->detectInputChanges() );
+    BOOST_CHECK_EQUAL( dialog->modificationGeneration(), generation );
+
+    // detected before an event is returned
+    a->setSelected( true );
+    b->setSelected( false );
+    YNullUI::ui()->queueWidgetEvent( combo );
+    BOOST_CHECK( dialog->pollEvent() != 0 );
+    BOOST_CHECK( table->changeGeneration() > generation );
+
+    // a widget added to the open dialog counts as changed once
+    generation = dialog->modificationGeneration();
+    YComboBox * other = factory()->createComboBox( vbox, "Other", true );
+    BOOST_CHECK( dialog->detectInputChanges() );
+    BOOST_CHECK( other->changeGeneration() > generation );
+    BOOST_CHECK( ! dialog->detectInputChanges() );
+
+    dialog->destroy();
+}
+
+// Records the notifications as text
+class TestListener: public YDialogListener
+{
+public:
+    std::vector<std::string> calls;
+
+    virtual void dialogOpened( YDialog * )		{ calls.push_back( "opened" ); }
+    virtual void dialogClosed( YDialog * )		{ calls.push_back( "closed" ); }
+    virtual void waitingForEvent( YDialog * )		{ calls.push_back( "waiting" ); }
+    virtual void eventReturned( YDialog *, YEvent * event )
+        { calls.push_back( YEvent::toString( event->eventType() ) ); }
+};
+
+BOOST_AUTO_TEST_CASE( dialog_listener )
+{
+    TestListener listener;
+    YDialog::addListener( &listener );
+
+    YDialog * dialog = factory()->createMainDialog();
+    YPushButton * button = factory()->createPushButton( dialog, "OK" );
+
+    button->activate();
+    dialog->waitForEvent();
+    BOOST_CHECK( dialog->pollEvent() == 0 );
+
+    // never opened: no notification
+    YDialog * popup = factory()->createPopupDialog();
+    popup->destroy();
+
+    dialog->destroy();
+    YDialog::removeListener( &listener );
+
+    std::vector<std::string> expected = { "opened", "waiting", "WidgetEvent", "waiting", "closed" };
+    BOOST_CHECK_EQUAL_COLLECTIONS( listener.calls.begin(), listener.calls.end(),
+                                   expected.begin(), expected.end() );
+}
+
+// Records the arguments of the notifications
+class ArgumentListener: public YDialogListener
+{
+public:
+    ArgumentListener() : opened( 0 ), eventDialog( 0 ), event( 0 ), events( 0 ) {}
+
+    virtual void dialogOpened( YDialog * dialog )	{ opened = dialog; }
+    virtual void eventReturned( YDialog * dialog, YEvent * ev )
+        { eventDialog = dialog; event = ev; ++events; }
+
+    YDialog *	opened;
+    YDialog *	eventDialog;
+    YEvent *	event;
+    int		events;
+};
+
+BOOST_AUTO_TEST_CASE( dialog_listener_arguments )
+{
+    ArgumentListener listener;
+    YDialog::addListener( &listener );
+
+    YDialog * dialog = factory()->createPopupDialog();
+    YPushButton * button = factory()->createPushButton( dialog, "OK" );
+    dialog->open();
+    BOOST_CHECK( listener.opened == dialog );
+
+    // the listener gets the event that the application gets
+    button->activate();
+    YEvent * event = dialog->waitForEvent();
+    BOOST_CHECK( listener.eventDialog == dialog );
+    BOOST_CHECK( listener.event == event );
+    BOOST_CHECK( event->widget() == button );
+    BOOST_CHECK_EQUAL( listener.events, 1 );
+
+    // no more notifications after removing it
+    YDialog::removeListener( &listener );
+    button->activate();
+    dialog->waitForEvent();
+    BOOST_CHECK_EQUAL( listener.events, 1 );
+
+    dialog->destroy();
+}
+
+
+typedef std::vector<std::string> StringVector;
+
+// A null UI dialog that records its layout passes and multiple changes
+// notifications in 'log'
+class RecordingDialog: public YNullDialog
+{
+public:
+    RecordingDialog( StringVector & log )
+	: YNullDialog( YPopupDialog, YDialogNormalColor )
+	, _log( log )
+	{}
+
+    virtual void setSize( int newWidth, int newHeight )
+	{ _log.push_back( "layout" ); YNullDialog::setSize( newWidth, newHeight ); }
+
+    virtual void startMultipleChanges()	{ _log.push_back( "start" ); }
+    virtual void doneMultipleChanges()	{ _log.push_back( "done" );  }
+
+private:
+    StringVector & _log;
+};
+
+BOOST_AUTO_TEST_CASE( change_batch )
+{
+    factory();
+    StringVector log;
+    YDialog * dialog = new RecordingDialog( log );
+    YLabel * label = factory()->createLabel( dialog, "" );
+    dialog->open();
+    log.clear();
+
+    {
+	YDialog::ChangeBatch batch;
+
+	for ( int i = 0; i < 40; i++ )
+	{
+	    label->setText( std::to_string( i ) );
+	    dialog->recalcLayout();
+	}
+
+	BOOST_CHECK( log == StringVector( { "start" } ) );
+    }
+
+    // one layout pass for all changes, then the screen update
+    BOOST_CHECK( log == StringVector( { "start", "layout", "done" } ) );
+
+    // without a batch, every recalcLayout() does a layout pass
+    log.clear();
+    dialog->recalcLayout();
+    dialog->recalcLayout();
+    BOOST_CHECK_EQUAL( log.size(), 2 );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( nested_change_batches )
+{
+    factory();
+    StringVector log;
+    YDialog * dialog = new RecordingDialog( log );
+    dialog->open();
+    log.clear();
+
+    {
+	YDialog::ChangeBatch outer;
+	dialog->recalcLayout();
+
+	{
+	    YDialog::ChangeBatch inner;
+	    dialog->recalcLayout();
+	}
+
+	// the layout waits for the outermost batch
+	BOOST_CHECK( log == StringVector( { "start", "start", "done" } ) );
+	dialog->recalcLayout();
+    }
+
+    BOOST_CHECK( log == StringVector( { "start", "start", "done", "layout", "done" } ) );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( dialog_deleted_in_change_batch )
+{
+    factory();
+    StringVector log;
+    StringVector popupLog;
+    YDialog * dialog = new RecordingDialog( log );
+    dialog->open();
+    log.clear();
+
+    {
+	YDialog::ChangeBatch outer;
+	dialog->recalcLayout();
+
+	YDialog * popup = new RecordingDialog( popupLog );
+	popup->open();
+
+	{
+	    YDialog::ChangeBatch inner;
+	    popup->recalcLayout();
+
+	    // neither a layout pass nor doneMultipleChanges() for a deleted
+	    // dialog
+	    popup->destroy();
+	}
+    }
+
+    BOOST_CHECK( popupLog == StringVector( { "layout", "start" } ) );
+    BOOST_CHECK( log == StringVector( { "start", "layout", "done" } ) );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( dialog_cache )
+{
+    YDialog * dialog1 = factory()->createPopupDialog();
+    YLayoutBox * vbox1 = factory()->createVBox( dialog1 );
+    YLayoutBox * hbox  = factory()->createHBox( vbox1 );
+    YLabel * label = factory()->createLabel( hbox, "Moving" );
+
+    YDialog * dialog2 = factory()->createPopupDialog();
+    YLayoutBox * vbox2 = factory()->createVBox( dialog2 );
+
+    // findDialog() caches the dialog in the whole subtree
+    BOOST_CHECK( label->findDialog() == dialog1 );
+    BOOST_CHECK( hbox->findDialog() == dialog1 );
+
+    // moving the subtree to another dialog must clear that cache
+    vbox1->removeChild( hbox );
+    hbox->setParent( 0 );
+    BOOST_CHECK( label->findDialog() == 0 );
+
+    vbox2->addChild( hbox );
+    hbox->setParent( vbox2 );
+    BOOST_CHECK( hbox->findDialog() == dialog2 );
+    BOOST_CHECK( label->findDialog() == dialog2 );
+
+    dialog2->destroy();
+    dialog1->destroy();
+}
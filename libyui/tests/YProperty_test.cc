@@ -0,0 +1,110 @@
+/*
+  Copyright (C) 2018 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YProperty and YPropertySet classes
+
+#define BOOST_TEST_MODULE YProperty_tests
+#include <boost/test/unit_test.hpp>
+
+#include "YProperty.h"
+#include "YUISymbols.h"
+#include "YUIException.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+BOOST_AUTO_TEST_CASE( lookup_id )
+{
+    // every well-known name maps to its own ID and back
+    for ( int id = YUIPropertyId_Unknown + 1; id < YUIPropertyId_Count; id++ )
+    {
+        std::string name = YProperty::idName( (YPropertyId) id );
+        BOOST_CHECK( ! name.empty() );
+        BOOST_CHECK_EQUAL( YProperty::lookupId( name ), id );
+
+        // the interned string is recognized without hashing
+        const std::string & interned = YProperty::idString( (YPropertyId) id );
+        BOOST_CHECK_EQUAL( interned, name );
+        BOOST_CHECK_EQUAL( YProperty::lookupId( interned ), id );
+    }
+
+    BOOST_CHECK_EQUAL( YProperty::idString( YUIPropertyId_Unknown ), "" );
+
+    BOOST_CHECK_EQUAL( YProperty::lookupId( YUIProperty_Label ), YUIPropertyId_Label );
+    BOOST_CHECK_EQUAL( YProperty::lookupId( YUIProperty_VScrollValue ), YUIPropertyId_VScrollValue );
+
+    // unknown names
+    BOOST_CHECK_EQUAL( YProperty::lookupId( "" ), YUIPropertyId_Unknown );
+    BOOST_CHECK_EQUAL( YProperty::lookupId( "label" ), YUIPropertyId_Unknown );
+    BOOST_CHECK_EQUAL( YProperty::lookupId( "Labels2" ), YUIPropertyId_Unknown );
+    BOOST_CHECK_EQUAL( YProperty::lookupId( "NoSuchProperty" ), YUIPropertyId_Unknown );
+
+    BOOST_CHECK_EQUAL( YProperty( YUIProperty_Value, YStringProperty ).id(), YUIPropertyId_Value );
+    BOOST_CHECK_EQUAL( YProperty( "Custom", YStringProperty ).id(), YUIPropertyId_Unknown );
+}
+
+BOOST_AUTO_TEST_CASE( property_set )
+{
+    YPropertySet propSet;
+    propSet.add( YProperty( YUIProperty_Value,       YStringProperty ) );
+    propSet.add( YProperty( YUIProperty_WidgetClass, YStringProperty, true ) ); // read-only
+    propSet.add( YProperty( YUIProperty_Items,       YOtherProperty ) );
+    propSet.add( YProperty( "Custom",                YBoolProperty ) );
+
+    BOOST_CHECK( propSet.contains( YUIPropertyId_Value ) );
+    BOOST_CHECK( propSet.contains( YUIProperty_Value ) );
+    BOOST_CHECK( ! propSet.contains( YUIPropertyId_Label ) );
+    BOOST_CHECK( ! propSet.contains( YUIProperty_Label ) );
+    BOOST_CHECK( ! propSet.contains( YUIPropertyId_Unknown ) );
+
+    // names that are not well-known are still found
+    BOOST_CHECK( propSet.contains( "Custom" ) );
+    BOOST_CHECK( propSet.contains( "Custom", YBoolProperty ) );
+    BOOST_CHECK( ! propSet.contains( "Other" ) );
+
+    // type checks
+    BOOST_CHECK( propSet.contains( YUIPropertyId_Value, YStringProperty ) );
+    BOOST_CHECK( propSet.contains( YUIPropertyId_Items, YIntegerProperty ) );
+    BOOST_CHECK_THROW( propSet.contains( YUIPropertyId_Value, YBoolProperty ), YUIPropertyTypeMismatchException );
+    BOOST_CHECK_THROW( propSet.contains( "Custom", YStringProperty ), YUIPropertyTypeMismatchException );
+    BOOST_CHECK_THROW( propSet.check( YUIPropertyId_WidgetClass, YStringProperty ), YUISetReadOnlyPropertyException );
+    BOOST_CHECK_THROW( propSet.check( YUIPropertyId_Label ), YUIUnknownPropertyException );
+    BOOST_CHECK_NO_THROW( propSet.check( YUIPropertyId_WidgetClass ) );
+}
+
+BOOST_AUTO_TEST_CASE( first_property_wins )
+{
+    YPropertySet derivedSet;
+    derivedSet.add( YProperty( YUIProperty_Value, YIntegerProperty ) );
+
+    YPropertySet baseSet;
+    baseSet.add( YProperty( YUIProperty_Value, YStringProperty ) );
+
+    derivedSet.add( baseSet );
+
+    BOOST_CHECK_EQUAL( derivedSet.size(), 2 );
+    BOOST_CHECK( derivedSet.contains( YUIPropertyId_Value, YIntegerProperty ) );
+    BOOST_CHECK_THROW( derivedSet.contains( YUIPropertyId_Value, YStringProperty ), YUIPropertyTypeMismatchException );
+}
@@ -0,0 +1,278 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for YSelectionWidget::replaceItems() and the item
+// changes it reports to the UI
+
+#define BOOST_TEST_MODULE YSelectionWidget_tests
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "YNullTestUI.h"
+#include "YDialog.h"
+#include "YItem.h"
+#include "YNullWidgets.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// a selection box that records the item changes instead of drawing them
+class RecordingSelectionBox: public YNullSelectionBox
+{
+public:
+    RecordingSelectionBox( YWidget * parent )
+	: YNullSelectionBox( parent, "" ) {}
+
+    // the changes of the last notification and the labels the UI would
+    // show after applying them
+    YItemChangeList changes;
+    std::vector<std::string> shown;
+
+protected:
+    virtual bool supportsItemChanges() const { return true; }
+
+    virtual void itemsChanged( const YItemChangeList & newChanges )
+    {
+	changes = newChanges;
+
+	for ( const YItemChange & change : changes )
+	{
+	    std::vector<std::string>::iterator first = shown.begin() + change.first;
+
+	    switch ( change.type )
+	    {
+		case YItemChange::Removed:
+		    shown.erase( first, first + change.count );
+		    break;
+
+		case YItemChange::Inserted:
+		    shown.insert( first, change.count, "" );
+		    first = shown.begin() + change.first;
+		    // fall through
+
+		case YItemChange::Changed:
+		    for ( int i = 0; i < change.count; i++ )
+			first[i] = itemAt( change.first + i )->label();
+		    break;
+	    }
+	}
+    }
+};
+
+
+// the items for the labels in 'labels' separated by blanks
+static YItemCollection items( const std::string & labels )
+{
+    YItemCollection result;
+    std::istringstream stream( labels );
+    std::string label;
+
+    while ( stream >> label )
+	result.push_back( new YItem( label ) );
+
+    return result;
+}
+
+static std::string labels( const std::vector<std::string> & list )
+{
+    std::string result;
+
+    for ( const std::string & label : list )
+	result += ( result.empty() ? "" : " " ) + label;
+
+    return result;
+}
+
+static std::string labels( YSelectionWidget * widget )
+{
+    std::vector<std::string> list;
+
+    for ( YItemConstIterator it = widget->itemsBegin(); it != widget->itemsEnd(); ++it )
+	list.push_back( (*it)->label() );
+
+    return labels( list );
+}
+
+// the changes as text: "-" removed, "+" inserted, "~" changed, then the
+// first position and the count
+static std::string changes( const YItemChangeList & list )
+{
+    std::ostringstream result;
+
+    for ( const YItemChange & change : list )
+    {
+	const char * type = change.type == YItemChange::Removed  ? "-" :
+			    change.type == YItemChange::Inserted ? "+" : "~";
+
+	result << ( result.tellp() > 0 ? " " : "" ) << type << change.first << ":" << change.count;
+    }
+
+    return result.str();
+}
+
+// the item objects of 'widget'
+static std::set<YItem *> itemObjects( YSelectionWidget * widget )
+{
+    return std::set<YItem *>( widget->itemsBegin(), widget->itemsEnd() );
+}
+
+// replace the items of 'widget' that shows 'before' with 'after', check
+// that applying the reported changes gives 'after' and return the number
+// of kept item objects
+static int replace( RecordingSelectionBox * widget, const std::string & before, const std::string & after )
+{
+    widget->replaceItems( items( before ) );
+    widget->shown.clear();
+
+    for ( YItemConstIterator it = widget->itemsBegin(); it != widget->itemsEnd(); ++it )
+	widget->shown.push_back( (*it)->label() );
+
+    std::set<YItem *> oldItems = itemObjects( widget );
+    widget->changes.clear();
+    widget->replaceItems( items( after ) );
+
+    BOOST_CHECK_EQUAL( labels( widget ), after );
+    BOOST_CHECK_EQUAL( labels( widget->shown ), after );
+
+    int kept = 0;
+
+    for ( YItem * item: itemObjects( widget ) )
+	kept += oldItems.count( item );
+
+    return kept;
+}
+
+
+BOOST_AUTO_TEST_CASE( insert_items )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    RecordingSelectionBox * widget = new RecordingSelectionBox( dialog );
+
+    BOOST_CHECK_EQUAL( replace( widget, "a b c", "a x b c" ), 3 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "+1:1" );
+
+    BOOST_CHECK_EQUAL( replace( widget, "a b", "x y a b z" ), 2 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "+0:2 +4:1" );
+
+    BOOST_CHECK_EQUAL( replace( widget, "", "a b" ), 0 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "+0:2" );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( remove_items )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    RecordingSelectionBox * widget = new RecordingSelectionBox( dialog );
+
+    BOOST_CHECK_EQUAL( replace( widget, "a b c d", "a d" ), 2 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "-1:2" );
+
+    BOOST_CHECK_EQUAL( replace( widget, "a b c d", "b" ), 1 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "-0:1 -1:2" );
+
+    BOOST_CHECK_EQUAL( replace( widget, "a b", "" ), 0 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "-0:2" );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( move_items )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    RecordingSelectionBox * widget = new RecordingSelectionBox( dialog );
+
+    // the longest sequence in the same order is kept, only the moved item
+    // is removed and inserted again
+    BOOST_CHECK_EQUAL( replace( widget, "a b c d", "d a b c" ), 3 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "+0:1 -4:1" );
+
+    BOOST_CHECK_EQUAL( replace( widget, "a b c d e", "a d c b e" ), 3 );
+
+    BOOST_CHECK_EQUAL( replace( widget, "a b c d", "d c b a" ), 1 );
+
+    // no changes: no notification
+    widget->changes.push_back( YItemChange( YItemChange::Changed, 0, 1 ) );
+    BOOST_CHECK_EQUAL( replace( widget, "a b c", "a b c" ), 3 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "" );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( duplicate_keys )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    RecordingSelectionBox * widget = new RecordingSelectionBox( dialog );
+
+    // duplicates are matched in the order in which they appear
+    BOOST_CHECK_EQUAL( replace( widget, "a a b", "a b a" ), 2 );
+    BOOST_CHECK_EQUAL( replace( widget, "a a a", "a a" ), 2 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "-2:1" );
+    BOOST_CHECK_EQUAL( replace( widget, "a b", "a a b b" ), 2 );
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "+1:1 +3:1" );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( changed_content )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    RecordingSelectionBox * widget = new RecordingSelectionBox( dialog );
+
+    widget->replaceItems( items( "a b c" ) );
+    YItem * oldB = widget->itemAt( 1 );
+
+    // same key, different icon: replaced in place
+    YItemCollection newItems = items( "a b c" );
+    newItems[1]->setIconName( "b.png" );
+    widget->replaceItems( std::move( newItems ) );
+
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "~1:1" );
+    BOOST_CHECK( widget->itemAt( 1 ) != oldB );
+    BOOST_CHECK_EQUAL( widget->itemAt( 1 )->iconName(), "b.png" );
+    BOOST_CHECK( widget->itemAt( 1 )->owner() == widget );
+
+    // only the selection of a single selection widget changed: the items
+    // are kept
+    YItem * oldC = widget->itemAt( 2 );
+    widget->changes.clear();
+    newItems = items( "a b c" );
+    newItems[1]->setIconName( "b.png" );
+    newItems[2]->setSelected( true );
+    widget->replaceItems( std::move( newItems ) );
+
+    BOOST_CHECK_EQUAL( changes( widget->changes ), "" );
+    BOOST_CHECK( widget->itemAt( 2 ) == oldC );
+    BOOST_CHECK( widget->selectedItem() == oldC );
+    BOOST_CHECK( ! widget->itemAt( 0 )->selected() );
+
+    dialog->destroy();
+}
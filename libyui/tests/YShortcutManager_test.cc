@@ -0,0 +1,133 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the incremental keyboard shortcut checks
+
+#define BOOST_TEST_MODULE YShortcutManager_tests
+#include <boost/test/unit_test.hpp>
+
+#include "YNullUI.h"
+#include "YNullTestUI.h"
+#include "YDialog.h"
+#include "YLayoutBox.h"
+#include "YPushButton.h"
+#include "YShortcutManager.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// Check all shortcuts of 'dialog' from scratch without changing anything
+static int conflicts( YDialog * dialog )
+{
+    YShortcutManager shortcutManager( dialog );
+    shortcutManager.checkShortcuts( false );
+
+    return shortcutManager.conflictCount();
+}
+
+
+BOOST_AUTO_TEST_CASE( added_widget )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YPushButton * ok = factory()->createPushButton( vbox, "&OK" );
+    factory()->createPushButton( vbox, "&Cancel" );
+    dialog->open();
+
+    YPushButton * options = factory()->createPushButton( vbox, "&Options" );
+    dialog->checkShortcuts();
+
+    // The existing button keeps its shortcut
+    BOOST_CHECK_EQUAL( ok->label(), "&OK" );
+    BOOST_CHECK_EQUAL( options->label(), "O&ptions" );
+    BOOST_CHECK_EQUAL( conflicts( dialog ), 0 );
+
+    dialog->destroy();
+}
+
+
+BOOST_AUTO_TEST_CASE( relabelled_widget )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YPushButton * ok = factory()->createPushButton( vbox, "&OK" );
+    YPushButton * cancel = factory()->createPushButton( vbox, "&Cancel" );
+    dialog->open();
+
+    cancel->setLabel( "&Open" );
+    dialog->checkShortcuts();
+
+    BOOST_CHECK_EQUAL( ok->label(), "&OK" );
+    BOOST_CHECK_EQUAL( cancel->label(), "O&pen" );
+    BOOST_CHECK_EQUAL( conflicts( dialog ), 0 );
+
+    dialog->destroy();
+}
+
+
+BOOST_AUTO_TEST_CASE( removed_widget )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YPushButton * ok = factory()->createPushButton( vbox, "&OK" );
+    YPushButton * okay = factory()->createPushButton( vbox, "&Okay" );
+    dialog->open();
+
+    BOOST_CHECK_EQUAL( okay->label(), "O&kay" );
+
+    // Deleting the button releases 'O' for the next one that wants it
+    delete ok;
+    YPushButton * open = factory()->createPushButton( vbox, "&Open" );
+    dialog->checkShortcuts();
+
+    BOOST_CHECK_EQUAL( open->label(), "&Open" );
+    BOOST_CHECK_EQUAL( conflicts( dialog ), 0 );
+
+    dialog->destroy();
+}
+
+
+BOOST_AUTO_TEST_CASE( unresolved_shortcut )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YPushButton * a1 = factory()->createPushButton( vbox, "&A" );
+    YPushButton * a2 = factory()->createPushButton( vbox, "&A" );
+    dialog->open();
+
+    // There is only one 'A'
+    BOOST_CHECK_EQUAL( a1->label(), "&A" );
+    BOOST_CHECK_EQUAL( a2->label(), "A" );
+
+    // ...until the first button doesn't need it anymore
+    a1->setLabel( "&B" );
+    dialog->checkShortcuts();
+
+    BOOST_CHECK_EQUAL( a1->label(), "&B" );
+    BOOST_CHECK_EQUAL( a2->label(), "&A" );
+
+    dialog->destroy();
+}
@@ -0,0 +1,128 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for calling built-ins in the UI thread of the null UI.
+// CMake runs it twice: With the command channel and, with $YUI_COMMAND_PIPE
+// set, with the pipe fallback.
+
+#define BOOST_TEST_MODULE YUICommandChannel_tests
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "YUI.h"
+#include "YUILoader.h"
+#include "YBuiltinCaller.h"
+#include "YEnvVar.h"
+#include "YUICommandChannel.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// Appends its number to 'calls' and remembers the thread it was called in
+class RecordingCaller: public YBuiltinCaller
+{
+public:
+    RecordingCaller( int number, std::vector<int> & calls )
+	: _number( number )
+	, _calls( calls )
+	{}
+
+    virtual void call()
+    {
+	_calls.push_back( _number );
+	_thread = std::this_thread::get_id();
+    }
+
+    std::thread::id thread() const { return _thread; }
+
+private:
+    int			_number;
+    std::vector<int> &	_calls;
+    std::thread::id	_thread;
+};
+
+
+// Create the null UI with a UI thread
+static YUI * threadedUI()
+{
+    setenv( "YUI_PREFERED_BACKEND", YUIPlugin_Null, 1 );
+    YUILoader::loadUI( true );
+
+    return YUI::ui();
+}
+
+
+BOOST_AUTO_TEST_CASE( call_builtins )
+{
+    YUI * ui = threadedUI();
+    BOOST_REQUIRE( ui->runningWithThreads() );
+
+    bool usePipe = YEnvVar( "YUI_COMMAND_PIPE" ).isSet();
+    const YUICommandChannel * channel = ui->commandChannel();
+    BOOST_CHECK_EQUAL( channel == 0, usePipe );
+
+    uint64_t callCount = channel ? channel->callCount() : 0;
+    std::vector<int> calls;
+
+    // one by one
+    for ( int i = 0; i < 100; i++ )
+    {
+	RecordingCaller caller( i, calls );
+	ui->callBuiltin( &caller );
+
+	BOOST_CHECK( caller.thread() != std::this_thread::get_id() );
+	BOOST_CHECK( caller.thread() != std::thread::id() );
+    }
+
+    // in one go: still executed in order
+    std::vector<RecordingCaller> batch;
+    std::vector<YBuiltinCaller *> callers;
+
+    for ( int i = 100; i < 150; i++ )
+	batch.emplace_back( i, calls );
+
+    for ( RecordingCaller & caller: batch )
+	callers.push_back( &caller );
+
+    ui->callBuiltins( callers );
+
+    BOOST_REQUIRE_EQUAL( calls.size(), 150 );
+
+    for ( int i = 0; i < 150; i++ )
+	BOOST_CHECK_EQUAL( calls[i], i );
+
+    for ( const RecordingCaller & caller: batch )
+	BOOST_CHECK( caller.thread() == batch.front().thread() );
+
+    // each callBuiltin() is one call, the whole batch is another one
+    if ( channel )
+	BOOST_CHECK_EQUAL( channel->callCount() - callCount, 101 );
+
+    ui->shutdownThreads();
+}
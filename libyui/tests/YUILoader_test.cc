@@ -0,0 +1,96 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#define BOOST_TEST_MODULE YUILoader_tests
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include "YNullTestUI.h"
+#include "YDialog.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// the names of the startup phases so far
+static std::vector<std::string> phaseNames()
+{
+    std::vector<std::string> names;
+
+    for ( const YUILoader::StartupPhase & phase: YUILoader::startupPhases() )
+	names.push_back( phase.name );
+
+    return names;
+}
+
+
+BOOST_AUTO_TEST_CASE( startup_phases )
+{
+    BOOST_CHECK( YUILoader::startupPhases().empty() );
+
+    // loading the UI adds the inner phase first
+    factory();
+    std::vector<std::string> names = phaseNames();
+    std::vector<std::string> expected = { "create UI " YUIPlugin_Null, "load UI" };
+    BOOST_CHECK( names == expected );
+
+    for ( const YUILoader::StartupPhase & phase: YUILoader::startupPhases() )
+	BOOST_CHECK( phase.milliseconds >= 0.0 );
+
+    // phases added by the UI are appended
+    YUILoader::addStartupPhase( "custom", 12.5 );
+    std::vector<YUILoader::StartupPhase> phases = YUILoader::startupPhases();
+    BOOST_REQUIRE_EQUAL( phases.size(), 3 );
+    BOOST_CHECK_EQUAL( phases.back().name, "custom" );
+    BOOST_CHECK_EQUAL( phases.back().milliseconds, 12.5 );
+}
+
+BOOST_AUTO_TEST_CASE( plugin_preload )
+{
+    YUILoader::enablePluginPreload( false );
+    size_t phases = YUILoader::startupPhases().size();
+
+    // disabled: nothing to do
+    YUILoader::preloadPlugins();
+    BOOST_CHECK_EQUAL( YUILoader::startupPhases().size(), phases );
+
+    // opening a dialog does not preload anything in a helper thread for
+    // any UI but NCurses
+    YUILoader::enablePluginPreload( true );
+    YDialog * dialog = factory()->createPopupDialog();
+    dialog->open();
+    YUILoader::waitForPluginPreload();
+    BOOST_CHECK_EQUAL( YUILoader::startupPhases().size(), phases );
+
+    // that UI's event loop preloads them instead, only once
+    YUILoader::preloadPlugins();
+    YUILoader::preloadPlugins();
+    BOOST_REQUIRE_EQUAL( YUILoader::startupPhases().size(), phases + 1 );
+    BOOST_CHECK_EQUAL( YUILoader::startupPhases().back().name, "preload plugins" );
+
+    dialog->destroy();
+}
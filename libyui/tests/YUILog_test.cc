@@ -0,0 +1,418 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YUILog logging macros
+
+#define BOOST_TEST_MODULE YUILog_tests
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <signal.h>
+#include <stdio.h>	// remove()
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define YUILogComponent "test"
+#include "YUILog.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+static int loggedLines = 0;
+static bool hookDebugLogging = false;
+
+static void countingLogger( YUILogLevel_t	logLevel,
+			    const char *	logComponent,
+			    const char *	sourceFileName,
+			    int			sourceLineNo,
+			    const char *	sourceFunctionName,
+			    const char *	message )
+{
+    ++loggedLines;
+}
+
+static void enableHook( bool enable )	{ hookDebugLogging = enable; }
+static bool isEnabledHook()		{ return hookDebugLogging; }
+
+// the messages passed to the collecting logger
+static std::mutex messagesMutex;
+static std::string messages;
+// the write end of the pipe to the parent process, -1 if not used
+static int messagesPipe = -1;
+
+static void collectingLogger( YUILogLevel_t	logLevel,
+			      const char *	logComponent,
+			      const char *	sourceFileName,
+			      int		sourceLineNo,
+			      const char *	sourceFunctionName,
+			      const char *	message )
+{
+    std::lock_guard<std::mutex> lock( messagesMutex );
+    messages += message;
+    messages += '\n';
+
+    if ( messagesPipe >= 0 )
+    {
+	std::string line = std::string( message ) + '\n';
+	(void) ! write( messagesPipe, line.data(), line.size() );
+    }
+}
+
+// logs from its destructor
+struct LogOnDestruction
+{
+    ~LogOnDestruction() { yuiMilestone() << "destroyed" << std::endl; }
+};
+
+static void logAtExit()
+{
+    yuiMilestone() << "at exit" << std::endl;
+}
+
+// the log file of the asynchronous logging tests
+static const char * asyncLogFile = "YUILog_test.log";
+
+// log to a new, empty log file
+static void startLogFile()
+{
+    remove( asyncLogFile );
+    YUILog::setLogFileName( asyncLogFile );
+}
+
+// log to stderr again and return the messages starting with "async " from
+// the log file in the order in which they were written
+static std::vector<std::string> readLogFile()
+{
+    YUILog::setLogFileName( "" );
+
+    std::vector<std::string> result;
+    std::ifstream file( asyncLogFile );
+    std::string line;
+
+    while ( std::getline( file, line ) )
+    {
+	std::string::size_type pos = line.find( "async " );
+
+	if ( pos != std::string::npos )
+	    result.push_back( line.substr( pos ) );
+    }
+
+    remove( asyncLogFile );
+
+    return result;
+}
+
+static void abortHandler( int ) {}
+
+// count how often the arguments of a debug logging statement are evaluated
+static int evaluated = 0;
+
+static int evaluate()
+{
+    return ++evaluated;
+}
+
+
+BOOST_AUTO_TEST_CASE( standard_logger )
+{
+    YUILog::enableDebugLogging( false );
+    BOOST_CHECK( ! YUILog::logLevelEnabled( YUI_LOG_DEBUG ) );
+    BOOST_CHECK( YUILog::logLevelEnabled( YUI_LOG_MILESTONE ) );
+
+    evaluated = 0;
+    yuiDebug() << evaluate() << std::endl;
+    BOOST_CHECK_EQUAL( evaluated, 0 );
+
+    YUILog::enableDebugLogging( true );
+    BOOST_CHECK( YUILog::logLevelEnabled( YUI_LOG_DEBUG ) );
+
+    YUILog::enableDebugLogging( false );
+}
+
+BOOST_AUTO_TEST_CASE( custom_logger_and_hooks )
+{
+    YUILog::setLoggerFunction( countingLogger );
+    YUILog::setEnableDebugLoggingHooks( enableHook, isEnabledHook );
+
+    // by default everything goes to a custom logger
+    YUILog::setMinLogLevel( YUI_LOG_DEBUG );
+    BOOST_CHECK( YUILog::logLevelEnabled( YUI_LOG_DEBUG ) );
+
+    // the application reports that it does not want debug logging
+    YUILog::setMinLogLevel( YUI_LOG_MILESTONE );
+    BOOST_CHECK( ! YUILog::logLevelEnabled( YUI_LOG_DEBUG ) );
+
+    evaluated = 0;
+    loggedLines = 0;
+    yuiDebug() << evaluate() << std::endl;
+    yuiMilestone() << "milestone" << std::endl;
+    BOOST_CHECK_EQUAL( evaluated, 0 );
+    BOOST_CHECK_EQUAL( loggedLines, 1 );
+
+    // enabling debug logging via libyui calls the hook and opens the gate
+    YUILog::enableDebugLogging( true );
+    BOOST_CHECK( hookDebugLogging );
+    BOOST_CHECK( YUILog::logLevelEnabled( YUI_LOG_DEBUG ) );
+
+    YUILog::enableDebugLogging( false );
+    BOOST_CHECK( ! YUILog::logLevelEnabled( YUI_LOG_DEBUG ) );
+
+    // a higher level is kept
+    YUILog::setMinLogLevel( YUI_LOG_WARNING );
+    YUILog::enableDebugLogging( true );
+    BOOST_CHECK( ! YUILog::logLevelEnabled( YUI_LOG_MILESTONE ) );
+    BOOST_CHECK( YUILog::logLevelEnabled( YUI_LOG_WARNING ) );
+
+    YUILog::setMinLogLevel( YUI_LOG_DEBUG );
+    YUILog::enableDebugLogging( false );
+    YUILog::setEnableDebugLoggingHooks( 0, 0 );
+    YUILog::setLoggerFunction( 0 );
+
+    // back to the standard logger
+    BOOST_CHECK( ! YUILog::logLevelEnabled( YUI_LOG_DEBUG ) );
+}
+
+BOOST_AUTO_TEST_CASE( log_after_thread_exit )
+{
+    YUILog::setLoggerFunction( collectingLogger );
+    messages.clear();
+
+    std::thread thread( []()
+    {
+	// constructed before the thread's log state, so it is destroyed
+	// after it
+	static thread_local LogOnDestruction logOnDestruction;
+	(void) logOnDestruction;
+	yuiMilestone() << "running" << std::endl;
+    } );
+
+    thread.join();
+    YUILog::setLoggerFunction( 0 );
+
+    BOOST_CHECK_EQUAL( messages, "running\ndestroyed\n" );
+}
+
+BOOST_AUTO_TEST_CASE( log_in_atexit_handler )
+{
+    // the atexit() handlers run after the main thread's thread-local
+    // objects were destroyed, check that in a child process
+    int fds[2];
+    BOOST_REQUIRE_EQUAL( pipe( fds ), 0 );
+
+    // the child's exit() would write the buffered output again
+    std::cout.flush();
+    pid_t pid = fork();
+    BOOST_REQUIRE( pid >= 0 );
+
+    if ( pid == 0 )
+    {
+	close( fds[0] );
+	messagesPipe = fds[1];
+	YUILog::setLoggerFunction( collectingLogger );
+	yuiMilestone() << "main" << std::endl;
+	atexit( logAtExit );
+	exit( 0 );
+    }
+
+    close( fds[1] );
+
+    std::string output;
+    char buffer[256];
+    ssize_t size;
+
+    while ( ( size = read( fds[0], buffer, sizeof( buffer ) ) ) > 0 )
+	output.append( buffer, size );
+
+    close( fds[0] );
+
+    int status = 0;
+    BOOST_REQUIRE_EQUAL( waitpid( pid, &status, 0 ), pid );
+    BOOST_CHECK( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 );
+    BOOST_CHECK_EQUAL( output, "main\nat exit\n" );
+}
+
+BOOST_AUTO_TEST_CASE( async_flush_on_stop )
+{
+    startLogFile();
+    YUILog::enableAsyncLogging( true, YUI_LOG_OVERFLOW_DROP, 1000 );
+    BOOST_CHECK( YUILog::asyncLoggingEnabled() );
+
+    for ( int i = 0; i < 100; i++ )
+	yuiMilestone() << "async " << i << std::endl;
+
+    // disabling writes everything that is still pending
+    YUILog::enableAsyncLogging( false );
+    BOOST_CHECK( ! YUILog::asyncLoggingEnabled() );
+
+    std::vector<std::string> lines = readLogFile();
+    BOOST_REQUIRE_EQUAL( lines.size(), 100 );
+    BOOST_CHECK_EQUAL( lines.front(), "async 0" );
+    BOOST_CHECK_EQUAL( lines.back(), "async 99" );
+}
+
+BOOST_AUTO_TEST_CASE( async_drop_policy )
+{
+    const int count = 20000;
+    long dropped = YUILog::droppedLogLines();
+
+    startLogFile();
+    YUILog::enableAsyncLogging( true, YUI_LOG_OVERFLOW_DROP, 2 );
+
+    for ( int i = 0; i < count; i++ )
+	yuiMilestone() << "async " << i << std::endl;
+
+    YUILog::enableAsyncLogging( false );
+    dropped = YUILog::droppedLogLines() - dropped;
+
+    // each line was either written or counted as dropped
+    std::vector<std::string> lines = readLogFile();
+    BOOST_CHECK_EQUAL( lines.size() + dropped, count );
+    BOOST_WARN( dropped > 0 );
+
+    // the written ones are still in order
+    int last = -1;
+    bool ordered = true;
+
+    for ( const std::string & line: lines )
+    {
+	int i = std::stoi( line.substr( 6 ) );
+	ordered = ordered && i > last;
+	last = i;
+    }
+
+    BOOST_CHECK( ordered );
+}
+
+BOOST_AUTO_TEST_CASE( async_block_policy )
+{
+    const int count = 5000;
+    long dropped = YUILog::droppedLogLines();
+
+    // a tiny ring buffer overflows all the time, the caller waits then
+    startLogFile();
+    YUILog::enableAsyncLogging( true, YUI_LOG_OVERFLOW_BLOCK, 2 );
+
+    for ( int i = 0; i < count; i++ )
+	yuiMilestone() << "async " << i << std::endl;
+
+    YUILog::enableAsyncLogging( false );
+
+    std::vector<std::string> lines = readLogFile();
+    BOOST_CHECK_EQUAL( YUILog::droppedLogLines(), dropped );
+    BOOST_REQUIRE_EQUAL( lines.size(), count );
+
+    for ( int i = 0; i < count; i++ )
+	BOOST_REQUIRE_EQUAL( lines[i], "async " + std::to_string( i ) );
+}
+
+BOOST_AUTO_TEST_CASE( async_threads )
+{
+    const int threadCount = 4;
+    const int count = 1000;
+
+    startLogFile();
+    YUILog::enableAsyncLogging( true, YUI_LOG_OVERFLOW_BLOCK, 16 );
+
+    std::vector<std::thread> threads;
+
+    for ( int t = 0; t < threadCount; t++ )
+    {
+	threads.emplace_back( [ t, count ]()
+	{
+	    for ( int i = 0; i < count; i++ )
+		yuiMilestone() << "async " << t << " " << i << std::endl;
+	} );
+    }
+
+    for ( std::thread & thread: threads )
+	thread.join();
+
+    YUILog::enableAsyncLogging( false );
+
+    // all lines arrived, in order within each thread
+    std::vector<std::string> lines = readLogFile();
+    BOOST_CHECK_EQUAL( lines.size(), threadCount * count );
+
+    std::vector<int> next( threadCount, 0 );
+
+    for ( const std::string & line: lines )
+    {
+	std::istringstream str( line.substr( 6 ) );
+	int t = -1;
+	int i = -1;
+	str >> t >> i;
+
+	BOOST_REQUIRE( t >= 0 && t < threadCount );
+	BOOST_REQUIRE_EQUAL( i, next[t] );
+	next[t]++;
+    }
+}
+
+BOOST_AUTO_TEST_CASE( async_abort_handler )
+{
+    struct sigaction current;
+    struct sigaction boostAction;
+
+    // Boost.Test has its own handler, start without any
+    sigaction( SIGABRT, 0, &boostAction );
+    signal( SIGABRT, SIG_DFL );
+
+    // installed only while asynchronous logging is enabled
+    YUILog::enableAsyncLogging( true );
+    sigaction( SIGABRT, 0, &current );
+    BOOST_CHECK( current.sa_handler != SIG_DFL );
+
+    YUILog::enableAsyncLogging( false );
+    sigaction( SIGABRT, 0, &current );
+    BOOST_CHECK( current.sa_handler == SIG_DFL );
+
+    // a handler of the application is neither replaced nor restored later
+    signal( SIGABRT, abortHandler );
+    YUILog::enableAsyncLogging( true );
+    sigaction( SIGABRT, 0, &current );
+    BOOST_CHECK( current.sa_handler == abortHandler );
+
+    YUILog::enableAsyncLogging( false );
+    sigaction( SIGABRT, 0, &current );
+    BOOST_CHECK( current.sa_handler == abortHandler );
+
+    // nor one that the application installs while it is enabled
+    signal( SIGABRT, SIG_DFL );
+    YUILog::enableAsyncLogging( true );
+    signal( SIGABRT, abortHandler );
+    YUILog::enableAsyncLogging( false );
+    sigaction( SIGABRT, 0, &current );
+    BOOST_CHECK( current.sa_handler == abortHandler );
+
+    sigaction( SIGABRT, &boostAction, 0 );
+}
@@ -0,0 +1,213 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the trace file written by YUITrace: It has to be
+// a JSON array of events in the Chrome trace event format.
+
+#define BOOST_TEST_MODULE YUITrace_tests
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#define YUILogComponent "test"
+#include "YUILog.h"
+
+#include "YNullTestUI.h"
+#include "YDialog.h"
+#include "YItem.h"
+#include "YSelectionBox.h"
+#include "YUITrace.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// the name of the trace file of this test process
+static std::string traceFile()
+{
+    return "/tmp/YUITrace_test." + std::to_string( getpid() ) + ".json";
+}
+
+
+// stop tracing and return the events of the trace file, one per line
+static std::vector<std::string> readEvents()
+{
+    YUITrace::stop();
+
+    std::ifstream file( traceFile() );
+    std::stringstream content;
+    content << file.rdbuf();
+    unlink( traceFile().c_str() );
+
+    std::string text = content.str();
+    std::vector<std::string> events;
+
+    if ( text == "[]\n" )
+	return events;
+
+    // "[", the events separated by ",", "]"
+    BOOST_REQUIRE( text.size() > 4 );
+    BOOST_REQUIRE_EQUAL( text.substr( 0, 2 ), "[\n" );
+    BOOST_REQUIRE_EQUAL( text.substr( text.size() - 3 ), "\n]\n" );
+
+    std::istringstream lines( text.substr( 2, text.size() - 5 ) );
+    std::string line;
+
+    while ( std::getline( lines, line ) )
+    {
+	if ( ! line.empty() && line.back() == ',' )
+	    line.pop_back();
+
+	events.push_back( line );
+    }
+
+    return events;
+}
+
+
+// a JSON string without any unescaped quote or control character
+#define JSON_STRING	"\"(?:[^\"\\\\\\x00-\\x1f]|\\\\[\"\\\\nt]|\\\\u[0-9a-f]{4})*\""
+#define JSON_NUMBER	"-?[0-9]+(?:\\.[0-9]+)?"
+
+// the fields every event has
+#define EVENT_START	"\\{\"name\":(" JSON_STRING "),\"cat\":(" JSON_STRING "),\"ph\":\"([XC])\",\"ts\":(" JSON_NUMBER "),\"pid\":[0-9]+,\"tid\":[0-9]+"
+
+static const std::regex spanRegex( EVENT_START ",\"dur\":(" JSON_NUMBER ")(?:,\"args\":\\{\"detail\":(" JSON_STRING ")\\})?\\}" );
+static const std::regex counterRegex( EVENT_START ",\"args\":\\{\"value\":(-?[0-9]+)\\}\\}" );
+
+
+BOOST_AUTO_TEST_CASE( empty_trace )
+{
+    BOOST_REQUIRE( YUITrace::start( traceFile() ) );
+    BOOST_CHECK( YUITrace::isEnabled() );
+
+    BOOST_CHECK( readEvents().empty() );
+    BOOST_CHECK( ! YUITrace::isEnabled() );
+}
+
+BOOST_AUTO_TEST_CASE( spans_and_counters )
+{
+    BOOST_REQUIRE( YUITrace::start( traceFile() ) );
+
+    double start = YUITrace::now();
+    YUITrace::span( "test", "inner", YUITrace::now(), "quote \" backslash \\ newline \n tab \t bell \a" );
+    YUITrace::span( "test", "outer", start );
+    YUITrace::counter( "test", "items", 42 );
+
+    std::vector<std::string> events = readEvents();
+    BOOST_REQUIRE_EQUAL( events.size(), 3 );
+
+    std::smatch inner;
+    BOOST_REQUIRE( std::regex_match( events[0], inner, spanRegex ) );
+    BOOST_CHECK_EQUAL( inner[1], "\"inner\"" );
+    BOOST_CHECK_EQUAL( inner[2], "\"test\"" );
+    BOOST_CHECK_EQUAL( inner[3], "X" );
+    BOOST_CHECK_EQUAL( inner[6], "\"quote \\\" backslash \\\\ newline \\n tab \\t bell \\u0007\"" );
+
+    // the outer span encloses the inner one
+    std::smatch outer;
+    BOOST_REQUIRE( std::regex_match( events[1], outer, spanRegex ) );
+    BOOST_CHECK_EQUAL( outer[1], "\"outer\"" );
+    BOOST_CHECK( ! outer[6].matched );
+    BOOST_CHECK( std::stod( outer[4] ) <= std::stod( inner[4] ) );
+    BOOST_CHECK( std::stod( outer[5] ) >= std::stod( inner[5] ) );
+
+    std::smatch counter;
+    BOOST_REQUIRE( std::regex_match( events[2], counter, counterRegex ) );
+    BOOST_CHECK_EQUAL( counter[1], "\"items\"" );
+    BOOST_CHECK_EQUAL( counter[3], "C" );
+    BOOST_CHECK_EQUAL( counter[5], "42" );
+
+    // nothing is written after stopping
+    YUITrace::span( "test", "late", YUITrace::now() );
+    BOOST_CHECK( ! YUITrace::isEnabled() );
+}
+
+#ifndef YUI_NO_TRACING
+
+BOOST_AUTO_TEST_CASE( macros )
+{
+    BOOST_REQUIRE( YUITrace::start( traceFile() ) );
+
+    {
+	YUI_TRACE_SPAN_DETAIL( "macro", std::string( "detail" ) );
+    }
+
+    YUI_TRACE_COUNTER( "count", 7 );
+
+    std::vector<std::string> events = readEvents();
+    BOOST_REQUIRE_EQUAL( events.size(), 2 );
+
+    std::smatch span;
+    BOOST_REQUIRE( std::regex_match( events[0], span, spanRegex ) );
+    BOOST_CHECK_EQUAL( span[1], "\"macro\"" );
+    BOOST_CHECK_EQUAL( span[2], "\"test\"" );
+    BOOST_CHECK_EQUAL( span[6], "\"detail\"" );
+
+    std::smatch counter;
+    BOOST_REQUIRE( std::regex_match( events[1], counter, counterRegex ) );
+    BOOST_CHECK_EQUAL( counter[5], "7" );
+}
+
+BOOST_AUTO_TEST_CASE( item_counter )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YSelectionBox * box = factory()->createSelectionBox( dialog, "" );
+
+    BOOST_REQUIRE( YUITrace::start( traceFile() ) );
+
+    YItemCollection items;
+    items.push_back( new YItem( "one" ) );
+    items.push_back( new YItem( "two" ) );
+    box->addItems( items );
+    box->deleteAllItems();
+
+    std::vector<std::string> counters;
+
+    for ( const std::string & event: readEvents() )
+    {
+	std::smatch counter;
+
+	if ( std::regex_match( event, counter, counterRegex ) && counter[1] == "\"items\"" )
+	    counters.push_back( counter[5] );
+	else
+	    BOOST_CHECK( std::regex_match( event, spanRegex ) );
+    }
+
+    BOOST_REQUIRE_EQUAL( counters.size(), 2 );
+    BOOST_CHECK_EQUAL( counters[0], "2" );
+    BOOST_CHECK_EQUAL( counters[1], "0" );
+
+    dialog->destroy();
+}
+
+#endif // YUI_NO_TRACING
@@ -0,0 +1,161 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the widget ID index of YDialog used by
+// YWidget::findWidget()
+
+#define BOOST_TEST_MODULE YWidgetIdIndex_tests
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+
+#include "YNullTestUI.h"
+#include "YDialog.h"
+#include "YLayoutBox.h"
+#include "YPushButton.h"
+#include "YWidgetID.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// find the widget with the string ID 'id' below 'root', 0 if not found
+static YWidget * find( YWidget * root, const char * id )
+{
+    YStringWidgetID widgetId( id );
+    return root->findWidget( &widgetId, false );
+}
+
+
+BOOST_AUTO_TEST_CASE( set_id )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YPushButton * button = factory()->createPushButton( vbox, "OK" );
+    int fallbacks = YWidget::findWidgetFallbackCount();
+
+    BOOST_CHECK( find( dialog, "ok" ) == 0 );
+
+    button->setId( new YStringWidgetID( "ok" ) );
+    BOOST_CHECK( find( dialog, "ok" ) == button );
+    BOOST_CHECK( find( vbox, "ok" ) == button );
+
+    // the old ID is gone from the index
+    button->setId( new YStringWidgetID( "accept" ) );
+    BOOST_CHECK( find( dialog, "ok" ) == 0 );
+    BOOST_CHECK( find( dialog, "accept" ) == button );
+
+    BOOST_CHECK_EQUAL( YWidget::findWidgetFallbackCount(), fallbacks );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( reparenting )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YLayoutBox * left = factory()->createHBox( vbox );
+    YLayoutBox * right = factory()->createHBox( vbox );
+    YPushButton * button = factory()->createPushButton( left, "OK" );
+    button->setId( new YStringWidgetID( "ok" ) );
+
+    left->removeChild( button );
+    button->setParent( 0 );
+
+    // not in the dialog anymore
+    BOOST_CHECK( find( dialog, "ok" ) == 0 );
+
+    button->setParent( right );
+    right->addChild( button );
+
+    BOOST_CHECK( find( dialog, "ok" ) == button );
+    BOOST_CHECK( find( right, "ok" ) == button );
+    BOOST_CHECK( find( left, "ok" ) == 0 );
+
+    // a subtree with IDs moves to another dialog
+    YDialog * popup = factory()->createPopupDialog();
+    vbox->removeChild( right );
+    right->setParent( 0 );
+    right->setParent( popup );
+    popup->addChild( right );
+
+    BOOST_CHECK( find( dialog, "ok" ) == 0 );
+    BOOST_CHECK( find( popup, "ok" ) == button );
+
+    popup->destroy();
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( duplicate_ids )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YLayoutBox * first = factory()->createHBox( vbox );
+    YLayoutBox * second = factory()->createHBox( vbox );
+    YPushButton * button1 = factory()->createPushButton( first, "One" );
+    YPushButton * button2 = factory()->createPushButton( second, "Two" );
+    button2->setId( new YStringWidgetID( "button" ) );
+    button1->setId( new YStringWidgetID( "button" ) );
+
+    // below a common ancestor the first one in the tree wins, that
+    // needs the tree walk
+    int fallbacks = YWidget::findWidgetFallbackCount();
+    BOOST_CHECK( find( dialog, "button" ) == button1 );
+    BOOST_CHECK_EQUAL( YWidget::findWidgetFallbackCount(), fallbacks + 1 );
+
+    // unique below each box: answered by the index
+    fallbacks = YWidget::findWidgetFallbackCount();
+    BOOST_CHECK( find( first, "button" ) == button1 );
+    BOOST_CHECK( find( second, "button" ) == button2 );
+    BOOST_CHECK_EQUAL( YWidget::findWidgetFallbackCount(), fallbacks );
+
+    delete button1;
+    BOOST_CHECK( find( dialog, "button" ) == button2 );
+
+    dialog->destroy();
+}
+
+BOOST_AUTO_TEST_CASE( removal )
+{
+    YDialog * dialog = factory()->createMainDialog();
+    YLayoutBox * vbox = factory()->createVBox( dialog );
+    YLayoutBox * hbox = factory()->createHBox( vbox );
+    YPushButton * button = factory()->createPushButton( hbox, "OK" );
+    button->setId( new YStringWidgetID( "ok" ) );
+    hbox->setId( new YStringWidgetID( "box" ) );
+
+    delete button;
+    BOOST_CHECK( find( dialog, "ok" ) == 0 );
+    BOOST_CHECK( find( dialog, "box" ) == hbox );
+
+    // deleting a subtree removes all its IDs
+    factory()->createPushButton( hbox, "Again" )->setId( new YStringWidgetID( "again" ) );
+    BOOST_CHECK( find( dialog, "again" ) );
+    delete hbox;
+    BOOST_CHECK( find( dialog, "again" ) == 0 );
+    BOOST_CHECK( find( dialog, "box" ) == 0 );
+
+    dialog->destroy();
+}
@@ -0,0 +1,590 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// Microbenchmarks for hot paths of the libyui core.
+//
+// They use the headless null UI (see YNullUI.h), so they measure only libyui
+// itself, not any rendering. Usage:
+//
+//     libyui-benchmark [--quick] [--filter TEXT] [--min-time MILLISEC]
+//                      [--output FILE]
+//
+// The results are written as JSON to FILE or to stdout:
+//
+//     {
+//       "version": "4.3.2",
+//       "quick": false,
+//       "benchmarks": [
+//         { "name": "SelectionBox.addItems", "size": 1000,
+//           "iterations": 412, "ops_per_iteration": 1000,
+//           "ns_per_op": 160.2, "ms_per_iteration": 0.160 },
+//         ...
+//       ]
+//     }
+//
+// 'size' is the problem size (number of items or widgets), 'ns_per_op' the
+// average time of one operation (e.g. adding one item) over all iterations.
+// '--quick' runs each benchmark once with small sizes; this is what the
+// unit tests do to make sure the benchmarks keep working.
+//
+// "make benchmark" in the build directory writes build/benchmark.json.
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Libyui_config.h"
+#include "YNullUI.h"
+#define YUILogComponent "benchmark"
+#include "YUILog.h"
+#include "YNullTestUI.h"
+#include "YDialog.h"
+#include "YLayoutBox.h"
+#include "YLabel.h"
+#include "YPushButton.h"
+#include "YInputField.h"
+#include "YSelectionBox.h"
+#include "YTable.h"
+#include "YTableHeader.h"
+#include "YTableItem.h"
+#include "YProperty.h"
+#include "YShortcutManager.h"
+#include "YWidgetID.h"
+
+using std::string;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+
+/**
+ * Stopwatch for the timed part of one benchmark iteration.
+ * Everything outside start() / stop() is setup and not measured.
+ **/
+class Stopwatch
+{
+public:
+    Stopwatch(): _elapsed( 0 ) {}
+
+    void start() { _started = Clock::now(); }
+    void stop()	 { _elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - _started ).count(); }
+
+    long long elapsed() const { return _elapsed; }
+
+private:
+    Clock::time_point	_started;
+    long long		_elapsed;	// nanoseconds
+};
+
+
+struct BenchmarkResult
+{
+    string	name;
+    int		size;
+    long	iterations;
+    long	opsPerIteration;
+    double	nsPerOp;
+    double	msPerIteration;
+};
+
+
+/**
+ * Run benchmarks and collect their results.
+ **/
+class BenchmarkRunner
+{
+public:
+
+    BenchmarkRunner()
+	: _quick( false )
+	, _minTime( 200 )
+	{}
+
+    /**
+     * Run 'body' repeatedly until its timed part took at least the minimum
+     * time (but at least once); in quick mode, run it only once.
+     **/
+    void run( const string & name,
+	      int size,
+	      long opsPerIteration,
+	      std::function<void( Stopwatch & )> body )
+    {
+	if ( ! _filter.empty() && name.find( _filter ) == string::npos )
+	    return;
+
+	Stopwatch stopwatch;
+	long iterations = 0;
+	long long minTime = _quick ? 0 : _minTime * 1000000LL;
+
+	do
+	{
+	    body( stopwatch );
+	    iterations++;
+	}
+	while ( stopwatch.elapsed() < minTime );
+
+	BenchmarkResult result;
+	result.name		= name;
+	result.size		= size;
+	result.iterations	= iterations;
+	result.opsPerIteration	= opsPerIteration;
+	result.nsPerOp		= (double) stopwatch.elapsed() / iterations / opsPerIteration;
+	result.msPerIteration	= stopwatch.elapsed() / 1000000.0 / iterations;
+
+	_results.push_back( result );
+
+	std::cerr << std::left << std::setw( 40 ) << name
+		  << std::right << std::setw( 8 ) << size
+		  << std::setw( 14 ) << std::fixed << std::setprecision( 1 ) << result.nsPerOp << " ns/op"
+		  << std::setw( 12 ) << std::setprecision( 3 ) << result.msPerIteration << " ms/iteration"
+		  << std::endl;
+    }
+
+    /**
+     * Return the problem sizes to use: 'sizes' or only a small one in
+     * quick mode.
+     **/
+    vector<int> sizes( const vector<int> & sizes ) const
+    {
+	return _quick ? vector<int>( 1, 100 ) : sizes;
+    }
+
+    void writeJson( std::ostream & out ) const
+    {
+	out << "{\n"
+	    << "  \"version\": \"" << VERSION << "\",\n"
+	    << "  \"quick\": " << ( _quick ? "true" : "false" ) << ",\n"
+	    << "  \"benchmarks\": [";
+
+	for ( size_t i = 0; i < _results.size(); i++ )
+	{
+	    const BenchmarkResult & result = _results[i];
+
+	    out << ( i > 0 ? "," : "" ) << "\n    { "
+		<< "\"name\": \"" << result.name << "\", "
+		<< "\"size\": " << result.size << ", "
+		<< "\"iterations\": " << result.iterations << ", "
+		<< "\"ops_per_iteration\": " << result.opsPerIteration << ", "
+		<< std::fixed
+		<< "\"ns_per_op\": " << std::setprecision( 1 ) << result.nsPerOp << ", "
+		<< "\"ms_per_iteration\": " << std::setprecision( 4 ) << result.msPerIteration
+		<< " }";
+	}
+
+	out << "\n  ]\n}\n";
+    }
+
+    bool	_quick;
+    int		_minTime;	// millisec
+    string	_filter;
+
+private:
+
+    vector<BenchmarkResult> _results;
+};
+
+
+static YItemCollection createItems( int count, const string & prefix = "Item " )
+{
+    YItemCollection items;
+    items.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+	items.push_back( new YItem( prefix + std::to_string( i ) ) );
+
+    return items;
+}
+
+
+static YItemCollection createTableItems( int count )
+{
+    YItemCollection items;
+    items.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+	string no = std::to_string( i );
+	items.push_back( new YTableItem( "Package " + no, "1." + no, no + " kB" ) );
+    }
+
+    return items;
+}
+
+
+//
+// Selection widgets
+//
+
+static void benchmarkSelectionWidgets( BenchmarkRunner & runner )
+{
+    for ( int size: runner.sizes( { 1000, 10000, 100000 } ) )
+    {
+	YDialog * dialog = factory()->createPopupDialog();
+	YSelectionBox * selBox = factory()->createSelectionBox( dialog, "Items" );
+
+	runner.run( "SelectionBox.addItems", size, size, [&]( Stopwatch & stopwatch )
+	{
+	    YItemCollection items = createItems( size );
+
+	    stopwatch.start();
+	    selBox->addItems( std::move( items ) );
+	    stopwatch.stop();
+
+	    selBox->deleteAllItems();
+	});
+
+	runner.run( "SelectionBox.deleteAllItems", size, size, [&]( Stopwatch & stopwatch )
+	{
+	    selBox->addItems( createItems( size ) );
+
+	    stopwatch.start();
+	    selBox->deleteAllItems();
+	    stopwatch.stop();
+	});
+
+	// Select and find 1000 items spread over the whole list
+
+	selBox->addItems( createItems( size ) );
+	const int lookups = 1000;
+	int step = std::max( 1, size / lookups );
+
+	runner.run( "SelectionBox.selectItem", size, lookups, [&]( Stopwatch & stopwatch )
+	{
+	    stopwatch.start();
+
+	    for ( int i = 0; i < lookups; i++ )
+		selBox->selectItem( selBox->itemAt( ( i * step ) % size ) );
+
+	    stopwatch.stop();
+	});
+
+	vector<string> labels;
+
+	for ( int i = 0; i < lookups; i++ )
+	    labels.push_back( "Item " + std::to_string( ( i * step ) % size ) );
+
+	runner.run( "SelectionBox.findItem", size, lookups, [&]( Stopwatch & stopwatch )
+	{
+	    stopwatch.start();
+
+	    for ( const string & label: labels )
+	    {
+		if ( ! selBox->findItem( label ) )
+		    std::cerr << "Item " << label << " not found" << std::endl;
+	    }
+
+	    stopwatch.stop();
+	});
+
+	dialog->destroy();
+
+
+	dialog = factory()->createPopupDialog();
+	YTableHeader * header = new YTableHeader();
+	header->addColumn( "Name" );
+	header->addColumn( "Version" );
+	header->addColumn( "Size", YAlignEnd );
+	YTable * table = factory()->createTable( dialog, header );
+
+	runner.run( "Table.addItems", size, size, [&]( Stopwatch & stopwatch )
+	{
+	    YItemCollection items = createTableItems( size );
+
+	    stopwatch.start();
+	    table->addItems( std::move( items ) );
+	    stopwatch.stop();
+
+	    table->deleteAllItems();
+	});
+
+	runner.run( "Table.deleteAllItems", size, size, [&]( Stopwatch & stopwatch )
+	{
+	    table->addItems( createTableItems( size ) );
+
+	    stopwatch.start();
+	    table->deleteAllItems();
+	    stopwatch.stop();
+	});
+
+	dialog->destroy();
+    }
+}
+
+
+//
+// Layout
+//
+
+static void benchmarkLayout( BenchmarkRunner & runner )
+{
+    // Deep: Nested boxes, alternating horizontal and vertical, each one with
+    // a label and a button next to the nested box
+
+    for ( int depth: runner.sizes( { 10, 100, 500 } ) )
+    {
+	YDialog * dialog = factory()->createPopupDialog();
+	YWidget * parent = dialog;
+
+	for ( int i = 0; i < depth; i++ )
+	{
+	    YLayoutBox * box = factory()->createLayoutBox( parent, i % 2 ? YD_HORIZ : YD_VERT );
+	    factory()->createLabel( box, "Level " + std::to_string( i ) );
+	    factory()->createPushButton( box, "Button" );
+	    parent = box;
+	}
+
+	dialog->open();
+
+	runner.run( "Dialog.layout.deep", depth, 1, [&]( Stopwatch & stopwatch )
+	{
+	    stopwatch.start();
+	    dialog->recalcLayout();
+	    stopwatch.stop();
+	});
+
+	dialog->destroy();
+    }
+
+    // Wide: A grid of rows x rows labels in horizontal boxes in a vertical box
+
+    for ( int size: runner.sizes( { 100, 1000, 10000 } ) )
+    {
+	int rows = 1;
+
+	while ( rows * rows < size )
+	    rows++;
+
+	YDialog * dialog = factory()->createPopupDialog();
+	YLayoutBox * vbox = factory()->createVBox( dialog );
+
+	for ( int row = 0; row < rows; row++ )
+	{
+	    YLayoutBox * hbox = factory()->createHBox( vbox );
+
+	    for ( int col = 0; col < rows; col++ )
+		factory()->createLabel( hbox, "Cell" );
+	}
+
+	dialog->open();
+
+	runner.run( "Dialog.layout.wide", rows * rows, 1, [&]( Stopwatch & stopwatch )
+	{
+	    stopwatch.start();
+	    dialog->recalcLayout();
+	    stopwatch.stop();
+	});
+
+	dialog->destroy();
+    }
+}
+
+
+//
+// Finding widgets and shortcuts
+//
+
+static void benchmarkWidgetTree( BenchmarkRunner & runner )
+{
+    for ( int size: runner.sizes( { 100, 1000, 10000 } ) )
+    {
+	YDialog * dialog = factory()->createPopupDialog();
+	YLayoutBox * vbox = factory()->createVBox( dialog );
+	vector<YPushButton *> buttons;
+
+	for ( int i = 0; i < size; i++ )
+	{
+	    YPushButton * button = factory()->createPushButton( vbox, "&Button " + std::to_string( i ) );
+	    button->setId( new YStringWidgetID( "button" + std::to_string( i ) ) );
+	    buttons.push_back( button );
+	}
+
+	const int lookups = 1000;
+	vector<YStringWidgetID *> ids;
+
+	for ( int i = 0; i < lookups; i++ )
+	    ids.push_back( new YStringWidgetID( "button" + std::to_string( ( i * 7919 ) % size ) ) );
+
+	runner.run( "Dialog.findWidget", size, lookups, [&]( Stopwatch & stopwatch )
+	{
+	    stopwatch.start();
+
+	    for ( YStringWidgetID * id: ids )
+		dialog->findWidget( id );
+
+	    stopwatch.stop();
+	});
+
+	for ( YStringWidgetID * id: ids )
+	    delete id;
+
+	runner.run( "ShortcutManager.checkShortcuts", size, size, [&]( Stopwatch & stopwatch )
+	{
+	    // Resolving conflicts changes the labels; start over each time
+	    for ( int i = 0; i < size; i++ )
+		buttons[i]->setLabel( "&Button " + std::to_string( i ) );
+
+	    stopwatch.start();
+	    YShortcutManager shortcutManager( dialog );
+	    shortcutManager.checkShortcuts();
+	    stopwatch.stop();
+	});
+
+	// The dialog's own shortcut manager only checks what changed
+
+	dialog->open();
+	const int changes = std::min( size, 100 );
+	int changed = 0;
+
+	runner.run( "Dialog.checkShortcuts.relabel", size, changes, [&]( Stopwatch & stopwatch )
+	{
+	    stopwatch.start();
+
+	    for ( int i = 0; i < changes; i++ )
+	    {
+		int index = ( changed++ * 7919 ) % size;
+		buttons[ index ]->setLabel( "&Button " + std::to_string( index ) );
+		dialog->checkShortcuts();
+	    }
+
+	    stopwatch.stop();
+	});
+
+	dialog->destroy();
+    }
+}
+
+
+//
+// Properties
+//
+
+static void benchmarkProperties( BenchmarkRunner & runner )
+{
+    YDialog * dialog = factory()->createPopupDialog();
+    YInputField * inputField = factory()->createInputField( dialog, "Name" );
+    const int count = runner._quick ? 100 : 10000;
+    YPropertyValue value( string( "Some value" ) );
+
+    runner.run( "Property.setByName", 1, count, [&]( Stopwatch & stopwatch )
+    {
+	stopwatch.start();
+
+	for ( int i = 0; i < count; i++ )
+	    inputField->setProperty( "Value", value );
+
+	stopwatch.stop();
+    });
+
+    runner.run( "Property.getByName", 1, count, [&]( Stopwatch & stopwatch )
+    {
+	stopwatch.start();
+
+	for ( int i = 0; i < count; i++ )
+	    inputField->getProperty( "Value" );
+
+	stopwatch.stop();
+    });
+
+    runner.run( "Property.setById", 1, count, [&]( Stopwatch & stopwatch )
+    {
+	stopwatch.start();
+
+	for ( int i = 0; i < count; i++ )
+	    inputField->setProperty( YUIPropertyId_Value, value );
+
+	stopwatch.stop();
+    });
+
+    runner.run( "Property.getById", 1, count, [&]( Stopwatch & stopwatch )
+    {
+	stopwatch.start();
+
+	for ( int i = 0; i < count; i++ )
+	    inputField->getProperty( YUIPropertyId_Value );
+
+	stopwatch.stop();
+    });
+
+    dialog->destroy();
+}
+
+
+static void usage( const char * programName )
+{
+    std::cerr << "Usage: " << programName
+	      << " [--quick] [--filter TEXT] [--min-time MILLISEC] [--output FILE]"
+	      << std::endl;
+    exit( 1 );
+}
+
+
+int main( int argc, char * argv[] )
+{
+    BenchmarkRunner runner;
+    string outputFile;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	string arg = argv[i];
+
+	if ( arg == "--quick" )
+	    runner._quick = true;
+	else if ( arg == "--filter" && i + 1 < argc )
+	    runner._filter = argv[ ++i ];
+	else if ( arg == "--min-time" && i + 1 < argc )
+	    runner._minTime = atoi( argv[ ++i ] );
+	else if ( arg == "--output" && i + 1 < argc )
+	    outputFile = argv[ ++i ];
+	else
+	    usage( argv[0] );
+    }
+
+    // Keep log output (and its cost) out of the measurements
+    YUILog::setLogFileName( "/dev/null" );
+
+    YNullUI::create();
+
+    benchmarkSelectionWidgets( runner );
+    benchmarkLayout( runner );
+    benchmarkWidgetTree( runner );
+    benchmarkProperties( runner );
+
+    if ( outputFile.empty() )
+    {
+	runner.writeJson( std::cout );
+    }
+    else
+    {
+	std::ofstream out( outputFile );
+
+	if ( ! out )
+	{
+	    std::cerr << "Can't write to " << outputFile << ": " << strerror( errno ) << std::endl;
+	    return 1;
+	}
+
+	runner.writeJson( out );
+    }
+
+    return 0;
+}
@@ -19,10 +19,10 @@
 Name:           libyui-qt-pkg
 
 # DO NOT manually bump the version here; instead, use rake version:bump
-Version:        4.3.2
+Version:        4.4.0
 Release:        0
 
-%define         so_version 16
+%define         so_version 17
 %define         libzypp_devel_version libzypp-devel >= 17.21.0
 %define         bin_name %{name}%{so_version}
 